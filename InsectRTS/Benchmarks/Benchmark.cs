@@ -0,0 +1,75 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using Engine;
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// Contains helpers for timing benchmarks.
+    /// </summary>
+    internal static class Benchmark
+    {
+        /// <summary>
+        /// The number of timed runs the iterations are split between. The spread between runs shows how
+        /// much the results can be trusted.
+        /// </summary>
+        private const int RUN_COUNT = 5;
+
+        private static readonly List<BenchmarkResult> m_results = new List<BenchmarkResult>();
+
+        /// <summary>
+        /// The results of every benchmark run so far.
+        /// </summary>
+        public static List<BenchmarkResult> Results => m_results;
+
+        /// <summary>
+        /// Times an action and prints the result.
+        /// </summary>
+        /// <param name="name">The name of the benchmark.</param>
+        /// <param name="act">The action to time.</param>
+        /// <param name="iterations">The number of times to run the action, split between the timed runs.</param>
+        /// <returns>The median time taken per iteration in nanoseconds.</returns>
+        public static double Run(string name, Action act, int iterations)
+        {
+            int runIterations = Math.Max(iterations / RUN_COUNT, 1);
+
+            // warm up so the timed runs use the optimized code
+            for (int i = 0; i < Math.Max(iterations / 10, 1); i++)
+            {
+                act.Invoke();
+            }
+
+            GC.Collect();
+            GC.WaitForPendingFinalizers();
+
+            double[] runs = new double[RUN_COUNT];
+            long startAllocated = FrameStats.GetAllocatedBytes();
+            Stopwatch sw = new Stopwatch();
+
+            for (int run = 0; run < RUN_COUNT; run++)
+            {
+                sw.Restart();
+                for (int i = 0; i < runIterations; i++)
+                {
+                    act.Invoke();
+                }
+                sw.Stop();
+
+                runs[run] = (1000000000.0 * sw.ElapsedTicks / Stopwatch.Frequency) / runIterations;
+            }
+
+            long allocated = FrameStats.GetAllocatedBytes() - startAllocated;
+
+            BenchmarkResult result = new BenchmarkResult(name, runIterations, runs, (double)allocated / (runIterations * RUN_COUNT));
+            m_results.Add(result);
+
+            Console.WriteLine($"{name,-40} {result.median,12:F1}ns/op ±{result.RelativeStdDev,5:P1} {result.allocatedBytes,10:F1}B/op");
+            return result.median;
+        }
+    }
+}
@@ -0,0 +1,134 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Runtime.Serialization;
+using System.Runtime.Serialization.Json;
+using System.Text;
+using System.Xml;
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// The results of a benchmark session along with the machine they ran on. Reports are saved as JSON so
+    /// results can be tracked over time and compared against a baseline.
+    /// </summary>
+    [DataContract]
+    internal class BenchmarkReport
+    {
+        /// <summary>
+        /// How much slower than the baseline a benchmark's median time can be before it is reported as a regression.
+        /// </summary>
+        private const double REGRESSION_THRESHOLD = 0.10;
+
+        [DataMember(Order = 0)]
+        public string date;
+
+        [DataMember(Order = 1)]
+        public string runtime;
+
+        [DataMember(Order = 2)]
+        public string os;
+
+        [DataMember(Order = 3)]
+        public string process;
+
+        [DataMember(Order = 4)]
+        public int processorCount;
+
+        [DataMember(Order = 5)]
+        public List<BenchmarkResult> results;
+
+        /// <summary>
+        /// Creates a report for results from this machine.
+        /// </summary>
+        /// <param name="results">The benchmark results.</param>
+        public BenchmarkReport(List<BenchmarkResult> results)
+        {
+            date = DateTime.UtcNow.ToString("o");
+            runtime = Environment.Version.ToString();
+            os = Environment.OSVersion.VersionString;
+            process = Environment.Is64BitProcess ? "x64" : "x86";
+            processorCount = Environment.ProcessorCount;
+            this.results = results;
+        }
+
+        /// <summary>
+        /// Writes the report to a JSON file.
+        /// </summary>
+        /// <param name="path">The path of the file to write.</param>
+        public void Save(string path)
+        {
+            using (FileStream stream = File.Create(path))
+            using (XmlDictionaryWriter writer = JsonReaderWriterFactory.CreateJsonWriter(stream, new UTF8Encoding(false), false, true))
+            {
+                new DataContractJsonSerializer(typeof(BenchmarkReport)).WriteObject(writer, this);
+            }
+        }
+
+        /// <summary>
+        /// Reads a report from a JSON file.
+        /// </summary>
+        /// <param name="path">The path of the file to read.</param>
+        public static BenchmarkReport Load(string path)
+        {
+            using (FileStream stream = File.OpenRead(path))
+            {
+                return (BenchmarkReport)new DataContractJsonSerializer(typeof(BenchmarkReport)).ReadObject(stream);
+            }
+        }
+
+        /// <summary>
+        /// Prints how the median time of each benchmark changed from a baseline.
+        /// </summary>
+        /// <param name="baseline">The report to compare against.</param>
+        /// <param name="reportMissing">If true, benchmarks in the baseline that are not in this report are listed.
+        /// Should be false if only some of the benchmarks were run.</param>
+        /// <returns>The number of benchmarks that got slower by more than the regression threshold.</returns>
+        public int Compare(BenchmarkReport baseline, bool reportMissing)
+        {
+            Console.WriteLine($"Compared to baseline from {baseline.date} ({baseline.process} on {baseline.os}):");
+
+            Dictionary<string, BenchmarkResult> baselineResults = new Dictionary<string, BenchmarkResult>();
+            foreach (BenchmarkResult result in baseline.results)
+            {
+                baselineResults[result.name] = result;
+            }
+
+            int regressions = 0;
+            foreach (BenchmarkResult result in results)
+            {
+                if (!baselineResults.TryGetValue(result.name, out BenchmarkResult previous))
+                {
+                    Console.WriteLine($"{result.name,-40} {"new",14} {result.median,12:F1}ns");
+                    continue;
+                }
+
+                double change = previous.median > 0 ? (result.median - previous.median) / previous.median : 0.0;
+                bool regressed = change > REGRESSION_THRESHOLD;
+                if (regressed)
+                {
+                    regressions++;
+                }
+
+                Console.WriteLine($"{result.name,-40} {previous.median,12:F1}ns {result.median,12:F1}ns {change,8:+0.0%;-0.0%}{(regressed ? " REGRESSION" : "")}");
+            }
+
+            if (reportMissing)
+            {
+                foreach (string name in baselineResults.Keys.Except(results.Select(r => r.name)))
+                {
+                    Console.WriteLine($"{name,-40} missing from this run");
+                }
+            }
+
+            Console.WriteLine($"{regressions} of {results.Count} benchmarks were more than {REGRESSION_THRESHOLD:P0} slower than the baseline");
+            Console.WriteLine();
+            return regressions;
+        }
+    }
+}
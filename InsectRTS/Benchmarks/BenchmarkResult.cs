@@ -0,0 +1,99 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Linq;
+using System.Runtime.Serialization;
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// The statistics from timing a benchmark. All times are in nanoseconds per iteration.
+    /// </summary>
+    [DataContract]
+    internal class BenchmarkResult
+    {
+        [DataMember(Order = 0)]
+        public string name;
+
+        /// <summary>
+        /// The number of iterations in each timed run.
+        /// </summary>
+        [DataMember(Order = 1)]
+        public int iterations;
+
+        /// <summary>
+        /// The number of timed runs.
+        /// </summary>
+        [DataMember(Order = 2)]
+        public int runs;
+
+        [DataMember(Order = 3)]
+        public double mean;
+
+        [DataMember(Order = 4)]
+        public double median;
+
+        [DataMember(Order = 5)]
+        public double min;
+
+        [DataMember(Order = 6)]
+        public double max;
+
+        /// <summary>
+        /// The standard deviation of the runs.
+        /// </summary>
+        [DataMember(Order = 7)]
+        public double stdDev;
+
+        /// <summary>
+        /// The average number of bytes allocated per iteration.
+        /// </summary>
+        [DataMember(Order = 8)]
+        public double allocatedBytes;
+
+        /// <summary>
+        /// The standard deviation as a fraction of the mean.
+        /// </summary>
+        public double RelativeStdDev => mean > 0 ? stdDev / mean : 0.0;
+
+        /// <summary>
+        /// Creates a result from the times of each run.
+        /// </summary>
+        /// <param name="name">The name of the benchmark.</param>
+        /// <param name="iterations">The number of iterations in each run.</param>
+        /// <param name="runTimes">The time per iteration of each run in nanoseconds.</param>
+        /// <param name="allocatedBytes">The average number of bytes allocated per iteration.</param>
+        public BenchmarkResult(string name, int iterations, double[] runTimes, double allocatedBytes)
+        {
+            if (runTimes == null)
+            {
+                throw new ArgumentNullException("runTimes");
+            }
+            if (runTimes.Length == 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(runTimes), runTimes.Length, "Must contain at least one run!");
+            }
+
+            double[] sorted = runTimes.OrderBy(t => t).ToArray();
+            int count = sorted.Length;
+
+            this.name = name;
+            this.iterations = iterations;
+            this.allocatedBytes = allocatedBytes;
+            runs = count;
+            mean = sorted.Average();
+            median = count % 2 == 1 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0;
+            min = sorted[0];
+            max = sorted[count - 1];
+
+            double variance = 0.0;
+            foreach (double time in sorted)
+            {
+                variance += (time - mean) * (time - mean);
+            }
+            stdDev = count > 1 ? Math.Sqrt(variance / (count - 1)) : 0.0;
+        }
+    }
+}
@@ -0,0 +1,162 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.IO;
+using System.Threading;
+using Engine.Logging;
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// Measures the cost of logging to the binary event log compared to the text log, and checks that
+    /// logged events decode to the expected text, including events from threads that never flushed.
+    /// </summary>
+    internal static class BinaryLogBenchmark
+    {
+        private const int EVENT_COUNT = 1000000;
+        private const int THREAD_COUNT = 4;
+
+        /// <summary>
+        /// Runs the benchmarks and the checks.
+        /// </summary>
+        /// <returns>True if the checks passed.</returns>
+        public static bool Run()
+        {
+            Console.WriteLine("Binary log:");
+
+            string textPath = Path.Combine(Path.GetTempPath(), "InsectRTS_TextLogBenchmark.log");
+            string binaryPath = Path.Combine(Path.GetTempPath(), "InsectRTS_BinaryLogBenchmark.blog");
+
+            LogWriter textWriter = new LogWriter(new FileInfo(textPath), 8192, LogOverflowPolicy.Block, new LogFlushPolicy(1000, 32 * 1024, false), LogRotationPolicy.None);
+            BinaryLogWriter binaryWriter = new BinaryLogWriter(new FileInfo(binaryPath), 1000);
+            LogEvent moved = binaryWriter.RegisterTemplate(LogLevel.Info, "Unit {0} moved to ({1}, {2})");
+
+            int unit = 0;
+            float x = 12.5f;
+            float z = -3.25f;
+
+            Benchmark.Run("Text message", () => textWriter.BufferMessage(new LogMessage(LogLevel.Info, $"Unit {unit++} moved to ({x}, {z})")), EVENT_COUNT / 10);
+            Benchmark.Run("Binary event", () => binaryWriter.Write(moved, unit++, x, z), EVENT_COUNT);
+
+            // logging threads do not share anything, so the cost should not increase with more threads
+            Benchmark.Run($"Binary event, {THREAD_COUNT} threads", () =>
+            {
+                // a thread can only be started once, and the benchmark runs this more than once
+                Thread[] threads = new Thread[THREAD_COUNT];
+                for (int i = 0; i < THREAD_COUNT; i++)
+                {
+                    threads[i] = new Thread(() =>
+                    {
+                        for (int j = 0; j < EVENT_COUNT; j++)
+                        {
+                            binaryWriter.Write(moved, j, x, z);
+                        }
+                        binaryWriter.Flush();
+                    });
+                }
+                foreach (Thread thread in threads)
+                {
+                    thread.Start();
+                }
+                foreach (Thread thread in threads)
+                {
+                    thread.Join();
+                }
+            }, 1);
+
+            bool passed = CheckDecoding();
+            passed &= CheckUnflushedThreads();
+
+            File.Delete(textPath);
+            File.Delete(binaryPath);
+            Console.WriteLine();
+            return passed;
+        }
+
+        /// <summary>
+        /// Logs events with each argument type to a new log and decodes it.
+        /// </summary>
+        private static bool CheckDecoding()
+        {
+            string path = Path.Combine(Path.GetTempPath(), "InsectRTS_BinaryLogCheck.blog");
+            BinaryLogWriter writer = new BinaryLogWriter(new FileInfo(path), 1000);
+
+            LogEvent types = writer.RegisterTemplate(LogLevel.Warning, "{0} {1} {2} {3}");
+            LogEvent text = writer.RegisterTemplate(LogLevel.Error, "Shader \"{0}\" failed: {1}");
+            writer.Write(types, -7, 1234567890123L, 0.5f, true);
+            writer.Write(text, "Terrain", "ünïcödé");
+            writer.Flush();
+
+            string[] expected =
+            {
+                "-7 1234567890123 0.5 True",
+                "Shader \"Terrain\" failed: ünïcödé",
+            };
+
+            string[] lines = Decode(path);
+
+            bool passed = lines.Length == expected.Length;
+            for (int i = 0; passed && i < lines.Length; i++)
+            {
+                passed &= lines[i].EndsWith(expected[i]);
+            }
+
+            string result = passed ? "passed" : "FAILED";
+            Console.WriteLine($"Decoding check {result}");
+
+            File.Delete(path);
+            return passed;
+        }
+
+        /// <summary>
+        /// Checks that events from threads that finish without flushing are collected by the writer
+        /// once they are older than the flush interval, and by a final flush of all threads.
+        /// </summary>
+        private static bool CheckUnflushedThreads()
+        {
+            const int flushInterval = 50;
+
+            string path = Path.Combine(Path.GetTempPath(), "InsectRTS_BinaryLogThreadCheck.blog");
+            BinaryLogWriter writer = new BinaryLogWriter(new FileInfo(path), flushInterval);
+            LogEvent finished = writer.RegisterTemplate(LogLevel.Info, "Thread {0} finished");
+
+            // the first thread's event should be collected while the writer waits for new events
+            Thread thread = new Thread(() => writer.Write(finished, 0));
+            thread.Start();
+            thread.Join();
+            Thread.Sleep(5 * flushInterval);
+
+            int collected = Decode(path).Length;
+
+            // the second thread's event is still new, so it is only written by the final flush
+            thread = new Thread(() => writer.Write(finished, 1));
+            thread.Start();
+            thread.Join();
+            writer.FlushAll();
+
+            int flushed = Decode(path).Length;
+
+            bool passed = collected == 1 && flushed == 2;
+            string result = passed ? "passed" : "FAILED";
+            Console.WriteLine($"Unflushed thread check {result}");
+
+            File.Delete(path);
+            return passed;
+        }
+
+        /// <summary>
+        /// Decodes a binary log into lines of text.
+        /// </summary>
+        private static string[] Decode(string path)
+        {
+            using (FileStream input = new FileStream(path, FileMode.Open, FileAccess.Read, FileShare.ReadWrite | FileShare.Delete))
+            using (StringWriter output = new StringWriter())
+            {
+                BinaryLogReader.Decode(input, output, false);
+                return output.ToString().Split(new[] { Environment.NewLine }, StringSplitOptions.RemoveEmptyEntries);
+            }
+        }
+    }
+}
@@ -0,0 +1,234 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using Engine;
+using Engine.Entities;
+using Engine.Jobs;
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// Measures iterating entities with a position and velocity integrate system, compares it to plain
+    /// arrays, and checks that structural changes keep entities and their components intact.
+    /// </summary>
+    internal static class EntityBenchmark
+    {
+        private const int ENTITY_COUNT = 100000;
+        private const int COMMAND_COUNT = 1000;
+        private const float DELTA_TIME = 1f / 60f;
+        private const ulong SEED = 12345;
+
+        private struct Position
+        {
+            public Vector3 value;
+        }
+
+        private struct Velocity
+        {
+            public Vector3 value;
+        }
+
+        private struct Health
+        {
+            public int value;
+        }
+
+        /// <summary>
+        /// Runs the benchmarks and the correctness checks.
+        /// </summary>
+        /// <returns>True if the correctness checks passed.</returns>
+        public static bool Run()
+        {
+            Console.WriteLine("Entities:");
+
+            World world = new World();
+            RandomGenerator random = new RandomGenerator(SEED);
+
+            Vector3[] positions = new Vector3[ENTITY_COUNT];
+            Vector3[] velocities = new Vector3[ENTITY_COUNT];
+            Entity[] entities = new Entity[ENTITY_COUNT];
+
+            for (int i = 0; i < ENTITY_COUNT; i++)
+            {
+                positions[i] = new Vector3(random.GetRange(-500f, 500f), 0f, random.GetRange(-500f, 500f));
+                velocities[i] = new Vector3(random.GetRange(-1f, 1f), 0f, random.GetRange(-1f, 1f));
+
+                entities[i] = world.CreateEntity(new Position { value = positions[i] }, new Velocity { value = velocities[i] });
+            }
+
+            EntityQuery query = world.CreateQuery<Position, Velocity>();
+
+            Benchmark.Run("Integrate 100k plain arrays", () =>
+            {
+                for (int i = 0; i < ENTITY_COUNT; i++)
+                {
+                    positions[i] += velocities[i] * DELTA_TIME;
+                }
+            }, 1000);
+
+            Benchmark.Run("Integrate 100k ForEach", () => query.ForEach((ref Position p, ref Velocity v) =>
+            {
+                p.value += v.value * DELTA_TIME;
+            }), 1000);
+
+            // cache the delegate, as converting the method group allocates each time
+            ChunkAction integrate = Integrate;
+
+            Benchmark.Run("Integrate 100k ForEachChunk", () => query.ForEachChunk(integrate), 1000);
+
+            using (JobScheduler scheduler = new JobScheduler(Math.Max(Environment.ProcessorCount - 1, 1)))
+            {
+                Benchmark.Run(
+                    "Integrate 100k ScheduleParallel",
+                    () => query.ScheduleParallel(scheduler, integrate).Complete(),
+                    1000
+                );
+            }
+
+            Benchmark.Run("Create and destroy entity", () => world.DestroyEntity(world.CreateEntity(new Position(), new Velocity())), 1000000);
+
+            // once the buffer has grown to fit the commands, recording and playback should not allocate
+            EntityCommandBuffer commands = new EntityCommandBuffer();
+            Benchmark.Run($"Record and play back {COMMAND_COUNT} commands", () =>
+            {
+                for (int i = 0; i < COMMAND_COUNT; i++)
+                {
+                    commands.SetComponent(entities[i], new Velocity { value = velocities[i] });
+                }
+                commands.Playback(world);
+            }, 10000);
+
+            bool passed = CheckStructuralChanges();
+            Console.WriteLine();
+            return passed;
+        }
+
+        private static void Integrate(Chunk chunk)
+        {
+            Position[] positions = chunk.GetComponents<Position>();
+            Velocity[] velocities = chunk.GetComponents<Velocity>();
+            int count = chunk.Count;
+
+            for (int i = 0; i < count; i++)
+            {
+                positions[i].value += velocities[i].value * DELTA_TIME;
+            }
+        }
+
+        /// <summary>
+        /// Adds, removes and destroys entities and components directly and through a command buffer,
+        /// checking that every remaining entity keeps its own component values.
+        /// </summary>
+        private static bool CheckStructuralChanges()
+        {
+            const int COUNT = 10000;
+
+            World world = new World();
+            Entity[] entities = new Entity[COUNT];
+
+            for (int i = 0; i < COUNT; i++)
+            {
+                entities[i] = world.CreateEntity(new Position { value = new Vector3(i, 0f, 0f) }, new Velocity());
+            }
+
+            // give every third entity health, and destroy every fifth using a command buffer from a query
+            EntityCommandBuffer commands = new EntityCommandBuffer();
+            for (int i = 0; i < COUNT; i += 3)
+            {
+                world.AddComponent(entities[i], new Health { value = i });
+            }
+
+            world.CreateQuery<Position>().ForEachChunk(chunk =>
+            {
+                Entity[] chunkEntities = chunk.GetEntities();
+                Position[] chunkPositions = chunk.GetComponents<Position>();
+
+                for (int i = 0; i < chunk.Count; i++)
+                {
+                    if ((int)chunkPositions[i].value.x % 5 == 0)
+                    {
+                        commands.DestroyEntity(chunkEntities[i]);
+                    }
+                }
+            });
+            commands.Playback(world);
+
+            // removing a component moves the entity back to the first archetype
+            for (int i = 0; i < COUNT; i += 6)
+            {
+                if (world.Exists(entities[i]))
+                {
+                    world.RemoveComponent<Health>(entities[i]);
+                }
+            }
+
+            bool passed = world.EntityCount == COUNT - (COUNT / 5);
+
+            for (int i = 0; i < COUNT; i++)
+            {
+                bool shouldExist = i % 5 != 0;
+                if (world.Exists(entities[i]) != shouldExist)
+                {
+                    passed = false;
+                    continue;
+                }
+                if (!shouldExist)
+                {
+                    continue;
+                }
+
+                passed &= world.GetComponent<Position>(entities[i]).value.x == i;
+
+                bool shouldHaveHealth = i % 3 == 0 && i % 6 != 0;
+                passed &= world.HasComponent<Health>(entities[i]) == shouldHaveHealth;
+                if (shouldHaveHealth)
+                {
+                    passed &= world.GetComponent<Health>(entities[i]).value == i;
+                }
+            }
+
+            // a destroyed entity's index is reused with a new generation
+            Entity created = world.CreateEntity();
+            passed &= !world.Exists(entities[0]) && created != entities[0];
+
+            passed &= world.CreateQuery<Position, Health>().CalculateEntityCount() == CountExpectedHealth(COUNT);
+
+            // entities created by a command buffer can be changed by later commands in the same buffer
+            EntityCommandBuffer deferred = new EntityCommandBuffer();
+            Entity placeholder = deferred.CreateEntity(new Position { value = new Vector3(-1f, 0f, 0f) });
+            deferred.AddComponent(placeholder, new Health { value = -1 });
+            deferred.SetComponent(placeholder, new Position { value = new Vector3(-2f, 0f, 0f) });
+            deferred.DestroyEntity(deferred.CreateEntity(new Health()));
+            deferred.Playback(world);
+
+            int matches = 0;
+            world.CreateQuery<Position, Health>().ForEach((ref Position position, ref Health health) =>
+            {
+                if (health.value == -1 && position.value.x == -2f)
+                {
+                    matches++;
+                }
+            });
+            passed &= matches == 1 && !world.Exists(placeholder);
+            passed &= world.CreateQuery<Health>().CalculateEntityCount() == CountExpectedHealth(COUNT) + 1;
+
+            Console.WriteLine($"Entity structural change check {(passed ? "passed" : "FAILED")}");
+            return passed;
+        }
+
+        private static int CountExpectedHealth(int count)
+        {
+            int expected = 0;
+            for (int i = 0; i < count; i++)
+            {
+                if (i % 5 != 0 && i % 3 == 0 && i % 6 != 0)
+                {
+                    expected++;
+                }
+            }
+            return expected;
+        }
+    }
+}
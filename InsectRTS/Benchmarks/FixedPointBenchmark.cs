@@ -0,0 +1,214 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Threading;
+using Engine;
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// Compares fixed-point and float performance on a simple steering simulation, and checks that the
+    /// fixed-point simulation gives identical results on every thread.
+    /// </summary>
+    internal static class FixedPointBenchmark
+    {
+        private const int UNIT_COUNT = 4096;
+        private const int STEPS = 100;
+        private const ulong SEED = 12345;
+
+        /// <summary>
+        /// Runs the benchmarks and the determinism check.
+        /// </summary>
+        /// <returns>True if the determinism check passed.</returns>
+        public static bool Run()
+        {
+            Console.WriteLine("Fixed point:");
+
+            FixedSimulation fixedSim = new FixedSimulation(SEED);
+            FloatSimulation floatSim = new FloatSimulation(SEED);
+
+            Benchmark.Run("Float steering step", floatSim.Step, 200);
+            Benchmark.Run("Fixed steering step", fixedSim.Step, 200);
+
+            Fixed a = Fixed.FromRaw(123456);
+            Fixed b = Fixed.FromRaw(654321);
+            float fa = (float)a;
+            float fb = (float)b;
+            Fixed fixedResult = Fixed.Zero;
+            float floatResult = 0f;
+
+            Benchmark.Run("Mathf.Sin", () => floatResult += Mathf.Sin(fa), 10000000);
+            Benchmark.Run("FixedMath.Sin", () => fixedResult += FixedMath.Sin(a), 10000000);
+            Benchmark.Run("Mathf.Atan2", () => floatResult += Mathf.Atan2(fa, fb), 10000000);
+            Benchmark.Run("FixedMath.Atan2", () => fixedResult += FixedMath.Atan2(a, b), 10000000);
+            Benchmark.Run("Mathf.Sqrt", () => floatResult += Mathf.Sqrt(fb), 10000000);
+            Benchmark.Run("FixedMath.Sqrt", () => fixedResult += FixedMath.Sqrt(b), 10000000);
+
+            bool passed = CheckDeterminism();
+            Console.WriteLine();
+            return passed;
+        }
+
+        /// <summary>
+        /// Runs the same fixed-point simulation on several threads at once and compares the final state.
+        /// </summary>
+        private static bool CheckDeterminism()
+        {
+            ulong expected = RunFixedSimulation();
+
+            int threadCount = Math.Max(Environment.ProcessorCount, 2);
+            ulong[] hashes = new ulong[threadCount];
+            Thread[] threads = new Thread[threadCount];
+
+            for (int i = 0; i < threadCount; i++)
+            {
+                int index = i;
+                threads[i] = new Thread(() => hashes[index] = RunFixedSimulation());
+                threads[i].Start();
+            }
+
+            bool passed = true;
+            for (int i = 0; i < threadCount; i++)
+            {
+                threads[i].Join();
+                passed &= hashes[i] == expected;
+            }
+
+            // the hash is printed so it can also be compared between machines
+            string result = passed ? "passed" : "FAILED";
+            Console.WriteLine($"Determinism check on {threadCount} threads {result}, state hash {expected:X16}");
+            return passed;
+        }
+
+        private static ulong RunFixedSimulation()
+        {
+            FixedSimulation sim = new FixedSimulation(SEED);
+            for (int i = 0; i < STEPS; i++)
+            {
+                sim.Step();
+            }
+            return sim.GetHash();
+        }
+
+        /// <summary>
+        /// Units that wander around, turning a little each step and bouncing off the edge of the world.
+        /// </summary>
+        private class FixedSimulation
+        {
+            private static readonly Fixed DELTA_TIME = Fixed.One / 60;
+            private static readonly Fixed TURN_RATE = (Fixed)0.05f;
+            private static readonly Fixed SPEED = 5;
+            private static readonly Fixed WORLD_RADIUS = 500;
+
+            private readonly FixedVector3[] m_positions = new FixedVector3[UNIT_COUNT];
+            private readonly FixedVector3[] m_velocities = new FixedVector3[UNIT_COUNT];
+
+            public FixedSimulation(ulong seed)
+            {
+                RandomGenerator random = new RandomGenerator(seed);
+
+                for (int i = 0; i < UNIT_COUNT; i++)
+                {
+                    m_positions[i] = new FixedVector3(
+                        Fixed.FromRaw(random.Next(-WORLD_RADIUS.raw, WORLD_RADIUS.raw)),
+                        Fixed.Zero,
+                        Fixed.FromRaw(random.Next(-WORLD_RADIUS.raw, WORLD_RADIUS.raw))
+                    );
+                    m_velocities[i] = new FixedVector3(
+                        Fixed.FromRaw(random.Next(-Fixed.One.raw, Fixed.One.raw)),
+                        Fixed.Zero,
+                        Fixed.FromRaw(random.Next(-Fixed.One.raw, Fixed.One.raw))
+                    );
+                }
+            }
+
+            public void Step()
+            {
+                for (int i = 0; i < UNIT_COUNT; i++)
+                {
+                    FixedVector3 position = m_positions[i];
+                    FixedVector3 velocity = m_velocities[i];
+
+                    Fixed heading = FixedMath.Atan2(velocity.z, velocity.x) + TURN_RATE;
+                    FixedMath.SinCos(heading, out Fixed sin, out Fixed cos);
+                    velocity = new FixedVector3(cos, Fixed.Zero, sin) * SPEED;
+
+                    position += velocity * DELTA_TIME;
+
+                    if (position.Length > WORLD_RADIUS)
+                    {
+                        velocity = -velocity;
+                        position = position.Normalized * WORLD_RADIUS;
+                    }
+
+                    m_positions[i] = position;
+                    m_velocities[i] = velocity;
+                }
+            }
+
+            public ulong GetHash()
+            {
+                // FNV-1a over the raw values
+                ulong hash = 14695981039346656037UL;
+                for (int i = 0; i < UNIT_COUNT; i++)
+                {
+                    hash = (hash ^ (uint)m_positions[i].x.raw) * 1099511628211UL;
+                    hash = (hash ^ (uint)m_positions[i].z.raw) * 1099511628211UL;
+                    hash = (hash ^ (uint)m_velocities[i].x.raw) * 1099511628211UL;
+                    hash = (hash ^ (uint)m_velocities[i].z.raw) * 1099511628211UL;
+                }
+                return hash;
+            }
+        }
+
+        /// <summary>
+        /// The same simulation as <see cref="FixedSimulation"/> using floats.
+        /// </summary>
+        private class FloatSimulation
+        {
+            private const float DELTA_TIME = 1f / 60f;
+            private const float TURN_RATE = 0.05f;
+            private const float SPEED = 5f;
+            private const float WORLD_RADIUS = 500f;
+
+            private readonly Vector3[] m_positions = new Vector3[UNIT_COUNT];
+            private readonly Vector3[] m_velocities = new Vector3[UNIT_COUNT];
+
+            public FloatSimulation(ulong seed)
+            {
+                RandomGenerator random = new RandomGenerator(seed);
+
+                for (int i = 0; i < UNIT_COUNT; i++)
+                {
+                    m_positions[i] = new Vector3(random.GetRange(-WORLD_RADIUS, WORLD_RADIUS), 0f, random.GetRange(-WORLD_RADIUS, WORLD_RADIUS));
+                    m_velocities[i] = new Vector3(random.GetRange(-1f, 1f), 0f, random.GetRange(-1f, 1f));
+                }
+            }
+
+            public void Step()
+            {
+                for (int i = 0; i < UNIT_COUNT; i++)
+                {
+                    Vector3 position = m_positions[i];
+                    Vector3 velocity = m_velocities[i];
+
+                    float heading = Mathf.Atan2(velocity.z, velocity.x) + TURN_RATE;
+                    velocity = new Vector3(Mathf.Cos(heading), 0f, Mathf.Sin(heading)) * SPEED;
+
+                    position += velocity * DELTA_TIME;
+
+                    if (position.Length > WORLD_RADIUS)
+                    {
+                        velocity = -velocity;
+                        position = position.Normalized * WORLD_RADIUS;
+                    }
+
+                    m_positions[i] = position;
+                    m_velocities[i] = velocity;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,96 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using Engine;
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// Times the fixed timestep, and checks that the rendered simulation time moves forward steadily
+    /// whether the steps run on the main thread or on a worker thread.
+    /// </summary>
+    internal static class FixedTimestepBenchmark
+    {
+        private const double SIMULATION_RATE = 20.0;
+        private const int MAX_STEPS_PER_FRAME = 5;
+        private const int FRAME_COUNT = 100000;
+        private const ulong SEED = 12345;
+
+        /// <summary>
+        /// Runs the benchmarks and the interpolation checks.
+        /// </summary>
+        /// <returns>True if the interpolation checks passed.</returns>
+        public static bool Run()
+        {
+            Console.WriteLine("Fixed timestep:");
+
+            FixedTimestep timestep = new FixedTimestep(SIMULATION_RATE, MAX_STEPS_PER_FRAME);
+            int steps = 0;
+            float alpha = 0f;
+
+            Benchmark.Run("FixedTimestep.Advance", () => steps += timestep.Advance(1.0 / 144.0), 10000000);
+            Benchmark.Run("FixedTimestep.GetAlpha", () => alpha += timestep.GetAlpha(1), 10000000);
+
+            bool passed = CheckInterpolation(false);
+            passed &= CheckInterpolation(true);
+
+            Console.WriteLine();
+            return passed;
+        }
+
+        /// <summary>
+        /// Runs frames of random lengths, as the main loop does, and checks that the time of the rendered
+        /// state never goes backwards and trails the time of the synchronous simulation by less than a frame.
+        /// </summary>
+        /// <param name="onWorkerThread">If true the steps of each frame are treated as completing during the
+        /// next frame.</param>
+        private static bool CheckInterpolation(bool onWorkerThread)
+        {
+            RandomGenerator random = new RandomGenerator(SEED);
+            FixedTimestep timestep = new FixedTimestep(SIMULATION_RATE, MAX_STEPS_PER_FRAME);
+            double stepDuration = timestep.StepDuration;
+
+            long completedSteps = 0;
+            double lastRendered = double.NegativeInfinity;
+            double largestLag = 0.0;
+            int backwardsCount = 0;
+
+            for (int i = 0; i < FRAME_COUNT; i++)
+            {
+                // frame times from well above to a little below the simulation rate
+                double elapsed = random.GetRange(1f / 240f, 1.5f / (float)SIMULATION_RATE);
+
+                int pendingSteps = timestep.Advance(elapsed);
+                if (!onWorkerThread)
+                {
+                    completedSteps += pendingSteps;
+                    pendingSteps = 0;
+                }
+
+                // interpolating from the state before the last completed step, in steps
+                float alpha = onWorkerThread ? timestep.GetAlpha(pendingSteps) : timestep.Alpha;
+                double rendered = completedSteps - 1 + (double)alpha;
+                double synchronous = timestep.StepCount - 1 + (double)timestep.Alpha;
+
+                if (rendered < lastRendered - 1e-5)
+                {
+                    backwardsCount++;
+                }
+                lastRendered = rendered;
+
+                // the lag is relative to the frame it happened in
+                largestLag = Math.Max(largestLag, (synchronous - rendered) * stepDuration / elapsed);
+
+                // the steps started this frame complete before the next one
+                completedSteps += pendingSteps;
+            }
+
+            bool passed = backwardsCount == 0 && largestLag < 1.0;
+            string name = onWorkerThread ? "Worker thread" : "Main thread";
+            Console.WriteLine($"{name} interpolation check: {backwardsCount} steps back, largest lag {largestLag:F3} frames {(passed ? "passed" : "FAILED")}");
+            return passed;
+        }
+    }
+}
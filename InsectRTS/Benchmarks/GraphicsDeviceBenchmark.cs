@@ -0,0 +1,182 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using Engine;
+using Engine.Rendering;
+using OpenTK.Graphics.OpenGL4;
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// Draws a scene through the recording graphics device, comparing binding every object's state with
+    /// sorting by material and skipping bindings that are already set. Checks that the device records
+    /// the expected calls, uploads and state changes.
+    /// </summary>
+    internal static class GraphicsDeviceBenchmark
+    {
+        private const int OBJECT_COUNT = 10000;
+        private const int MATERIAL_COUNT = 8;
+        private const int INDEX_COUNT = 36;
+        private const int VERTEX_COUNT = 24;
+        private const int TEXTURE_SIZE = 16;
+        private const ulong SEED = 12345;
+
+        private struct DrawItem
+        {
+            public int program;
+            public int texture;
+            public int vertexArray;
+        }
+
+        /// <summary>
+        /// Runs the benchmarks and the correctness checks.
+        /// </summary>
+        /// <returns>True if the correctness checks passed.</returns>
+        public static bool Run()
+        {
+            Console.WriteLine("Graphics device:");
+
+            RecordingContext context = new RecordingContext();
+            RecordingDevice device = context.RecordingDevice;
+            RandomGenerator random = new RandomGenerator(SEED);
+
+            context.Initialize();
+            context.Resize(1280, 720);
+
+            // the materials and meshes are shared between many objects
+            int[] programs = new int[MATERIAL_COUNT];
+            int[] textures = new int[MATERIAL_COUNT];
+            int[] vertexArrays = new int[MATERIAL_COUNT];
+            // like a dynamic buffer, the vertex array has spare capacity that is not uploaded
+            Vector3[] vertices = new Vector3[2 * VERTEX_COUNT];
+            byte[] pixels = new byte[TEXTURE_SIZE * TEXTURE_SIZE * 4];
+            int vertexSize = VERTEX_COUNT * Unsafe.SizeOf<Vector3>();
+
+            for (int i = 0; i < MATERIAL_COUNT; i++)
+            {
+                programs[i] = i + 1;
+                textures[i] = device.CreateTexture();
+                device.BindTexture(TextureTarget.Texture2D, textures[i]);
+                device.TexImage2D(TextureTarget.Texture2D, 0, PixelInternalFormat.Rgba, TEXTURE_SIZE, TEXTURE_SIZE, PixelFormat.Bgra, PixelType.UnsignedByte, pixels.Length, pixels);
+                device.BindTexture(TextureTarget.Texture2D, 0);
+
+                vertexArrays[i] = device.CreateVertexArray();
+
+                int vertexBuffer = device.CreateBuffer();
+                device.BindVertexArray(vertexArrays[i]);
+                device.BindBuffer(BufferTarget.ArrayBuffer, vertexBuffer);
+                device.BufferData(BufferTarget.ArrayBuffer, vertexSize, vertices, BufferUsageHint.StaticDraw);
+                device.BindBuffer(BufferTarget.ArrayBuffer, 0);
+            }
+            device.BindVertexArray(0);
+
+            DrawItem[] items = new DrawItem[OBJECT_COUNT];
+            for (int i = 0; i < OBJECT_COUNT; i++)
+            {
+                int material = random.Next(0, MATERIAL_COUNT);
+                items[i] = new DrawItem { program = programs[material], texture = textures[material], vertexArray = vertexArrays[material] };
+            }
+
+            DrawItem[] sorted = (DrawItem[])items.Clone();
+            Array.Sort(sorted, (a, b) => a.program.CompareTo(b.program));
+
+            bool passed = true;
+
+            long expectedUpload = MATERIAL_COUNT * (vertexSize + pixels.Length);
+            passed &= Check("Uploaded bytes", device.Stats.bytesUploaded, expectedUpload);
+
+            Benchmark.Run($"Bind every object, {OBJECT_COUNT} draws", () => DrawUnsorted(device, items), 100);
+            Benchmark.Run($"Sorted and cached, {OBJECT_COUNT} draws", () =>
+            {
+                Unbind(device);
+                DrawSorted(device, sorted);
+            }, 100);
+
+            device.ResetStats();
+            DrawUnsorted(device, items);
+            GraphicsDeviceStats unsorted = device.Stats;
+
+            Unbind(device);
+            device.ResetStats();
+            DrawSorted(device, sorted);
+            GraphicsDeviceStats cached = device.Stats;
+
+            Console.WriteLine($"Unsorted: {unsorted}");
+            Console.WriteLine($"Sorted:   {cached}");
+
+            passed &= Check("Unsorted draw calls", unsorted.drawCalls, OBJECT_COUNT);
+            passed &= Check("Sorted draw calls", cached.drawCalls, OBJECT_COUNT);
+            passed &= Check("Vertices drawn", cached.vertices, (long)OBJECT_COUNT * INDEX_COUNT);
+            passed &= Check("Sorted redundant state changes", cached.redundantStateChanges, 0);
+            passed &= Check("Sorted state changes", cached.stateChanges, 3 * MATERIAL_COUNT);
+            passed &= Check("Unsorted calls", unsorted.calls, unsorted.drawCalls + unsorted.stateChanges + unsorted.redundantStateChanges);
+
+            Console.WriteLine();
+            return passed;
+        }
+
+        /// <summary>
+        /// Binds the state of every object before drawing it.
+        /// </summary>
+        private static void DrawUnsorted(IGraphicsDevice device, DrawItem[] items)
+        {
+            foreach (DrawItem item in items)
+            {
+                device.UseProgram(item.program);
+                device.BindTexture(TextureTarget.Texture2D, item.texture);
+                device.BindVertexArray(item.vertexArray);
+                device.DrawElements(PrimitiveType.Triangles, INDEX_COUNT, DrawElementsType.UnsignedShort, 0);
+            }
+        }
+
+        /// <summary>
+        /// Draws objects sorted by material, only binding state that differs from the previous object.
+        /// Expects nothing to be bound beforehand.
+        /// </summary>
+        private static void DrawSorted(IGraphicsDevice device, DrawItem[] items)
+        {
+            int program = 0;
+            int texture = 0;
+            int vertexArray = 0;
+
+            foreach (DrawItem item in items)
+            {
+                if (program != item.program)
+                {
+                    device.UseProgram(item.program);
+                    program = item.program;
+                }
+                if (texture != item.texture)
+                {
+                    device.BindTexture(TextureTarget.Texture2D, item.texture);
+                    texture = item.texture;
+                }
+                if (vertexArray != item.vertexArray)
+                {
+                    device.BindVertexArray(item.vertexArray);
+                    vertexArray = item.vertexArray;
+                }
+                device.DrawElements(PrimitiveType.Triangles, INDEX_COUNT, DrawElementsType.UnsignedShort, 0);
+            }
+        }
+
+        private static void Unbind(IGraphicsDevice device)
+        {
+            device.UseProgram(0);
+            device.BindTexture(TextureTarget.Texture2D, 0);
+            device.BindVertexArray(0);
+        }
+
+        private static bool Check(string name, long value, long expected)
+        {
+            bool passed = value == expected;
+            if (!passed)
+            {
+                Console.WriteLine($"{name} check FAILED, got {value} but expected {expected}");
+            }
+            return passed;
+        }
+    }
+}
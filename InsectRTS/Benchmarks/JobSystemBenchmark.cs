@@ -0,0 +1,253 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Threading;
+using Engine;
+using Engine.Jobs;
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// Measures how a unit update scales with the number of job threads, the overhead of scheduling
+    /// jobs, and checks that jobs give the same results as running the work serially.
+    /// </summary>
+    internal static class JobSystemBenchmark
+    {
+        private const int UNIT_COUNT = 64 * 1024;
+        private const int STEPS = 20;
+        private const ulong SEED = 12345;
+
+        /// <summary>
+        /// Runs the benchmarks and the correctness checks.
+        /// </summary>
+        /// <returns>True if the correctness checks passed.</returns>
+        public static bool Run()
+        {
+            Console.WriteLine("Job system:");
+
+            int maxThreads = Environment.ProcessorCount;
+            UnitSimulation sim = new UnitSimulation(SEED);
+
+            double serial = Benchmark.Run("Unit update serial", () => sim.Update(0, UNIT_COUNT), 100);
+
+            // the thread waiting on the job also runs batches, so use one less worker than threads
+            for (int threads = 1; threads <= maxThreads; threads = NextThreadCount(threads, maxThreads))
+            {
+                using (JobScheduler scheduler = new JobScheduler(threads - 1))
+                {
+                    // the thread count of the last run depends on the machine, so it is named so it can be compared
+                    double time = Benchmark.Run(
+                        threads == maxThreads ? "Unit update on all threads" : $"Unit update on {threads} threads",
+                        () => scheduler.ParallelForBatch(UNIT_COUNT, sim.Update).Complete(),
+                        100
+                    );
+                    Console.WriteLine($"{"",-40} {serial / time,10:F2}x speedup");
+                }
+            }
+
+            bool passed = true;
+
+            using (JobScheduler scheduler = new JobScheduler(maxThreads - 1))
+            {
+                Action empty = () => { };
+                Benchmark.Run("Schedule and complete job", () => scheduler.Schedule(empty).Complete(), 100000);
+                Benchmark.Run("Schedule dependent job", () => scheduler.Schedule(empty, scheduler.Schedule(empty)).Complete(), 100000);
+                Benchmark.Run("Empty parallel for of 1024", () => scheduler.ParallelForBatch(1024, (start, end) => { }).Complete(), 100000);
+
+                passed &= CheckResults(scheduler);
+                passed &= CheckDependencies(scheduler);
+                passed &= CheckExceptions(scheduler);
+            }
+
+            Console.WriteLine();
+            return passed;
+        }
+
+        /// <summary>
+        /// Doubles the thread count, making sure the maximum is also tested.
+        /// </summary>
+        private static int NextThreadCount(int threads, int maxThreads)
+        {
+            if (threads < maxThreads && threads * 2 > maxThreads)
+            {
+                return maxThreads;
+            }
+            return threads * 2;
+        }
+
+        /// <summary>
+        /// Checks that a simulation updated by parallel jobs ends up in the same state as one updated serially.
+        /// </summary>
+        private static bool CheckResults(JobScheduler scheduler)
+        {
+            UnitSimulation serialSim = new UnitSimulation(SEED);
+            UnitSimulation parallelSim = new UnitSimulation(SEED);
+
+            JobHandle handle = default(JobHandle);
+            for (int i = 0; i < STEPS; i++)
+            {
+                serialSim.Update(0, UNIT_COUNT);
+
+                // chain the steps so each starts after the last without waiting in between
+                handle = scheduler.ParallelForBatch(UNIT_COUNT, parallelSim.Update, handle);
+            }
+            handle.Complete();
+
+            bool passed = serialSim.Matches(parallelSim);
+            Console.WriteLine($"Parallel unit update check {(passed ? "passed" : "FAILED")}");
+            return passed;
+        }
+
+        /// <summary>
+        /// Checks that dependent jobs run in order, and that combined handles wait for every job.
+        /// </summary>
+        private static bool CheckDependencies(JobScheduler scheduler)
+        {
+            const int CHAIN_LENGTH = 1000;
+
+            int[] order = new int[CHAIN_LENGTH];
+            int next = 0;
+            JobHandle handle = default(JobHandle);
+
+            for (int i = 0; i < CHAIN_LENGTH; i++)
+            {
+                int index = i;
+                handle = scheduler.Schedule(() => order[next++] = index, handle);
+            }
+            handle.Complete();
+
+            bool passed = next == CHAIN_LENGTH;
+            for (int i = 0; i < CHAIN_LENGTH; i++)
+            {
+                passed &= order[i] == i;
+            }
+
+            int[] counts = new int[CHAIN_LENGTH];
+            JobHandle[] handles = new JobHandle[CHAIN_LENGTH];
+            for (int i = 0; i < CHAIN_LENGTH; i++)
+            {
+                int index = i;
+                handles[i] = scheduler.ParallelFor(16, j => Interlocked.Increment(ref counts[index]), default(JobHandle), 1);
+            }
+            JobHandle.CombineDependencies(handles).Complete();
+
+            foreach (int count in counts)
+            {
+                passed &= count == 16;
+            }
+
+            Console.WriteLine($"Job dependency check {(passed ? "passed" : "FAILED")}");
+            return passed;
+        }
+
+        /// <summary>
+        /// Checks that exceptions thrown by jobs and their batches are rethrown by Complete, and that jobs
+        /// depending on a failed job still run but fail as well.
+        /// </summary>
+        private static bool CheckExceptions(JobScheduler scheduler)
+        {
+            bool dependentRan = false;
+            JobHandle failed = scheduler.Schedule(() => { throw new InvalidOperationException("Job"); });
+            JobHandle dependent = scheduler.Schedule(() => dependentRan = true, failed);
+            JobHandle batches = scheduler.ParallelFor(64, i =>
+            {
+                if (i % 16 == 3)
+                {
+                    throw new InvalidOperationException("Batch");
+                }
+            }, default(JobHandle), 4);
+            JobHandle succeeded = scheduler.Schedule(() => { });
+
+            bool passed = GetExceptionCount(dependent) == 1 && dependentRan;
+            passed &= GetExceptionCount(failed) == 1;
+            passed &= GetExceptionCount(batches) == 4;
+            passed &= GetExceptionCount(succeeded) == 0;
+
+            // a completed job that failed must not be dropped when combined
+            passed &= GetExceptionCount(JobHandle.CombineDependencies(failed, succeeded)) == 1;
+            passed &= GetExceptionCount(JobHandle.CombineDependencies(failed, batches, succeeded)) == 5;
+
+            Console.WriteLine($"Job exception check {(passed ? "passed" : "FAILED")}");
+            return passed;
+        }
+
+        /// <summary>
+        /// Completes a job and gets the number of exceptions it rethrew.
+        /// </summary>
+        private static int GetExceptionCount(JobHandle handle)
+        {
+            try
+            {
+                handle.Complete();
+                return 0;
+            }
+            catch (AggregateException e)
+            {
+                return e.InnerExceptions.Count;
+            }
+        }
+
+        /// <summary>
+        /// Units that wander around, turning a little each step and bouncing off the edge of the world.
+        /// Each unit only reads and writes its own state, so any range of units can be updated in parallel.
+        /// </summary>
+        private class UnitSimulation
+        {
+            private const float DELTA_TIME = 1f / 60f;
+            private const float TURN_RATE = 0.05f;
+            private const float SPEED = 5f;
+            private const float WORLD_RADIUS = 500f;
+
+            private readonly Vector3[] m_positions = new Vector3[UNIT_COUNT];
+            private readonly Vector3[] m_velocities = new Vector3[UNIT_COUNT];
+
+            public UnitSimulation(ulong seed)
+            {
+                RandomGenerator random = new RandomGenerator(seed);
+
+                for (int i = 0; i < UNIT_COUNT; i++)
+                {
+                    m_positions[i] = new Vector3(random.GetRange(-WORLD_RADIUS, WORLD_RADIUS), 0f, random.GetRange(-WORLD_RADIUS, WORLD_RADIUS));
+                    m_velocities[i] = new Vector3(random.GetRange(-1f, 1f), 0f, random.GetRange(-1f, 1f));
+                }
+            }
+
+            public void Update(int start, int end)
+            {
+                for (int i = start; i < end; i++)
+                {
+                    Vector3 position = m_positions[i];
+                    Vector3 velocity = m_velocities[i];
+
+                    float heading = Mathf.Atan2(velocity.z, velocity.x) + TURN_RATE;
+                    velocity = new Vector3(Mathf.Cos(heading), 0f, Mathf.Sin(heading)) * SPEED;
+
+                    position += velocity * DELTA_TIME;
+
+                    if (position.Length > WORLD_RADIUS)
+                    {
+                        velocity = -velocity;
+                        position = position.Normalized * WORLD_RADIUS;
+                    }
+
+                    m_positions[i] = position;
+                    m_velocities[i] = velocity;
+                }
+            }
+
+            public bool Matches(UnitSimulation other)
+            {
+                for (int i = 0; i < UNIT_COUNT; i++)
+                {
+                    if (m_positions[i] != other.m_positions[i] || m_velocities[i] != other.m_velocities[i])
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+        }
+    }
+}
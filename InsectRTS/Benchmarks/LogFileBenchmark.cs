@@ -0,0 +1,93 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.IO;
+using System.Text;
+using Engine.Logging;
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// Compares the log file throughput of reopening the file for every batch of messages with
+    /// keeping one buffered stream open for the session.
+    /// </summary>
+    internal static class LogFileBenchmark
+    {
+        private const string LINE = "2019/01/01 12:00:00 [Info]      A typical log message of moderate length";
+        private const int LINE_COUNT = 20000;
+        private static readonly int[] BATCH_SIZES = { 1, 16, 256 };
+
+        /// <summary>
+        /// Runs the benchmarks.
+        /// </summary>
+        public static void Run()
+        {
+            Console.WriteLine("Log file:");
+
+            string path = Path.Combine(Path.GetTempPath(), "InsectRTS_LogFileBenchmark.log");
+
+            foreach (int batchSize in BATCH_SIZES)
+            {
+                string batch = CreateBatch(batchSize);
+                int batchCount = LINE_COUNT / batchSize;
+
+                Benchmark.Run($"Reopen file, {batchSize} lines per write", () =>
+                {
+                    File.Delete(path);
+                    for (int i = 0; i < batchCount; i++)
+                    {
+                        using (StreamWriter stream = File.AppendText(path))
+                        {
+                            stream.Write(batch);
+                        }
+                    }
+                }, 5);
+
+                Benchmark.Run($"Persistent stream, {batchSize} lines per write", () =>
+                {
+                    File.Delete(path);
+                    using (FileStream file = new FileStream(path, FileMode.Append, FileAccess.Write, FileShare.Read, 64 * 1024))
+                    using (StreamWriter stream = new StreamWriter(file, new UTF8Encoding(false), 64 * 1024))
+                    {
+                        for (int i = 0; i < batchCount; i++)
+                        {
+                            stream.Write(batch);
+                        }
+                    }
+                }, 5);
+            }
+
+            File.Delete(path);
+
+            // measure the log writer itself, ending with an error to force everything to disk
+            string writerPath = Path.Combine(Path.GetTempPath(), "InsectRTS_LogWriterBenchmark.log");
+            LogWriter writer = new LogWriter(new FileInfo(writerPath), 8192, LogOverflowPolicy.Block, new LogFlushPolicy(1000, 32 * 1024, true), LogRotationPolicy.None);
+            LogMessage message = new LogMessage(LogLevel.Info, "A typical log message of moderate length");
+
+            Benchmark.Run($"LogWriter, {LINE_COUNT} messages", () =>
+            {
+                for (int i = 0; i < LINE_COUNT; i++)
+                {
+                    writer.BufferMessage(message);
+                }
+                writer.WriteSynchronous(new LogMessage(LogLevel.Error, "Done"));
+            }, 5);
+
+            // the writer keeps the file open, but allows it to be deleted
+            File.Delete(writerPath);
+            Console.WriteLine();
+        }
+
+        private static string CreateBatch(int lineCount)
+        {
+            StringBuilder sb = new StringBuilder();
+            for (int i = 0; i < lineCount; i++)
+            {
+                sb.AppendLine(LINE);
+            }
+            return sb.ToString();
+        }
+    }
+}
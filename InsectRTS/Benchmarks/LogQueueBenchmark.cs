@@ -0,0 +1,209 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Threading;
+using Engine.Logging;
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// Measures the time logging threads spend handing messages to the log writer thread, comparing
+    /// the lock-free log queue with a locked list that pulses the writer for every message.
+    /// </summary>
+    internal static class LogQueueBenchmark
+    {
+        private const int MESSAGES_PER_THREAD = 200000;
+        private const int QUEUE_CAPACITY = 8192;
+        private static readonly int[] THREAD_COUNTS = { 1, 4, 16 };
+
+        /// <summary>
+        /// Runs the benchmarks.
+        /// </summary>
+        /// <returns>True if every message was received.</returns>
+        public static bool Run()
+        {
+            Console.WriteLine("Log queue:");
+
+            bool passed = true;
+            foreach (int threadCount in THREAD_COUNTS)
+            {
+                passed &= Measure($"Locked list, {threadCount} producers", threadCount, new LockedQueue());
+                passed &= Measure($"Lock-free queue, {threadCount} producers", threadCount, new LockFreeQueue());
+            }
+
+            Console.WriteLine();
+            return passed;
+        }
+
+        /// <summary>
+        /// Times producer threads logging messages while a consumer thread drains the queue.
+        /// </summary>
+        private static bool Measure(string name, int threadCount, IQueue queue)
+        {
+            LogMessage message = new LogMessage(LogLevel.Info, "Benchmark message");
+
+            Thread consumer = new Thread(queue.Consume);
+            consumer.Start();
+
+            ManualResetEvent start = new ManualResetEvent(false);
+            double[] nanoseconds = new double[threadCount];
+            Thread[] producers = new Thread[threadCount];
+
+            for (int i = 0; i < threadCount; i++)
+            {
+                int index = i;
+                producers[i] = new Thread(() =>
+                {
+                    start.WaitOne();
+
+                    Stopwatch sw = Stopwatch.StartNew();
+                    for (int j = 0; j < MESSAGES_PER_THREAD; j++)
+                    {
+                        queue.Produce(message);
+                    }
+                    sw.Stop();
+
+                    nanoseconds[index] = (1000000000.0 * sw.ElapsedTicks / Stopwatch.Frequency) / MESSAGES_PER_THREAD;
+                });
+                producers[i].Start();
+            }
+
+            GC.Collect();
+            start.Set();
+
+            double total = 0;
+            double worst = 0;
+            for (int i = 0; i < threadCount; i++)
+            {
+                producers[i].Join();
+                total += nanoseconds[i];
+                worst = Math.Max(worst, nanoseconds[i]);
+            }
+
+            queue.Stop();
+            consumer.Join();
+
+            long expected = (long)threadCount * MESSAGES_PER_THREAD;
+            bool passed = queue.Consumed == expected;
+
+            string result = passed ? string.Empty : $" FAILED, received {queue.Consumed} of {expected}";
+            Console.WriteLine($"{name,-40} {total / threadCount,10:F1}ns/msg {worst,10:F1}ns/msg worst thread{result}");
+            return passed;
+        }
+
+        private interface IQueue
+        {
+            long Consumed { get; }
+            void Produce(LogMessage message);
+            void Consume();
+            void Stop();
+        }
+
+        /// <summary>
+        /// The approach the log writer used before the lock-free queue.
+        /// </summary>
+        private class LockedQueue : IQueue
+        {
+            private readonly List<LogMessage> m_buffer = new List<LogMessage>();
+            private readonly object m_bufferLock = new object();
+            private bool m_stop;
+
+            public long Consumed { get; private set; }
+
+            public void Produce(LogMessage message)
+            {
+                lock (m_bufferLock)
+                {
+                    m_buffer.Add(message);
+                    Monitor.Pulse(m_bufferLock);
+                }
+            }
+
+            public void Consume()
+            {
+                List<LogMessage> toWrite = new List<LogMessage>();
+
+                while (true)
+                {
+                    lock (m_bufferLock)
+                    {
+                        while (m_buffer.Count == 0 && !m_stop)
+                        {
+                            Monitor.Wait(m_bufferLock);
+                        }
+                        if (m_buffer.Count == 0)
+                        {
+                            return;
+                        }
+
+                        toWrite.AddRange(m_buffer);
+                        m_buffer.Clear();
+                    }
+
+                    Consumed += toWrite.Count;
+                    toWrite.Clear();
+                }
+            }
+
+            public void Stop()
+            {
+                lock (m_bufferLock)
+                {
+                    m_stop = true;
+                    Monitor.Pulse(m_bufferLock);
+                }
+            }
+        }
+
+        /// <summary>
+        /// The queue used by the log writer, with blocking when full.
+        /// </summary>
+        private class LockFreeQueue : IQueue
+        {
+            private readonly LogQueue<LogMessage> m_queue = new LogQueue<LogMessage>(QUEUE_CAPACITY);
+            private volatile bool m_stop;
+
+            public long Consumed { get; private set; }
+
+            public void Produce(LogMessage message)
+            {
+                if (!m_queue.TryEnqueue(message))
+                {
+                    SpinWait spin = new SpinWait();
+                    while (!m_queue.TryEnqueue(message))
+                    {
+                        spin.SpinOnce();
+                    }
+                }
+            }
+
+            public void Consume()
+            {
+                while (true)
+                {
+                    bool stopping = m_stop;
+
+                    while (m_queue.TryDequeue(out LogMessage message))
+                    {
+                        Consumed++;
+                    }
+
+                    if (stopping)
+                    {
+                        return;
+                    }
+                    Thread.Yield();
+                }
+            }
+
+            public void Stop()
+            {
+                m_stop = true;
+            }
+        }
+    }
+}
@@ -0,0 +1,43 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using Engine;
+using Engine.Logging;
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// Times logging through the <see cref="Logger"/> API, which writes to the session's log files.
+    /// </summary>
+    internal static class LoggerBenchmark
+    {
+        private const int ITERATIONS = 200000;
+
+        /// <summary>
+        /// Runs the benchmarks.
+        /// </summary>
+        public static void Run()
+        {
+            Console.WriteLine("Logger:");
+
+            Vector3 position = new Vector3(1.5f, -2.25f, 3f);
+            LogEvent unitMoved = Logger.RegisterEvent(LogLevel.Info, "Unit {0} moved to tile {1}");
+
+            Benchmark.Run("Logger.Info string", () => Logger.Info("A typical log message of moderate length"), ITERATIONS);
+            Benchmark.Run("Logger.Info formattable", () => Logger.Info("Unit moved to ", position), ITERATIONS);
+            Benchmark.Run("Logger.Info category format", () => Logger.Info(LogCategory.Simulation, "Unit {0} moved", 42), ITERATIONS);
+            Benchmark.Run("Logger.Event", () => Logger.Event(unitMoved, 42, 1234), ITERATIONS);
+
+            // messages below the minimum level should cost almost nothing
+            LogLevel level = Logger.GetLevel(LogCategory.Simulation);
+            Logger.SetLevel(LogCategory.Simulation, LogLevel.Warning);
+            Benchmark.Run("Logger.Info filtered", () => Logger.Info(LogCategory.Simulation, "Unit {0} moved", 42), ITERATIONS);
+            Logger.SetLevel(LogCategory.Simulation, level);
+
+            Logger.FlushEvents();
+            Console.WriteLine();
+        }
+    }
+}
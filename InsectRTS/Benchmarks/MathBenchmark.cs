@@ -0,0 +1,279 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using Engine;
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// Times the common operations of the engine's math types, and checks that the batch quaternion
+    /// operations match their scalar versions and that the array reductions skip NaN.
+    /// </summary>
+    internal static class MathBenchmark
+    {
+        private const int ITERATIONS = 10000000;
+        private const int ARRAY_LENGTH = 1024;
+        private const ulong SEED = 12345;
+
+        // not a multiple of any vector width, so the last group of each batch is partial
+        private const int BATCH_LENGTH = 1027;
+
+        /// <summary>
+        /// Runs the benchmarks and the batch checks.
+        /// </summary>
+        /// <returns>True if every batch operation matched its scalar version and every reduction check passed.</returns>
+        public static bool Run()
+        {
+            Console.WriteLine("Math:");
+
+            RandomGenerator random = new RandomGenerator(SEED);
+
+            Vector3 axis = random.GetDirection();
+            Vector3 v1 = random.GetVector3(10f);
+            Vector3 v2 = random.GetVector3(10f);
+            Quaternion q1 = Quaternion.FromAxisAngle(axis, 1.1f);
+            Quaternion q2 = Quaternion.FromAxisAngle(random.GetDirection(), 2.3f);
+            Matrix m1 = Matrix.CreateFromAxisAngle(axis, 0.7f) * Matrix.CreateTranslation(v1);
+            Matrix m2 = Matrix.CreateFromQuaternion(q2) * Matrix.CreateScale(2f);
+
+            Vector3 vectorResult = Vector3.Zero;
+            Vector3 scaleResult = Vector3.Zero;
+            Quaternion quaternionResult = Quaternion.Identity;
+            Matrix matrixResult = Matrix.Identity;
+            float floatResult = 0f;
+
+            Benchmark.Run("Matrix.Multiply", () => Matrix.Multiply(ref m1, ref m2, out matrixResult), ITERATIONS);
+            Benchmark.Run("Matrix.Invert", () => Matrix.Invert(ref m1, out matrixResult), ITERATIONS);
+            Benchmark.Run("Matrix.InvertPrecise", () => Matrix.InvertPrecise(ref m1, out matrixResult), ITERATIONS);
+            Benchmark.Run("Matrix.InvertAffine", () => Matrix.InvertAffine(ref m1, out matrixResult), ITERATIONS);
+            Benchmark.Run("Matrix.Transpose", () => Matrix.Transpose(ref m1, out matrixResult), ITERATIONS);
+            Benchmark.Run("Matrix.CreateFromQuaternion", () => Matrix.CreateFromQuaternion(ref q1, out matrixResult), ITERATIONS);
+            Benchmark.Run("Matrix.Decompose", () => m1.Decompose(out vectorResult, out quaternionResult, out scaleResult), ITERATIONS);
+
+            Benchmark.Run("Vector3.Normalized", () => vectorResult = v1.Normalized, ITERATIONS);
+            Benchmark.Run("Vector3.NormalizedFast", () => vectorResult = v1.NormalizedFast, ITERATIONS);
+            Benchmark.Run("Vector3.Dot", () => floatResult += Vector3.Dot(v1, v2), ITERATIONS);
+            Benchmark.Run("Vector3.Cross", () => vectorResult = Vector3.Cross(v1, v2), ITERATIONS);
+            Benchmark.Run("Vector3.Angle", () => floatResult += Vector3.Angle(v1, v2), ITERATIONS);
+            Benchmark.Run("Vector3.TransformPosition", () => vectorResult = Vector3.TransformPosition(v1, m1), ITERATIONS);
+
+            Vector3[] positions = new Vector3[ARRAY_LENGTH];
+            Vector3[] transformed = new Vector3[ARRAY_LENGTH];
+            random.GetVector3(positions, 0, ARRAY_LENGTH, 10f);
+
+            Benchmark.Run($"Vector3.TransformDirection x{ARRAY_LENGTH}", () => Vector3.TransformDirection(positions, ref m1, transformed), ITERATIONS / ARRAY_LENGTH);
+
+            Benchmark.Run("Quaternion.Multiply", () => Quaternion.Multiply(ref q1, ref q2, out quaternionResult), ITERATIONS);
+            Benchmark.Run("Quaternion.FromAxisAngle", () => Quaternion.FromAxisAngle(ref axis, 0.5f, out quaternionResult), ITERATIONS);
+            Benchmark.Run("Quaternion * Vector3", () => vectorResult = q1 * v1, ITERATIONS);
+            Benchmark.Run("Quaternion.Slerp", () => quaternionResult = Quaternion.Slerp(q1, q2, 0.3f), ITERATIONS);
+            Benchmark.Run("Quaternion.SlerpFast", () => quaternionResult = Quaternion.SlerpFast(q1, q2, 0.3f), ITERATIONS);
+
+            Benchmark.Run("Mathf.Cos", () => floatResult += Mathf.Cos(floatResult), ITERATIONS);
+            Benchmark.Run("Mathf.Pow", () => floatResult += Mathf.Pow(1.0001f, 2.5f), ITERATIONS);
+            Benchmark.Run("Mathf.Lerp", () => floatResult = Mathf.Lerp(floatResult, 1f, 0.5f), ITERATIONS);
+            Benchmark.Run("Mathf.LerpAngle", () => floatResult = Mathf.LerpAngle(floatResult, 1f, 0.5f), ITERATIONS);
+            Benchmark.Run("Mathf.Clamp", () => floatResult = Mathf.Clamp(floatResult + 0.1f, -1f, 1f), ITERATIONS);
+
+            bool passed = RunBatches(random);
+            passed &= CheckReductions(random);
+
+            Console.WriteLine();
+            return passed;
+        }
+
+        /// <summary>
+        /// Times the batch quaternion operations and compares each result with the scalar operation.
+        /// </summary>
+        private static bool RunBatches(RandomGenerator random)
+        {
+            Quaternion[] from = new Quaternion[BATCH_LENGTH];
+            Quaternion[] to = new Quaternion[BATCH_LENGTH];
+            Quaternion[] blended = new Quaternion[BATCH_LENGTH];
+            float[] blends = new float[BATCH_LENGTH];
+            Vector3[] vectors = new Vector3[BATCH_LENGTH];
+            Vector3[] rotated = new Vector3[BATCH_LENGTH];
+            Matrix[] matrices = new Matrix[BATCH_LENGTH];
+
+            for (int i = 0; i < BATCH_LENGTH; i++)
+            {
+                from[i] = Quaternion.FromAxisAngle(random.GetDirection(), random.GetRange(-Mathf.Pi, Mathf.Pi));
+                to[i] = Quaternion.FromAxisAngle(random.GetDirection(), random.GetRange(-Mathf.Pi, Mathf.Pi));
+            }
+            random.Fill(blends, 0, BATCH_LENGTH);
+            random.GetVector3(vectors, 0, BATCH_LENGTH, 10f);
+
+            // cover the identical, nearly identical and opposite pairs the blends treat specially
+            for (int i = 0; i < 16; i++)
+            {
+                to[i] = from[i];
+                to[i + 16] = Quaternion.FromAxisAngle(random.GetDirection(), 0.01f) * from[i + 16];
+                to[i + 32] = new Quaternion(-from[i + 32].x, -from[i + 32].y, -from[i + 32].z, -from[i + 32].w);
+            }
+
+            Benchmark.Run($"Quaternion.Lerp x{BATCH_LENGTH}", () => Quaternion.Lerp(from, to, blends, blended), ITERATIONS / BATCH_LENGTH);
+            Benchmark.Run($"Quaternion.SlerpFast x{BATCH_LENGTH}", () => Quaternion.SlerpFast(from, to, blends, blended), ITERATIONS / BATCH_LENGTH);
+            Benchmark.Run($"Quaternion.Slerp x{BATCH_LENGTH}", () => Quaternion.Slerp(from, to, blends, blended), ITERATIONS / BATCH_LENGTH);
+            Benchmark.Run($"Vector3.Rotate x{BATCH_LENGTH}", () => Vector3.Rotate(vectors, from, rotated), ITERATIONS / BATCH_LENGTH);
+            Benchmark.Run($"Matrix.CreateFromQuaternion x{BATCH_LENGTH}", () => Matrix.CreateFromQuaternion(from, matrices), ITERATIONS / BATCH_LENGTH);
+
+            bool passed = true;
+
+            Quaternion.Lerp(from, to, blends, blended);
+            passed &= Check("Quaternion.Lerp", 0f, i =>
+            {
+                Quaternion.Lerp(ref from[i], ref to[i], blends[i], out Quaternion expected);
+                return Difference(blended[i], expected);
+            });
+
+            Quaternion.SlerpFast(from, to, 0.3f, blended);
+            passed &= Check("Quaternion.SlerpFast", 0f, i =>
+            {
+                Quaternion.SlerpFast(ref from[i], ref to[i], 0.3f, out Quaternion expected);
+                return Difference(blended[i], expected);
+            });
+
+            Quaternion.SlerpFast(from, to, blends, blended);
+            passed &= Check("Quaternion.SlerpFast angle", Quaternion.SlerpFastMaxError, i => SlerpAngle(from[i], to[i], blends[i], blended[i]));
+
+            Quaternion.Slerp(from, to, blends, blended);
+            passed &= Check("Quaternion.Slerp", Simd.SlerpMaxError, i =>
+            {
+                Quaternion.Slerp(ref from[i], ref to[i], blends[i], out Quaternion expected);
+                return Difference(blended[i], expected);
+            });
+
+            Vector3.Rotate(vectors, from, rotated);
+            passed &= Check("Vector3.Rotate", 0f, i =>
+            {
+                Vector3.Rotate(ref vectors[i], ref from[i], out Vector3 expected);
+                Vector3 difference = rotated[i] - expected;
+                return Math.Max(Math.Abs(difference.x), Math.Max(Math.Abs(difference.y), Math.Abs(difference.z)));
+            });
+
+            Matrix.CreateFromQuaternion(from, matrices);
+            passed &= Check("Matrix.CreateFromQuaternion", 0f, i =>
+            {
+                Matrix.CreateFromQuaternion(ref from[i], out Matrix expected);
+                return matrices[i] == expected ? 0f : float.PositiveInfinity;
+            });
+
+            return passed;
+        }
+
+        /// <summary>
+        /// Checks that Mathf.Min, Max and MinMax skip NaN values the same way in their scalar and vector paths,
+        /// over lengths on both sides of the vector width.
+        /// </summary>
+        private static bool CheckReductions(RandomGenerator random)
+        {
+            float[] values = new float[64];
+            int failures = 0;
+
+            for (int length = 1; length <= values.Length; length++)
+            {
+                for (int nanIndex = -1; nanIndex < length; nanIndex++)
+                {
+                    random.Fill(values, 0, length);
+                    bool allNaN = nanIndex == length - 1 && length < 4;
+                    for (int i = 0; i < length; i++)
+                    {
+                        // one NaN at each position, or a leading run of them, or every value when the range is short
+                        if (i == nanIndex || i < nanIndex / 2 || allNaN)
+                        {
+                            values[i] = float.NaN;
+                        }
+                    }
+
+                    float expectedMin = float.NaN;
+                    float expectedMax = float.NaN;
+                    for (int i = 0; i < length; i++)
+                    {
+                        float value = values[i];
+                        if (!float.IsNaN(value) && (float.IsNaN(expectedMin) || value < expectedMin))
+                        {
+                            expectedMin = value;
+                        }
+                        if (!float.IsNaN(value) && (float.IsNaN(expectedMax) || value > expectedMax))
+                        {
+                            expectedMax = value;
+                        }
+                    }
+
+                    Mathf.MinMax(values, 0, length, out float min, out float max);
+                    if (!Mathf.Min(values, 0, length).Equals(expectedMin) || !Mathf.Max(values, 0, length).Equals(expectedMax) ||
+                        !min.Equals(expectedMin) || !max.Equals(expectedMax))
+                    {
+                        failures++;
+                    }
+                }
+            }
+
+            bool passed = failures == 0;
+            Console.WriteLine($"{"Mathf.Min/Max with NaN",-36} {failures} failures {(passed ? "passed" : "FAILED")}");
+            return passed;
+        }
+
+        /// <summary>
+        /// Checks that the largest difference between a batch result and the scalar result is within a tolerance.
+        /// </summary>
+        /// <param name="difference">Gets the difference at an index.</param>
+        private static bool Check(string name, float maxDifference, Func<int, float> difference)
+        {
+            float largest = 0f;
+            for (int i = 0; i < BATCH_LENGTH; i++)
+            {
+                float d = difference(i);
+                if (d > largest || float.IsNaN(d))
+                {
+                    largest = d;
+                }
+            }
+
+            bool passed = largest <= maxDifference;
+            Console.WriteLine($"{name + " batch",-36} max difference {largest:G3} of {maxDifference:G2} {(passed ? "passed" : "FAILED")}");
+            return passed;
+        }
+
+        /// <summary>
+        /// Gets the angle in radians of the rotation between a blended quaternion and the exact slerp, computed
+        /// in double precision.
+        /// </summary>
+        private static float SlerpAngle(Quaternion a, Quaternion b, float t, Quaternion blended)
+        {
+            double dot = (double)a.x * b.x + (double)a.y * b.y + (double)a.z * b.z + (double)a.w * b.w;
+            double sign = dot < 0.0 ? -1.0 : 1.0;
+            double angle = Math.Acos(Math.Min(Math.Abs(dot), 1.0));
+            double wa = 1.0 - t;
+            double wb = t;
+            if (angle > 1e-9)
+            {
+                wa = Math.Sin((1.0 - t) * angle) / Math.Sin(angle);
+                wb = Math.Sin(t * angle) / Math.Sin(angle);
+            }
+            wb *= sign;
+
+            double ex = wa * a.x + wb * b.x;
+            double ey = wa * a.y + wb * b.y;
+            double ez = wa * a.z + wb * b.z;
+            double ew = wa * a.w + wb * b.w;
+
+            // the rotation angle of the difference, which unlike acos of the dot product is well conditioned near zero
+            double w = ew * blended.w + ex * blended.x + ey * blended.y + ez * blended.z;
+            double x = ew * blended.x - ex * blended.w - ey * blended.z + ez * blended.y;
+            double y = ew * blended.y - ey * blended.w - ez * blended.x + ex * blended.z;
+            double z = ew * blended.z - ez * blended.w - ex * blended.y + ey * blended.x;
+            return (float)(2.0 * Math.Atan2(Math.Sqrt(x * x + y * y + z * z), Math.Abs(w)));
+        }
+
+        /// <summary>
+        /// Gets the largest difference between the components of two quaternions.
+        /// </summary>
+        private static float Difference(Quaternion a, Quaternion b)
+        {
+            return Math.Max(Math.Max(Math.Abs(a.x - b.x), Math.Abs(a.y - b.y)), Math.Max(Math.Abs(a.z - b.z), Math.Abs(a.w - b.w)));
+        }
+    }
+}
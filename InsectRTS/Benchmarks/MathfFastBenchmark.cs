@@ -0,0 +1,219 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Numerics;
+using Engine;
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// Times the approximations in <see cref="MathfFast"/> against <see cref="Mathf"/>, and checks that
+    /// each approximation stays within the maximum error given in its documentation.
+    /// </summary>
+    internal static class MathfFastBenchmark
+    {
+        private const int ITERATIONS = 10000000;
+        private const ulong SEED = 12345;
+
+        // not a multiple of any vector width, so the array overloads finish with the scalar loop
+        private const int ARRAY_LENGTH = 1027;
+        private const int SAMPLE_COUNT = 100 * ARRAY_LENGTH;
+
+        // the documented maximum errors
+        private const double SIN_COS_ERROR = 3e-7;
+        private const double ATAN_ERROR = 6e-7;
+        private const double EXP_ERROR = 3e-7;
+        private const double LOG_ERROR = 3e-7;
+        private const double POW_ERROR = 2e-6;
+        private const double INVERSE_SQRT_ERROR = 5e-6;
+        private const double INVERSE_SQRT_ARRAY_ERROR = 1.2e-7;
+
+        /// <summary>
+        /// Runs the benchmarks and the accuracy checks.
+        /// </summary>
+        /// <returns>True if every function was within its documented error.</returns>
+        public static bool Run()
+        {
+            Console.WriteLine("MathfFast:");
+
+            RandomGenerator random = new RandomGenerator(SEED);
+
+            float[] values = new float[ARRAY_LENGTH];
+            float[] results = new float[ARRAY_LENGTH];
+            random.Fill(values, 0, ARRAY_LENGTH, 0.1f, 100f);
+
+            float a = values[0];
+            float b = values[1];
+            float floatResult = 0f;
+
+            Benchmark.Run("Mathf.Sin", () => floatResult += Mathf.Sin(a), ITERATIONS);
+            Benchmark.Run("MathfFast.Sin", () => floatResult += MathfFast.Sin(a), ITERATIONS);
+            Benchmark.Run("Mathf.Atan2", () => floatResult += Mathf.Atan2(a, b), ITERATIONS);
+            Benchmark.Run("MathfFast.Atan2", () => floatResult += MathfFast.Atan2(a, b), ITERATIONS);
+            Benchmark.Run("Mathf.Exp", () => floatResult += Mathf.Exp(a), ITERATIONS);
+            Benchmark.Run("MathfFast.Exp", () => floatResult += MathfFast.Exp(a), ITERATIONS);
+            Benchmark.Run("Mathf.Pow", () => floatResult += Mathf.Pow(a, b), ITERATIONS);
+            Benchmark.Run("MathfFast.Pow", () => floatResult += MathfFast.Pow(a, b), ITERATIONS);
+
+            Benchmark.Run($"Mathf.Sin x{ARRAY_LENGTH}", () =>
+            {
+                for (int i = 0; i < ARRAY_LENGTH; i++)
+                {
+                    results[i] = Mathf.Sin(values[i]);
+                }
+            }, ITERATIONS / ARRAY_LENGTH);
+            Benchmark.Run($"MathfFast.Sin x{ARRAY_LENGTH}", () => MathfFast.Sin(values, results), ITERATIONS / ARRAY_LENGTH);
+            Benchmark.Run($"MathfFast.Exp x{ARRAY_LENGTH}", () => MathfFast.Exp(values, results), ITERATIONS / ARRAY_LENGTH);
+            Benchmark.Run($"MathfFast.InverseSqrt x{ARRAY_LENGTH}", () => MathfFast.InverseSqrt(values, results), ITERATIONS / ARRAY_LENGTH);
+
+            bool passed = true;
+
+            float[] angles = Uniform(random, -1000f, 1000f);
+            passed &= CheckArray("Sin", angles, MathfFast.Sin, MathfFast.Sin, Math.Sin, SIN_COS_ERROR, false);
+            passed &= CheckArray("Cos", angles, MathfFast.Cos, MathfFast.Cos, Math.Cos, SIN_COS_ERROR, false);
+            passed &= CheckSinCos(angles);
+
+            float[] tangents = Uniform(random, -100f, 100f);
+            passed &= Check("Atan", ATAN_ERROR, false, i => Error(MathfFast.Atan(tangents[i]), Math.Atan(tangents[i]), false));
+
+            float[] ys = Uniform(random, -10f, 10f);
+            float[] xs = Uniform(random, -10f, 10f);
+            passed &= Check("Atan2", ATAN_ERROR, false, i => Error(MathfFast.Atan2(ys[i], xs[i]), Math.Atan2(ys[i], xs[i]), false));
+
+            // stay above the range where the result is no longer a normalized float
+            float[] powers = Uniform(random, -80f, 88f);
+            passed &= CheckArray("Exp", powers, MathfFast.Exp, MathfFast.Exp, Math.Exp, EXP_ERROR, true);
+
+            float[] magnitudes = LogUniform(random, 1e-30f, 1e30f);
+            passed &= Check("Log", LOG_ERROR, true, i => Error(MathfFast.Log(magnitudes[i]), Math.Log(magnitudes[i]), true));
+
+            // the array overload is exact rather than using the scalar approximation
+            passed &= Check("InverseSqrt", INVERSE_SQRT_ERROR, true, i => Error(MathfFast.InverseSqrt(magnitudes[i]), 1.0 / Math.Sqrt(magnitudes[i]), true));
+            passed &= CheckArrayOnly("InverseSqrt array", magnitudes, MathfFast.InverseSqrt, n => 1.0 / Math.Sqrt(n), INVERSE_SQRT_ARRAY_ERROR, true);
+
+            // keep |p * ln(b)| below 20, where the error is documented
+            float[] bases = LogUniform(random, 0.05f, 20f);
+            float[] exponents = Uniform(random, -6f, 6f);
+            passed &= Check("Pow", POW_ERROR, true, i => Error(MathfFast.Pow(bases[i], exponents[i]), Math.Pow(bases[i], exponents[i]), true));
+
+            Console.WriteLine();
+            return passed;
+        }
+
+        /// <summary>
+        /// Checks a function with an array overload. The scalar function is checked on every value, then
+        /// the array overload is checked on the whole array, which runs both the vectorized and the scalar
+        /// loop, and on a range shorter than one vector, which only runs the scalar loop.
+        /// </summary>
+        private static bool CheckArray(string name, float[] src, Action<float[], int, float[], int, int> arrayFunc, Func<float, float> scalarFunc, Func<double, double> reference, double maxError, bool relative)
+        {
+            bool passed = Check(name, maxError, relative, i => Error(scalarFunc(src[i]), reference(src[i]), relative));
+            return passed & CheckArrayOnly($"{name} array", src, arrayFunc, reference, maxError, relative);
+        }
+
+        /// <summary>
+        /// Checks the array overload of a function on the whole array and on a range shorter than one vector.
+        /// </summary>
+        private static bool CheckArrayOnly(string name, float[] src, Action<float[], int, float[], int, int> arrayFunc, Func<double, double> reference, double maxError, bool relative)
+        {
+            float[] dest = new float[src.Length];
+            arrayFunc(src, 0, dest, 0, src.Length);
+
+            float[] tail = new float[src.Length];
+            int tailLength = Vector<float>.Count - 1;
+            arrayFunc(src, 1, tail, 1, tailLength);
+
+            return Check(name, maxError, relative, i =>
+            {
+                double error = Error(dest[i], reference(src[i]), relative);
+                if (i >= 1 && i <= tailLength)
+                {
+                    error = Math.Max(error, Error(tail[i], reference(src[i]), relative));
+                }
+                return error;
+            });
+        }
+
+        /// <summary>
+        /// Checks the array overload of <see cref="MathfFast.SinCos(float, out float, out float)"/> the same
+        /// way as <see cref="CheckArray"/>.
+        /// </summary>
+        private static bool CheckSinCos(float[] angles)
+        {
+            bool passed = Check("SinCos", SIN_COS_ERROR, false, i =>
+            {
+                MathfFast.SinCos(angles[i], out float sin, out float cos);
+                return Math.Max(Error(sin, Math.Sin(angles[i]), false), Error(cos, Math.Cos(angles[i]), false));
+            });
+
+            float[] sins = new float[angles.Length];
+            float[] coses = new float[angles.Length];
+            MathfFast.SinCos(angles, sins, coses);
+
+            float[] tailSins = new float[angles.Length];
+            float[] tailCoses = new float[angles.Length];
+            int tailLength = Vector<float>.Count - 1;
+            MathfFast.SinCos(angles, 1, tailSins, tailCoses, 1, tailLength);
+
+            return passed & Check("SinCos array", SIN_COS_ERROR, false, i =>
+            {
+                double sin = Math.Sin(angles[i]);
+                double cos = Math.Cos(angles[i]);
+                double error = Math.Max(Error(sins[i], sin, false), Error(coses[i], cos, false));
+                if (i >= 1 && i <= tailLength)
+                {
+                    error = Math.Max(error, Math.Max(Error(tailSins[i], sin, false), Error(tailCoses[i], cos, false)));
+                }
+                return error;
+            });
+        }
+
+        /// <summary>
+        /// Finds the largest error over all the samples and compares it to the documented error.
+        /// </summary>
+        private static bool Check(string name, double maxError, bool relative, Func<int, double> getError)
+        {
+            double largest = 0.0;
+            for (int i = 0; i < SAMPLE_COUNT; i++)
+            {
+                // once a NaN is found it is kept, so the check fails
+                double error = getError(i);
+                if (error > largest || double.IsNaN(error))
+                {
+                    largest = error;
+                }
+            }
+
+            bool passed = largest <= maxError;
+            string kind = relative ? "relative" : "absolute";
+            string result = passed ? "passed" : "FAILED";
+            Console.WriteLine($"{name,-24} max {kind} error {largest:G3} of {maxError:G2} {result}");
+            return passed;
+        }
+
+        private static double Error(float value, double expected, bool relative)
+        {
+            double error = Math.Abs(value - expected);
+            return relative ? error / Math.Abs(expected) : error;
+        }
+
+        private static float[] Uniform(RandomGenerator random, float min, float max)
+        {
+            float[] values = new float[SAMPLE_COUNT];
+            random.Fill(values, 0, SAMPLE_COUNT, min, max);
+            return values;
+        }
+
+        private static float[] LogUniform(RandomGenerator random, float min, float max)
+        {
+            float[] values = Uniform(random, (float)Math.Log(min), (float)Math.Log(max));
+            for (int i = 0; i < SAMPLE_COUNT; i++)
+            {
+                values[i] = (float)Math.Exp(values[i]);
+            }
+            return values;
+        }
+    }
+}
@@ -0,0 +1,108 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Collections.Generic;
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// Runs the benchmarks. The supported arguments are:
+    /// <list type="bullet">
+    /// <item><c>--filter name</c> only runs the benchmark groups whose name contains the text.</item>
+    /// <item><c>--json path</c> saves the results to a JSON file.</item>
+    /// <item><c>--baseline path</c> compares the results with a JSON file saved by an earlier run, such as
+    /// the committed <c>baseline.json</c>.</item>
+    /// </list>
+    /// The exit code is 1 if a correctness check fails, or 2 if a benchmark regressed from the baseline.
+    /// </summary>
+    internal class Program
+    {
+        public static int Main(string[] args)
+        {
+            string filter = GetArgument(args, "--filter");
+            string jsonPath = GetArgument(args, "--json");
+            string baselinePath = GetArgument(args, "--baseline");
+
+            string process = Environment.Is64BitProcess ? "x64" : "x86";
+            Console.WriteLine($"Running as {process} on {Environment.OSVersion.VersionString}");
+            Console.WriteLine();
+
+            List<KeyValuePair<string, Func<bool>>> groups = new List<KeyValuePair<string, Func<bool>>>
+            {
+                CheckedGroup("FixedPoint", FixedPointBenchmark.Run),
+                CheckedGroup("Math", MathBenchmark.Run),
+                CheckedGroup("MathfFast", MathfFastBenchmark.Run),
+                Group("Random", RandomBenchmark.Run),
+                CheckedGroup("LogQueue", LogQueueBenchmark.Run),
+                Group("LogFile", LogFileBenchmark.Run),
+                CheckedGroup("BinaryLog", BinaryLogBenchmark.Run),
+                Group("Logger", LoggerBenchmark.Run),
+                CheckedGroup("JobSystem", JobSystemBenchmark.Run),
+                CheckedGroup("Entity", EntityBenchmark.Run),
+                CheckedGroup("GraphicsDevice", GraphicsDeviceBenchmark.Run),
+                CheckedGroup("FixedTimestep", FixedTimestepBenchmark.Run),
+            };
+
+            bool passed = true;
+            int regressions = 0;
+
+            foreach (KeyValuePair<string, Func<bool>> group in groups)
+            {
+                if (filter == null || group.Key.IndexOf(filter, StringComparison.OrdinalIgnoreCase) >= 0)
+                {
+                    passed &= group.Value();
+                }
+            }
+
+            BenchmarkReport report = new BenchmarkReport(Benchmark.Results);
+
+            if (baselinePath != null)
+            {
+                // benchmarks in groups that were filtered out are not missing
+                regressions = report.Compare(BenchmarkReport.Load(baselinePath), filter == null);
+            }
+            if (jsonPath != null)
+            {
+                report.Save(jsonPath);
+                Console.WriteLine($"Saved {report.results.Count} results to \"{jsonPath}\"");
+            }
+
+            if (!passed)
+            {
+                return 1;
+            }
+            return regressions > 0 ? 2 : 0;
+        }
+
+        /// <summary>
+        /// Creates a group whose run method returns if its correctness checks passed.
+        /// </summary>
+        private static KeyValuePair<string, Func<bool>> CheckedGroup(string name, Func<bool> run)
+        {
+            return new KeyValuePair<string, Func<bool>>(name, run);
+        }
+
+        /// <summary>
+        /// Creates a group that only measures performance.
+        /// </summary>
+        private static KeyValuePair<string, Func<bool>> Group(string name, Action run)
+        {
+            return CheckedGroup(name, () =>
+            {
+                run();
+                return true;
+            });
+        }
+
+        /// <summary>
+        /// Gets the value following an argument, or null if the argument was not given.
+        /// </summary>
+        private static string GetArgument(string[] args, string name)
+        {
+            int index = Array.IndexOf(args, name);
+            return index >= 0 && index + 1 < args.Length ? args[index + 1] : null;
+        }
+    }
+}
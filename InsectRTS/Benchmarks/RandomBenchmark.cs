@@ -0,0 +1,49 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using Engine;
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// Times random number generation, comparing the engine's generator with <see cref="System.Random"/>.
+    /// </summary>
+    internal static class RandomBenchmark
+    {
+        private const int ITERATIONS = 10000000;
+        private const int ARRAY_LENGTH = 1024;
+        private const ulong SEED = 12345;
+
+        /// <summary>
+        /// Runs the benchmarks.
+        /// </summary>
+        public static void Run()
+        {
+            Console.WriteLine("Random:");
+
+            RandomGenerator random = new RandomGenerator(SEED);
+            System.Random systemRandom = new System.Random((int)SEED);
+
+            uint uintResult = 0;
+            int intResult = 0;
+            float floatResult = 0f;
+            double doubleResult = 0.0;
+            Vector3 vectorResult = Vector3.Zero;
+
+            Benchmark.Run("RandomGenerator.NextUInt", () => uintResult += random.NextUInt(), ITERATIONS);
+            Benchmark.Run("RandomGenerator.Next", () => intResult += random.Next(-100, 100), ITERATIONS);
+            Benchmark.Run("RandomGenerator.NextFloat", () => floatResult += random.NextFloat(), ITERATIONS);
+            Benchmark.Run("RandomGenerator.GetDirection", () => vectorResult = random.GetDirection(), ITERATIONS);
+            Benchmark.Run("Random.Value", () => floatResult += Engine.Random.Value, ITERATIONS);
+            Benchmark.Run("System.Random.Next", () => intResult += systemRandom.Next(-100, 100), ITERATIONS);
+            Benchmark.Run("System.Random.NextDouble", () => doubleResult += systemRandom.NextDouble(), ITERATIONS);
+
+            float[] values = new float[ARRAY_LENGTH];
+            Benchmark.Run($"RandomGenerator.Fill x{ARRAY_LENGTH}", () => random.Fill(values, 0, ARRAY_LENGTH), ITERATIONS / ARRAY_LENGTH);
+
+            Console.WriteLine();
+        }
+    }
+}
@@ -0,0 +1,173 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Collections.Generic;
+
+namespace Engine.Entities
+{
+    /// <summary>
+    /// Stores all entities with a given set of components in a list of chunks.
+    /// </summary>
+    /// <remarks>
+    /// Entities are kept packed, so every chunk except the last is full. When an entity is removed,
+    /// the last entity of the archetype is moved into its place.
+    /// </remarks>
+    internal sealed class Archetype
+    {
+        /// <summary>
+        /// The approximate size of a chunk in bytes. Chunk capacity is chosen so that the
+        /// entity IDs and components of a chunk fit in this size.
+        /// </summary>
+        public const int CHUNK_SIZE = 16 * 1024;
+
+        private readonly int[] m_componentTypes;
+        private readonly int[] m_columnLookup;
+        private readonly int m_chunkCapacity;
+        private readonly List<Chunk> m_chunks = new List<Chunk>();
+        private readonly Dictionary<int, Archetype> m_addEdges = new Dictionary<int, Archetype>();
+        private readonly Dictionary<int, Archetype> m_removeEdges = new Dictionary<int, Archetype>();
+        private Chunk m_spareChunk = null;
+        private int m_entityCount = 0;
+
+        /// <summary>
+        /// The IDs of the component types, in ascending order.
+        /// </summary>
+        public int[] ComponentTypes => m_componentTypes;
+
+        /// <summary>
+        /// The number of entities that fit in each chunk.
+        /// </summary>
+        public int ChunkCapacity => m_chunkCapacity;
+
+        /// <summary>
+        /// The chunks storing the entities.
+        /// </summary>
+        public List<Chunk> Chunks => m_chunks;
+
+        /// <summary>
+        /// The number of entities in this archetype.
+        /// </summary>
+        public int EntityCount => m_entityCount;
+
+        /// <summary>
+        /// The archetypes reached by adding a component type, cached by component type ID.
+        /// </summary>
+        public Dictionary<int, Archetype> AddEdges => m_addEdges;
+
+        /// <summary>
+        /// The archetypes reached by removing a component type, cached by component type ID.
+        /// </summary>
+        public Dictionary<int, Archetype> RemoveEdges => m_removeEdges;
+
+        /// <summary>
+        /// Creates a new archetype.
+        /// </summary>
+        /// <param name="componentTypes">The IDs of the component types, in ascending order.</param>
+        public Archetype(int[] componentTypes)
+        {
+            m_componentTypes = componentTypes;
+
+            int maxType = -1;
+            int entitySize = Unsafe.SizeOf<Entity>();
+
+            foreach (int type in componentTypes)
+            {
+                maxType = Math.Max(maxType, type);
+                entitySize += Engine.Entities.ComponentTypes.GetSize(type);
+            }
+
+            m_columnLookup = new int[maxType + 1];
+            for (int i = 0; i < m_columnLookup.Length; i++)
+            {
+                m_columnLookup[i] = -1;
+            }
+            for (int i = 0; i < componentTypes.Length; i++)
+            {
+                m_columnLookup[componentTypes[i]] = i;
+            }
+
+            m_chunkCapacity = Math.Max(CHUNK_SIZE / entitySize, 1);
+        }
+
+        /// <summary>
+        /// Gets the index of a component type in this archetype's chunks.
+        /// </summary>
+        /// <param name="type">The component type ID.</param>
+        /// <returns>The column index, or -1 if the archetype doesn't have the component.</returns>
+        public int GetColumn(int type)
+        {
+            return type < m_columnLookup.Length ? m_columnLookup[type] : -1;
+        }
+
+        /// <summary>
+        /// Checks if this archetype has all of the given component types.
+        /// </summary>
+        /// <param name="types">The component type IDs.</param>
+        public bool HasAll(int[] types)
+        {
+            foreach (int type in types)
+            {
+                if (GetColumn(type) < 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// Adds an entity to the end of the last chunk, with all components set to their default value.
+        /// </summary>
+        /// <param name="entity">The entity to add.</param>
+        /// <param name="index">Returns the index of the entity in the chunk.</param>
+        /// <returns>The chunk the entity was added to.</returns>
+        public Chunk Add(Entity entity, out int index)
+        {
+            Chunk chunk = m_chunks.Count > 0 ? m_chunks[m_chunks.Count - 1] : null;
+
+            if (chunk == null || chunk.IsFull)
+            {
+                chunk = m_spareChunk ?? new Chunk(this);
+                m_spareChunk = null;
+                m_chunks.Add(chunk);
+            }
+
+            index = chunk.Add(entity);
+            m_entityCount++;
+            return chunk;
+        }
+
+        /// <summary>
+        /// Removes an entity by moving the last entity of the archetype into its place.
+        /// </summary>
+        /// <param name="chunk">The chunk containing the entity.</param>
+        /// <param name="index">The index of the entity in the chunk.</param>
+        /// <returns>The entity that was moved to the given chunk and index, or <see cref="Entity.Null"/>
+        /// if the removed entity was the last one.</returns>
+        public Entity Remove(Chunk chunk, int index)
+        {
+            Chunk lastChunk = m_chunks[m_chunks.Count - 1];
+            int lastIndex = lastChunk.Count - 1;
+            Entity moved = Entity.Null;
+
+            if (lastChunk != chunk || lastIndex != index)
+            {
+                lastChunk.CopyTo(lastIndex, chunk, index);
+                moved = chunk.GetEntities()[index];
+            }
+
+            lastChunk.RemoveLast();
+            m_entityCount--;
+
+            // keep one empty chunk around so adding and removing at a chunk boundary doesn't allocate
+            if (lastChunk.Count == 0)
+            {
+                m_chunks.RemoveAt(m_chunks.Count - 1);
+                m_spareChunk = lastChunk;
+            }
+            return moved;
+        }
+    }
+}
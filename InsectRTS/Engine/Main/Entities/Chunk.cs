@@ -0,0 +1,140 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+
+namespace Engine.Entities
+{
+    /// <summary>
+    /// A block of entities that all have the same set of components. Each component type is stored in
+    /// its own array, so systems read only the components they use, one after another in memory.
+    /// </summary>
+    /// <remarks>
+    /// Only the first <see cref="Count"/> elements of each array are in use. Entities in a chunk may be moved
+    /// or reordered by any structural change to the world, so arrays must not be held on to across changes.
+    /// </remarks>
+    public sealed class Chunk
+    {
+        private readonly Archetype m_archetype;
+        private readonly Entity[] m_entities;
+        private readonly Array[] m_columns;
+        private int m_count = 0;
+
+        /// <summary>
+        /// The number of entities in the chunk.
+        /// </summary>
+        public int Count => m_count;
+
+        /// <summary>
+        /// The maximum number of entities the chunk can hold.
+        /// </summary>
+        public int Capacity => m_entities.Length;
+
+        /// <summary>
+        /// Indicates if the chunk can't hold any more entities.
+        /// </summary>
+        internal bool IsFull => m_count == m_entities.Length;
+
+        internal Archetype Archetype => m_archetype;
+
+        internal Chunk(Archetype archetype)
+        {
+            m_archetype = archetype;
+
+            int capacity = archetype.ChunkCapacity;
+            int[] componentTypes = archetype.ComponentTypes;
+
+            m_entities = new Entity[capacity];
+            m_columns = new Array[componentTypes.Length];
+
+            for (int i = 0; i < componentTypes.Length; i++)
+            {
+                m_columns[i] = Array.CreateInstance(ComponentTypes.GetComponentType(componentTypes[i]), capacity);
+            }
+        }
+
+        /// <summary>
+        /// Gets the entities in the chunk. The array must not be modified.
+        /// </summary>
+        public Entity[] GetEntities()
+        {
+            return m_entities;
+        }
+
+        /// <summary>
+        /// Gets the array storing a component for each entity in the chunk.
+        /// </summary>
+        /// <typeparam name="T">The component type.</typeparam>
+        /// <exception cref="InvalidOperationException">Thrown if the chunk's entities don't have the component.</exception>
+        public T[] GetComponents<T>() where T : struct
+        {
+            int column = m_archetype.GetColumn(ComponentType<T>.ID);
+            if (column < 0)
+            {
+                throw new InvalidOperationException($"Chunk does not have component \"{typeof(T).Name}\"!");
+            }
+            return (T[])m_columns[column];
+        }
+
+        /// <summary>
+        /// Checks if the entities in this chunk have a component.
+        /// </summary>
+        /// <typeparam name="T">The component type.</typeparam>
+        public bool HasComponent<T>() where T : struct
+        {
+            return m_archetype.GetColumn(ComponentType<T>.ID) >= 0;
+        }
+
+        /// <summary>
+        /// Adds an entity to the end of the chunk, with all components set to their default value.
+        /// </summary>
+        /// <returns>The index of the entity in the chunk.</returns>
+        internal int Add(Entity entity)
+        {
+            int index = m_count++;
+
+            m_entities[index] = entity;
+            foreach (Array column in m_columns)
+            {
+                Array.Clear(column, index, 1);
+            }
+            return index;
+        }
+
+        /// <summary>
+        /// Removes the last entity in the chunk.
+        /// </summary>
+        internal void RemoveLast()
+        {
+            m_count--;
+
+            // don't keep references held by components alive
+            foreach (Array column in m_columns)
+            {
+                Array.Clear(column, m_count, 1);
+            }
+        }
+
+        /// <summary>
+        /// Copies an entity and the components it shares with the destination chunk.
+        /// </summary>
+        /// <param name="index">The index of the entity in this chunk.</param>
+        /// <param name="destination">The chunk to copy to.</param>
+        /// <param name="destinationIndex">The index of the entity in the destination chunk.</param>
+        internal void CopyTo(int index, Chunk destination, int destinationIndex)
+        {
+            destination.m_entities[destinationIndex] = m_entities[index];
+
+            int[] componentTypes = m_archetype.ComponentTypes;
+            for (int i = 0; i < componentTypes.Length; i++)
+            {
+                int column = destination.m_archetype.GetColumn(componentTypes[i]);
+                if (column >= 0)
+                {
+                    Array.Copy(m_columns[i], index, destination.m_columns[column], destinationIndex, 1);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,27 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+
+namespace Engine.Entities
+{
+    /// <summary>
+    /// Processes the components of an entity.
+    /// </summary>
+    public delegate void ComponentAction<T1>(ref T1 component1);
+
+    /// <summary>
+    /// Processes the components of an entity.
+    /// </summary>
+    public delegate void ComponentAction<T1, T2>(ref T1 component1, ref T2 component2);
+
+    /// <summary>
+    /// Processes the components of an entity.
+    /// </summary>
+    public delegate void ComponentAction<T1, T2, T3>(ref T1 component1, ref T2 component2, ref T3 component3);
+
+    /// <summary>
+    /// Processes the entities in a chunk.
+    /// </summary>
+    public delegate void ChunkAction(Chunk chunk);
+}
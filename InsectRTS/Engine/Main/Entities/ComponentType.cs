@@ -0,0 +1,82 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Collections.Generic;
+
+namespace Engine.Entities
+{
+    /// <summary>
+    /// Assigns each component type a small integer ID, used to identify archetypes and index columns.
+    /// </summary>
+    internal static class ComponentTypes
+    {
+        private static readonly object m_lock = new object();
+        private static readonly List<Type> m_types = new List<Type>();
+        private static readonly List<int> m_sizes = new List<int>();
+
+        /// <summary>
+        /// The number of registered component types.
+        /// </summary>
+        public static int Count
+        {
+            get
+            {
+                lock (m_lock)
+                {
+                    return m_types.Count;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Registers a component type.
+        /// </summary>
+        /// <param name="type">The component type.</param>
+        /// <param name="size">The size of the component in bytes.</param>
+        /// <returns>The ID of the component type.</returns>
+        public static int Register(Type type, int size)
+        {
+            lock (m_lock)
+            {
+                m_types.Add(type);
+                m_sizes.Add(size);
+                return m_types.Count - 1;
+            }
+        }
+
+        /// <summary>
+        /// Gets the type of a component.
+        /// </summary>
+        /// <param name="id">The component type ID.</param>
+        public static Type GetComponentType(int id)
+        {
+            lock (m_lock)
+            {
+                return m_types[id];
+            }
+        }
+
+        /// <summary>
+        /// Gets the size of a component in bytes.
+        /// </summary>
+        /// <param name="id">The component type ID.</param>
+        public static int GetSize(int id)
+        {
+            lock (m_lock)
+            {
+                return m_sizes[id];
+            }
+        }
+    }
+
+    /// <summary>
+    /// Caches the ID of a component type.
+    /// </summary>
+    /// <typeparam name="T">The component type.</typeparam>
+    internal static class ComponentType<T> where T : struct
+    {
+        public static readonly int ID = ComponentTypes.Register(typeof(T), Unsafe.SizeOf<T>());
+    }
+}
@@ -0,0 +1,82 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+
+namespace Engine.Entities
+{
+    /// <summary>
+    /// Identifies an entity in a <see cref="World"/>.
+    /// </summary>
+    /// <remarks>
+    /// Entity indices are reused once an entity is destroyed, so each entity also stores the generation
+    /// of its index. An entity that refers to a destroyed entity never matches the entity that reuses
+    /// its index. The default value is <see cref="Null"/>, which never refers to an entity.
+    /// </remarks>
+    public struct Entity : IEquatable<Entity>
+    {
+        /// <summary>
+        /// An entity that never exists.
+        /// </summary>
+        public static readonly Entity Null = default(Entity);
+
+        /// <summary>
+        /// The index of the entity in the world.
+        /// </summary>
+        public readonly int index;
+
+        /// <summary>
+        /// The number of times the index has been used. Starts at one.
+        /// </summary>
+        public readonly int generation;
+
+        internal Entity(int index, int generation)
+        {
+            this.index = index;
+            this.generation = generation;
+        }
+
+        /// <summary>
+        /// Compares whether this instance is equal to another.
+        /// </summary>
+        /// <param name="other">The instance to compare with.</param>
+        /// <returns><c>true</c> if the instances are equal, <c>false</c> otherwise.</returns>
+        public bool Equals(Entity other)
+        {
+            return index == other.index && generation == other.generation;
+        }
+
+        /// <summary>
+        /// Compares whether this instance is equal to specified <see cref="Object"/>.
+        /// </summary>
+        /// <param name="obj">The <see cref="Object"/> to compare.</param>
+        /// <returns><c>true</c> if the instances are equal, <c>false</c> otherwise.</returns>
+        public override bool Equals(object obj)
+        {
+            return (obj is Entity) && Equals((Entity)obj);
+        }
+
+        /// <summary>
+        /// Gets the hash code of this instance.
+        /// </summary>
+        public override int GetHashCode()
+        {
+            unchecked
+            {
+                return (index * 397) ^ generation;
+            }
+        }
+
+        /// <summary>
+        /// Returns a <see cref="String"/> representation of this instance.
+        /// </summary>
+        public override string ToString()
+        {
+            return $"Entity({index}:{generation})";
+        }
+
+        public static bool operator ==(Entity left, Entity right) => left.Equals(right);
+        public static bool operator !=(Entity left, Entity right) => !left.Equals(right);
+    }
+}
@@ -0,0 +1,449 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Collections.Generic;
+using System.Threading;
+
+namespace Engine.Entities
+{
+    /// <summary>
+    /// Records structural changes to make to a <see cref="World"/> later, such as from inside a query
+    /// or from jobs, where the world can't be changed directly.
+    /// </summary>
+    /// <remarks>
+    /// Commands can be recorded from any thread, and are played back in the order they were recorded.
+    /// When several jobs record into one buffer that order depends on timing, so systems that need a
+    /// deterministic result should give each job its own buffer and play them back in a fixed order.
+    /// Commands that refer to entities destroyed before they are played back are skipped.
+    /// Creating an entity returns a deferred entity, which can be passed to later commands in the same
+    /// buffer and refers to the created entity once the commands are played back.
+    /// Each command is stored as a struct in a list for its type, so once the lists have grown to fit
+    /// a frame's commands, recording and playback do not allocate.
+    /// </remarks>
+    public sealed class EntityCommandBuffer
+    {
+        private static int m_commandTypeCount = 0;
+
+        private readonly object m_lock = new object();
+        private readonly List<CommandRef> m_order = new List<CommandRef>();
+        private CommandList[] m_lists = new CommandList[0];
+        private Entity[] m_created = new Entity[0];
+        private int m_createdCount = 0;
+
+        /// <summary>
+        /// The number of recorded commands.
+        /// </summary>
+        public int Count
+        {
+            get
+            {
+                lock (m_lock)
+                {
+                    return m_order.Count;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Records the creation of an entity with no components.
+        /// </summary>
+        /// <returns>A deferred entity that can only be used in later commands recorded into this buffer.</returns>
+        public Entity CreateEntity()
+        {
+            lock (m_lock)
+            {
+                Record(new CreateCommand(m_createdCount));
+                return GetDeferredEntity(m_createdCount++);
+            }
+        }
+
+        /// <summary>
+        /// Records the creation of an entity with a component.
+        /// </summary>
+        /// <returns>A deferred entity that can only be used in later commands recorded into this buffer.</returns>
+        public Entity CreateEntity<T1>(T1 component1)
+            where T1 : struct
+        {
+            lock (m_lock)
+            {
+                Record(new CreateCommand<T1>(m_createdCount, component1));
+                return GetDeferredEntity(m_createdCount++);
+            }
+        }
+
+        /// <summary>
+        /// Records the creation of an entity with two components.
+        /// </summary>
+        /// <returns>A deferred entity that can only be used in later commands recorded into this buffer.</returns>
+        public Entity CreateEntity<T1, T2>(T1 component1, T2 component2)
+            where T1 : struct
+            where T2 : struct
+        {
+            lock (m_lock)
+            {
+                Record(new CreateCommand<T1, T2>(m_createdCount, component1, component2));
+                return GetDeferredEntity(m_createdCount++);
+            }
+        }
+
+        /// <summary>
+        /// Records the destruction of an entity.
+        /// </summary>
+        /// <param name="entity">The entity to destroy.</param>
+        public void DestroyEntity(Entity entity)
+        {
+            Record(new DestroyCommand(entity));
+        }
+
+        /// <summary>
+        /// Records adding a component to an entity, or setting it if the entity already has the component.
+        /// </summary>
+        /// <param name="entity">The entity to add the component to.</param>
+        /// <param name="component">The component value.</param>
+        public void AddComponent<T>(Entity entity, T component)
+            where T : struct
+        {
+            Record(new AddCommand<T>(entity, component));
+        }
+
+        /// <summary>
+        /// Records setting a component the entity has when the command is played back.
+        /// </summary>
+        /// <param name="entity">The entity to set the component on.</param>
+        /// <param name="component">The component value.</param>
+        public void SetComponent<T>(Entity entity, T component)
+            where T : struct
+        {
+            Record(new SetCommand<T>(entity, component));
+        }
+
+        /// <summary>
+        /// Records removing a component from an entity.
+        /// </summary>
+        /// <param name="entity">The entity to remove the component from.</param>
+        public void RemoveComponent<T>(Entity entity)
+            where T : struct
+        {
+            Record(new RemoveCommand<T>(entity));
+        }
+
+        /// <summary>
+        /// Makes the recorded changes to a world and clears the buffer.
+        /// </summary>
+        /// <remarks>
+        /// Threads recording commands into this buffer wait until the playback is finished.
+        /// </remarks>
+        /// <param name="world">The world to change.</param>
+        public void Playback(World world)
+        {
+            if (world == null)
+            {
+                throw new ArgumentNullException("world");
+            }
+
+            lock (m_lock)
+            {
+                try
+                {
+                    if (m_created.Length < m_createdCount)
+                    {
+                        Array.Resize(ref m_created, Math.Max(m_createdCount, m_created.Length * 2));
+                    }
+
+                    for (int i = 0; i < m_order.Count; i++)
+                    {
+                        CommandRef command = m_order[i];
+                        command.list.Execute(this, world, command.index);
+                    }
+                }
+                finally
+                {
+                    ClearCommands();
+                }
+            }
+        }
+
+        /// <summary>
+        /// Removes all recorded commands without playing them back.
+        /// </summary>
+        public void Clear()
+        {
+            lock (m_lock)
+            {
+                ClearCommands();
+            }
+        }
+
+        /// <summary>
+        /// Gets the deferred entity that stands for an entity created during playback. Deferred entities
+        /// have negative indices, so they never exist in a world.
+        /// </summary>
+        /// <param name="created">The number of entities created by earlier commands.</param>
+        private static Entity GetDeferredEntity(int created)
+        {
+            return new Entity(-1 - created, 0);
+        }
+
+        /// <summary>
+        /// Gets the entity a command refers to during playback, replacing deferred entities with the
+        /// entities created for them.
+        /// </summary>
+        private Entity Resolve(Entity entity)
+        {
+            if (entity.index >= 0)
+            {
+                return entity;
+            }
+
+            int created = -1 - entity.index;
+            if (entity.generation != 0 || created >= m_createdCount)
+            {
+                throw new InvalidOperationException($"{entity} is not a deferred entity from this command buffer!");
+            }
+            return m_created[created];
+        }
+
+        /// <summary>
+        /// Stores a command in the list for its type, and remembers its place in the recorded order.
+        /// </summary>
+        private void Record<TCommand>(TCommand command)
+            where TCommand : struct, ICommand
+        {
+            lock (m_lock)
+            {
+                int id = CommandType<TCommand>.ID;
+                if (id >= m_lists.Length)
+                {
+                    Array.Resize(ref m_lists, m_commandTypeCount);
+                }
+
+                CommandList<TCommand> list = m_lists[id] as CommandList<TCommand>;
+                if (list == null)
+                {
+                    list = new CommandList<TCommand>();
+                    m_lists[id] = list;
+                }
+
+                m_order.Add(new CommandRef(list, list.Add(ref command)));
+            }
+        }
+
+        /// <summary>
+        /// Removes all recorded commands, keeping the storage for reuse. Must be called while holding the lock.
+        /// </summary>
+        private void ClearCommands()
+        {
+            foreach (CommandList list in m_lists)
+            {
+                list?.Clear();
+            }
+            m_order.Clear();
+            m_createdCount = 0;
+        }
+
+        /// <summary>
+        /// Assigns each command type the index of its list.
+        /// </summary>
+        private static class CommandType<TCommand>
+        {
+            public static readonly int ID = Interlocked.Increment(ref m_commandTypeCount) - 1;
+        }
+
+        /// <summary>
+        /// The location of a recorded command.
+        /// </summary>
+        private struct CommandRef
+        {
+            public readonly CommandList list;
+            public readonly int index;
+
+            public CommandRef(CommandList list, int index)
+            {
+                this.list = list;
+                this.index = index;
+            }
+        }
+
+        /// <summary>
+        /// Stores the recorded commands of one type.
+        /// </summary>
+        private abstract class CommandList
+        {
+            public abstract void Execute(EntityCommandBuffer buffer, World world, int index);
+            public abstract void Clear();
+        }
+
+        private sealed class CommandList<TCommand> : CommandList
+            where TCommand : struct, ICommand
+        {
+            private TCommand[] m_commands = new TCommand[4];
+            private int m_count = 0;
+
+            public int Add(ref TCommand command)
+            {
+                if (m_count == m_commands.Length)
+                {
+                    Array.Resize(ref m_commands, m_count * 2);
+                }
+                m_commands[m_count] = command;
+                return m_count++;
+            }
+
+            public override void Execute(EntityCommandBuffer buffer, World world, int index)
+            {
+                m_commands[index].Execute(buffer, world);
+            }
+
+            public override void Clear()
+            {
+                // the commands may hold references in their component values
+                Array.Clear(m_commands, 0, m_count);
+                m_count = 0;
+            }
+        }
+
+        private interface ICommand
+        {
+            void Execute(EntityCommandBuffer buffer, World world);
+        }
+
+        private struct CreateCommand : ICommand
+        {
+            private readonly int m_created;
+
+            public CreateCommand(int created)
+            {
+                m_created = created;
+            }
+
+            public void Execute(EntityCommandBuffer buffer, World world)
+            {
+                buffer.m_created[m_created] = world.CreateEntity();
+            }
+        }
+
+        private struct CreateCommand<T1> : ICommand
+            where T1 : struct
+        {
+            private readonly int m_created;
+            private readonly T1 m_component1;
+
+            public CreateCommand(int created, T1 component1)
+            {
+                m_created = created;
+                m_component1 = component1;
+            }
+
+            public void Execute(EntityCommandBuffer buffer, World world)
+            {
+                buffer.m_created[m_created] = world.CreateEntity(m_component1);
+            }
+        }
+
+        private struct CreateCommand<T1, T2> : ICommand
+            where T1 : struct
+            where T2 : struct
+        {
+            private readonly int m_created;
+            private readonly T1 m_component1;
+            private readonly T2 m_component2;
+
+            public CreateCommand(int created, T1 component1, T2 component2)
+            {
+                m_created = created;
+                m_component1 = component1;
+                m_component2 = component2;
+            }
+
+            public void Execute(EntityCommandBuffer buffer, World world)
+            {
+                buffer.m_created[m_created] = world.CreateEntity(m_component1, m_component2);
+            }
+        }
+
+        private struct DestroyCommand : ICommand
+        {
+            private readonly Entity m_entity;
+
+            public DestroyCommand(Entity entity)
+            {
+                m_entity = entity;
+            }
+
+            public void Execute(EntityCommandBuffer buffer, World world)
+            {
+                Entity entity = buffer.Resolve(m_entity);
+                if (world.Exists(entity))
+                {
+                    world.DestroyEntity(entity);
+                }
+            }
+        }
+
+        private struct AddCommand<T> : ICommand
+            where T : struct
+        {
+            private readonly Entity m_entity;
+            private readonly T m_component;
+
+            public AddCommand(Entity entity, T component)
+            {
+                m_entity = entity;
+                m_component = component;
+            }
+
+            public void Execute(EntityCommandBuffer buffer, World world)
+            {
+                Entity entity = buffer.Resolve(m_entity);
+                if (world.Exists(entity))
+                {
+                    world.AddComponent(entity, m_component);
+                }
+            }
+        }
+
+        private struct SetCommand<T> : ICommand
+            where T : struct
+        {
+            private readonly Entity m_entity;
+            private readonly T m_component;
+
+            public SetCommand(Entity entity, T component)
+            {
+                m_entity = entity;
+                m_component = component;
+            }
+
+            public void Execute(EntityCommandBuffer buffer, World world)
+            {
+                Entity entity = buffer.Resolve(m_entity);
+                if (world.Exists(entity))
+                {
+                    world.SetComponent(entity, m_component);
+                }
+            }
+        }
+
+        private struct RemoveCommand<T> : ICommand
+            where T : struct
+        {
+            private readonly Entity m_entity;
+
+            public RemoveCommand(Entity entity)
+            {
+                m_entity = entity;
+            }
+
+            public void Execute(EntityCommandBuffer buffer, World world)
+            {
+                Entity entity = buffer.Resolve(m_entity);
+                if (world.Exists(entity))
+                {
+                    world.RemoveComponent<T>(entity);
+                }
+            }
+        }
+    }
+}
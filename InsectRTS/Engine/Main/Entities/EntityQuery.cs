@@ -0,0 +1,291 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Collections.Generic;
+using Engine.Jobs;
+
+namespace Engine.Entities
+{
+    /// <summary>
+    /// Iterates over all entities in a <see cref="World"/> that have a set of components.
+    /// </summary>
+    /// <remarks>
+    /// Entities are visited chunk by chunk, so each component array is read linearly, and iterating on the
+    /// calling thread does not allocate. Structural changes are not allowed while a query is iterating, including while a
+    /// scheduled iteration is running.
+    /// </remarks>
+    public sealed class EntityQuery
+    {
+        private readonly World m_world;
+        private readonly int[] m_componentTypes;
+        private readonly List<Archetype> m_archetypes = new List<Archetype>();
+        private int m_checkedArchetypeCount = 0;
+
+        // reused by each scheduled iteration so that scheduling only allocates the jobs
+        private readonly Action<int, int> m_processChunks;
+        private readonly Action m_endScheduled;
+        private Chunk[] m_chunks = new Chunk[0];
+        private int m_chunkCount = 0;
+        private ChunkAction m_scheduledAction;
+
+        internal EntityQuery(World world, int[] componentTypes)
+        {
+            m_world = world;
+            m_componentTypes = componentTypes;
+            m_processChunks = ProcessChunks;
+            m_endScheduled = EndScheduled;
+        }
+
+        /// <summary>
+        /// Counts the entities matching the query.
+        /// </summary>
+        public int CalculateEntityCount()
+        {
+            int count = 0;
+            foreach (Archetype archetype in GetArchetypes())
+            {
+                count += archetype.EntityCount;
+            }
+            return count;
+        }
+
+        /// <summary>
+        /// Runs an action on each chunk of matching entities.
+        /// </summary>
+        /// <param name="action">The action to run.</param>
+        public void ForEachChunk(ChunkAction action)
+        {
+            if (action == null)
+            {
+                throw new ArgumentNullException("action");
+            }
+
+            m_world.BeginIteration();
+            try
+            {
+                foreach (Archetype archetype in GetArchetypes())
+                {
+                    foreach (Chunk chunk in archetype.Chunks)
+                    {
+                        action(chunk);
+                    }
+                }
+            }
+            finally
+            {
+                m_world.EndIteration();
+            }
+        }
+
+        /// <summary>
+        /// Runs an action on the components of each matching entity.
+        /// </summary>
+        /// <param name="action">The action to run.</param>
+        public void ForEach<T1>(ComponentAction<T1> action)
+            where T1 : struct
+        {
+            if (action == null)
+            {
+                throw new ArgumentNullException("action");
+            }
+
+            m_world.BeginIteration();
+            try
+            {
+                foreach (Archetype archetype in GetArchetypes())
+                {
+                    foreach (Chunk chunk in archetype.Chunks)
+                    {
+                        T1[] components1 = chunk.GetComponents<T1>();
+                        int count = chunk.Count;
+
+                        for (int i = 0; i < count; i++)
+                        {
+                            action(ref components1[i]);
+                        }
+                    }
+                }
+            }
+            finally
+            {
+                m_world.EndIteration();
+            }
+        }
+
+        /// <summary>
+        /// Runs an action on the components of each matching entity.
+        /// </summary>
+        /// <param name="action">The action to run.</param>
+        public void ForEach<T1, T2>(ComponentAction<T1, T2> action)
+            where T1 : struct
+            where T2 : struct
+        {
+            if (action == null)
+            {
+                throw new ArgumentNullException("action");
+            }
+
+            m_world.BeginIteration();
+            try
+            {
+                foreach (Archetype archetype in GetArchetypes())
+                {
+                    foreach (Chunk chunk in archetype.Chunks)
+                    {
+                        T1[] components1 = chunk.GetComponents<T1>();
+                        T2[] components2 = chunk.GetComponents<T2>();
+                        int count = chunk.Count;
+
+                        for (int i = 0; i < count; i++)
+                        {
+                            action(ref components1[i], ref components2[i]);
+                        }
+                    }
+                }
+            }
+            finally
+            {
+                m_world.EndIteration();
+            }
+        }
+
+        /// <summary>
+        /// Runs an action on the components of each matching entity.
+        /// </summary>
+        /// <param name="action">The action to run.</param>
+        public void ForEach<T1, T2, T3>(ComponentAction<T1, T2, T3> action)
+            where T1 : struct
+            where T2 : struct
+            where T3 : struct
+        {
+            if (action == null)
+            {
+                throw new ArgumentNullException("action");
+            }
+
+            m_world.BeginIteration();
+            try
+            {
+                foreach (Archetype archetype in GetArchetypes())
+                {
+                    foreach (Chunk chunk in archetype.Chunks)
+                    {
+                        T1[] components1 = chunk.GetComponents<T1>();
+                        T2[] components2 = chunk.GetComponents<T2>();
+                        T3[] components3 = chunk.GetComponents<T3>();
+                        int count = chunk.Count;
+
+                        for (int i = 0; i < count; i++)
+                        {
+                            action(ref components1[i], ref components2[i], ref components3[i]);
+                        }
+                    }
+                }
+            }
+            finally
+            {
+                m_world.EndIteration();
+            }
+        }
+
+        /// <summary>
+        /// Schedules jobs that run an action on each chunk of matching entities, with the chunks split
+        /// between worker threads. Each chunk is only processed by one thread at a time.
+        /// </summary>
+        /// <remarks>
+        /// The chunks are gathered when this is called, so no structural changes may be made until the
+        /// returned job has completed. A query can only have one scheduled iteration at a time.
+        /// </remarks>
+        /// <param name="scheduler">The scheduler to run the jobs on.</param>
+        /// <param name="action">The action to run.</param>
+        /// <param name="dependsOn">A job that must complete before the chunks are processed.</param>
+        /// <returns>A handle to the scheduled jobs.</returns>
+        /// <exception cref="InvalidOperationException">Thrown if an iteration scheduled by this query has
+        /// not completed.</exception>
+        public JobHandle ScheduleParallel(JobScheduler scheduler, ChunkAction action, JobHandle dependsOn = default(JobHandle))
+        {
+            if (scheduler == null)
+            {
+                throw new ArgumentNullException("scheduler");
+            }
+            if (action == null)
+            {
+                throw new ArgumentNullException("action");
+            }
+
+            if (m_scheduledAction != null)
+            {
+                throw new InvalidOperationException("Can't schedule a query that is already scheduled!");
+            }
+
+            List<Archetype> archetypes = GetArchetypes();
+
+            int chunkCount = 0;
+            foreach (Archetype archetype in archetypes)
+            {
+                chunkCount += archetype.Chunks.Count;
+            }
+            if (m_chunks.Length < chunkCount)
+            {
+                m_chunks = new Chunk[Math.Max(chunkCount, m_chunks.Length * 2)];
+            }
+
+            m_chunkCount = 0;
+            foreach (Archetype archetype in archetypes)
+            {
+                archetype.Chunks.CopyTo(m_chunks, m_chunkCount);
+                m_chunkCount += archetype.Chunks.Count;
+            }
+            m_scheduledAction = action;
+
+            m_world.BeginIteration();
+
+            JobHandle handle = scheduler.ParallelForBatch(m_chunkCount, m_processChunks, dependsOn);
+            return scheduler.Schedule(m_endScheduled, handle);
+        }
+
+        /// <summary>
+        /// Runs the scheduled action on a batch of the gathered chunks.
+        /// </summary>
+        private void ProcessChunks(int start, int end)
+        {
+            for (int i = start; i < end; i++)
+            {
+                m_scheduledAction(m_chunks[i]);
+            }
+        }
+
+        /// <summary>
+        /// Finishes a scheduled iteration, allowing structural changes and another iteration to be scheduled.
+        /// </summary>
+        private void EndScheduled()
+        {
+            // don't keep chunks that may be removed from the world alive
+            Array.Clear(m_chunks, 0, m_chunkCount);
+            m_chunkCount = 0;
+            m_scheduledAction = null;
+
+            m_world.EndIteration();
+        }
+
+        /// <summary>
+        /// Gets the archetypes matching the query, checking any archetypes created since the last call.
+        /// </summary>
+        private List<Archetype> GetArchetypes()
+        {
+            List<Archetype> archetypes = m_world.Archetypes;
+
+            for (; m_checkedArchetypeCount < archetypes.Count; m_checkedArchetypeCount++)
+            {
+                Archetype archetype = archetypes[m_checkedArchetypeCount];
+                if (archetype.HasAll(m_componentTypes))
+                {
+                    m_archetypes.Add(archetype);
+                }
+            }
+            return m_archetypes;
+        }
+    }
+}
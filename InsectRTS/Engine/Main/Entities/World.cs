@@ -0,0 +1,458 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Collections.Generic;
+using System.Threading;
+
+namespace Engine.Entities
+{
+    /// <summary>
+    /// Stores entities and their components, grouped by archetype.
+    /// </summary>
+    /// <remarks>
+    /// Structural changes, meaning creating or destroying entities or adding or removing components,
+    /// must be made from a single thread and not while a query is iterating over the world. Record them
+    /// in an <see cref="EntityCommandBuffer"/> to make them from a query or from jobs.
+    /// </remarks>
+    public sealed class World
+    {
+        private const int INITIAL_CAPACITY = 1024;
+
+        /// <summary>
+        /// Where an entity is stored.
+        /// </summary>
+        private struct EntityRecord
+        {
+            public Chunk chunk;
+            public int index;
+            public int generation;
+        }
+
+        private readonly Dictionary<int[], Archetype> m_archetypeLookup = new Dictionary<int[], Archetype>(new ComponentSetComparer());
+        private readonly List<Archetype> m_archetypes = new List<Archetype>();
+        private readonly Archetype m_emptyArchetype;
+        private readonly Queue<int> m_freeIndices = new Queue<int>();
+        private EntityRecord[] m_records = new EntityRecord[INITIAL_CAPACITY];
+        private int m_recordCount = 0;
+        private int m_entityCount = 0;
+        private int m_iterationCount = 0;
+
+        /// <summary>
+        /// The number of entities in the world.
+        /// </summary>
+        public int EntityCount => m_entityCount;
+
+        /// <summary>
+        /// All archetypes created so far. Archetypes are never removed, so queries only need to check
+        /// archetypes past the ones they have already seen.
+        /// </summary>
+        internal List<Archetype> Archetypes => m_archetypes;
+
+        /// <summary>
+        /// Creates a new world.
+        /// </summary>
+        public World()
+        {
+            m_emptyArchetype = GetOrCreateArchetype(new int[0]);
+        }
+
+        /// <summary>
+        /// Creates an entity with no components.
+        /// </summary>
+        public Entity CreateEntity()
+        {
+            return CreateEntity(m_emptyArchetype);
+        }
+
+        /// <summary>
+        /// Creates an entity with a component.
+        /// </summary>
+        public Entity CreateEntity<T1>(T1 component1)
+            where T1 : struct
+        {
+            Archetype archetype = GetArchetypeWith(m_emptyArchetype, ComponentType<T1>.ID);
+
+            Entity entity = CreateEntity(archetype);
+            ref EntityRecord record = ref m_records[entity.index];
+            record.chunk.GetComponents<T1>()[record.index] = component1;
+            return entity;
+        }
+
+        /// <summary>
+        /// Creates an entity with two components.
+        /// </summary>
+        public Entity CreateEntity<T1, T2>(T1 component1, T2 component2)
+            where T1 : struct
+            where T2 : struct
+        {
+            Archetype archetype = GetArchetypeWith(m_emptyArchetype, ComponentType<T1>.ID);
+            archetype = GetArchetypeWith(archetype, ComponentType<T2>.ID);
+
+            Entity entity = CreateEntity(archetype);
+            ref EntityRecord record = ref m_records[entity.index];
+            record.chunk.GetComponents<T1>()[record.index] = component1;
+            record.chunk.GetComponents<T2>()[record.index] = component2;
+            return entity;
+        }
+
+        /// <summary>
+        /// Creates an entity with three components.
+        /// </summary>
+        public Entity CreateEntity<T1, T2, T3>(T1 component1, T2 component2, T3 component3)
+            where T1 : struct
+            where T2 : struct
+            where T3 : struct
+        {
+            Archetype archetype = GetArchetypeWith(m_emptyArchetype, ComponentType<T1>.ID);
+            archetype = GetArchetypeWith(archetype, ComponentType<T2>.ID);
+            archetype = GetArchetypeWith(archetype, ComponentType<T3>.ID);
+
+            Entity entity = CreateEntity(archetype);
+            ref EntityRecord record = ref m_records[entity.index];
+            record.chunk.GetComponents<T1>()[record.index] = component1;
+            record.chunk.GetComponents<T2>()[record.index] = component2;
+            record.chunk.GetComponents<T3>()[record.index] = component3;
+            return entity;
+        }
+
+        private Entity CreateEntity(Archetype archetype)
+        {
+            ValidateStructuralChange();
+
+            int index;
+            if (m_freeIndices.Count > 0)
+            {
+                index = m_freeIndices.Dequeue();
+            }
+            else
+            {
+                if (m_recordCount == m_records.Length)
+                {
+                    Array.Resize(ref m_records, m_records.Length * 2);
+                }
+
+                index = m_recordCount++;
+                m_records[index].generation = 1;
+            }
+
+            ref EntityRecord record = ref m_records[index];
+            Entity entity = new Entity(index, record.generation);
+
+            record.chunk = archetype.Add(entity, out record.index);
+            m_entityCount++;
+            return entity;
+        }
+
+        /// <summary>
+        /// Destroys an entity. The entity's index may be reused by entities created later.
+        /// </summary>
+        /// <param name="entity">The entity to destroy.</param>
+        /// <exception cref="ArgumentException">Thrown if the entity does not exist.</exception>
+        public void DestroyEntity(Entity entity)
+        {
+            ValidateStructuralChange();
+
+            ref EntityRecord record = ref GetRecord(entity);
+            Chunk chunk = record.chunk;
+
+            Entity moved = chunk.Archetype.Remove(chunk, record.index);
+            if (moved != Entity.Null)
+            {
+                m_records[moved.index].chunk = chunk;
+                m_records[moved.index].index = record.index;
+            }
+
+            record.chunk = null;
+            record.generation++;
+            m_freeIndices.Enqueue(entity.index);
+            m_entityCount--;
+        }
+
+        /// <summary>
+        /// Checks if an entity exists.
+        /// </summary>
+        /// <param name="entity">The entity to check.</param>
+        /// <returns>False if the entity was destroyed or never existed.</returns>
+        public bool Exists(Entity entity)
+        {
+            return
+                entity.index >= 0 &&
+                entity.index < m_recordCount &&
+                m_records[entity.index].generation == entity.generation &&
+                m_records[entity.index].chunk != null;
+        }
+
+        /// <summary>
+        /// Checks if an entity has a component.
+        /// </summary>
+        /// <typeparam name="T">The component type.</typeparam>
+        /// <param name="entity">The entity to check.</param>
+        /// <exception cref="ArgumentException">Thrown if the entity does not exist.</exception>
+        public bool HasComponent<T>(Entity entity) where T : struct
+        {
+            return GetRecord(entity).chunk.HasComponent<T>();
+        }
+
+        /// <summary>
+        /// Gets a reference to a component of an entity. The reference must not be used after any
+        /// structural change to the world.
+        /// </summary>
+        /// <typeparam name="T">The component type.</typeparam>
+        /// <param name="entity">The entity to get the component from.</param>
+        /// <exception cref="ArgumentException">Thrown if the entity does not exist.</exception>
+        /// <exception cref="InvalidOperationException">Thrown if the entity doesn't have the component.</exception>
+        public ref T GetComponent<T>(Entity entity) where T : struct
+        {
+            ref EntityRecord record = ref GetRecord(entity);
+            return ref record.chunk.GetComponents<T>()[record.index];
+        }
+
+        /// <summary>
+        /// Sets the value of a component the entity already has.
+        /// </summary>
+        /// <typeparam name="T">The component type.</typeparam>
+        /// <param name="entity">The entity to set the component on.</param>
+        /// <param name="component">The new component value.</param>
+        /// <exception cref="ArgumentException">Thrown if the entity does not exist.</exception>
+        /// <exception cref="InvalidOperationException">Thrown if the entity doesn't have the component.</exception>
+        public void SetComponent<T>(Entity entity, T component) where T : struct
+        {
+            GetComponent<T>(entity) = component;
+        }
+
+        /// <summary>
+        /// Adds a component to an entity, moving the entity to a new archetype. If the entity already has
+        /// the component, its value is set instead.
+        /// </summary>
+        /// <typeparam name="T">The component type.</typeparam>
+        /// <param name="entity">The entity to add the component to.</param>
+        /// <param name="component">The component value.</param>
+        /// <exception cref="ArgumentException">Thrown if the entity does not exist.</exception>
+        public void AddComponent<T>(Entity entity, T component) where T : struct
+        {
+            Archetype archetype = GetRecord(entity).chunk.Archetype;
+            int type = ComponentType<T>.ID;
+
+            if (archetype.GetColumn(type) < 0)
+            {
+                MoveEntity(entity, GetArchetypeWith(archetype, type));
+            }
+            GetComponent<T>(entity) = component;
+        }
+
+        /// <summary>
+        /// Removes a component from an entity, moving the entity to a new archetype. Does nothing if the
+        /// entity doesn't have the component.
+        /// </summary>
+        /// <typeparam name="T">The component type.</typeparam>
+        /// <param name="entity">The entity to remove the component from.</param>
+        /// <exception cref="ArgumentException">Thrown if the entity does not exist.</exception>
+        public void RemoveComponent<T>(Entity entity) where T : struct
+        {
+            Archetype archetype = GetRecord(entity).chunk.Archetype;
+            int type = ComponentType<T>.ID;
+
+            if (archetype.GetColumn(type) >= 0)
+            {
+                MoveEntity(entity, GetArchetypeWithout(archetype, type));
+            }
+        }
+
+        /// <summary>
+        /// Creates a query over all entities with a component.
+        /// </summary>
+        public EntityQuery CreateQuery<T1>()
+            where T1 : struct
+        {
+            return new EntityQuery(this, new int[] { ComponentType<T1>.ID });
+        }
+
+        /// <summary>
+        /// Creates a query over all entities with two components.
+        /// </summary>
+        public EntityQuery CreateQuery<T1, T2>()
+            where T1 : struct
+            where T2 : struct
+        {
+            return new EntityQuery(this, new int[] { ComponentType<T1>.ID, ComponentType<T2>.ID });
+        }
+
+        /// <summary>
+        /// Creates a query over all entities with three components.
+        /// </summary>
+        public EntityQuery CreateQuery<T1, T2, T3>()
+            where T1 : struct
+            where T2 : struct
+            where T3 : struct
+        {
+            return new EntityQuery(this, new int[] { ComponentType<T1>.ID, ComponentType<T2>.ID, ComponentType<T3>.ID });
+        }
+
+        /// <summary>
+        /// Marks the start of an iteration over the world, during which structural changes are not allowed.
+        /// </summary>
+        internal void BeginIteration()
+        {
+            Interlocked.Increment(ref m_iterationCount);
+        }
+
+        /// <summary>
+        /// Marks the end of an iteration over the world.
+        /// </summary>
+        internal void EndIteration()
+        {
+            Interlocked.Decrement(ref m_iterationCount);
+        }
+
+        private void ValidateStructuralChange()
+        {
+            if (Volatile.Read(ref m_iterationCount) > 0)
+            {
+                throw new InvalidOperationException("Can't make structural changes while iterating over the world! Use an EntityCommandBuffer instead.");
+            }
+        }
+
+        private ref EntityRecord GetRecord(Entity entity)
+        {
+            if (!Exists(entity))
+            {
+                throw new ArgumentException($"{entity} does not exist!", nameof(entity));
+            }
+            return ref m_records[entity.index];
+        }
+
+        /// <summary>
+        /// Moves an entity to another archetype, keeping the components both archetypes have.
+        /// </summary>
+        private void MoveEntity(Entity entity, Archetype destination)
+        {
+            ValidateStructuralChange();
+
+            ref EntityRecord record = ref m_records[entity.index];
+            Chunk source = record.chunk;
+            int sourceIndex = record.index;
+
+            Chunk target = destination.Add(entity, out int targetIndex);
+            source.CopyTo(sourceIndex, target, targetIndex);
+
+            Entity moved = source.Archetype.Remove(source, sourceIndex);
+            if (moved != Entity.Null)
+            {
+                m_records[moved.index].chunk = source;
+                m_records[moved.index].index = sourceIndex;
+            }
+
+            record.chunk = target;
+            record.index = targetIndex;
+        }
+
+        private Archetype GetArchetypeWith(Archetype archetype, int type)
+        {
+            if (!archetype.AddEdges.TryGetValue(type, out Archetype result))
+            {
+                if (archetype.GetColumn(type) >= 0)
+                {
+                    result = archetype;
+                }
+                else
+                {
+                    int[] types = archetype.ComponentTypes;
+                    int[] newTypes = new int[types.Length + 1];
+
+                    // keep the types sorted so each set of types has one key
+                    int i = 0;
+                    for (; i < types.Length && types[i] < type; i++)
+                    {
+                        newTypes[i] = types[i];
+                    }
+                    newTypes[i] = type;
+                    for (; i < types.Length; i++)
+                    {
+                        newTypes[i + 1] = types[i];
+                    }
+
+                    result = GetOrCreateArchetype(newTypes);
+                }
+                archetype.AddEdges.Add(type, result);
+            }
+            return result;
+        }
+
+        private Archetype GetArchetypeWithout(Archetype archetype, int type)
+        {
+            if (!archetype.RemoveEdges.TryGetValue(type, out Archetype result))
+            {
+                if (archetype.GetColumn(type) < 0)
+                {
+                    result = archetype;
+                }
+                else
+                {
+                    int[] types = archetype.ComponentTypes;
+                    int[] newTypes = new int[types.Length - 1];
+
+                    int j = 0;
+                    for (int i = 0; i < types.Length; i++)
+                    {
+                        if (types[i] != type)
+                        {
+                            newTypes[j++] = types[i];
+                        }
+                    }
+
+                    result = GetOrCreateArchetype(newTypes);
+                }
+                archetype.RemoveEdges.Add(type, result);
+            }
+            return result;
+        }
+
+        private Archetype GetOrCreateArchetype(int[] types)
+        {
+            if (!m_archetypeLookup.TryGetValue(types, out Archetype archetype))
+            {
+                archetype = new Archetype(types);
+                m_archetypeLookup.Add(types, archetype);
+                m_archetypes.Add(archetype);
+            }
+            return archetype;
+        }
+
+        /// <summary>
+        /// Compares sorted arrays of component type IDs by value.
+        /// </summary>
+        private class ComponentSetComparer : IEqualityComparer<int[]>
+        {
+            public bool Equals(int[] x, int[] y)
+            {
+                if (x.Length != y.Length)
+                {
+                    return false;
+                }
+                for (int i = 0; i < x.Length; i++)
+                {
+                    if (x[i] != y[i])
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            public int GetHashCode(int[] types)
+            {
+                unchecked
+                {
+                    int hashCode = types.Length;
+                    foreach (int type in types)
+                    {
+                        hashCode = (hashCode * 397) ^ type;
+                    }
+                    return hashCode;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,127 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+
+namespace Engine
+{
+    /// <summary>
+    /// Converts variable frame times into a whole number of fixed simulation steps.
+    /// </summary>
+    /// <remarks>
+    /// Frame time is added to an accumulator, and a step is taken for each full step duration in it.
+    /// The leftover time gives the interpolation alpha, how far the current time is between the last
+    /// step and the next one. If a frame needs more than the maximum number of steps, the extra time is
+    /// dropped so that a slow simulation can't make every following frame slower.
+    /// </remarks>
+    public sealed class FixedTimestep
+    {
+        private readonly double m_stepDuration;
+        private readonly int m_maxStepsPerFrame;
+        private double m_accumulator = 0;
+        private long m_stepCount = 0;
+        private double m_droppedTime = 0;
+
+        /// <summary>
+        /// The number of steps per second.
+        /// </summary>
+        public double Rate => 1.0 / m_stepDuration;
+
+        /// <summary>
+        /// The duration of a step in seconds.
+        /// </summary>
+        public double StepDuration => m_stepDuration;
+
+        /// <summary>
+        /// The maximum number of steps taken in one frame.
+        /// </summary>
+        public int MaxStepsPerFrame => m_maxStepsPerFrame;
+
+        /// <summary>
+        /// The total number of steps taken.
+        /// </summary>
+        public long StepCount => m_stepCount;
+
+        /// <summary>
+        /// The total time in seconds dropped because frames needed more than the maximum number of steps.
+        /// </summary>
+        public double DroppedTime => m_droppedTime;
+
+        /// <summary>
+        /// The fraction of a step that has passed since the last step, in the range [0, 1).
+        /// Used to interpolate between the last two simulation states when rendering.
+        /// </summary>
+        public float Alpha => (float)(m_accumulator / m_stepDuration);
+
+        /// <summary>
+        /// Gets the interpolation alpha when the last steps taken have not completed yet, such as when they
+        /// run on another thread, so the last two completed states must be interpolated between instead.
+        /// </summary>
+        /// <remarks>
+        /// This renders one step behind the completed state. The alpha is clamped to one while steps are
+        /// pending, which holds the last completed state until they complete rather than jumping back.
+        /// </remarks>
+        /// <param name="pendingSteps">The number of steps from the last call to <see cref="Advance"/> that
+        /// have not completed.</param>
+        public float GetAlpha(int pendingSteps)
+        {
+            return (float)Math.Min((m_accumulator / m_stepDuration) + pendingSteps, 1.0);
+        }
+
+        /// <summary>
+        /// Creates a new timestep.
+        /// </summary>
+        /// <param name="rate">The number of steps per second.</param>
+        /// <param name="maxStepsPerFrame">The maximum number of steps taken in one frame.</param>
+        public FixedTimestep(double rate, int maxStepsPerFrame)
+        {
+            if (!(rate > 0) || double.IsInfinity(rate))
+            {
+                throw new ArgumentOutOfRangeException(nameof(rate), rate, "Must be greater than zero!");
+            }
+            if (maxStepsPerFrame < 1)
+            {
+                throw new ArgumentOutOfRangeException(nameof(maxStepsPerFrame), maxStepsPerFrame, "Must be greater than zero!");
+            }
+
+            m_stepDuration = 1.0 / rate;
+            m_maxStepsPerFrame = maxStepsPerFrame;
+        }
+
+        /// <summary>
+        /// Advances time by a frame.
+        /// </summary>
+        /// <param name="elapsed">The time since the last frame in seconds.</param>
+        /// <returns>The number of steps to take this frame.</returns>
+        public int Advance(double elapsed)
+        {
+            m_accumulator += Math.Max(elapsed, 0.0);
+
+            int steps = (int)Math.Min(Math.Floor(m_accumulator / m_stepDuration), m_maxStepsPerFrame);
+            m_accumulator -= steps * m_stepDuration;
+
+            if (m_accumulator >= m_stepDuration)
+            {
+                // the simulation has fallen behind, keep only the fraction of a step
+                double remainder = m_accumulator % m_stepDuration;
+                m_droppedTime += m_accumulator - remainder;
+                m_accumulator = remainder;
+            }
+
+            // guard against rounding leaving the accumulator slightly negative
+            m_accumulator = Math.Max(m_accumulator, 0.0);
+
+            m_stepCount += steps;
+            return steps;
+        }
+
+        /// <summary>
+        /// Clears the accumulated time, such as after loading, so the time spent isn't caught up.
+        /// </summary>
+        public void Reset()
+        {
+            m_accumulator = 0;
+        }
+    }
+}
@@ -0,0 +1,32 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+
+namespace Engine.Jobs
+{
+    /// <summary>
+    /// A job that invokes a delegate.
+    /// </summary>
+    internal sealed class ActionJob : Job
+    {
+        private readonly Action m_action;
+
+        /// <summary>
+        /// Creates a new job.
+        /// </summary>
+        /// <param name="scheduler">The scheduler that runs this job.</param>
+        /// <param name="action">The work to do. May be null for jobs that only group dependencies.</param>
+        /// <param name="isMainThreadOnly">If true the job is only run on the main thread.</param>
+        public ActionJob(JobScheduler scheduler, Action action, bool isMainThreadOnly) : base(scheduler, null, isMainThreadOnly)
+        {
+            m_action = action;
+        }
+
+        protected override void Run()
+        {
+            m_action?.Invoke();
+        }
+    }
+}
@@ -0,0 +1,222 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Collections.Generic;
+using System.Threading;
+
+namespace Engine.Jobs
+{
+    /// <summary>
+    /// A unit of work run by a <see cref="JobScheduler"/>.
+    /// </summary>
+    /// <remarks>
+    /// A job is queued once all of its dependencies have completed, and completes once it has run
+    /// and all of its child jobs have completed. Both counts start at one so that a job can't be
+    /// queued or completed while it is still being set up.
+    /// <para>
+    /// As with tasks, exceptions thrown by a job are kept by it and rethrown to whoever completes its
+    /// handle. They are also passed on to its parent and to the jobs that depend on it. Like a task
+    /// continuation, a job with a failed dependency still runs, so jobs that clean up after others are
+    /// not skipped, but it completes with the dependency's exceptions.
+    /// </para>
+    /// </remarks>
+    internal abstract class Job
+    {
+        private readonly JobScheduler m_scheduler;
+        private readonly Job m_parent;
+        private readonly bool m_isMainThreadOnly;
+        private int m_unfinishedCount = 1;
+        private int m_dependencyCount = 1;
+        private List<Job> m_continuations;
+        private List<Exception> m_exceptions;
+        private volatile bool m_isCompleted;
+
+        /// <summary>
+        /// The scheduler that runs this job.
+        /// </summary>
+        public JobScheduler Scheduler => m_scheduler;
+
+        /// <summary>
+        /// Indicates if this job must be run on the main thread.
+        /// </summary>
+        public bool IsMainThreadOnly => m_isMainThreadOnly;
+
+        /// <summary>
+        /// Indicates if this job and all of its children have finished running.
+        /// </summary>
+        public bool IsCompleted => m_isCompleted;
+
+        /// <summary>
+        /// Indicates if this job, one of its children, or one of its dependencies threw an exception.
+        /// Only final once the job has completed.
+        /// </summary>
+        public bool IsFaulted => Volatile.Read(ref m_exceptions) != null;
+
+        /// <summary>
+        /// Creates a new job.
+        /// </summary>
+        /// <param name="scheduler">The scheduler that runs this job.</param>
+        /// <param name="parent">A job that will not complete until this job has completed.</param>
+        /// <param name="isMainThreadOnly">If true the job is only run on the main thread.</param>
+        protected Job(JobScheduler scheduler, Job parent, bool isMainThreadOnly)
+        {
+            m_scheduler = scheduler;
+            m_parent = parent;
+            m_isMainThreadOnly = isMainThreadOnly;
+
+            if (parent != null)
+            {
+                Interlocked.Increment(ref parent.m_unfinishedCount);
+            }
+        }
+
+        /// <summary>
+        /// Does the work of the job.
+        /// </summary>
+        protected abstract void Run();
+
+        /// <summary>
+        /// Runs the job and completes it if it has no unfinished children.
+        /// </summary>
+        public void Execute()
+        {
+            using (Profiler.Sample("Job"))
+            {
+                try
+                {
+                    Run();
+                }
+                catch (Exception e)
+                {
+                    AddException(e);
+                }
+            }
+            Finish();
+        }
+
+        /// <summary>
+        /// Throws the exceptions of this job, its children and its dependencies, if there were any.
+        /// Must be called once the job has completed.
+        /// </summary>
+        /// <exception cref="AggregateException">Thrown if any of the jobs threw an exception.</exception>
+        public void ThrowIfFaulted()
+        {
+            if (m_exceptions != null)
+            {
+                AggregateException exception;
+                lock (this)
+                {
+                    exception = new AggregateException(m_exceptions);
+                }
+                throw exception;
+            }
+        }
+
+        /// <summary>
+        /// Prevents this job from being queued until another job has completed.
+        /// Must be called before <see cref="Submit"/>.
+        /// </summary>
+        /// <param name="dependency">The job to wait for.</param>
+        public void AddDependency(Job dependency)
+        {
+            Interlocked.Increment(ref m_dependencyCount);
+
+            // jobs are internal, so nothing else can take this lock
+            lock (dependency)
+            {
+                if (!dependency.m_isCompleted)
+                {
+                    if (dependency.m_continuations == null)
+                    {
+                        dependency.m_continuations = new List<Job>();
+                    }
+                    dependency.m_continuations.Add(this);
+                    return;
+                }
+            }
+            AddExceptions(dependency);
+            DependencyCompleted();
+        }
+
+        /// <summary>
+        /// Marks the job as set up, queueing it once all dependencies have completed.
+        /// </summary>
+        public void Submit()
+        {
+            DependencyCompleted();
+        }
+
+        private void DependencyCompleted()
+        {
+            if (Interlocked.Decrement(ref m_dependencyCount) == 0)
+            {
+                m_scheduler.Enqueue(this);
+            }
+        }
+
+        private void Finish()
+        {
+            if (Interlocked.Decrement(ref m_unfinishedCount) != 0)
+            {
+                return;
+            }
+
+            List<Job> continuations;
+            lock (this)
+            {
+                m_isCompleted = true;
+                continuations = m_continuations;
+                m_continuations = null;
+            }
+
+            if (continuations != null)
+            {
+                foreach (Job job in continuations)
+                {
+                    job.AddExceptions(this);
+                    job.DependencyCompleted();
+                }
+            }
+
+            if (m_parent != null)
+            {
+                m_parent.AddExceptions(this);
+                m_parent.Finish();
+            }
+        }
+
+        private void AddException(Exception exception)
+        {
+            lock (this)
+            {
+                if (m_exceptions == null)
+                {
+                    m_exceptions = new List<Exception>();
+                }
+                m_exceptions.Add(exception);
+            }
+        }
+
+        /// <summary>
+        /// Takes on the exceptions of a completed job.
+        /// </summary>
+        private void AddExceptions(Job job)
+        {
+            if (job.m_exceptions == null)
+            {
+                return;
+            }
+
+            lock (this)
+            {
+                if (m_exceptions == null)
+                {
+                    m_exceptions = new List<Exception>();
+                }
+                m_exceptions.AddRange(job.m_exceptions);
+            }
+        }
+    }
+}
@@ -0,0 +1,115 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+
+namespace Engine.Jobs
+{
+    /// <summary>
+    /// Refers to a scheduled job. Handles can be used to wait for a job to complete,
+    /// or passed when scheduling other jobs to make them depend on it.
+    /// </summary>
+    /// <remarks>
+    /// The default handle refers to no job and is always completed.
+    /// </remarks>
+    public struct JobHandle
+    {
+        internal readonly Job job;
+
+        /// <summary>
+        /// Indicates if the job and all the jobs it created have finished running.
+        /// </summary>
+        public bool IsCompleted => job == null || job.IsCompleted;
+
+        /// <summary>
+        /// Indicates if the job, a job it created, or a job it depended on threw an exception.
+        /// Only final once the job has completed.
+        /// </summary>
+        public bool IsFaulted => job != null && job.IsFaulted;
+
+        internal JobHandle(Job job)
+        {
+            this.job = job;
+        }
+
+        /// <summary>
+        /// Blocks until the job has completed. The calling thread runs other jobs while waiting.
+        /// </summary>
+        /// <remarks>
+        /// If the job depends on a main thread job, this must only be called from the main thread
+        /// or the main thread must be running <see cref="JobScheduler.RunMainThreadJobs"/>.
+        /// </remarks>
+        /// <exception cref="AggregateException">Thrown if the job, a job it created, or a job it depended
+        /// on threw an exception.</exception>
+        public void Complete()
+        {
+            if (job != null)
+            {
+                if (!job.IsCompleted)
+                {
+                    job.Scheduler.WaitFor(job);
+                }
+                job.ThrowIfFaulted();
+            }
+        }
+
+        /// <summary>
+        /// Creates a handle that completes once both jobs have completed.
+        /// </summary>
+        /// <param name="a">The first job.</param>
+        /// <param name="b">The second job.</param>
+        public static JobHandle CombineDependencies(JobHandle a, JobHandle b)
+        {
+            // a completed job can only be left out if its exceptions would not be lost
+            if (a.IsCompleted && !a.IsFaulted)
+            {
+                return b;
+            }
+            if (b.IsCompleted && !b.IsFaulted)
+            {
+                return a;
+            }
+            return CombineDependencies(new JobHandle[] { a, b });
+        }
+
+        /// <summary>
+        /// Creates a handle that completes once all of the jobs have completed.
+        /// </summary>
+        /// <param name="handles">The jobs to wait for.</param>
+        public static JobHandle CombineDependencies(params JobHandle[] handles)
+        {
+            if (handles == null)
+            {
+                throw new ArgumentNullException("handles");
+            }
+
+            JobScheduler scheduler = null;
+            foreach (JobHandle handle in handles)
+            {
+                if (!handle.IsCompleted || handle.IsFaulted)
+                {
+                    scheduler = handle.job.Scheduler;
+                    break;
+                }
+            }
+
+            if (scheduler == null)
+            {
+                return default(JobHandle);
+            }
+
+            Job job = new ActionJob(scheduler, null, false);
+            foreach (JobHandle handle in handles)
+            {
+                if (handle.job != null)
+                {
+                    job.AddDependency(handle.job);
+                }
+            }
+            job.Submit();
+
+            return new JobHandle(job);
+        }
+    }
+}
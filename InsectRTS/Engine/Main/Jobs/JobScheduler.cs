@@ -0,0 +1,382 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Collections.Concurrent;
+using System.Threading;
+
+namespace Engine.Jobs
+{
+    /// <summary>
+    /// Runs jobs on a fixed pool of worker threads.
+    /// </summary>
+    /// <remarks>
+    /// Each worker owns a work-stealing deque. Jobs scheduled from a worker are pushed onto its own
+    /// deque, while jobs scheduled from other threads go to a shared queue. Idle workers take jobs from
+    /// the shared queue or steal them from other workers, and sleep once there is nothing left to do.
+    /// Threads waiting on a <see cref="JobHandle"/> run other jobs until the job they wait for completes,
+    /// so the waiting thread adds to the pool instead of blocking.
+    /// </remarks>
+    public sealed class JobScheduler : Disposable
+    {
+        /// <summary>
+        /// The number of batches per thread a parallel for is split into when no batch size is given.
+        /// Using several batches per thread lets threads that finish early steal from slower ones.
+        /// </summary>
+        private const int BATCHES_PER_THREAD = 4;
+
+        private static readonly object m_defaultLock = new object();
+        private static JobScheduler m_default;
+
+        [ThreadStatic]
+        private static Worker m_currentWorker;
+
+        /// <summary>
+        /// The scheduler used by the engine, with one worker for each processor besides the main thread's.
+        /// </summary>
+        public static JobScheduler Default
+        {
+            get
+            {
+                if (m_default == null)
+                {
+                    lock (m_defaultLock)
+                    {
+                        if (m_default == null)
+                        {
+                            m_default = new JobScheduler(Math.Max(Environment.ProcessorCount - 1, 1));
+                        }
+                    }
+                }
+                return m_default;
+            }
+        }
+
+        private readonly Worker[] m_workers;
+        private readonly ConcurrentQueue<Job> m_sharedQueue = new ConcurrentQueue<Job>();
+        private readonly ConcurrentQueue<Job> m_mainThreadQueue = new ConcurrentQueue<Job>();
+        private readonly SemaphoreSlim m_workSignal = new SemaphoreSlim(0);
+        private int m_sleepingCount = 0;
+        private volatile bool m_shutdown = false;
+
+        /// <summary>
+        /// The number of worker threads.
+        /// </summary>
+        public int WorkerCount => m_workers.Length;
+
+        /// <summary>
+        /// Creates a new scheduler and starts its worker threads.
+        /// </summary>
+        /// <param name="workerCount">The number of worker threads to create. With no workers, jobs are
+        /// only run by threads waiting on them.</param>
+        public JobScheduler(int workerCount)
+        {
+            if (workerCount < 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(workerCount), workerCount, "Must be non-negative!");
+            }
+
+            m_workers = new Worker[workerCount];
+
+            for (int i = 0; i < workerCount; i++)
+            {
+                m_workers[i] = new Worker(this, i);
+            }
+            foreach (Worker worker in m_workers)
+            {
+                worker.thread.Start();
+            }
+        }
+
+        /// <summary>
+        /// Schedules a job to run on a worker thread.
+        /// </summary>
+        /// <param name="action">The work to do.</param>
+        /// <param name="dependsOn">A job that must complete before this job is started.</param>
+        /// <returns>A handle to the scheduled job.</returns>
+        public JobHandle Schedule(Action action, JobHandle dependsOn = default(JobHandle))
+        {
+            if (action == null)
+            {
+                throw new ArgumentNullException("action");
+            }
+            return Submit(new ActionJob(this, action, false), dependsOn);
+        }
+
+        /// <summary>
+        /// Schedules a job that is only run on the main thread, such as work that makes GL calls.
+        /// </summary>
+        /// <remarks>
+        /// These jobs are run by <see cref="RunMainThreadJobs"/>, or while the main thread waits on a job.
+        /// </remarks>
+        /// <param name="action">The work to do.</param>
+        /// <param name="dependsOn">A job that must complete before this job is started.</param>
+        /// <returns>A handle to the scheduled job.</returns>
+        public JobHandle ScheduleOnMainThread(Action action, JobHandle dependsOn = default(JobHandle))
+        {
+            if (action == null)
+            {
+                throw new ArgumentNullException("action");
+            }
+            return Submit(new ActionJob(this, action, true), dependsOn);
+        }
+
+        /// <summary>
+        /// Schedules a job that runs a function for each index in a range, split into batches that are
+        /// run in parallel.
+        /// </summary>
+        /// <param name="length">The number of indices to process.</param>
+        /// <param name="body">The function to run for each index.</param>
+        /// <param name="dependsOn">A job that must complete before this job is started.</param>
+        /// <param name="batchSize">The number of indices in each batch. If zero, a batch size is picked
+        /// that gives each thread a few batches.</param>
+        /// <returns>A handle to the scheduled job.</returns>
+        public JobHandle ParallelFor(int length, Action<int> body, JobHandle dependsOn = default(JobHandle), int batchSize = 0)
+        {
+            if (body == null)
+            {
+                throw new ArgumentNullException("body");
+            }
+            return ParallelForBatch(length, (start, end) =>
+            {
+                for (int i = start; i < end; i++)
+                {
+                    body(i);
+                }
+            }, dependsOn, batchSize);
+        }
+
+        /// <summary>
+        /// Schedules a job that processes a range of indices, split into batches that are run in parallel.
+        /// </summary>
+        /// <remarks>
+        /// Prefer this to <see cref="ParallelFor"/> for cheap loop bodies, since the body is only invoked
+        /// once per batch.
+        /// </remarks>
+        /// <param name="length">The number of indices to process.</param>
+        /// <param name="body">Processes the indices from the first argument up to but excluding the second.</param>
+        /// <param name="dependsOn">A job that must complete before this job is started.</param>
+        /// <param name="batchSize">The number of indices in each batch. If zero, a batch size is picked
+        /// that gives each thread a few batches.</param>
+        /// <returns>A handle to the scheduled job.</returns>
+        public JobHandle ParallelForBatch(int length, Action<int, int> body, JobHandle dependsOn = default(JobHandle), int batchSize = 0)
+        {
+            if (body == null)
+            {
+                throw new ArgumentNullException("body");
+            }
+            if (length < 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(length), length, "Must be non-negative!");
+            }
+            if (batchSize < 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(batchSize), batchSize, "Must be non-negative!");
+            }
+
+            if (length == 0)
+            {
+                return dependsOn;
+            }
+            if (batchSize == 0)
+            {
+                // the thread that waits on the job also runs batches
+                int batchCount = (m_workers.Length + 1) * BATCHES_PER_THREAD;
+                batchSize = Math.Max((length + batchCount - 1) / batchCount, 1);
+            }
+
+            return Submit(new ParallelForJob(this, body, length, batchSize), dependsOn);
+        }
+
+        /// <summary>
+        /// Runs the main thread jobs that are ready. Jobs that become ready while this runs are
+        /// left for the next call.
+        /// </summary>
+        /// <exception cref="InvalidOperationException">Thrown if not called on the main thread.</exception>
+        public void RunMainThreadJobs()
+        {
+            Threading.EnsureMainThread();
+
+            int count = m_mainThreadQueue.Count;
+            for (int i = 0; i < count && m_mainThreadQueue.TryDequeue(out Job job); i++)
+            {
+                job.Execute();
+            }
+        }
+
+        private JobHandle Submit(Job job, JobHandle dependsOn)
+        {
+            ValidateDispose();
+
+            if (dependsOn.job != null)
+            {
+                job.AddDependency(dependsOn.job);
+            }
+            job.Submit();
+
+            return new JobHandle(job);
+        }
+
+        /// <summary>
+        /// Queues a job whose dependencies have all completed.
+        /// </summary>
+        internal void Enqueue(Job job)
+        {
+            if (job.IsMainThreadOnly)
+            {
+                m_mainThreadQueue.Enqueue(job);
+                return;
+            }
+
+            Worker worker = m_currentWorker;
+            if (worker != null && worker.scheduler == this)
+            {
+                worker.deque.Push(job);
+            }
+            else
+            {
+                m_sharedQueue.Enqueue(job);
+            }
+
+            // the fence pairs with the one in WorkerLoop, so either a worker about to sleep
+            // finds the job, or we see that it is sleeping and wake it
+            Interlocked.MemoryBarrier();
+            if (Volatile.Read(ref m_sleepingCount) > 0)
+            {
+                m_workSignal.Release();
+            }
+        }
+
+        /// <summary>
+        /// Runs other jobs until a job has completed.
+        /// </summary>
+        internal void WaitFor(Job job)
+        {
+            Worker worker = m_currentWorker;
+            if (worker != null && worker.scheduler != this)
+            {
+                worker = null;
+            }
+
+            bool isMainThread = Threading.IsOnMainThread();
+            SpinWait spinner = new SpinWait();
+
+            while (!job.IsCompleted)
+            {
+                Job other;
+                if ((isMainThread && m_mainThreadQueue.TryDequeue(out other)) || TryGetJob(worker, out other))
+                {
+                    other.Execute();
+                    spinner.Reset();
+                }
+                else
+                {
+                    spinner.SpinOnce();
+                }
+            }
+        }
+
+        private bool TryGetJob(Worker worker, out Job job)
+        {
+            if (worker != null && worker.deque.TryPop(out job))
+            {
+                return true;
+            }
+            if (m_sharedQueue.TryDequeue(out job))
+            {
+                return true;
+            }
+
+            // start at a different worker on each thread so thieves don't all contend on the same deque
+            int workerCount = m_workers.Length;
+            int start = worker != null ? worker.index + 1 : Thread.CurrentThread.ManagedThreadId;
+
+            for (int i = 0; i < workerCount; i++)
+            {
+                Worker victim = m_workers[(start + i) % workerCount];
+                if (victim != worker && victim.deque.TrySteal(out job))
+                {
+                    return true;
+                }
+            }
+
+            job = null;
+            return false;
+        }
+
+        private void WorkerLoop(Worker worker)
+        {
+            m_currentWorker = worker;
+
+            while (!m_shutdown)
+            {
+                // spin briefly before sleeping, as more work often arrives soon after running out
+                SpinWait spinner = new SpinWait();
+                Job job;
+
+                while (!TryGetJob(worker, out job) && !spinner.NextSpinWillYield)
+                {
+                    spinner.SpinOnce();
+                }
+
+                if (job == null)
+                {
+                    Interlocked.Increment(ref m_sleepingCount);
+
+                    if (!TryGetJob(worker, out job) && !m_shutdown)
+                    {
+                        m_workSignal.Wait();
+                    }
+
+                    Interlocked.Decrement(ref m_sleepingCount);
+                }
+
+                job?.Execute();
+            }
+
+            // write out any events the jobs logged on this thread before it finishes
+            Logger.FlushEvents();
+        }
+
+        protected override void OnDispose(bool disposing)
+        {
+            m_shutdown = true;
+
+            if (m_workers.Length > 0)
+            {
+                m_workSignal.Release(m_workers.Length);
+            }
+
+            if (disposing)
+            {
+                foreach (Worker worker in m_workers)
+                {
+                    worker.thread.Join();
+                }
+                m_workSignal.Dispose();
+            }
+        }
+
+        /// <summary>
+        /// The state of a worker thread.
+        /// </summary>
+        private sealed class Worker
+        {
+            public readonly JobScheduler scheduler;
+            public readonly int index;
+            public readonly WorkStealingDeque<Job> deque = new WorkStealingDeque<Job>();
+            public readonly Thread thread;
+
+            public Worker(JobScheduler scheduler, int index)
+            {
+                this.scheduler = scheduler;
+                this.index = index;
+
+                thread = new Thread(() => scheduler.WorkerLoop(this));
+                thread.Name = $"Job Worker {index}";
+                thread.IsBackground = true;
+            }
+        }
+    }
+}
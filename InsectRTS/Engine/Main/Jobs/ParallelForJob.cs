@@ -0,0 +1,66 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+
+namespace Engine.Jobs
+{
+    /// <summary>
+    /// A job that splits a range of indices into batches that are run in parallel.
+    /// </summary>
+    internal sealed class ParallelForJob : Job
+    {
+        private readonly Action<int, int> m_body;
+        private readonly int m_length;
+        private readonly int m_batchSize;
+
+        /// <summary>
+        /// Creates a new job.
+        /// </summary>
+        /// <param name="scheduler">The scheduler that runs this job.</param>
+        /// <param name="body">Processes the indices from the first argument up to but excluding the second.</param>
+        /// <param name="length">The number of indices to process.</param>
+        /// <param name="batchSize">The number of indices in each batch.</param>
+        public ParallelForJob(JobScheduler scheduler, Action<int, int> body, int length, int batchSize) : base(scheduler, null, false)
+        {
+            m_body = body;
+            m_length = length;
+            m_batchSize = batchSize;
+        }
+
+        protected override void Run()
+        {
+            // queue all but the first batch for other workers, and run the first batch here
+            for (int start = m_batchSize; start < m_length; start += m_batchSize)
+            {
+                int end = Math.Min(start + m_batchSize, m_length);
+                new BatchJob(Scheduler, this, m_body, start, end).Submit();
+            }
+
+            m_body(0, Math.Min(m_batchSize, m_length));
+        }
+
+        /// <summary>
+        /// Processes one batch of a <see cref="ParallelForJob"/>.
+        /// </summary>
+        private sealed class BatchJob : Job
+        {
+            private readonly Action<int, int> m_body;
+            private readonly int m_start;
+            private readonly int m_end;
+
+            public BatchJob(JobScheduler scheduler, Job parent, Action<int, int> body, int start, int end) : base(scheduler, parent, false)
+            {
+                m_body = body;
+                m_start = start;
+                m_end = end;
+            }
+
+            protected override void Run()
+            {
+                m_body(m_start, m_end);
+            }
+        }
+    }
+}
@@ -0,0 +1,148 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Threading;
+
+namespace Engine.Jobs
+{
+    /// <summary>
+    /// A Chase-Lev work-stealing deque. The owning thread pushes and pops items at the bottom
+    /// without contention, while other threads steal items from the top.
+    /// </summary>
+    /// <remarks>
+    /// Only the owning thread may call <see cref="Push"/> and <see cref="TryPop"/>. Any thread may call
+    /// <see cref="TrySteal"/>. The buffer grows when full, and old buffers are left untouched so a
+    /// thief reading a stale buffer still finds the item it expects.
+    /// </remarks>
+    /// <typeparam name="T">The type of the items.</typeparam>
+    internal class WorkStealingDeque<T> where T : class
+    {
+        private const int DEFAULT_CAPACITY = 256;
+
+        private volatile T[] m_buffer;
+        private long m_top;
+        private long m_bottom;
+
+        /// <summary>
+        /// An estimate of the number of items in the deque.
+        /// </summary>
+        public int Count => (int)Math.Max(0, Volatile.Read(ref m_bottom) - Volatile.Read(ref m_top));
+
+        /// <summary>
+        /// Creates a new deque.
+        /// </summary>
+        /// <param name="capacity">The initial capacity. Must be a power of two.</param>
+        public WorkStealingDeque(int capacity = DEFAULT_CAPACITY)
+        {
+            if (capacity < 2 || (capacity & (capacity - 1)) != 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(capacity), capacity, "Must be a power of two greater than one!");
+            }
+
+            m_buffer = new T[capacity];
+        }
+
+        /// <summary>
+        /// Adds an item to the bottom of the deque. Must only be called by the owning thread.
+        /// </summary>
+        /// <param name="item">The item to add.</param>
+        public void Push(T item)
+        {
+            long bottom = Volatile.Read(ref m_bottom);
+            long top = Volatile.Read(ref m_top);
+            T[] buffer = m_buffer;
+
+            if (bottom - top >= buffer.Length - 1)
+            {
+                buffer = Grow(buffer, top, bottom);
+            }
+
+            buffer[bottom & (buffer.Length - 1)] = item;
+            Volatile.Write(ref m_bottom, bottom + 1);
+        }
+
+        /// <summary>
+        /// Removes the most recently pushed item. Must only be called by the owning thread.
+        /// </summary>
+        /// <param name="item">Returns the removed item.</param>
+        /// <returns>False if the deque was empty.</returns>
+        public bool TryPop(out T item)
+        {
+            long bottom = Volatile.Read(ref m_bottom) - 1;
+            T[] buffer = m_buffer;
+
+            // a full fence is needed so that thieves see the reserved slot before we read the top
+            Interlocked.Exchange(ref m_bottom, bottom);
+            long top = Volatile.Read(ref m_top);
+
+            if (top > bottom)
+            {
+                // the deque was empty
+                Volatile.Write(ref m_bottom, bottom + 1);
+                item = null;
+                return false;
+            }
+
+            item = buffer[bottom & (buffer.Length - 1)];
+
+            if (top == bottom)
+            {
+                // this is the last item, so race any thieves for it
+                bool won = Interlocked.CompareExchange(ref m_top, top + 1, top) == top;
+                Volatile.Write(ref m_bottom, top + 1);
+
+                if (!won)
+                {
+                    item = null;
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// Removes the oldest item. May be called from any thread.
+        /// </summary>
+        /// <param name="item">Returns the removed item.</param>
+        /// <returns>False if the deque was empty or another thread took the item first.</returns>
+        public bool TrySteal(out T item)
+        {
+            long top = Volatile.Read(ref m_top);
+            Interlocked.MemoryBarrier();
+            long bottom = Volatile.Read(ref m_bottom);
+
+            if (top < bottom)
+            {
+                T[] buffer = m_buffer;
+                T candidate = buffer[top & (buffer.Length - 1)];
+
+                if (Interlocked.CompareExchange(ref m_top, top + 1, top) == top)
+                {
+                    item = candidate;
+                    return true;
+                }
+            }
+
+            item = null;
+            return false;
+        }
+
+        /// <summary>
+        /// Replaces the buffer with one twice the size.
+        /// </summary>
+        private T[] Grow(T[] buffer, long top, long bottom)
+        {
+            T[] newBuffer = new T[buffer.Length * 2];
+
+            for (long i = top; i < bottom; i++)
+            {
+                newBuffer[i & (newBuffer.Length - 1)] = buffer[i & (buffer.Length - 1)];
+            }
+
+            m_buffer = newBuffer;
+            return newBuffer;
+        }
+    }
+}
@@ -3,6 +3,9 @@
 * See "Licence.txt" for full licence.
 */
 using System;
+using System.Diagnostics;
+using System.Threading;
+using Engine.Jobs;
 using Engine.Rendering;
 
 namespace Engine
@@ -24,23 +27,71 @@ namespace Engine
         /// </summary>
         internal Window Window { get; private set; }
 
-        private static void Benchmark(Action act, int iterations)
-        {
-            for (int i = 0; i < iterations / 10; i++)
-            {
-                act.Invoke();
-            }
-            System.Diagnostics.Stopwatch sw = System.Diagnostics.Stopwatch.StartNew();
-            GC.Collect();
-            for (int i = 0; i < iterations; i++)
-            {
-                act.Invoke();
-            }
-            sw.Stop();
+        /// <summary>
+        /// The number of simulation steps per second.
+        /// </summary>
+        protected virtual double SimulationRate => 20.0;
 
-            double milliseconds = 1000.0 * ((double)sw.ElapsedTicks / System.Diagnostics.Stopwatch.Frequency);
-            Logger.Info($"{milliseconds.ToString("F2")}ms");
-        }
+        /// <summary>
+        /// The maximum number of simulation steps run in one frame. Time past this is dropped, so the
+        /// simulation slows down rather than making every frame longer trying to catch up.
+        /// </summary>
+        protected virtual int MaxStepsPerFrame => 5;
+
+        /// <summary>
+        /// If true, simulation steps run on a worker thread while the main thread renders the state
+        /// from the previous frame's steps.
+        /// </summary>
+        protected virtual bool SimulateOnWorkerThread => false;
+
+        /// <summary>
+        /// The maximum number of frames rendered per second, or zero to only be limited by vsync.
+        /// </summary>
+        protected virtual double RenderFrequency => 0.0;
+
+        /// <summary>
+        /// If true, the engine runs without a window or graphics context, such as for dedicated servers
+        /// and automated tests. By default this is enabled by passing "--headless" on the command line.
+        /// </summary>
+        protected virtual bool Headless => Array.IndexOf(Environment.GetCommandLineArgs(), HEADLESS_ARGUMENT) >= 0;
+
+        /// <summary>
+        /// The number of frames run per second in headless mode. If zero, frames run as fast as possible
+        /// and each frame takes exactly one simulation step, so the simulation runs faster than real time.
+        /// </summary>
+        protected virtual double HeadlessFrameRate => 0.0;
+
+        /// <summary>
+        /// The maximum number of bytes each frame should allocate, or a negative value to disable the check.
+        /// Frames that allocate more log a warning saying which phase allocated, see <see cref="FrameStats.AllocationBudget"/>.
+        /// </summary>
+        protected virtual long AllocationBudget => -1;
+
+        /// <summary>
+        /// The fixed simulation timestep.
+        /// </summary>
+        public FixedTimestep Timestep => m_timestep;
+
+        /// <summary>
+        /// How far the current time is between the last two simulation states passed to
+        /// <see cref="SimulationStepsCompleted"/>, from 0 to 1.
+        /// </summary>
+        public float InterpolationAlpha => m_simulateOnWorkerThread ? m_timestep.GetAlpha(m_pendingSteps) : m_timestep.Alpha;
+
+        /// <summary>
+        /// The frame timing statistics.
+        /// </summary>
+        public FrameStats FrameStats => m_frameStats;
+
+        private const string HEADLESS_ARGUMENT = "--headless";
+
+        private readonly FixedTimestep m_timestep;
+        private readonly FrameStats m_frameStats = new FrameStats();
+        private readonly bool m_simulateOnWorkerThread;
+        private readonly Action m_runSimulation;
+        private JobHandle m_simulation;
+        private int m_pendingSteps;
+        private volatile bool m_exitRequested = false;
 
         public Main()
         {
@@ -52,6 +103,12 @@ namespace Engine
 
             // configure the main thread
             Threading.SetMainThread();
+
+            // configure the simulation
+            m_timestep = new FixedTimestep(SimulationRate, MaxStepsPerFrame);
+            m_simulateOnWorkerThread = SimulateOnWorkerThread;
+            m_runSimulation = RunSimulation;
+            m_frameStats.AllocationBudget = AllocationBudget;
             
             Matrix m = Matrix.CreateFromAxisAngle(Random.GetVector3(), Random.Value * Mathf.Tau);
             m.Decompose(out Vector3 position, out Quaternion rotation, out Vector3 scale);
@@ -69,18 +126,6 @@ namespace Engine
             Logger.Info(rotation * vec);
             Logger.Info(Matrix.CreateFromQuaternion(rotation));
 
-            //Logger.Info(mat);
-            //Matrix.InvertPrecise(ref mat, out mat);
-            //Logger.Info(mat);
-            //Matrix.InvertPrecise(ref mat, out mat);
-            //Logger.Info(mat);
-
-            //Benchmark(() => Matrix.Invert(ref mat, out mat), 10000000);
-            //Benchmark(() => Matrix.InvertPrecise(ref mat, out mat), 10000000);
-            //Benchmark(() => Matrix.Invert(ref mat, out mat), 10000000);
-            //Benchmark(() => Matrix.InvertPrecise(ref mat, out mat), 10000000);
-            //Logger.Info(mat);
-
             //Quaternion q1 = Quaternion.FromEuler(15.0f * Mathf.DegToRad, 25.0f * Mathf.DegToRad, 90.0f * Mathf.DegToRad);
             //Quaternion q1 = Quaternion.FromAxisAngle(Vector3.Up, 0f * Mathf.DegToRad);
             //Quaternion q2 = Quaternion.FromAxisAngle(Vector3.Up, 0f * Mathf.DegToRad);
@@ -99,19 +144,126 @@ namespace Engine
             string platform = Environment.Is64BitOperatingSystem ? "x64" : "x86";
             string process = Environment.Is64BitProcess ? "x64" : "x86";
             Logger.Info($"Running as {process} on {os} {platform}");
+            Logger.Info($"Using {JobScheduler.Default.WorkerCount} job worker threads");
 
-            // create the game window
-            Window window = new Window(new OpenGLContext(), 1280, 720, Name);
-            window.UpdateFrame += UpdateFrame;
+            if (Headless)
+            {
+                RunHeadless();
+            }
+            else
+            {
+                // create the game window
+                Window = new Window(new OpenGLContext(), m_frameStats, 1280, 720, Name, RenderFrequency);
+                Window.UpdateFrame += UpdateFrame;
+                Window.RenderFrame += RenderFrame;
+
+                Window.Run();
+            }
+
+            // write out the events logged by the main thread
+            Logger.FlushEvents();
+        }
 
-            window.Run();
+        /// <summary>
+        /// Stops the update loop, closing the window if there is one. Must be called from the main thread.
+        /// </summary>
+        public void Exit()
+        {
+            m_exitRequested = true;
+            Window?.Exit();
+        }
+
+        /// <summary>
+        /// Runs the update loop without creating a window or graphics context until <see cref="Exit"/> is called.
+        /// </summary>
+        private void RunHeadless()
+        {
+            double frameRate = HeadlessFrameRate;
+            double frameDuration = frameRate > 0 ? 1.0 / frameRate : 0.0;
+
+            Logger.Info($"Running headless at {(frameRate > 0 ? $"{frameRate:0.##} frames per second" : "an unthrottled frame rate")}");
+
+            Stopwatch stopwatch = Stopwatch.StartNew();
+            double lastFrameTime = 0.0;
+
+            while (!m_exitRequested)
+            {
+                double frameStart = stopwatch.Elapsed.TotalSeconds;
+
+                // without throttling each frame takes one step, as real time would give fractions of a step
+                double elapsed = frameDuration > 0 ? frameStart - lastFrameTime : m_timestep.StepDuration;
+                lastFrameTime = frameStart;
+
+                Threading.RunDeferredActions(Window.DEFERRED_ACTION_BUDGET);
+                Tick(elapsed);
+
+                if (frameDuration > 0)
+                {
+                    double remaining = frameDuration - (stopwatch.Elapsed.TotalSeconds - frameStart);
+                    if (remaining > 0)
+                    {
+                        Thread.Sleep(TimeSpan.FromSeconds(remaining));
+                    }
+                }
+            }
+
+            m_simulation.Complete();
+
+            double seconds = stopwatch.Elapsed.TotalSeconds;
+            Logger.Info($"Ran {m_timestep.StepCount} simulation steps in {seconds:0.00}s ({m_timestep.StepCount / seconds:0.0} steps per second)");
         }
 
         private void UpdateFrame(object sender, OpenTK.FrameEventArgs e)
+        {
+            Tick(e.Time);
+        }
+
+        /// <summary>
+        /// Runs one frame of the update loop.
+        /// </summary>
+        /// <param name="elapsed">The time since the last frame in seconds.</param>
+        private void Tick(double elapsed)
+        {
+            Profiler.NextFrame();
+            m_frameStats.NextFrame();
+
+            long start = Stopwatch.GetTimestamp();
+            long startAllocated = FrameStats.GetAllocatedBytes();
+
+            using (Profiler.Sample("Main.UpdateFrame"))
+            {
+                try
+                {
+                    using (Profiler.Sample("Main Thread Jobs"))
+                    {
+                        JobScheduler.Default.RunMainThreadJobs();
+                    }
+                    using (Profiler.Sample("Simulate"))
+                    {
+                        Simulate(elapsed);
+                    }
+                    using (Profiler.Sample("Update"))
+                    {
+                        Update();
+                    }
+                }
+                catch (Exception ex)
+                {
+                    Logger.Exception(ex);
+                }
+            }
+
+            m_frameStats.AddUpdate(Stopwatch.GetTimestamp() - start, FrameStats.GetAllocatedBytes() - startAllocated);
+        }
+
+        private void RenderFrame(object sender, OpenTK.FrameEventArgs e)
         {
             try
             {
-                Update();
+                using (Profiler.Sample("Render"))
+                {
+                    Render(InterpolationAlpha);
+                }
             }
             catch (Exception ex)
             {
@@ -120,8 +272,72 @@ namespace Engine
         }
 
         /// <summary>
-        /// The main update loop.
+        /// Runs the simulation steps that are due after a frame.
+        /// </summary>
+        /// <param name="elapsed">The time since the last frame in seconds.</param>
+        private void Simulate(double elapsed)
+        {
+            if (m_simulateOnWorkerThread)
+            {
+                // finish the steps started last frame before starting more, clearing the handle first so
+                // that a failed step is only reported once
+                JobHandle simulation = m_simulation;
+                m_simulation = default(JobHandle);
+                simulation.Complete();
+                if (m_pendingSteps > 0)
+                {
+                    SimulationStepsCompleted();
+                }
+
+                m_pendingSteps = m_timestep.Advance(elapsed);
+                if (m_pendingSteps > 0)
+                {
+                    m_simulation = JobScheduler.Default.Schedule(m_runSimulation);
+                }
+            }
+            else
+            {
+                m_pendingSteps = m_timestep.Advance(elapsed);
+                if (m_pendingSteps > 0)
+                {
+                    RunSimulation();
+                    SimulationStepsCompleted();
+                }
+            }
+        }
+
+        private void RunSimulation()
+        {
+            for (int i = 0; i < m_pendingSteps; i++)
+            {
+                using (Profiler.Sample("FixedUpdate"))
+                {
+                    FixedUpdate();
+                }
+            }
+        }
+
+        /// <summary>
+        /// The main update loop, called once per frame.
         /// </summary>
         protected virtual void Update() {}
+
+        /// <summary>
+        /// Advances the simulation by one step of <see cref="FixedTimestep.StepDuration"/>. This may run on
+        /// a worker thread, see <see cref="SimulateOnWorkerThread"/>.
+        /// </summary>
+        protected virtual void FixedUpdate() {}
+
+        /// <summary>
+        /// Called on the main thread once a frame's simulation steps have finished, before <see cref="Update"/>.
+        /// When simulating on a worker thread, this is where the simulation state should be copied for rendering.
+        /// </summary>
+        protected virtual void SimulationStepsCompleted() {}
+
+        /// <summary>
+        /// Draws a frame.
+        /// </summary>
+        /// <param name="alpha">How far to interpolate between the last two simulation states, from 0 to 1.</param>
+        protected virtual void Render(float alpha) {}
     }
 }
@@ -73,26 +73,29 @@ namespace SoSmooth.Rendering
         /// <param name="usageHint">The usage hint.</param>
         public void BufferData(BufferUsageHint usageHint = BufferUsageHint.DynamicDraw)
         {
-            ValidateDispose();
-
-            if (m_dirty)
+            using (Engine.Profiler.Sample("Buffer.BufferData"))
             {
-                GL.BindBuffer(m_target, this);
+                ValidateDispose();
 
-                // If the allocated buffer on the GPU is large enough, don't reallocate
-                int requiredSize = m_elementSize * m_count;
-                if (m_capacity >= requiredSize)
-                {
-                    GL.BufferSubData(m_target, (IntPtr)0, requiredSize, m_buffer);
-                }
-                else
+                if (m_dirty)
                 {
-                    GL.BufferData(m_target, requiredSize, m_buffer, usageHint);
-                    m_capacity = requiredSize;
-                }
-                m_dirty = false;
+                    GL.BindBuffer(m_target, this);
+
+                    // If the allocated buffer on the GPU is large enough, don't reallocate
+                    int requiredSize = m_elementSize * m_count;
+                    if (m_capacity >= requiredSize)
+                    {
+                        GL.BufferSubData(m_target, (IntPtr)0, requiredSize, m_buffer);
+                    }
+                    else
+                    {
+                        GL.BufferData(m_target, requiredSize, m_buffer, usageHint);
+                        m_capacity = requiredSize;
+                    }
+                    m_dirty = false;
 
-                GL.BindBuffer(m_target, 0);
+                    GL.BindBuffer(m_target, 0);
+                }
             }
         }
 
@@ -105,12 +108,8 @@ namespace SoSmooth.Rendering
         }
 
         /// <summary>
-        /// Cleanup unmanaged resources.
+        /// The GL function that deletes a handle to this type of resource.
         /// </summary>
-        protected override void OnDispose(bool disposing)
-        {
-            GL.DeleteBuffer(this);
-            base.OnDispose(disposing);
-        }
+        protected override Action<int> DeleteHandle => GL.DeleteBuffer;
     }
 }
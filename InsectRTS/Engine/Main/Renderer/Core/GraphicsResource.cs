@@ -22,11 +22,35 @@ namespace SoSmooth.Rendering
             }
         }
         
+        /// <summary>
+        /// The GL function that deletes a handle to this type of resource.
+        /// </summary>
+        /// <remarks>
+        /// This must not reference the instance, as it may be queued to run after the instance is finalized.
+        /// </remarks>
+        protected abstract Action<int> DeleteHandle { get; }
+
         /// <summary>
         /// Checks if this instance can be disposed.
         /// </summary>
+        /// <remarks>
+        /// GL objects must be deleted on the main thread. When disposed from any other thread, such as
+        /// by the finalizer, deleting the handle is deferred to the main thread instead of leaking it.
+        /// </remarks>
         protected override bool CanDispose()
         {
+            if (!Threading.IsOnMainThread())
+            {
+                // only the handle is captured, as queuing the instance would resurrect it after finalization
+                if (m_handle != -1)
+                {
+                    int handle = m_handle;
+                    Action<int> deleteHandle = DeleteHandle;
+                    Threading.RunOnMainThread(() => deleteHandle(handle));
+                    m_handle = -1;
+                }
+                return true;
+            }
             if (GraphicsContext.CurrentContext == null)
             {
                 Logger.Error($"Can't dispose a graphics resource while the current graphics context is null! Type:{GetType().Name} {ToString()}");
@@ -45,8 +69,9 @@ namespace SoSmooth.Rendering
         /// <param name="disposing">If true managed resources should be cleaned up.</param>
         protected override void OnDispose(bool disposing)
         {
-            if (disposing)
+            if (m_handle != -1)
             {
+                DeleteHandle(m_handle);
                 m_handle = -1;
             }
         }
@@ -1,3 +1,4 @@
+using System;
 using OpenTK.Graphics.OpenGL;
 
 namespace SoSmooth.Rendering
@@ -50,13 +51,8 @@ namespace SoSmooth.Rendering
         }
 
         /// <summary>
-        /// Cleanup unmanaged resources.
+        /// The GL function that deletes a handle to this type of resource.
         /// </summary>
-        protected override void OnDispose(bool disposing)
-        {
-            GL.DeleteShader(this);
-
-            base.OnDispose(disposing);
-        }
+        protected override Action<int> DeleteHandle => GL.DeleteShader;
     }
 }
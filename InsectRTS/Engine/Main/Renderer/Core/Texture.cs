@@ -186,13 +186,8 @@ namespace SoSmooth.Rendering
         }
 
         /// <summary>
-        /// Cleanup unmanaged resources.
+        /// The GL function that deletes a handle to this type of resource.
         /// </summary>
-        protected override void OnDispose(bool disposing)
-        {
-            GL.DeleteTexture(this);
-
-            base.OnDispose(disposing);
-        }
+        protected override Action<int> DeleteHandle => GL.DeleteTexture;
     }
 }
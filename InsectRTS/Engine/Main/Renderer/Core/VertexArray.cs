@@ -135,16 +135,8 @@ namespace SoSmooth.Rendering
         }
 
         /// <summary>
-        /// Cleanup unmanaged resources.
+        /// The GL function that deletes a handle to this type of resource.
         /// </summary>
-        protected override void OnDispose(bool disposing)
-        {
-            if (m_vertexArrayGenerated)
-            {
-                GL.DeleteVertexArray(this);
-            }
-
-            base.OnDispose(disposing);
-        }
+        protected override Action<int> DeleteHandle => GL.DeleteVertexArray;
     }
 }
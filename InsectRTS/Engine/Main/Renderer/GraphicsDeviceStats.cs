@@ -0,0 +1,49 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+namespace Engine.Rendering
+{
+    /// <summary>
+    /// Counts of the work sent to a <see cref="RecordingDevice"/>.
+    /// </summary>
+    internal struct GraphicsDeviceStats
+    {
+        /// <summary>
+        /// The total number of calls made to the device.
+        /// </summary>
+        public long calls;
+
+        /// <summary>
+        /// The number of draw calls.
+        /// </summary>
+        public long drawCalls;
+
+        /// <summary>
+        /// The number of vertices or indices drawn.
+        /// </summary>
+        public long vertices;
+
+        /// <summary>
+        /// The number of bytes copied into buffers and textures.
+        /// </summary>
+        public long bytesUploaded;
+
+        /// <summary>
+        /// The number of calls that changed bindings or render state.
+        /// </summary>
+        public long stateChanges;
+
+        /// <summary>
+        /// The number of calls that set bindings or render state to the value it already had. These
+        /// can be removed by caching the state.
+        /// </summary>
+        public long redundantStateChanges;
+
+        public override string ToString()
+        {
+            return $"{calls} calls, {drawCalls} draws ({vertices} vertices), {bytesUploaded} bytes uploaded, " +
+                $"{stateChanges} state changes ({redundantStateChanges} redundant)";
+        }
+    }
+}
@@ -9,6 +9,11 @@ namespace Engine.Rendering
     /// </summary>
     internal interface IContext
     {
+        /// <summary>
+        /// The device graphics calls are made through.
+        /// </summary>
+        IGraphicsDevice Device { get; }
+
         /// <summary>
         /// Gets a string describing the current graphics context.
         /// </summary>
@@ -0,0 +1,319 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using OpenTK.Graphics.OpenGL4;
+
+namespace Engine.Rendering
+{
+    /// <summary>
+    /// The graphics API calls used by the renderer. Going through this interface instead of calling
+    /// <see cref="GL"/> directly allows the renderer to run against <see cref="RecordingDevice"/>, which
+    /// needs no window or driver, to test and benchmark rendering code.
+    /// </summary>
+    internal interface IGraphicsDevice
+    {
+        /// <summary>
+        /// Creates a buffer object.
+        /// </summary>
+        /// <returns>The handle of the new buffer.</returns>
+        int CreateBuffer();
+
+        /// <summary>
+        /// Deletes a buffer object.
+        /// </summary>
+        void DeleteBuffer(int buffer);
+
+        /// <summary>
+        /// Binds a buffer to a target, or unbinds the target if the buffer is zero.
+        /// </summary>
+        void BindBuffer(BufferTarget target, int buffer);
+
+        /// <summary>
+        /// Binds a buffer to an indexed binding point of a target, such as a uniform block binding.
+        /// </summary>
+        void BindBufferBase(BufferRangeTarget target, int index, int buffer);
+
+        /// <summary>
+        /// Allocates storage for the buffer bound to a target and fills it.
+        /// </summary>
+        /// <param name="target">The target the buffer is bound to.</param>
+        /// <param name="size">The size of the buffer in bytes. No more than this is read from the data.</param>
+        /// <param name="data">The data to copy into the buffer.</param>
+        /// <param name="usage">How the buffer is expected to be used.</param>
+        void BufferData<T>(BufferTarget target, int size, T[] data, BufferUsageHint usage) where T : struct;
+
+        /// <summary>
+        /// Replaces part of the storage of the buffer bound to a target.
+        /// </summary>
+        /// <param name="target">The target the buffer is bound to.</param>
+        /// <param name="offset">The offset in bytes into the buffer to start writing at.</param>
+        /// <param name="size">The number of bytes to write.</param>
+        /// <param name="data">The data to copy into the buffer.</param>
+        void BufferSubData<T>(BufferTarget target, int offset, int size, T[] data) where T : struct;
+
+        /// <summary>
+        /// Creates a vertex array object.
+        /// </summary>
+        /// <returns>The handle of the new vertex array.</returns>
+        int CreateVertexArray();
+
+        /// <summary>
+        /// Deletes a vertex array object.
+        /// </summary>
+        void DeleteVertexArray(int vertexArray);
+
+        /// <summary>
+        /// Binds a vertex array, or unbinds the current vertex array if zero.
+        /// </summary>
+        void BindVertexArray(int vertexArray);
+
+        /// <summary>
+        /// Creates a texture object.
+        /// </summary>
+        /// <returns>The handle of the new texture.</returns>
+        int CreateTexture();
+
+        /// <summary>
+        /// Deletes a texture object.
+        /// </summary>
+        void DeleteTexture(int texture);
+
+        /// <summary>
+        /// Binds a texture to a target, or unbinds the target if the texture is zero.
+        /// </summary>
+        void BindTexture(TextureTarget target, int texture);
+
+        /// <summary>
+        /// Allocates storage for the texture bound to a target and fills it.
+        /// </summary>
+        /// <param name="size">The size of the pixel data in bytes, or zero if there is no pixel data.</param>
+        /// <param name="pixels">The pixel data, or null to only allocate the storage.</param>
+        void TexImage2D<T>(TextureTarget target, int level, PixelInternalFormat internalFormat, int width, int height, PixelFormat format, PixelType type, int size, T[] pixels) where T : struct;
+
+        /// <summary>
+        /// Allocates storage for the texture bound to a target and fills it from unmanaged memory.
+        /// </summary>
+        /// <param name="size">The size of the pixel data in bytes, or zero if there is no pixel data.</param>
+        /// <param name="pixels">The pixel data, or <see cref="IntPtr.Zero"/> to only allocate the storage.</param>
+        void TexImage2D(TextureTarget target, int level, PixelInternalFormat internalFormat, int width, int height, PixelFormat format, PixelType type, int size, IntPtr pixels);
+
+        /// <summary>
+        /// Sets a parameter of the texture bound to a target.
+        /// </summary>
+        void TexParameter(TextureTarget target, TextureParameterName parameter, int value);
+
+        /// <summary>
+        /// Generates the mipmaps of the texture bound to a target.
+        /// </summary>
+        void GenerateMipmap(GenerateMipmapTarget target);
+
+        /// <summary>
+        /// Sets the texture unit that texture binding calls apply to.
+        /// </summary>
+        void ActiveTexture(TextureUnit unit);
+
+        /// <summary>
+        /// Creates a shader object.
+        /// </summary>
+        /// <returns>The handle of the new shader.</returns>
+        int CreateShader(ShaderType type);
+
+        /// <summary>
+        /// Deletes a shader object.
+        /// </summary>
+        void DeleteShader(int shader);
+
+        /// <summary>
+        /// Compiles a shader from source code.
+        /// </summary>
+        /// <returns>True if the shader compiled successfully.</returns>
+        bool CompileShader(int shader, string source);
+
+        /// <summary>
+        /// Gets the messages from the last time a shader was compiled.
+        /// </summary>
+        string GetShaderInfoLog(int shader);
+
+        /// <summary>
+        /// Creates a shader program object.
+        /// </summary>
+        /// <returns>The handle of the new program.</returns>
+        int CreateProgram();
+
+        /// <summary>
+        /// Deletes a shader program object.
+        /// </summary>
+        void DeleteProgram(int program);
+
+        /// <summary>
+        /// Attaches a shader to a program, to be included when the program is linked.
+        /// </summary>
+        void AttachShader(int program, int shader);
+
+        /// <summary>
+        /// Detaches a shader from a program.
+        /// </summary>
+        void DetachShader(int program, int shader);
+
+        /// <summary>
+        /// Links the shaders attached to a program.
+        /// </summary>
+        /// <returns>True if the program linked successfully.</returns>
+        bool LinkProgram(int program);
+
+        /// <summary>
+        /// Gets the messages from the last time a program was linked.
+        /// </summary>
+        string GetProgramInfoLog(int program);
+
+        /// <summary>
+        /// Gets the number of uniform blocks used by a linked program.
+        /// </summary>
+        int GetUniformBlockCount(int program);
+
+        /// <summary>
+        /// Gets the name of a uniform block used by a linked program.
+        /// </summary>
+        /// <param name="program">The program.</param>
+        /// <param name="blockIndex">The index of the block in the program.</param>
+        string GetUniformBlockName(int program, int blockIndex);
+
+        /// <summary>
+        /// Sets the buffer binding point a uniform block of a program reads from.
+        /// </summary>
+        /// <param name="program">The program.</param>
+        /// <param name="blockIndex">The index of the block in the program.</param>
+        /// <param name="bindingPoint">The binding point index.</param>
+        void UniformBlockBinding(int program, int blockIndex, int bindingPoint);
+
+        /// <summary>
+        /// Gets the location of a vertex attribute in a linked program.
+        /// </summary>
+        /// <returns>The attribute's location, or -1 if the program does not use it.</returns>
+        int GetAttribLocation(int program, string name);
+
+        /// <summary>
+        /// Gets the location of a uniform in a linked program.
+        /// </summary>
+        /// <returns>The uniform's location, or -1 if the program does not use it.</returns>
+        int GetUniformLocation(int program, string name);
+
+        /// <summary>
+        /// Sets how a vertex attribute is read from the bound array buffer, and enables it for the bound vertex array.
+        /// </summary>
+        /// <param name="index">The attribute's location.</param>
+        /// <param name="size">The number of components in the attribute.</param>
+        /// <param name="type">The type of each component.</param>
+        /// <param name="normalized">Whether integer components are normalized when converted to floating point.</param>
+        /// <param name="stride">The offset in bytes between consecutive attributes.</param>
+        /// <param name="offset">The offset in bytes of the first attribute in the buffer.</param>
+        void VertexAttribPointer(int index, int size, VertexAttribPointerType type, bool normalized, int stride, int offset);
+
+        /// <summary>
+        /// Sets an integer uniform of the program in use.
+        /// </summary>
+        void Uniform1(int location, int value);
+
+        /// <summary>
+        /// Sets a float uniform of the program in use.
+        /// </summary>
+        void Uniform1(int location, float value);
+
+        /// <summary>
+        /// Sets a two component uniform of the program in use.
+        /// </summary>
+        void Uniform2(int location, float x, float y);
+
+        /// <summary>
+        /// Sets a three component uniform of the program in use.
+        /// </summary>
+        void Uniform3(int location, float x, float y, float z);
+
+        /// <summary>
+        /// Sets a four component uniform of the program in use.
+        /// </summary>
+        void Uniform4(int location, float x, float y, float z, float w);
+
+        /// <summary>
+        /// Sets a matrix uniform of the program in use.
+        /// </summary>
+        /// <param name="location">The uniform's location.</param>
+        /// <param name="transpose">Whether the matrix is transposed when it is set.</param>
+        /// <param name="matrix">The matrix.</param>
+        void UniformMatrix4(int location, bool transpose, ref OpenTK.Matrix4 matrix);
+
+        /// <summary>
+        /// Sets the shader program used for drawing, or unsets it if zero.
+        /// </summary>
+        void UseProgram(int program);
+
+        /// <summary>
+        /// Enables a capability.
+        /// </summary>
+        void Enable(EnableCap cap);
+
+        /// <summary>
+        /// Disables a capability.
+        /// </summary>
+        void Disable(EnableCap cap);
+
+        /// <summary>
+        /// Sets how colors are blended.
+        /// </summary>
+        void BlendFunc(BlendingFactorSrc source, BlendingFactorDest destination);
+
+        /// <summary>
+        /// Sets how blended colors are combined.
+        /// </summary>
+        void BlendEquation(BlendEquationMode mode);
+
+        /// <summary>
+        /// Sets which faces are culled.
+        /// </summary>
+        void CullFace(CullFaceMode mode);
+
+        /// <summary>
+        /// Sets whether drawing writes to the depth buffer.
+        /// </summary>
+        void DepthMask(bool write);
+
+        /// <summary>
+        /// Sets how polygons are rasterized.
+        /// </summary>
+        void PolygonMode(MaterialFace face, PolygonMode mode);
+
+        /// <summary>
+        /// Sets the region of the framebuffer drawn to.
+        /// </summary>
+        void Viewport(int x, int y, int width, int height);
+
+        /// <summary>
+        /// Sets the region of the framebuffer that can be modified.
+        /// </summary>
+        void Scissor(int x, int y, int width, int height);
+
+        /// <summary>
+        /// Clears buffers of the framebuffer.
+        /// </summary>
+        void Clear(ClearBufferMask mask);
+
+        /// <summary>
+        /// Draws primitives from the bound vertex array.
+        /// </summary>
+        /// <param name="mode">The type of primitive to draw.</param>
+        /// <param name="first">The index of the first vertex.</param>
+        /// <param name="count">The number of vertices.</param>
+        void DrawArrays(PrimitiveType mode, int first, int count);
+
+        /// <summary>
+        /// Draws indexed primitives from the bound vertex array.
+        /// </summary>
+        /// <param name="mode">The type of primitive to draw.</param>
+        /// <param name="count">The number of indices.</param>
+        /// <param name="type">The type of the indices.</param>
+        /// <param name="offset">The offset in bytes into the bound index buffer.</param>
+        void DrawElements(PrimitiveType mode, int count, DrawElementsType type, int offset);
+    }
+}
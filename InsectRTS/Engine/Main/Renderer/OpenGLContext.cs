@@ -5,6 +5,7 @@
 using System;
 using System.Text;
 using OpenTK.Graphics.OpenGL4;
+using Engine.Logging;
 
 namespace Engine.Rendering
 {
@@ -13,6 +14,13 @@ namespace Engine.Rendering
         public static readonly int OPENGL_VERSION_MAJOR = 4;
         public static readonly int OPENGL_VERSION_MINOR = 6;
 
+        private readonly OpenGLDevice m_device = new OpenGLDevice();
+
+        /// <summary>
+        /// The device graphics calls are made through.
+        /// </summary>
+        public IGraphicsDevice Device => m_device;
+
         /// <summary>
         /// Gets a string describing the current graphics context.
         /// </summary>
@@ -50,7 +58,7 @@ namespace Engine.Rendering
             // confirm the graphics api version
             if (major < OPENGL_VERSION_MAJOR || (major == OPENGL_VERSION_MAJOR && minor < OPENGL_VERSION_MINOR))
             {
-                Logger.Warning($"OpenGL context is version {major}.{minor} but {OPENGL_VERSION_MAJOR}.{OPENGL_VERSION_MINOR} was requested.");
+                Logger.Warning(LogCategory.Renderer, $"OpenGL context is version {major}.{minor} but {OPENGL_VERSION_MAJOR}.{OPENGL_VERSION_MINOR} was requested.");
                 supported = false;
             }
 
@@ -71,8 +79,8 @@ namespace Engine.Rendering
         /// </summary>
         public void Initialize()
         {
-            GL.Enable(EnableCap.DepthTest);
-            GL.Enable(EnableCap.ScissorTest);
+            m_device.Enable(EnableCap.DepthTest);
+            m_device.Enable(EnableCap.ScissorTest);
         }
 
         /// <summary>
@@ -80,12 +88,33 @@ namespace Engine.Rendering
         /// </summary>
         public void Resize(int width, int height)
         {
-            GL.Viewport(0, 0, width, height);
-            GL.Scissor(0, 0, width, height);
+            m_device.Viewport(0, 0, width, height);
+            m_device.Scissor(0, 0, width, height);
         }
 
         private static void DebugCallback(DebugSource source, DebugType type, int id, DebugSeverity severity, int length, IntPtr message, IntPtr userParam)
         {
+            LogLevel level;
+            switch (severity)
+            {
+                case DebugSeverity.DebugSeverityHigh:
+                    level = LogLevel.Error;
+                    break;
+                case DebugSeverity.DebugSeverityMedium:
+                case DebugSeverity.DebugSeverityLow:
+                    level = LogLevel.Warning;
+                    break;
+                default:
+                    level = LogLevel.Info;
+                    break;
+            }
+
+            // skip building the message if it would not be logged
+            if (!Logger.IsEnabled(level, LogCategory.Renderer))
+            {
+                return;
+            }
+
             StringBuilder sb = new StringBuilder();
 
             // get the message source
@@ -123,22 +152,7 @@ namespace Engine.Rendering
                 }
             }
 
-            // forward the message to an appropriate logger method
-            string line = sb.ToString();
-
-            switch (severity)
-            {
-                case DebugSeverity.DebugSeverityHigh:
-                    Logger.Error(line, false);
-                    break;
-                case DebugSeverity.DebugSeverityMedium:
-                case DebugSeverity.DebugSeverityLow:
-                    Logger.Warning(line);
-                    break;
-                default:
-                    Logger.Info(line);
-                    break;
-            }
+            Logger.Log(level, LogCategory.Renderer, sb.ToString());
         }
     }
 }
@@ -0,0 +1,158 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using OpenTK.Graphics.OpenGL4;
+
+namespace Engine.Rendering
+{
+    /// <summary>
+    /// Sends graphics calls to the current OpenGL context.
+    /// </summary>
+    internal class OpenGLDevice : IGraphicsDevice
+    {
+        public int CreateBuffer() => GL.GenBuffer();
+
+        public void DeleteBuffer(int buffer) => GL.DeleteBuffer(buffer);
+
+        public void BindBuffer(BufferTarget target, int buffer) => GL.BindBuffer(target, buffer);
+
+        public void BindBufferBase(BufferRangeTarget target, int index, int buffer) => GL.BindBufferBase(target, index, buffer);
+
+        public void BufferData<T>(BufferTarget target, int size, T[] data, BufferUsageHint usage) where T : struct
+        {
+            GL.BufferData(target, size, data, usage);
+        }
+
+        public void BufferSubData<T>(BufferTarget target, int offset, int size, T[] data) where T : struct
+        {
+            GL.BufferSubData(target, (IntPtr)offset, size, data);
+        }
+
+        public int CreateVertexArray() => GL.GenVertexArray();
+
+        public void DeleteVertexArray(int vertexArray) => GL.DeleteVertexArray(vertexArray);
+
+        public void BindVertexArray(int vertexArray) => GL.BindVertexArray(vertexArray);
+
+        public int CreateTexture() => GL.GenTexture();
+
+        public void DeleteTexture(int texture) => GL.DeleteTexture(texture);
+
+        public void BindTexture(TextureTarget target, int texture) => GL.BindTexture(target, texture);
+
+        public void TexImage2D<T>(TextureTarget target, int level, PixelInternalFormat internalFormat, int width, int height, PixelFormat format, PixelType type, int size, T[] pixels) where T : struct
+        {
+            // the size of the pixel data is given by the dimensions and format
+            if (pixels != null)
+            {
+                GL.TexImage2D(target, level, internalFormat, width, height, 0, format, type, pixels);
+            }
+            else
+            {
+                GL.TexImage2D(target, level, internalFormat, width, height, 0, format, type, IntPtr.Zero);
+            }
+        }
+
+        public void TexImage2D(TextureTarget target, int level, PixelInternalFormat internalFormat, int width, int height, PixelFormat format, PixelType type, int size, IntPtr pixels)
+        {
+            GL.TexImage2D(target, level, internalFormat, width, height, 0, format, type, pixels);
+        }
+
+        public void TexParameter(TextureTarget target, TextureParameterName parameter, int value) => GL.TexParameter(target, parameter, value);
+
+        public void GenerateMipmap(GenerateMipmapTarget target) => GL.GenerateMipmap(target);
+
+        public void ActiveTexture(TextureUnit unit) => GL.ActiveTexture(unit);
+
+        public int CreateShader(ShaderType type) => GL.CreateShader(type);
+
+        public void DeleteShader(int shader) => GL.DeleteShader(shader);
+
+        public bool CompileShader(int shader, string source)
+        {
+            GL.ShaderSource(shader, source);
+            GL.CompileShader(shader);
+            GL.GetShader(shader, ShaderParameter.CompileStatus, out int status);
+            return status == 1;
+        }
+
+        public string GetShaderInfoLog(int shader) => GL.GetShaderInfoLog(shader);
+
+        public int CreateProgram() => GL.CreateProgram();
+
+        public void DeleteProgram(int program) => GL.DeleteProgram(program);
+
+        public void AttachShader(int program, int shader) => GL.AttachShader(program, shader);
+
+        public void DetachShader(int program, int shader) => GL.DetachShader(program, shader);
+
+        public bool LinkProgram(int program)
+        {
+            GL.LinkProgram(program);
+            GL.GetProgram(program, GetProgramParameterName.LinkStatus, out int status);
+            return status == 1;
+        }
+
+        public string GetProgramInfoLog(int program) => GL.GetProgramInfoLog(program);
+
+        public int GetUniformBlockCount(int program)
+        {
+            GL.GetProgram(program, GetProgramParameterName.ActiveUniformBlocks, out int count);
+            return count;
+        }
+
+        public string GetUniformBlockName(int program, int blockIndex) => GL.GetActiveUniformBlockName(program, blockIndex);
+
+        public void UniformBlockBinding(int program, int blockIndex, int bindingPoint) => GL.UniformBlockBinding(program, blockIndex, bindingPoint);
+
+        public int GetAttribLocation(int program, string name) => GL.GetAttribLocation(program, name);
+
+        public int GetUniformLocation(int program, string name) => GL.GetUniformLocation(program, name);
+
+        public void VertexAttribPointer(int index, int size, VertexAttribPointerType type, bool normalized, int stride, int offset)
+        {
+            GL.EnableVertexAttribArray(index);
+            GL.VertexAttribPointer(index, size, type, normalized, stride, offset);
+        }
+
+        public void Uniform1(int location, int value) => GL.Uniform1(location, value);
+
+        public void Uniform1(int location, float value) => GL.Uniform1(location, value);
+
+        public void Uniform2(int location, float x, float y) => GL.Uniform2(location, x, y);
+
+        public void Uniform3(int location, float x, float y, float z) => GL.Uniform3(location, x, y, z);
+
+        public void Uniform4(int location, float x, float y, float z, float w) => GL.Uniform4(location, x, y, z, w);
+
+        public void UniformMatrix4(int location, bool transpose, ref OpenTK.Matrix4 matrix) => GL.UniformMatrix4(location, transpose, ref matrix);
+
+        public void UseProgram(int program) => GL.UseProgram(program);
+
+        public void Enable(EnableCap cap) => GL.Enable(cap);
+
+        public void Disable(EnableCap cap) => GL.Disable(cap);
+
+        public void BlendFunc(BlendingFactorSrc source, BlendingFactorDest destination) => GL.BlendFunc(source, destination);
+
+        public void BlendEquation(BlendEquationMode mode) => GL.BlendEquation(mode);
+
+        public void CullFace(CullFaceMode mode) => GL.CullFace(mode);
+
+        public void DepthMask(bool write) => GL.DepthMask(write);
+
+        public void PolygonMode(MaterialFace face, PolygonMode mode) => GL.PolygonMode(face, mode);
+
+        public void Viewport(int x, int y, int width, int height) => GL.Viewport(x, y, width, height);
+
+        public void Scissor(int x, int y, int width, int height) => GL.Scissor(x, y, width, height);
+
+        public void Clear(ClearBufferMask mask) => GL.Clear(mask);
+
+        public void DrawArrays(PrimitiveType mode, int first, int count) => GL.DrawArrays(mode, first, count);
+
+        public void DrawElements(PrimitiveType mode, int count, DrawElementsType type, int offset) => GL.DrawElements(mode, count, type, offset);
+    }
+}
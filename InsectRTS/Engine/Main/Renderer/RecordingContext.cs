@@ -0,0 +1,68 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using OpenTK.Graphics.OpenGL4;
+
+namespace Engine.Rendering
+{
+    /// <summary>
+    /// A context that records graphics calls using a <see cref="RecordingDevice"/> instead of drawing.
+    /// </summary>
+    internal class RecordingContext : IContext
+    {
+        private readonly RecordingDevice m_device = new RecordingDevice();
+
+        /// <summary>
+        /// The device graphics calls are made through.
+        /// </summary>
+        public IGraphicsDevice Device => m_device;
+
+        /// <summary>
+        /// The device, giving access to the recorded stats.
+        /// </summary>
+        public RecordingDevice RecordingDevice => m_device;
+
+        /// <summary>
+        /// Gets a string describing the current graphics context.
+        /// </summary>
+        public string GetContextInformation()
+        {
+            return "Recording device (no rendering)";
+        }
+
+        /// <summary>
+        /// Checks if the requested context supports the required features.
+        /// </summary>
+        /// <returns>Always true, as nothing is rendered.</returns>
+        public bool CheckSupport()
+        {
+            return true;
+        }
+
+        /// <summary>
+        /// Enables debug output from the graphics context.
+        /// </summary>
+        public void EnableDebugOutput()
+        {
+        }
+
+        /// <summary>
+        /// Initializes the context.
+        /// </summary>
+        public void Initialize()
+        {
+            m_device.Enable(EnableCap.DepthTest);
+            m_device.Enable(EnableCap.ScissorTest);
+        }
+
+        /// <summary>
+        /// Resize the context.
+        /// </summary>
+        public void Resize(int width, int height)
+        {
+            m_device.Viewport(0, 0, width, height);
+            m_device.Scissor(0, 0, width, height);
+        }
+    }
+}
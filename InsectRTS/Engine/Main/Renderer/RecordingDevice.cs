@@ -0,0 +1,388 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Collections.Generic;
+using OpenTK.Graphics.OpenGL4;
+
+namespace Engine.Rendering
+{
+    /// <summary>
+    /// A graphics device that draws nothing, but counts the calls made to it. It tracks bindings and
+    /// render state like a real context so that state changes which have no effect can be counted.
+    /// It does not need a window or graphics driver, so rendering code can be tested and benchmarked
+    /// on any machine.
+    /// </summary>
+    /// <remarks>
+    /// Buffer and texture uploads are both counted by their size argument, which is the number of bytes
+    /// read from the data and must not exceed the size of the data passed.
+    /// </remarks>
+    internal class RecordingDevice : IGraphicsDevice
+    {
+        private readonly Dictionary<BufferTarget, int> m_buffers = new Dictionary<BufferTarget, int>();
+        private readonly Dictionary<(BufferRangeTarget, int), int> m_indexedBuffers = new Dictionary<(BufferRangeTarget, int), int>();
+        private readonly Dictionary<(TextureUnit, TextureTarget), int> m_textures = new Dictionary<(TextureUnit, TextureTarget), int>();
+        private readonly List<BufferTarget> m_unboundBuffers = new List<BufferTarget>();
+        private readonly List<(BufferRangeTarget, int)> m_unboundIndexedBuffers = new List<(BufferRangeTarget, int)>();
+        private readonly List<(TextureUnit, TextureTarget)> m_unboundTextures = new List<(TextureUnit, TextureTarget)>();
+        private readonly Dictionary<string, int> m_locations = new Dictionary<string, int>();
+        private readonly HashSet<EnableCap> m_enabled = new HashSet<EnableCap>();
+        private GraphicsDeviceStats m_stats;
+        private int m_nextHandle = 1;
+        private int m_vertexArray = 0;
+        private int m_program = 0;
+        private TextureUnit m_textureUnit = TextureUnit.Texture0;
+
+        // the initial values match the defaults of an OpenGL context
+        private BlendingFactorSrc m_blendSource = BlendingFactorSrc.One;
+        private BlendingFactorDest m_blendDestination = BlendingFactorDest.Zero;
+        private BlendEquationMode m_blendEquation = BlendEquationMode.FuncAdd;
+        private CullFaceMode m_cullFace = CullFaceMode.Back;
+        private PolygonMode m_polygonMode = OpenTK.Graphics.OpenGL4.PolygonMode.Fill;
+        private bool m_depthMask = true;
+        private RectInt m_viewport = default(RectInt);
+        private RectInt m_scissor = default(RectInt);
+
+        /// <summary>
+        /// The work recorded since the device was created or the stats were last reset.
+        /// </summary>
+        public GraphicsDeviceStats Stats => m_stats;
+
+        /// <summary>
+        /// Clears the recorded stats. The tracked state is kept.
+        /// </summary>
+        public void ResetStats()
+        {
+            m_stats = default(GraphicsDeviceStats);
+        }
+
+        public int CreateBuffer() => CreateHandle();
+
+        public void DeleteBuffer(int buffer)
+        {
+            DeleteHandle(buffer, m_buffers, m_unboundBuffers);
+            Unbind(buffer, m_indexedBuffers, m_unboundIndexedBuffers);
+        }
+
+        public void BindBuffer(BufferTarget target, int buffer) => Bind(m_buffers, target, buffer);
+
+        public void BindBufferBase(BufferRangeTarget target, int index, int buffer) => Bind(m_indexedBuffers, (target, index), buffer);
+
+        public void BufferData<T>(BufferTarget target, int size, T[] data, BufferUsageHint usage) where T : struct
+        {
+            Upload(size, data);
+        }
+
+        public void BufferSubData<T>(BufferTarget target, int offset, int size, T[] data) where T : struct
+        {
+            Upload(size, data);
+        }
+
+        public int CreateVertexArray() => CreateHandle();
+
+        public void DeleteVertexArray(int vertexArray)
+        {
+            m_stats.calls++;
+            if (m_vertexArray == vertexArray)
+            {
+                m_vertexArray = 0;
+            }
+        }
+
+        public void BindVertexArray(int vertexArray) => SetState(ref m_vertexArray, vertexArray);
+
+        public int CreateTexture() => CreateHandle();
+
+        public void DeleteTexture(int texture) => DeleteHandle(texture, m_textures, m_unboundTextures);
+
+        public void BindTexture(TextureTarget target, int texture) => Bind(m_textures, (m_textureUnit, target), texture);
+
+        public void TexImage2D<T>(TextureTarget target, int level, PixelInternalFormat internalFormat, int width, int height, PixelFormat format, PixelType type, int size, T[] pixels) where T : struct
+        {
+            Upload(size, pixels);
+        }
+
+        public void TexImage2D(TextureTarget target, int level, PixelInternalFormat internalFormat, int width, int height, PixelFormat format, PixelType type, int size, IntPtr pixels)
+        {
+            // the length of unmanaged data is unknown, so only check that there is data to read
+            Upload(size, pixels != IntPtr.Zero ? int.MaxValue : 0);
+        }
+
+        public void TexParameter(TextureTarget target, TextureParameterName parameter, int value)
+        {
+            m_stats.calls++;
+        }
+
+        public void GenerateMipmap(GenerateMipmapTarget target)
+        {
+            m_stats.calls++;
+        }
+
+        public void ActiveTexture(TextureUnit unit)
+        {
+            m_stats.calls++;
+            CountStateChange(m_textureUnit != unit);
+            m_textureUnit = unit;
+        }
+
+        public int CreateShader(ShaderType type) => CreateHandle();
+
+        public void DeleteShader(int shader)
+        {
+            m_stats.calls++;
+        }
+
+        public bool CompileShader(int shader, string source)
+        {
+            m_stats.calls++;
+            return true;
+        }
+
+        public string GetShaderInfoLog(int shader)
+        {
+            m_stats.calls++;
+            return string.Empty;
+        }
+
+        public int CreateProgram() => CreateHandle();
+
+        public void DeleteProgram(int program)
+        {
+            // a program in use is only deleted once it is no longer in use, so it stays bound
+            m_stats.calls++;
+        }
+
+        public void AttachShader(int program, int shader)
+        {
+            m_stats.calls++;
+        }
+
+        public void DetachShader(int program, int shader)
+        {
+            m_stats.calls++;
+        }
+
+        public bool LinkProgram(int program)
+        {
+            m_stats.calls++;
+            return true;
+        }
+
+        public string GetProgramInfoLog(int program)
+        {
+            m_stats.calls++;
+            return string.Empty;
+        }
+
+        public int GetUniformBlockCount(int program)
+        {
+            m_stats.calls++;
+            return 0;
+        }
+
+        public string GetUniformBlockName(int program, int blockIndex)
+        {
+            throw new ArgumentOutOfRangeException(nameof(blockIndex), blockIndex, "Must be less than the uniform block count!");
+        }
+
+        public void UniformBlockBinding(int program, int blockIndex, int bindingPoint)
+        {
+            throw new ArgumentOutOfRangeException(nameof(blockIndex), blockIndex, "Must be less than the uniform block count!");
+        }
+
+        public int GetAttribLocation(int program, string name) => GetLocation(name);
+
+        public int GetUniformLocation(int program, string name) => GetLocation(name);
+
+        public void VertexAttribPointer(int index, int size, VertexAttribPointerType type, bool normalized, int stride, int offset)
+        {
+            m_stats.calls++;
+        }
+
+        public void Uniform1(int location, int value)
+        {
+            m_stats.calls++;
+        }
+
+        public void Uniform1(int location, float value)
+        {
+            m_stats.calls++;
+        }
+
+        public void Uniform2(int location, float x, float y)
+        {
+            m_stats.calls++;
+        }
+
+        public void Uniform3(int location, float x, float y, float z)
+        {
+            m_stats.calls++;
+        }
+
+        public void Uniform4(int location, float x, float y, float z, float w)
+        {
+            m_stats.calls++;
+        }
+
+        public void UniformMatrix4(int location, bool transpose, ref OpenTK.Matrix4 matrix)
+        {
+            m_stats.calls++;
+        }
+
+        public void UseProgram(int program) => SetState(ref m_program, program);
+
+        public void Enable(EnableCap cap)
+        {
+            m_stats.calls++;
+            CountStateChange(m_enabled.Add(cap));
+        }
+
+        public void Disable(EnableCap cap)
+        {
+            m_stats.calls++;
+            CountStateChange(m_enabled.Remove(cap));
+        }
+
+        public void BlendFunc(BlendingFactorSrc source, BlendingFactorDest destination)
+        {
+            m_stats.calls++;
+            CountStateChange(m_blendSource != source || m_blendDestination != destination);
+            m_blendSource = source;
+            m_blendDestination = destination;
+        }
+
+        public void BlendEquation(BlendEquationMode mode)
+        {
+            m_stats.calls++;
+            CountStateChange(m_blendEquation != mode);
+            m_blendEquation = mode;
+        }
+
+        public void CullFace(CullFaceMode mode)
+        {
+            m_stats.calls++;
+            CountStateChange(m_cullFace != mode);
+            m_cullFace = mode;
+        }
+
+        public void DepthMask(bool write) => SetState(ref m_depthMask, write);
+
+        public void PolygonMode(MaterialFace face, PolygonMode mode)
+        {
+            // only both faces can be set in a core context
+            m_stats.calls++;
+            CountStateChange(m_polygonMode != mode);
+            m_polygonMode = mode;
+        }
+
+        public void Viewport(int x, int y, int width, int height) => SetState(ref m_viewport, new RectInt(x, y, width, height));
+
+        public void Scissor(int x, int y, int width, int height) => SetState(ref m_scissor, new RectInt(x, y, width, height));
+
+        public void Clear(ClearBufferMask mask)
+        {
+            m_stats.calls++;
+        }
+
+        public void DrawArrays(PrimitiveType mode, int first, int count) => Draw(count);
+
+        public void DrawElements(PrimitiveType mode, int count, DrawElementsType type, int offset) => Draw(count);
+
+        private int CreateHandle()
+        {
+            m_stats.calls++;
+            return m_nextHandle++;
+        }
+
+        private void DeleteHandle<TTarget>(int handle, Dictionary<TTarget, int> bindings, List<TTarget> unbound)
+        {
+            m_stats.calls++;
+            Unbind(handle, bindings, unbound);
+        }
+
+        private void Unbind<TTarget>(int handle, Dictionary<TTarget, int> bindings, List<TTarget> unbound)
+        {
+            // deleting a bound object unbinds it, but the bindings can't be changed while they are enumerated,
+            // so the targets are gathered in a list that is reused between deletes
+            foreach (KeyValuePair<TTarget, int> binding in bindings)
+            {
+                if (binding.Value == handle)
+                {
+                    unbound.Add(binding.Key);
+                }
+            }
+            foreach (TTarget target in unbound)
+            {
+                bindings[target] = 0;
+            }
+            unbound.Clear();
+        }
+
+        private void Bind<TTarget>(Dictionary<TTarget, int> bindings, TTarget target, int handle)
+        {
+            m_stats.calls++;
+
+            bindings.TryGetValue(target, out int current);
+            CountStateChange(current != handle);
+            bindings[target] = handle;
+        }
+
+        private void SetState<T>(ref T current, T value) where T : IEquatable<T>
+        {
+            m_stats.calls++;
+            CountStateChange(!current.Equals(value));
+            current = value;
+        }
+
+        private void CountStateChange(bool changed)
+        {
+            if (changed)
+            {
+                m_stats.stateChanges++;
+            }
+            else
+            {
+                m_stats.redundantStateChanges++;
+            }
+        }
+
+        /// <summary>
+        /// Gives each name used by programs a location, so that the same name always has the same location.
+        /// </summary>
+        private int GetLocation(string name)
+        {
+            m_stats.calls++;
+
+            if (!m_locations.TryGetValue(name, out int location))
+            {
+                location = m_locations.Count;
+                m_locations.Add(name, location);
+            }
+            return location;
+        }
+
+        private void Upload<T>(int size, T[] data) where T : struct
+        {
+            Upload(size, data != null ? (long)data.Length * Unsafe.SizeOf<T>() : 0);
+        }
+
+        private void Upload(int size, long dataSize)
+        {
+            if (size < 0 || size > dataSize)
+            {
+                throw new ArgumentOutOfRangeException(nameof(size), size, $"Must be non-negative and no larger than the data ({dataSize} bytes)!");
+            }
+
+            m_stats.calls++;
+            m_stats.bytesUploaded += size;
+        }
+
+        private void Draw(int count)
+        {
+            m_stats.calls++;
+            m_stats.drawCalls++;
+            m_stats.vertices += count;
+        }
+    }
+}
@@ -69,34 +69,37 @@ namespace SoSmooth
         /// <param name="assemblies">The assembly to search for shader files in.</param>
         public void LoadShaders(Assembly assembly)
         {
-            if (!m_assemblyToResName.ContainsKey(assembly))
+            using (Engine.Profiler.Sample("ShaderManager.LoadShaders"))
             {
-                m_assemblyToResName.Add(assembly, assembly.GetManifestResourceNames());
-
-                Logger.Info($"Loading shaders from assembly: {assembly.FullName}");
-
-                // Create programs from shaders sharing a name
-                foreach (KeyValuePair<string, List<Shader>> nameShaders in GetShaderSources(assembly))
+                if (!m_assemblyToResName.ContainsKey(assembly))
                 {
-                    string name = nameShaders.Key;
-                    List<Shader> shaders = nameShaders.Value;
+                    m_assemblyToResName.Add(assembly, assembly.GetManifestResourceNames());
 
-                    if (shaders.Any(s => !s.IsValid))
+                    Logger.Info($"Loading shaders from assembly: {assembly.FullName}");
+
+                    // Create programs from shaders sharing a name
+                    foreach (KeyValuePair<string, List<Shader>> nameShaders in GetShaderSources(assembly))
                     {
-                        Logger.Error($"Can't create program \"{name}\" as source shaders are not valid!");
-                        shaders.ForEach(s => s.Dispose());
-                        continue;
-                    }
+                        string name = nameShaders.Key;
+                        List<Shader> shaders = nameShaders.Value;
+
+                        if (shaders.Any(s => !s.IsValid))
+                        {
+                            Logger.Error($"Can't create program \"{name}\" as source shaders are not valid!");
+                            shaders.ForEach(s => s.Dispose());
+                            continue;
+                        }
 
-                    Logger.Info("Creating program: " + name);
-                    ShaderProgram program = new ShaderProgram(name, shaders);
+                        Logger.Info("Creating program: " + name);
+                        ShaderProgram program = new ShaderProgram(name, shaders);
 
-                    if (program.IsValid)
-                    {
-                        m_shaderPrograms.Add(name, program);
-                    }
+                        if (program.IsValid)
+                        {
+                            m_shaderPrograms.Add(name, program);
+                        }
                     
-                    shaders.ForEach(s => s.Dispose());
+                        shaders.ForEach(s => s.Dispose());
+                    }
                 }
             }
         }
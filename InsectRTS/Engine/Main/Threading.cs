@@ -3,6 +3,8 @@
 * See "Licence.txt" for full licence.
 */
 using System;
+using System.Collections.Concurrent;
+using System.Diagnostics;
 using System.Threading;
 
 namespace Engine
@@ -13,6 +15,12 @@ namespace Engine
     internal static class Threading
     {
         private static int m_mainThreadId;
+        private static readonly ConcurrentQueue<Action> m_deferredActions = new ConcurrentQueue<Action>();
+
+        /// <summary>
+        /// The number of actions waiting to be run on the main thread.
+        /// </summary>
+        public static int DeferredActionCount => m_deferredActions.Count;
         
         /// <summary>
         /// Records the currently executing thead as the main thread.
@@ -42,5 +50,55 @@ namespace Engine
                 throw new InvalidOperationException("Operation not called on main thread.");
             }
         }
+
+        /// <summary>
+        /// Queues an action to be run on the main thread by <see cref="RunDeferredActions"/>.
+        /// This never blocks, so it is safe to call from any thread, including the finalizer thread.
+        /// </summary>
+        /// <param name="action">The action to run.</param>
+        public static void RunOnMainThread(Action action)
+        {
+            if (action == null)
+            {
+                throw new ArgumentNullException("action");
+            }
+            m_deferredActions.Enqueue(action);
+        }
+
+        /// <summary>
+        /// Runs the actions queued by <see cref="RunOnMainThread"/> in the order they were queued, stopping
+        /// once the queue is empty or the time budget is used up. At least one action is run if any are
+        /// queued, so the queue always makes progress.
+        /// </summary>
+        /// <param name="budget">The maximum time to spend in milliseconds.</param>
+        /// <returns>The number of actions that were run.</returns>
+        /// <exception cref="InvalidOperationException">Thrown if not called on the main thread.</exception>
+        public static int RunDeferredActions(double budget)
+        {
+            EnsureMainThread();
+
+            long start = Stopwatch.GetTimestamp();
+            int count = 0;
+
+            while (m_deferredActions.TryDequeue(out Action action))
+            {
+                try
+                {
+                    action();
+                }
+                catch (Exception e)
+                {
+                    Logger.Exception(e);
+                }
+                count++;
+
+                double elapsed = (1000.0 * (Stopwatch.GetTimestamp() - start)) / Stopwatch.Frequency;
+                if (elapsed >= budget)
+                {
+                    break;
+                }
+            }
+            return count;
+        }
     }
 }
\ No newline at end of file
@@ -0,0 +1,263 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Globalization;
+
+namespace Engine
+{
+    /// <summary>
+    /// Contains methods for writing values into character buffers without allocating, used to
+    /// implement <see cref="ICharFormattable"/>.
+    /// </summary>
+    /// <remarks>
+    /// Each method advances the index past the written characters and returns false if the buffer is too
+    /// small. Numbers are written using the invariant culture and match the text produced by
+    /// <see cref="float.ToString(string, IFormatProvider)"/>, except for floats that need an exponent
+    /// or are too large to fit in a <see cref="long"/>, which fall back to allocating a string.
+    /// </remarks>
+    public static class CharFormat
+    {
+        /// <summary>
+        /// The number of significant digits used when formatting a float.
+        /// </summary>
+        private const int FLOAT_PRECISION = 7;
+
+        private static readonly long[] POWERS_OF_10 =
+        {
+            1L,
+            10L,
+            100L,
+            1000L,
+            10000L,
+            100000L,
+            1000000L,
+            10000000L,
+            100000000L,
+            1000000000L,
+            10000000000L,
+            100000000000L,
+            1000000000000L,
+            10000000000000L,
+            100000000000000L,
+            1000000000000000L,
+            10000000000000000L,
+            100000000000000000L,
+            1000000000000000000L,
+        };
+
+        /// <summary>
+        /// Writes a character.
+        /// </summary>
+        public static bool TryWrite(char[] destination, ref int index, char value)
+        {
+            if (index >= destination.Length)
+            {
+                return false;
+            }
+            destination[index++] = value;
+            return true;
+        }
+
+        /// <summary>
+        /// Writes a string.
+        /// </summary>
+        public static bool TryWrite(char[] destination, ref int index, string value)
+        {
+            if (index + value.Length > destination.Length)
+            {
+                return false;
+            }
+            value.CopyTo(0, destination, index, value.Length);
+            index += value.Length;
+            return true;
+        }
+
+        /// <summary>
+        /// Writes an integer.
+        /// </summary>
+        public static bool TryWrite(char[] destination, ref int index, int value)
+        {
+            bool negative = value < 0;
+            ulong magnitude = negative ? (ulong)(-(long)value) : (ulong)value;
+            return TryWriteDigits(destination, ref index, magnitude, 0, negative);
+        }
+
+        /// <summary>
+        /// Writes a float with a fixed number of decimal places, like the "F" format specifier.
+        /// </summary>
+        /// <param name="destination">The buffer to write to.</param>
+        /// <param name="index">The index to write at, advanced past the written characters.</param>
+        /// <param name="value">The value to write.</param>
+        /// <param name="decimals">The number of digits after the decimal point.</param>
+        public static bool TryWrite(char[] destination, ref int index, float value, int decimals)
+        {
+            if (float.IsNaN(value) || float.IsInfinity(value))
+            {
+                return TryWriteSpecial(destination, ref index, value);
+            }
+
+            if (value == 0f)
+            {
+                return TryWriteDigits(destination, ref index, 0, decimals, false);
+            }
+
+            // like float.ToString, first round to the precision of a float, then to the requested decimal places
+            ulong digits = RoundToPrecision(Math.Abs((double)value), out int exponent);
+            int shift = exponent + 1 + decimals - FLOAT_PRECISION;
+
+            if (shift >= 0)
+            {
+                if (shift > POWERS_OF_10.Length - FLOAT_PRECISION - 1)
+                {
+                    return TryWrite(destination, ref index, value.ToString("F" + decimals, CultureInfo.InvariantCulture));
+                }
+                digits *= (ulong)POWERS_OF_10[shift];
+            }
+            else if (-shift > FLOAT_PRECISION)
+            {
+                digits = 0;
+            }
+            else
+            {
+                ulong divisor = (ulong)POWERS_OF_10[-shift];
+                digits = (digits + (divisor / 2)) / divisor;
+            }
+
+            return TryWriteDigits(destination, ref index, digits, decimals, value < 0f && digits != 0);
+        }
+
+        /// <summary>
+        /// Writes a float using the shortest representation up to seven significant digits,
+        /// like the "G" format specifier.
+        /// </summary>
+        /// <param name="destination">The buffer to write to.</param>
+        /// <param name="index">The index to write at, advanced past the written characters.</param>
+        /// <param name="value">The value to write.</param>
+        public static bool TryWrite(char[] destination, ref int index, float value)
+        {
+            if (float.IsNaN(value) || float.IsInfinity(value))
+            {
+                return TryWriteSpecial(destination, ref index, value);
+            }
+            if (value == 0f)
+            {
+                return TryWrite(destination, ref index, '0');
+            }
+
+            ulong digits = RoundToPrecision(Math.Abs((double)value), out int exponent);
+
+            // the "G" format switches to scientific notation for these exponents
+            if (exponent < -5 || exponent >= FLOAT_PRECISION)
+            {
+                return TryWrite(destination, ref index, value.ToString(CultureInfo.InvariantCulture));
+            }
+
+            // drop trailing zeros, keeping any needed before the decimal point
+            int decimals = FLOAT_PRECISION - 1 - exponent;
+            while (decimals > 0 && digits % 10 == 0)
+            {
+                digits /= 10;
+                decimals--;
+            }
+
+            return TryWriteDigits(destination, ref index, digits, decimals, value < 0f);
+        }
+
+        /// <summary>
+        /// Writes a value formatted by <see cref="ICharFormattable.TryFormat"/>. This does not box the value.
+        /// </summary>
+        public static bool TryWrite<T>(char[] destination, ref int index, T value) where T : ICharFormattable
+        {
+            if (value.TryFormat(destination, index, out int charsWritten))
+            {
+                index += charsWritten;
+                return true;
+            }
+            return false;
+        }
+
+        /// <summary>
+        /// Writes a number stored as an integer scaled by a power of ten.
+        /// </summary>
+        /// <param name="destination">The buffer to write to.</param>
+        /// <param name="index">The index to write at, advanced past the written characters.</param>
+        /// <param name="digits">The magnitude of the number multiplied by 10^decimals.</param>
+        /// <param name="decimals">The number of digits to write after the decimal point.</param>
+        /// <param name="negative">If true a minus sign is written.</param>
+        public static bool TryWriteDigits(char[] destination, ref int index, ulong digits, int decimals, bool negative)
+        {
+            // count the digits needed, with at least one before the decimal point
+            int digitCount = 1;
+            for (ulong d = digits / 10; d != 0; d /= 10)
+            {
+                digitCount++;
+            }
+            digitCount = Math.Max(digitCount, decimals + 1);
+
+            int length = digitCount + (decimals > 0 ? 1 : 0) + (negative ? 1 : 0);
+            if (index + length > destination.Length)
+            {
+                return false;
+            }
+
+            // write the digits from the end backwards
+            int end = index + length;
+            int pos = end;
+            for (int i = 0; i < digitCount; i++)
+            {
+                if (i == decimals && decimals > 0)
+                {
+                    destination[--pos] = '.';
+                }
+                destination[--pos] = (char)('0' + (int)(digits % 10));
+                digits /= 10;
+            }
+            if (negative)
+            {
+                destination[--pos] = '-';
+            }
+
+            index = end;
+            return true;
+        }
+
+        /// <summary>
+        /// Rounds a positive number to the number of significant digits in a float.
+        /// </summary>
+        /// <param name="magnitude">The number to round.</param>
+        /// <param name="exponent">Returns the base 10 exponent of the most significant digit.</param>
+        /// <returns>The significant digits as an integer.</returns>
+        private static ulong RoundToPrecision(double magnitude, out int exponent)
+        {
+            exponent = (int)Math.Floor(Math.Log10(magnitude));
+
+            ulong digits = (ulong)Math.Round(magnitude * Math.Pow(10, FLOAT_PRECISION - 1 - exponent), MidpointRounding.AwayFromZero);
+
+            // correct for the logarithm being slightly off near powers of ten
+            if (digits >= (ulong)POWERS_OF_10[FLOAT_PRECISION])
+            {
+                digits = (digits + 5) / 10;
+                exponent++;
+            }
+            else if (digits < (ulong)POWERS_OF_10[FLOAT_PRECISION - 1])
+            {
+                exponent--;
+                digits = (ulong)Math.Round(magnitude * Math.Pow(10, FLOAT_PRECISION - 1 - exponent), MidpointRounding.AwayFromZero);
+            }
+            return digits;
+        }
+
+        private static bool TryWriteSpecial(char[] destination, ref int index, float value)
+        {
+            NumberFormatInfo info = NumberFormatInfo.InvariantInfo;
+
+            if (float.IsNaN(value))
+            {
+                return TryWrite(destination, ref index, info.NaNSymbol);
+            }
+            return TryWrite(destination, ref index, value > 0f ? info.PositiveInfinitySymbol : info.NegativeInfinitySymbol);
+        }
+    }
+}
@@ -0,0 +1,281 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+
+namespace Engine
+{
+    /// <summary>
+    /// Contains deterministic math functions for <see cref="Fixed"/> numbers.
+    /// </summary>
+    /// <remarks>
+    /// Every function uses only integer arithmetic and constant lookup tables, so the results are bit
+    /// identical on all machines. The tables are stored as literals rather than computed at startup, since
+    /// the floating point functions that would generate them are not guaranteed to round the same everywhere.
+    /// </remarks>
+    public static class FixedMath
+    {
+        /// <summary>
+        /// The value of sin(x) for x in [0, π/2] in 256 steps, with one extra entry to simplify interpolation.
+        /// </summary>
+        private static readonly int[] SIN_TABLE =
+        {
+            0, 402, 804, 1206, 1608, 2010, 2412, 2814, 3216, 3617, 4019, 4420,
+            4821, 5222, 5623, 6023, 6424, 6824, 7224, 7623, 8022, 8421, 8820, 9218,
+            9616, 10014, 10411, 10808, 11204, 11600, 11996, 12391, 12785, 13180, 13573, 13966,
+            14359, 14751, 15143, 15534, 15924, 16314, 16703, 17091, 17479, 17867, 18253, 18639,
+            19024, 19409, 19792, 20175, 20557, 20939, 21320, 21699, 22078, 22457, 22834, 23210,
+            23586, 23961, 24335, 24708, 25080, 25451, 25821, 26190, 26558, 26925, 27291, 27656,
+            28020, 28383, 28745, 29106, 29466, 29824, 30182, 30538, 30893, 31248, 31600, 31952,
+            32303, 32652, 33000, 33347, 33692, 34037, 34380, 34721, 35062, 35401, 35738, 36075,
+            36410, 36744, 37076, 37407, 37736, 38064, 38391, 38716, 39040, 39362, 39683, 40002,
+            40320, 40636, 40951, 41264, 41576, 41886, 42194, 42501, 42806, 43110, 43412, 43713,
+            44011, 44308, 44604, 44898, 45190, 45480, 45769, 46056, 46341, 46624, 46906, 47186,
+            47464, 47741, 48015, 48288, 48559, 48828, 49095, 49361, 49624, 49886, 50146, 50404,
+            50660, 50914, 51166, 51417, 51665, 51911, 52156, 52398, 52639, 52878, 53114, 53349,
+            53581, 53812, 54040, 54267, 54491, 54714, 54934, 55152, 55368, 55582, 55794, 56004,
+            56212, 56418, 56621, 56823, 57022, 57219, 57414, 57607, 57798, 57986, 58172, 58356,
+            58538, 58718, 58896, 59071, 59244, 59415, 59583, 59750, 59914, 60075, 60235, 60392,
+            60547, 60700, 60851, 60999, 61145, 61288, 61429, 61568, 61705, 61839, 61971, 62101,
+            62228, 62353, 62476, 62596, 62714, 62830, 62943, 63054, 63162, 63268, 63372, 63473,
+            63572, 63668, 63763, 63854, 63944, 64031, 64115, 64197, 64277, 64354, 64429, 64501,
+            64571, 64639, 64704, 64766, 64827, 64884, 64940, 64993, 65043, 65091, 65137, 65180,
+            65220, 65259, 65294, 65328, 65358, 65387, 65413, 65436, 65457, 65476, 65492, 65505,
+            65516, 65525, 65531, 65535, 65536, 65536
+        };
+
+        /// <summary>
+        /// The value of atan(x) for x in [0, 1] in 256 steps, with one extra entry to simplify interpolation.
+        /// </summary>
+        private static readonly int[] ATAN_TABLE =
+        {
+            0, 256, 512, 768, 1024, 1280, 1536, 1792, 2047, 2303, 2559, 2814,
+            3070, 3325, 3580, 3836, 4091, 4346, 4600, 4855, 5110, 5364, 5618, 5872,
+            6126, 6380, 6633, 6887, 7140, 7392, 7645, 7898, 8150, 8402, 8653, 8905,
+            9156, 9407, 9657, 9908, 10158, 10408, 10657, 10906, 11155, 11403, 11652, 11899,
+            12147, 12394, 12641, 12887, 13133, 13379, 13624, 13869, 14114, 14358, 14601, 14845,
+            15088, 15330, 15572, 15814, 16055, 16296, 16536, 16776, 17015, 17254, 17492, 17730,
+            17968, 18205, 18441, 18677, 18913, 19148, 19382, 19616, 19850, 20083, 20315, 20547,
+            20779, 21009, 21240, 21469, 21699, 21927, 22156, 22383, 22610, 22836, 23062, 23288,
+            23512, 23737, 23960, 24183, 24406, 24627, 24849, 25069, 25289, 25509, 25727, 25946,
+            26163, 26380, 26597, 26813, 27028, 27242, 27456, 27670, 27882, 28094, 28306, 28517,
+            28727, 28936, 29145, 29354, 29561, 29768, 29975, 30180, 30386, 30590, 30794, 30997,
+            31200, 31402, 31603, 31803, 32003, 32203, 32401, 32600, 32797, 32994, 33190, 33385,
+            33580, 33774, 33968, 34160, 34353, 34544, 34735, 34925, 35115, 35304, 35492, 35680,
+            35867, 36053, 36239, 36424, 36608, 36792, 36975, 37158, 37340, 37521, 37701, 37881,
+            38060, 38239, 38417, 38594, 38771, 38947, 39123, 39297, 39472, 39645, 39818, 39990,
+            40162, 40333, 40503, 40673, 40842, 41010, 41178, 41346, 41512, 41678, 41844, 42008,
+            42172, 42336, 42499, 42661, 42823, 42984, 43145, 43304, 43464, 43622, 43780, 43938,
+            44095, 44251, 44407, 44562, 44716, 44870, 45024, 45176, 45328, 45480, 45631, 45781,
+            45931, 46080, 46229, 46377, 46525, 46672, 46818, 46964, 47109, 47254, 47398, 47542,
+            47685, 47827, 47969, 48111, 48251, 48392, 48531, 48671, 48809, 48947, 49085, 49222,
+            49359, 49495, 49630, 49765, 49899, 50033, 50167, 50299, 50432, 50563, 50695, 50826,
+            50956, 51086, 51215, 51344, 51472, 51472
+        };
+
+        // 2^32 / 2π, used to convert radians to a 32 bit fraction of a turn
+        private const long TURNS_PER_RADIAN = 683565276;
+
+        /// <summary>
+        /// Returns the absolute value of a number.
+        /// </summary>
+        public static Fixed Abs(Fixed n) => n.raw < 0 ? -n : n;
+
+        /// <summary>
+        /// Returns the sign of a number, or zero if the number is zero.
+        /// </summary>
+        public static int Sign(Fixed n) => n.raw > 0 ? 1 : (n.raw < 0 ? -1 : 0);
+
+        /// <summary>
+        /// Returns the lesser of two numbers.
+        /// </summary>
+        public static Fixed Min(Fixed a, Fixed b) => a.raw < b.raw ? a : b;
+
+        /// <summary>
+        /// Returns the greater of two numbers.
+        /// </summary>
+        public static Fixed Max(Fixed a, Fixed b) => a.raw > b.raw ? a : b;
+
+        /// <summary>
+        /// Clamps a number between a minimum and a maximum.
+        /// </summary>
+        /// <param name="n">The number to clamp.</param>
+        /// <param name="min">The minimum value.</param>
+        /// <param name="max">The maximum value.</param>
+        public static Fixed Clamp(Fixed n, Fixed min, Fixed max) => Max(Min(n, max), min);
+
+        /// <summary>
+        /// Returns the largest integer less than or equal to a number.
+        /// </summary>
+        public static Fixed Floor(Fixed n) => Fixed.FromRaw(n.raw & ~(Fixed.One.raw - 1));
+
+        /// <summary>
+        /// Returns the smallest integer greater than or equal to a number.
+        /// </summary>
+        public static Fixed Ceil(Fixed n) => Fixed.FromRaw((n.raw + (Fixed.One.raw - 1)) & ~(Fixed.One.raw - 1));
+
+        /// <summary>
+        /// Linearly interpolates between two values.
+        /// </summary>
+        /// <param name="a">The starting value.</param>
+        /// <param name="b">The end value.</param>
+        /// <param name="t">The blend factor.</param>
+        public static Fixed Lerp(Fixed a, Fixed b, Fixed t) => a + ((b - a) * t);
+
+        /// <summary>
+        /// Gets the square root of a number.
+        /// </summary>
+        /// <remarks>
+        /// The result is rounded towards zero, so the error is less than 2^-16. Returns zero for negative numbers.
+        /// </remarks>
+        /// <param name="n">The number to get the square root of.</param>
+        public static Fixed Sqrt(Fixed n)
+        {
+            if (n.raw <= 0)
+            {
+                return Fixed.Zero;
+            }
+            return Fixed.FromRaw((int)SqrtRaw((ulong)n.raw << Fixed.FRACTIONAL_BITS));
+        }
+
+        /// <summary>
+        /// Computes the integer square root of a number, rounded down.
+        /// </summary>
+        internal static uint SqrtRaw(ulong n)
+        {
+            ulong result = 0;
+            ulong bit = 1UL << 62;
+
+            while (bit > n)
+            {
+                bit >>= 2;
+            }
+
+            while (bit != 0)
+            {
+                if (n >= result + bit)
+                {
+                    n -= result + bit;
+                    result = (result >> 1) + bit;
+                }
+                else
+                {
+                    result >>= 1;
+                }
+                bit >>= 2;
+            }
+
+            return (uint)result;
+        }
+
+        /// <summary>
+        /// Gets the sine of an angle.
+        /// </summary>
+        /// <remarks>
+        /// The absolute error is less than 3e-5.
+        /// </remarks>
+        /// <param name="angle">The angle in radians.</param>
+        public static Fixed Sin(Fixed angle)
+        {
+            return Fixed.FromRaw(SinTurn(ToTurn(angle)));
+        }
+
+        /// <summary>
+        /// Gets the cosine of an angle.
+        /// </summary>
+        /// <remarks>
+        /// The absolute error is less than 3e-5.
+        /// </remarks>
+        /// <param name="angle">The angle in radians.</param>
+        public static Fixed Cos(Fixed angle)
+        {
+            return Fixed.FromRaw(SinTurn(ToTurn(angle) + 0x40000000));
+        }
+
+        /// <summary>
+        /// Gets the sine and cosine of an angle.
+        /// </summary>
+        /// <param name="angle">The angle in radians.</param>
+        /// <param name="sin">The sine of the angle.</param>
+        /// <param name="cos">The cosine of the angle.</param>
+        public static void SinCos(Fixed angle, out Fixed sin, out Fixed cos)
+        {
+            uint turn = ToTurn(angle);
+            sin = Fixed.FromRaw(SinTurn(turn));
+            cos = Fixed.FromRaw(SinTurn(turn + 0x40000000));
+        }
+
+        /// <summary>
+        /// Converts an angle to a fraction of a turn, where 2^32 is one full turn.
+        /// </summary>
+        private static uint ToTurn(Fixed angle)
+        {
+            return (uint)((angle.raw * TURNS_PER_RADIAN) >> Fixed.FRACTIONAL_BITS);
+        }
+
+        /// <summary>
+        /// Gets the sine of a fraction of a turn as a raw fixed-point value.
+        /// </summary>
+        private static int SinTurn(uint turn)
+        {
+            uint quadrant = turn >> 30;
+            uint offset = turn & 0x3FFFFFFF;
+
+            // the second and fourth quadrants mirror the first and third
+            if ((quadrant & 1) != 0)
+            {
+                offset = 0x40000000 - offset;
+            }
+
+            int index = (int)(offset >> 22);
+            long fraction = offset & 0x3FFFFF;
+
+            int a = SIN_TABLE[index];
+            int b = SIN_TABLE[index + 1];
+            int value = a + (int)(((b - a) * fraction) >> 22);
+
+            return quadrant >= 2 ? -value : value;
+        }
+
+        /// <summary>
+        /// Gets the angle whose tangent is the quotient of two numbers.
+        /// </summary>
+        /// <remarks>
+        /// The absolute error is less than 5e-5 radians. Returns zero when both arguments are zero.
+        /// </remarks>
+        /// <param name="y">The y coordinate of a point.</param>
+        /// <param name="x">The x coordinate of a point.</param>
+        /// <returns>The angle in radians in the range [-π, π].</returns>
+        public static Fixed Atan2(Fixed y, Fixed x)
+        {
+            long absX = x.raw < 0 ? -(long)x.raw : x.raw;
+            long absY = y.raw < 0 ? -(long)y.raw : y.raw;
+
+            if (absX == 0 && absY == 0)
+            {
+                return Fixed.Zero;
+            }
+
+            // reduce to the first octant so the ratio is in [0, 1]
+            bool swap = absY > absX;
+            long ratio = swap ? (absX << 16) / absY : (absY << 16) / absX;
+
+            int index = (int)(ratio >> 8);
+            long fraction = ratio & 0xFF;
+
+            int a = ATAN_TABLE[index];
+            int b = ATAN_TABLE[index + 1];
+            int angle = a + (int)(((b - a) * fraction) >> 8);
+
+            if (swap)
+            {
+                angle = Fixed.PiOver2.raw - angle;
+            }
+            if (x.raw < 0)
+            {
+                angle = Fixed.Pi.raw - angle;
+            }
+            return Fixed.FromRaw(y.raw < 0 ? -angle : angle);
+        }
+    }
+}
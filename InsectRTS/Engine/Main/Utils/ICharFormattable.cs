@@ -0,0 +1,27 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+namespace Engine
+{
+    /// <summary>
+    /// Implemented by types that can write their text representation into a character buffer
+    /// without allocating any strings.
+    /// </summary>
+    public interface ICharFormattable
+    {
+        /// <summary>
+        /// Writes the text of <see cref="object.ToString"/> into a buffer.
+        /// </summary>
+        /// <remarks>
+        /// Numbers are always written using the invariant culture, so the text only matches
+        /// <see cref="object.ToString"/> when the current culture formats numbers the same way.
+        /// </remarks>
+        /// <param name="destination">The buffer to write to.</param>
+        /// <param name="index">The index in the buffer to start writing at.</param>
+        /// <param name="charsWritten">Returns the number of characters written, or zero on failure.</param>
+        /// <returns>False if the buffer was too small, in which case the contents of the buffer after
+        /// <paramref name="index"/> are undefined.</returns>
+        bool TryFormat(char[] destination, int index, out int charsWritten);
+    }
+}
@@ -0,0 +1,64 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+namespace Engine.Logging
+{
+    /// <summary>
+    /// Describes the layout of binary event log files.
+    /// </summary>
+    /// <remarks>
+    /// A file starts with a header containing <see cref="MAGIC"/>, <see cref="VERSION"/>, the stopwatch
+    /// frequency, the stopwatch timestamp at the start of the session and the local time at the start
+    /// of the session in ticks. It is followed by records, each starting with a <see cref="RecordType"/>.
+    /// 
+    /// A template record contains the template ID, the log level and the template text.
+    /// 
+    /// An events record contains the ID of the thread that logged the events, the timestamp the first
+    /// event is relative to, and the length in bytes of the encoded events that follow. Each event is
+    /// the template ID as a var int, the time since the previous event as a var int, the argument count
+    /// as a byte and then the arguments. Each argument is an <see cref="ArgType"/> followed by the value.
+    /// Integers are zig-zag encoded var ints, floating point values are stored in little endian and
+    /// strings are a 16-bit byte count followed by UTF-8 text.
+    /// </remarks>
+    internal static class BinaryLogFormat
+    {
+        /// <summary>
+        /// Identifies a binary log file. The ASCII text "IRTSBLOG".
+        /// </summary>
+        public const ulong MAGIC = 0x474F4C4253545249UL;
+
+        /// <summary>
+        /// The version of the file format.
+        /// </summary>
+        public const int VERSION = 1;
+
+        /// <summary>
+        /// The maximum number of characters stored for a string argument.
+        /// </summary>
+        public const int MAX_STRING_LENGTH = 1024;
+
+        /// <summary>
+        /// The kinds of record in a binary log.
+        /// </summary>
+        public enum RecordType : byte
+        {
+            Template    = 1,
+            Events      = 2,
+        }
+
+        /// <summary>
+        /// The types of event argument.
+        /// </summary>
+        public enum ArgType : byte
+        {
+            Int         = 0,
+            Long        = 1,
+            Float       = 2,
+            Double      = 3,
+            True        = 4,
+            False       = 5,
+            String      = 6,
+        }
+    }
+}
@@ -0,0 +1,240 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+using System.Text;
+
+namespace Engine.Logging
+{
+    /// <summary>
+    /// Decodes binary event logs into the same text format used by the text log.
+    /// </summary>
+    public static class BinaryLogReader
+    {
+        private struct Template
+        {
+            public LogLevel level;
+            public string format;
+        }
+
+        private struct Event
+        {
+            public long timestamp;
+            public long order;
+            public int threadId;
+            public int templateId;
+            public object[] args;
+        }
+
+        /// <summary>
+        /// Decodes a binary log. Events from all threads are merged in the order they were logged.
+        /// </summary>
+        /// <param name="input">The binary log to read.</param>
+        /// <param name="output">The writer to output the text log to.</param>
+        /// <param name="includeThreadIds">If true each message is prefixed with the ID of the thread that logged it.</param>
+        /// <returns>The number of decoded events.</returns>
+        /// <exception cref="InvalidDataException">Thrown if the input is not a supported binary log.</exception>
+        public static int Decode(Stream input, TextWriter output, bool includeThreadIds)
+        {
+            BinaryReader reader = new BinaryReader(input, Encoding.UTF8);
+
+            if (reader.ReadUInt64() != BinaryLogFormat.MAGIC)
+            {
+                throw new InvalidDataException("The input is not a binary log!");
+            }
+
+            int version = reader.ReadInt32();
+            if (version != BinaryLogFormat.VERSION)
+            {
+                throw new InvalidDataException($"Binary log version {version} is not supported, expected version {BinaryLogFormat.VERSION}!");
+            }
+
+            long frequency = reader.ReadInt64();
+            long startTimestamp = reader.ReadInt64();
+            DateTime startTime = new DateTime(reader.ReadInt64());
+
+            Dictionary<int, Template> templates = new Dictionary<int, Template>();
+            List<Event> events = new List<Event>();
+
+            try
+            {
+                while (input.Position < input.Length)
+                {
+                    BinaryLogFormat.RecordType type = (BinaryLogFormat.RecordType)reader.ReadByte();
+
+                    switch (type)
+                    {
+                        case BinaryLogFormat.RecordType.Template:
+                        {
+                            int id = reader.ReadInt32();
+                            templates[id] = new Template
+                            {
+                                level = (LogLevel)reader.ReadByte(),
+                                format = reader.ReadString(),
+                            };
+                            break;
+                        }
+                        case BinaryLogFormat.RecordType.Events:
+                        {
+                            int threadId = reader.ReadInt32();
+                            long timestamp = reader.ReadInt64();
+                            int length = reader.ReadInt32();
+                            byte[] data = reader.ReadBytes(length);
+
+                            if (data.Length < length)
+                            {
+                                throw new EndOfStreamException();
+                            }
+                            ReadEvents(data, threadId, timestamp, events);
+                            break;
+                        }
+                        default:
+                            throw new InvalidDataException($"Unknown record type {type} at offset {input.Position - 1}!");
+                    }
+                }
+            }
+            catch (EndOfStreamException)
+            {
+                // the log was not completely written, most likely due to a crash, so decode what is there
+            }
+
+            // buffers from different threads are written in the order they fill up
+            events.Sort((x, y) => x.timestamp != y.timestamp ? x.timestamp.CompareTo(y.timestamp) : x.order.CompareTo(y.order));
+
+            StringBuilder sb = new StringBuilder();
+            foreach (Event e in events)
+            {
+                DateTime time = startTime.AddTicks((long)((e.timestamp - startTimestamp) * ((double)TimeSpan.TicksPerSecond / frequency)));
+
+                if (!templates.TryGetValue(e.templateId, out Template template))
+                {
+                    template = new Template
+                    {
+                        level = LogLevel.Warning,
+                        format = $"Unknown event template {e.templateId}",
+                    };
+                }
+
+                LogMessage.AppendLineStart(sb, time, template.level);
+                if (includeThreadIds)
+                {
+                    sb.Append("[Thread ").Append(e.threadId).Append("] ");
+                }
+                AppendMessage(sb, template.format, e.args);
+                sb.AppendLine();
+
+                output.Write(sb.ToString());
+                sb.Clear();
+            }
+
+            return events.Count;
+        }
+
+        private static void ReadEvents(byte[] data, int threadId, long timestamp, List<Event> events)
+        {
+            int index = 0;
+            while (index < data.Length)
+            {
+                Event e = new Event();
+                e.threadId = threadId;
+                e.order = events.Count;
+                e.templateId = (int)ReadVarInt(data, ref index);
+
+                timestamp += (long)ReadVarInt(data, ref index);
+                e.timestamp = timestamp;
+
+                int argCount = data[index++];
+                e.args = new object[argCount];
+                for (int i = 0; i < argCount; i++)
+                {
+                    e.args[i] = ReadArg(data, ref index);
+                }
+
+                events.Add(e);
+            }
+        }
+
+        private static object ReadArg(byte[] data, ref int index)
+        {
+            BinaryLogFormat.ArgType type = (BinaryLogFormat.ArgType)data[index++];
+
+            switch (type)
+            {
+                case BinaryLogFormat.ArgType.Int:
+                    return (int)ReadZigZag(data, ref index);
+                case BinaryLogFormat.ArgType.Long:
+                    return ReadZigZag(data, ref index);
+                case BinaryLogFormat.ArgType.Float:
+                {
+                    float value = BitConverter.ToSingle(data, index);
+                    index += 4;
+                    return value;
+                }
+                case BinaryLogFormat.ArgType.Double:
+                {
+                    double value = BitConverter.ToDouble(data, index);
+                    index += 8;
+                    return value;
+                }
+                case BinaryLogFormat.ArgType.True:
+                    return true;
+                case BinaryLogFormat.ArgType.False:
+                    return false;
+                case BinaryLogFormat.ArgType.String:
+                {
+                    int byteCount = BitConverter.ToUInt16(data, index);
+                    string value = Encoding.UTF8.GetString(data, index + 2, byteCount);
+                    index += 2 + byteCount;
+                    return value;
+                }
+                default:
+                    throw new InvalidDataException($"Unknown argument type {type}!");
+            }
+        }
+
+        private static void AppendMessage(StringBuilder sb, string format, object[] args)
+        {
+            int start = sb.Length;
+            try
+            {
+                sb.AppendFormat(CultureInfo.InvariantCulture, format, args);
+            }
+            catch (FormatException)
+            {
+                // show the raw values if the template does not match the arguments
+                sb.Length = start;
+                sb.Append(format);
+                foreach (object arg in args)
+                {
+                    sb.Append(' ').Append(arg);
+                }
+            }
+        }
+
+        private static long ReadZigZag(byte[] data, ref int index)
+        {
+            ulong value = ReadVarInt(data, ref index);
+            return (long)(value >> 1) ^ -(long)(value & 1);
+        }
+
+        private static ulong ReadVarInt(byte[] data, ref int index)
+        {
+            ulong value = 0;
+            int shift = 0;
+            byte b;
+            do
+            {
+                b = data[index++];
+                value |= (ulong)(b & 0x7F) << shift;
+                shift += 7;
+            }
+            while ((b & 0x80) != 0);
+
+            return value;
+        }
+    }
+}
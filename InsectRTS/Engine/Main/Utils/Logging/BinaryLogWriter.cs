@@ -0,0 +1,561 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Runtime.CompilerServices;
+using System.Text;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace Engine.Logging
+{
+    /// <summary>
+    /// Writes structured events to a compact binary log file. Only a template ID, a timestamp and the
+    /// typed arguments are stored for each event, and all formatting is left to the decoder.
+    /// </summary>
+    /// <remarks>
+    /// Each thread encodes events into its own buffer, taking only an uncontended flag on the buffer.
+    /// A buffer is passed to the writer thread once it is full, once it holds events older than the
+    /// flush interval when the next event is logged, or when <see cref="Flush"/> is called. Every
+    /// thread's buffer is registered with the writer, which also collects buffers that have held events
+    /// for longer than the flush interval, so threads that stop logging do not keep their last events.
+    /// When the process exits normally all buffers are collected, except for those of threads that are
+    /// logging at that moment. See <see cref="BinaryLogFormat"/> for the file layout.
+    /// </remarks>
+    internal class BinaryLogWriter
+    {
+        /// <summary>
+        /// The size in bytes of each thread's event buffer.
+        /// </summary>
+        private const int BUFFER_SIZE = 64 * 1024;
+
+        /// <summary>
+        /// The largest possible encoded event without arguments.
+        /// </summary>
+        private const int MAX_HEADER_SIZE = 5 + 10 + 1;
+
+        /// <summary>
+        /// The largest possible encoded argument, excluding strings.
+        /// </summary>
+        private const int MAX_ARG_SIZE = 1 + 10;
+
+        /// <summary>
+        /// The maximum number of buffers waiting to be written or reused.
+        /// </summary>
+        private const int QUEUE_CAPACITY = 64;
+
+        private class EventBuffer
+        {
+            public readonly byte[] data = new byte[BUFFER_SIZE];
+            public int threadId;
+            public int length;
+            public long baseTimestamp;
+            public long lastTimestamp;
+        }
+
+        /// <summary>
+        /// A thread that logs events to a writer. The thread and the writer take the busy flag before
+        /// using the current buffer.
+        /// </summary>
+        /// <remarks>
+        /// The flag is a single interlocked exchange rather than a monitor, which costs about a third as
+        /// much, since the writer only competes for it while collecting buffers from idle threads.
+        /// </remarks>
+        private class LoggingThread
+        {
+            public readonly Thread thread = Thread.CurrentThread;
+            public BinaryLogWriter owner;
+            public EventBuffer buffer;
+            private int m_busy;
+
+            public void Enter()
+            {
+                if (Interlocked.CompareExchange(ref m_busy, 1, 0) != 0)
+                {
+                    SpinWait spin = new SpinWait();
+                    while (Interlocked.CompareExchange(ref m_busy, 1, 0) != 0)
+                    {
+                        spin.SpinOnce();
+                    }
+                }
+            }
+
+            public bool TryEnter()
+            {
+                return Interlocked.CompareExchange(ref m_busy, 1, 0) == 0;
+            }
+
+            public void Exit()
+            {
+                Volatile.Write(ref m_busy, 0);
+            }
+        }
+
+        [ThreadStatic]
+        private static LoggingThread m_thread;
+
+        private readonly List<LoggingThread> m_threads = new List<LoggingThread>();
+
+        private readonly LogQueue<EventBuffer> m_pending = new LogQueue<EventBuffer>(QUEUE_CAPACITY);
+        private readonly LogQueue<EventBuffer> m_free = new LogQueue<EventBuffer>(QUEUE_CAPACITY);
+        private readonly AutoResetEvent m_wakeEvent = new AutoResetEvent(false);
+
+        private readonly object m_fileLock = new object();
+        private readonly FileStream m_fileStream;
+        private readonly BinaryWriter m_fileWriter;
+        private readonly int m_flushInterval;
+        private readonly long m_flushTicks;
+        private int m_templateCount;
+
+        /// <summary>
+        /// Creates a new binary log writer and spawns a new thread to write from.
+        /// </summary>
+        /// <param name="outputFile">The log file to output to.</param>
+        /// <param name="flushInterval">The time in milliseconds after which the events in a thread's buffer
+        /// are passed to the writer.</param>
+        public BinaryLogWriter(FileInfo outputFile, int flushInterval)
+        {
+            m_flushInterval = flushInterval;
+            m_flushTicks = (flushInterval * Stopwatch.Frequency) / 1000;
+
+            m_fileStream = new FileStream(outputFile.FullName, FileMode.Create, FileAccess.Write, FileShare.Read | FileShare.Delete, BUFFER_SIZE);
+            m_fileWriter = new BinaryWriter(m_fileStream, Encoding.UTF8);
+
+            m_fileWriter.Write(BinaryLogFormat.MAGIC);
+            m_fileWriter.Write(BinaryLogFormat.VERSION);
+            m_fileWriter.Write(Stopwatch.Frequency);
+            m_fileWriter.Write(Stopwatch.GetTimestamp());
+            m_fileWriter.Write(DateTime.Now.Ticks);
+
+            // make sure buffered events are not lost when the application closes normally
+            AppDomain.CurrentDomain.ProcessExit += (s, e) => FlushAll();
+
+            // start a thread for the write loop
+            Task task = new Task(WriteLoop, TaskCreationOptions.LongRunning);
+            task.Start();
+        }
+
+        /// <summary>
+        /// Registers an event template.
+        /// </summary>
+        /// <param name="level">The level of the events.</param>
+        /// <param name="format">The text of the events, with argument placeholders.</param>
+        /// <returns>The handle used to log events with this template.</returns>
+        public LogEvent RegisterTemplate(LogLevel level, string format)
+        {
+            if (format == null)
+            {
+                throw new ArgumentNullException("format");
+            }
+
+            // templates are written directly so they always come before any events that use them
+            lock (m_fileLock)
+            {
+                int id = m_templateCount++;
+
+                m_fileWriter.Write((byte)BinaryLogFormat.RecordType.Template);
+                m_fileWriter.Write(id);
+                m_fileWriter.Write((byte)level);
+                m_fileWriter.Write(format);
+
+                return new LogEvent(id, level);
+            }
+        }
+
+        /// <summary>
+        /// Logs an event without arguments.
+        /// </summary>
+        public void Write(LogEvent logEvent)
+        {
+            LogArg none = default(LogArg);
+            Write(logEvent, 0, ref none, ref none, ref none, ref none);
+        }
+
+        /// <summary>
+        /// Logs an event with one argument.
+        /// </summary>
+        public void Write(LogEvent logEvent, LogArg arg0)
+        {
+            LogArg none = default(LogArg);
+            Write(logEvent, 1, ref arg0, ref none, ref none, ref none);
+        }
+
+        /// <summary>
+        /// Logs an event with two arguments.
+        /// </summary>
+        public void Write(LogEvent logEvent, LogArg arg0, LogArg arg1)
+        {
+            LogArg none = default(LogArg);
+            Write(logEvent, 2, ref arg0, ref arg1, ref none, ref none);
+        }
+
+        /// <summary>
+        /// Logs an event with three arguments.
+        /// </summary>
+        public void Write(LogEvent logEvent, LogArg arg0, LogArg arg1, LogArg arg2)
+        {
+            LogArg none = default(LogArg);
+            Write(logEvent, 3, ref arg0, ref arg1, ref arg2, ref none);
+        }
+
+        /// <summary>
+        /// Logs an event with four arguments.
+        /// </summary>
+        public void Write(LogEvent logEvent, LogArg arg0, LogArg arg1, LogArg arg2, LogArg arg3)
+        {
+            Write(logEvent, 4, ref arg0, ref arg1, ref arg2, ref arg3);
+        }
+
+        /// <summary>
+        /// Passes the events logged by the calling thread to the writer, and waits until all submitted
+        /// events are written to the file.
+        /// </summary>
+        public void Flush()
+        {
+            LoggingThread thread = m_thread;
+            if (thread != null && thread.owner == this)
+            {
+                thread.Enter();
+                try
+                {
+                    if (thread.buffer.length > 0)
+                    {
+                        Submit(thread);
+                    }
+                }
+                finally
+                {
+                    thread.Exit();
+                }
+            }
+
+            lock (m_fileLock)
+            {
+                WritePending();
+                m_fileWriter.Flush();
+            }
+        }
+
+        /// <summary>
+        /// Writes the events buffered by every thread to the file.
+        /// </summary>
+        public void FlushAll()
+        {
+            lock (m_fileLock)
+            {
+                WritePending();
+                Collect(true);
+                WritePending();
+                m_fileWriter.Flush();
+            }
+        }
+
+        private void Write(LogEvent logEvent, int argCount, ref LogArg arg0, ref LogArg arg1, ref LogArg arg2, ref LogArg arg3)
+        {
+            long timestamp = Stopwatch.GetTimestamp();
+
+            LoggingThread thread = m_thread;
+            if (thread == null || thread.owner != this)
+            {
+                thread = Register();
+            }
+
+            int maxSize = MAX_HEADER_SIZE;
+            switch (argCount)
+            {
+                case 4: maxSize += GetMaxSize(ref arg3); goto case 3;
+                case 3: maxSize += GetMaxSize(ref arg2); goto case 2;
+                case 2: maxSize += GetMaxSize(ref arg1); goto case 1;
+                case 1: maxSize += GetMaxSize(ref arg0); break;
+            }
+
+            thread.Enter();
+            try
+            {
+                EventBuffer buffer = thread.buffer;
+
+                // hand the buffer to the writer if this event does not fit, or it has been holding events too long
+                if (buffer.length > 0 && (buffer.length + maxSize > BUFFER_SIZE || timestamp - buffer.baseTimestamp > m_flushTicks))
+                {
+                    buffer = Submit(thread);
+                }
+                if (buffer.length == 0)
+                {
+                    buffer.baseTimestamp = timestamp;
+                    buffer.lastTimestamp = timestamp;
+                }
+
+                Encode(buffer, timestamp, logEvent, argCount, ref arg0, ref arg1, ref arg2, ref arg3);
+            }
+            finally
+            {
+                thread.Exit();
+            }
+        }
+
+        /// <summary>
+        /// Appends an event to a buffer.
+        /// </summary>
+        private static unsafe void Encode(EventBuffer buffer, long timestamp, LogEvent logEvent, int argCount, ref LogArg arg0, ref LogArg arg1, ref LogArg arg2, ref LogArg arg3)
+        {
+            fixed (byte* start = buffer.data)
+            {
+                byte* ptr = start + buffer.length;
+
+                ptr = WriteVarInt(ptr, (uint)logEvent.id);
+                ptr = WriteVarInt(ptr, (ulong)(timestamp - buffer.lastTimestamp));
+                *ptr++ = (byte)argCount;
+
+                switch (argCount)
+                {
+                    case 1:
+                        ptr = WriteArg(ptr, ref arg0);
+                        break;
+                    case 2:
+                        ptr = WriteArg(ptr, ref arg0);
+                        ptr = WriteArg(ptr, ref arg1);
+                        break;
+                    case 3:
+                        ptr = WriteArg(ptr, ref arg0);
+                        ptr = WriteArg(ptr, ref arg1);
+                        ptr = WriteArg(ptr, ref arg2);
+                        break;
+                    case 4:
+                        ptr = WriteArg(ptr, ref arg0);
+                        ptr = WriteArg(ptr, ref arg1);
+                        ptr = WriteArg(ptr, ref arg2);
+                        ptr = WriteArg(ptr, ref arg3);
+                        break;
+                }
+
+                buffer.length = (int)(ptr - start);
+            }
+
+            buffer.lastTimestamp = timestamp;
+        }
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static int GetMaxSize(ref LogArg arg)
+        {
+            if (arg.type == BinaryLogFormat.ArgType.String && arg.text != null)
+            {
+                // UTF-8 uses at most three bytes per UTF-16 character
+                return 1 + 2 + (Math.Min(arg.text.Length, BinaryLogFormat.MAX_STRING_LENGTH) * 3);
+            }
+            return MAX_ARG_SIZE;
+        }
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static unsafe byte* WriteArg(byte* ptr, ref LogArg arg)
+        {
+            *ptr++ = (byte)arg.type;
+
+            switch (arg.type)
+            {
+                case BinaryLogFormat.ArgType.Int:
+                case BinaryLogFormat.ArgType.Long:
+                    // zig-zag encoding keeps small negative values small
+                    return WriteVarInt(ptr, (ulong)((arg.bits << 1) ^ (arg.bits >> 63)));
+                case BinaryLogFormat.ArgType.Float:
+                    *(int*)ptr = (int)arg.bits;
+                    return ptr + 4;
+                case BinaryLogFormat.ArgType.Double:
+                    *(long*)ptr = arg.bits;
+                    return ptr + 8;
+                case BinaryLogFormat.ArgType.String:
+                    return WriteString(ptr, arg.text);
+                default:
+                    return ptr;
+            }
+        }
+
+        private static unsafe byte* WriteString(byte* ptr, string text)
+        {
+            int byteCount = 0;
+            if (text != null)
+            {
+                fixed (char* chars = text)
+                {
+                    int length = Math.Min(text.Length, BinaryLogFormat.MAX_STRING_LENGTH);
+                    byteCount = Encoding.UTF8.GetBytes(chars, length, ptr + 2, length * 3);
+                }
+            }
+            *(ushort*)ptr = (ushort)byteCount;
+            return ptr + 2 + byteCount;
+        }
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static unsafe byte* WriteVarInt(byte* ptr, ulong value)
+        {
+            while (value >= 0x80)
+            {
+                *ptr++ = (byte)(value | 0x80);
+                value >>= 7;
+            }
+            *ptr++ = (byte)value;
+            return ptr;
+        }
+
+        /// <summary>
+        /// Registers the calling thread with this writer and makes it the thread's writer.
+        /// </summary>
+        private LoggingThread Register()
+        {
+            LoggingThread thread = null;
+
+            lock (m_threads)
+            {
+                // the thread may have logged to this writer before switching to another
+                foreach (LoggingThread registered in m_threads)
+                {
+                    if (registered.thread == Thread.CurrentThread)
+                    {
+                        thread = registered;
+                        break;
+                    }
+                }
+
+                if (thread == null)
+                {
+                    thread = new LoggingThread();
+                    thread.owner = this;
+                    thread.buffer = GetBuffer(thread.thread.ManagedThreadId);
+                    m_threads.Add(thread);
+                }
+            }
+
+            m_thread = thread;
+            return thread;
+        }
+
+        /// <summary>
+        /// Gets an empty buffer for a thread.
+        /// </summary>
+        private EventBuffer GetBuffer(int threadId)
+        {
+            if (!m_free.TryDequeue(out EventBuffer buffer))
+            {
+                buffer = new EventBuffer();
+            }
+
+            buffer.threadId = threadId;
+            buffer.length = 0;
+            return buffer;
+        }
+
+        /// <summary>
+        /// Passes a thread's buffer to the writer thread. Must be called while holding the thread's busy flag.
+        /// </summary>
+        /// <returns>The new buffer for the thread.</returns>
+        private EventBuffer Submit(LoggingThread thread)
+        {
+            EventBuffer buffer = thread.buffer;
+
+            if (!m_pending.TryEnqueue(buffer))
+            {
+                // the writer is falling behind, so wait for it rather than lose events
+                SpinWait spin = new SpinWait();
+                while (!m_pending.TryEnqueue(buffer))
+                {
+                    m_wakeEvent.Set();
+                    spin.SpinOnce();
+                }
+            }
+            m_wakeEvent.Set();
+
+            thread.buffer = GetBuffer(buffer.threadId);
+            return thread.buffer;
+        }
+
+        /// <summary>
+        /// Passes the buffers of registered threads to the writer, and forgets threads that have finished.
+        /// Must be called while holding the file lock.
+        /// </summary>
+        /// <param name="all">Collects every buffer holding events, rather than only those holding events
+        /// older than the flush interval.</param>
+        private void Collect(bool all)
+        {
+            long timestamp = Stopwatch.GetTimestamp();
+
+            lock (m_threads)
+            {
+                for (int i = m_threads.Count - 1; i >= 0; i--)
+                {
+                    LoggingThread thread = m_threads[i];
+
+                    // a thread that is logging right now hands over its own buffer when it needs to
+                    if (!thread.TryEnter())
+                    {
+                        continue;
+                    }
+
+                    try
+                    {
+                        EventBuffer buffer = thread.buffer;
+
+                        if (buffer.length > 0 && (all || timestamp - buffer.baseTimestamp > m_flushTicks))
+                        {
+                            // the file lock is held, so make room by writing rather than waiting for the writer
+                            while (!m_pending.TryEnqueue(buffer))
+                            {
+                                WritePending();
+                            }
+                            thread.buffer = GetBuffer(buffer.threadId);
+                        }
+                        else if (buffer.length == 0 && !thread.thread.IsAlive)
+                        {
+                            m_threads.RemoveAt(i);
+                            m_free.TryEnqueue(buffer);
+                        }
+                    }
+                    finally
+                    {
+                        thread.Exit();
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Loop that waits for submitted buffers and writes them.
+        /// </summary>
+        private void WriteLoop()
+        {
+            while (true)
+            {
+                // wake up at least once per flush interval to collect events from idle threads
+                m_wakeEvent.WaitOne(m_flushInterval);
+
+                lock (m_fileLock)
+                {
+                    WritePending();
+                    Collect(false);
+                    WritePending();
+                    m_fileWriter.Flush();
+                }
+            }
+        }
+
+        /// <summary>
+        /// Writes all submitted buffers to the file. Must be called while holding the file lock.
+        /// </summary>
+        private void WritePending()
+        {
+            while (m_pending.TryDequeue(out EventBuffer buffer))
+            {
+                m_fileWriter.Write((byte)BinaryLogFormat.RecordType.Events);
+                m_fileWriter.Write(buffer.threadId);
+                m_fileWriter.Write(buffer.baseTimestamp);
+                m_fileWriter.Write(buffer.length);
+                m_fileWriter.Write(buffer.data, 0, buffer.length);
+
+                buffer.length = 0;
+                m_free.TryEnqueue(buffer);
+            }
+        }
+    }
+}
@@ -0,0 +1,63 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System.Collections.Generic;
+
+namespace Engine.Logging
+{
+    /// <summary>
+    /// A thread safe pool of character buffers, used to format log messages without creating garbage.
+    /// </summary>
+    internal class CharBufferPool
+    {
+        /// <summary>
+        /// The size of newly created buffers.
+        /// </summary>
+        public const int DEFAULT_SIZE = 256;
+
+        /// <summary>
+        /// The maximum number of buffers kept in the pool. Every queued message may hold a buffer, so this
+        /// matches the logger's queue so that a burst that fills the queue does not allocate once warmed up.
+        /// </summary>
+        private const int MAX_POOLED = Logger.QUEUE_CAPACITY;
+
+        /// <summary>
+        /// The pool used for log messages.
+        /// </summary>
+        public static readonly CharBufferPool Shared = new CharBufferPool();
+
+        private readonly Stack<char[]> m_buffers = new Stack<char[]>(MAX_POOLED);
+
+        /// <summary>
+        /// Gets a buffer from the pool, or creates one if none are free.
+        /// </summary>
+        /// <param name="minLength">The minimum length of the buffer.</param>
+        public char[] Rent(int minLength)
+        {
+            lock (m_buffers)
+            {
+                if (m_buffers.Count > 0 && m_buffers.Peek().Length >= minLength)
+                {
+                    return m_buffers.Pop();
+                }
+            }
+            return new char[System.Math.Max(minLength, DEFAULT_SIZE)];
+        }
+
+        /// <summary>
+        /// Returns a buffer to the pool.
+        /// </summary>
+        /// <param name="buffer">A buffer obtained using <see cref="Rent"/>.</param>
+        public void Return(char[] buffer)
+        {
+            lock (m_buffers)
+            {
+                if (m_buffers.Count < MAX_POOLED)
+                {
+                    m_buffers.Push(buffer);
+                }
+            }
+        }
+    }
+}
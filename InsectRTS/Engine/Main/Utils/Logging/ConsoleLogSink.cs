@@ -0,0 +1,29 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+
+namespace Engine.Logging
+{
+    /// <summary>
+    /// Writes log messages to the console. Errors are written to the standard error stream.
+    /// </summary>
+    public class ConsoleLogSink : ILogSink
+    {
+        /// <summary>
+        /// Writes a log message to the console.
+        /// </summary>
+        public void Write(LogLevel level, LogCategory category, string text)
+        {
+            if (level == LogLevel.Error)
+            {
+                Console.Error.Write(text);
+            }
+            else
+            {
+                Console.Out.Write(text);
+            }
+        }
+    }
+}
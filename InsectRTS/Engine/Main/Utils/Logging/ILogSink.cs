@@ -0,0 +1,22 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+namespace Engine.Logging
+{
+    /// <summary>
+    /// A destination for log messages in addition to the log file. See
+    /// <see cref="Logger.AddSink(ILogSink, LogLevel, LogCategory[])"/>.
+    /// </summary>
+    public interface ILogSink
+    {
+        /// <summary>
+        /// Writes a log message. This is called from the log writer thread, or from the thread that
+        /// logged the message in the case of errors, but never from two threads at once.
+        /// </summary>
+        /// <param name="level">The level of the message.</param>
+        /// <param name="category">The category of the message.</param>
+        /// <param name="text">The formatted message as it appears in the log file, including the line break.</param>
+        void Write(LogLevel level, LogCategory category, string text);
+    }
+}
@@ -0,0 +1,32 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+namespace Engine.Logging
+{
+    /// <summary>
+    /// A typed argument of a binary log event. Values are implicitly converted to this type, which
+    /// avoids boxing them.
+    /// </summary>
+    public struct LogArg
+    {
+        internal readonly BinaryLogFormat.ArgType type;
+        internal readonly long bits;
+        internal readonly string text;
+
+        private LogArg(BinaryLogFormat.ArgType type, long bits, string text)
+        {
+            this.type = type;
+            this.bits = bits;
+            this.text = text;
+        }
+
+        public static implicit operator LogArg(int value) => new LogArg(BinaryLogFormat.ArgType.Int, value, null);
+        public static implicit operator LogArg(long value) => new LogArg(BinaryLogFormat.ArgType.Long, value, null);
+        public static implicit operator LogArg(bool value) => new LogArg(value ? BinaryLogFormat.ArgType.True : BinaryLogFormat.ArgType.False, 0, null);
+        public static implicit operator LogArg(string value) => new LogArg(BinaryLogFormat.ArgType.String, 0, value);
+
+        public static unsafe implicit operator LogArg(float value) => new LogArg(BinaryLogFormat.ArgType.Float, *(int*)&value, null);
+        public static unsafe implicit operator LogArg(double value) => new LogArg(BinaryLogFormat.ArgType.Double, *(long*)&value, null);
+    }
+}
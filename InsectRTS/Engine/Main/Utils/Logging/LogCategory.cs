@@ -0,0 +1,17 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+namespace Engine.Logging
+{
+    /// <summary>
+    /// The engine systems that log messages. Each category has its own level threshold.
+    /// </summary>
+    public enum LogCategory : int
+    {
+        General     = 0,
+        Renderer    = 1,
+        Shaders     = 2,
+        Simulation  = 3,
+    }
+}
@@ -0,0 +1,27 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+namespace Engine.Logging
+{
+    /// <summary>
+    /// Identifies a registered event template that can be logged to the binary event log. 
+    /// </summary>
+    /// <remarks>
+    /// Templates are registered once using <see cref="Logger.RegisterEvent(LogLevel, string)"/>, after
+    /// which each logged event only stores the template ID and its arguments. The template text uses
+    /// the same placeholders as <see cref="string.Format(string, object[])"/> and is only formatted
+    /// when the log is decoded.
+    /// </remarks>
+    public struct LogEvent
+    {
+        internal readonly int id;
+        internal readonly LogLevel level;
+
+        internal LogEvent(int id, LogLevel level)
+        {
+            this.id = id;
+            this.level = level;
+        }
+    }
+}
@@ -0,0 +1,42 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+namespace Engine.Logging
+{
+    /// <summary>
+    /// Determines when the log writer flushes its buffered output to the log file. Errors are always
+    /// flushed immediately.
+    /// </summary>
+    internal struct LogFlushPolicy
+    {
+        /// <summary>
+        /// The maximum time in milliseconds written messages may stay buffered before being flushed.
+        /// </summary>
+        public readonly int interval;
+
+        /// <summary>
+        /// The number of buffered characters that causes a flush.
+        /// </summary>
+        public readonly int size;
+
+        /// <summary>
+        /// If true, errors wait until the log file is committed to disk, so that the messages leading up
+        /// to a crash survive even if the operating system fails.
+        /// </summary>
+        public readonly bool syncOnError;
+
+        /// <summary>
+        /// Creates a new flush policy.
+        /// </summary>
+        /// <param name="interval">The maximum time in milliseconds messages may stay buffered.</param>
+        /// <param name="size">The number of buffered characters that causes a flush.</param>
+        /// <param name="syncOnError">If true errors are committed to disk before returning.</param>
+        public LogFlushPolicy(int interval, int size, bool syncOnError)
+        {
+            this.interval = interval;
+            this.size = size;
+            this.syncOnError = syncOnError;
+        }
+    }
+}
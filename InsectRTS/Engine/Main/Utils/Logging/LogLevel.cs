@@ -5,12 +5,12 @@
 namespace Engine.Logging
 {
     /// <summary>
-    /// Represents different types of log messages.
+    /// Represents different types of log messages, in order of increasing severity.
     /// </summary>
-    internal enum LogLevel : int
+    public enum LogLevel : int
     {
-        Info        = 0,
-        Debug       = 1,
+        Debug       = 0,
+        Info        = 1,
         Warning     = 2,
         Error       = 3,
     }
@@ -19,6 +19,7 @@ namespace Engine.Logging
         private static readonly string DATE_FORMAT = "yyyy/MM/dd HH:mm:ss";
 
         private static readonly string[] LEVEL_NAMES = Enum.GetNames(typeof(LogLevel));
+        private static readonly string[] CATEGORY_NAMES = Enum.GetNames(typeof(LogCategory));
         private static readonly int MESSAGE_START_PADDING;
         
         static LogMessage()
@@ -27,34 +28,106 @@ namespace Engine.Logging
         }
 
         private readonly LogLevel m_level;
+        private readonly LogCategory m_category;
         private readonly string m_message;
+        private readonly char[] m_chars;
+        private readonly int m_charCount;
         private readonly string m_stackTrace;
+
+        /// <summary>
+        /// The severity of the message.
+        /// </summary>
+        public LogLevel Level => m_level;
+
+        /// <summary>
+        /// The system that logged the message.
+        /// </summary>
+        public LogCategory Category => m_category;
         
-        public LogMessage(LogLevel level, string message, string stackTrace = null)
+        public LogMessage(LogLevel level, string message, string stackTrace = null) : this(level, LogCategory.General, message, stackTrace)
+        {
+        }
+
+        public LogMessage(LogLevel level, LogCategory category, string message, string stackTrace = null)
         {
             m_level = level;
+            m_category = category;
             m_message = message;
+            m_chars = null;
+            m_charCount = 0;
+            m_stackTrace = stackTrace;
+        }
+
+        /// <summary>
+        /// Creates a message whose content is stored in a buffer from <see cref="CharBufferPool.Shared"/>.
+        /// The buffer is returned to the pool once the message is appended.
+        /// </summary>
+        public LogMessage(LogLevel level, LogCategory category, char[] chars, int charCount, string stackTrace = null)
+        {
+            m_level = level;
+            m_category = category;
+            m_message = null;
+            m_chars = chars;
+            m_charCount = charCount;
             m_stackTrace = stackTrace;
         }
 
         public void AppendTo(StringBuilder sb)
+        {
+            AppendLineStart(sb, DateTime.Now, m_level);
+
+            if (m_category != LogCategory.General)
+            {
+                sb.Append('[');
+                sb.Append(CATEGORY_NAMES[(int)m_category]);
+                sb.Append("] ");
+            }
+
+            if (m_chars != null)
+            {
+                sb.Append(m_chars, 0, m_charCount);
+                sb.AppendLine();
+                CharBufferPool.Shared.Return(m_chars);
+            }
+            else
+            {
+                sb.AppendLine(m_message);
+            }
+            
+            if (m_stackTrace != null)
+            {
+                sb.AppendLine(m_stackTrace);
+            }
+        }
+
+        /// <summary>
+        /// Appends the time and level that start each log line.
+        /// </summary>
+        /// <param name="sb">The builder to append to.</param>
+        /// <param name="time">The time the message was logged.</param>
+        /// <param name="level">The level of the message.</param>
+        public static void AppendLineStart(StringBuilder sb, DateTime time, LogLevel level)
         {
             int initialLength = sb.Length;
 
-            sb.Append(DateTime.Now.ToString(DATE_FORMAT));
+            sb.Append(time.ToString(DATE_FORMAT));
             sb.Append(" [");
-            sb.Append(LEVEL_NAMES[(int)m_level]);
+            sb.Append(LEVEL_NAMES[(int)level]);
             sb.Append("]");
 
             // right pad the line start
             int lineLength = sb.Length - initialLength;
             sb.Append(' ', Math.Max(0, MESSAGE_START_PADDING - lineLength));
+        }
 
-            sb.AppendLine(m_message);
-            
-            if (m_stackTrace != null)
+        /// <summary>
+        /// Releases the message without writing it.
+        /// </summary>
+        public void Discard()
+        {
+            if (m_chars != null)
             {
-                sb.AppendLine(m_stackTrace);
+                CharBufferPool.Shared.Return(m_chars);
             }
         }
     }
@@ -0,0 +1,25 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+namespace Engine.Logging
+{
+    /// <summary>
+    /// Determines what happens when a message is logged while the log queue is full.
+    /// </summary>
+    internal enum LogOverflowPolicy : int
+    {
+        /// <summary>
+        /// The logging thread waits until the writer makes space. No messages are lost.
+        /// </summary>
+        Block       = 0,
+        /// <summary>
+        /// The oldest queued message is discarded to make space for the new message.
+        /// </summary>
+        DropOldest  = 1,
+        /// <summary>
+        /// The new message is discarded.
+        /// </summary>
+        DropNewest  = 2,
+    }
+}
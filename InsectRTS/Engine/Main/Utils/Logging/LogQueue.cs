@@ -0,0 +1,165 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace Engine.Logging
+{
+    /// <summary>
+    /// A counter padded to fill its own cache lines, so the producers and consumer do not contend
+    /// over the same cache line.
+    /// </summary>
+    /// <remarks>
+    /// This can't be nested in <see cref="LogQueue{T}"/>, as types nested in generic types are generic
+    /// themselves and the runtime refuses to load generic types with explicit layout.
+    /// </remarks>
+    [StructLayout(LayoutKind.Explicit, Size = 128)]
+    internal struct PaddedCounter
+    {
+        [FieldOffset(64)]
+        public long value;
+    }
+
+    /// <summary>
+    /// A bounded lock-free queue backed by a ring buffer. Any number of threads may enqueue and
+    /// dequeue concurrently, but it is intended for many logging threads feeding a single writer.
+    /// </summary>
+    /// <remarks>
+    /// Each slot stores a sequence number that tells a thread whether the slot is ready to be written
+    /// or read for its position, so a producer only needs a single compare exchange to claim a slot.
+    /// </remarks>
+    internal class LogQueue<T>
+    {
+        private struct Slot
+        {
+            public long sequence;
+            public T item;
+        }
+
+        private readonly Slot[] m_slots;
+        private readonly int m_mask;
+        private PaddedCounter m_head;
+        private PaddedCounter m_tail;
+
+        /// <summary>
+        /// The maximum number of items the queue can hold.
+        /// </summary>
+        public int Capacity => m_slots.Length;
+
+        /// <summary>
+        /// The approximate number of items in the queue.
+        /// </summary>
+        public int Count => (int)Math.Max(Volatile.Read(ref m_tail.value) - Volatile.Read(ref m_head.value), 0);
+
+        /// <summary>
+        /// Creates a new queue.
+        /// </summary>
+        /// <param name="capacity">The maximum number of items in the queue. Rounded up to a power of two.</param>
+        public LogQueue(int capacity)
+        {
+            if (capacity < 2)
+            {
+                throw new ArgumentOutOfRangeException(nameof(capacity), capacity, "Must be at least 2!");
+            }
+
+            int size = 2;
+            while (size < capacity)
+            {
+                size *= 2;
+            }
+
+            m_slots = new Slot[size];
+            m_mask = size - 1;
+
+            for (int i = 0; i < size; i++)
+            {
+                m_slots[i].sequence = i;
+            }
+        }
+
+        /// <summary>
+        /// Adds an item to the end of the queue.
+        /// </summary>
+        /// <param name="item">The item to add.</param>
+        /// <returns>False if the queue is full.</returns>
+        public bool TryEnqueue(T item)
+        {
+            long position = Volatile.Read(ref m_tail.value);
+
+            while (true)
+            {
+                ref Slot slot = ref m_slots[position & m_mask];
+                long sequence = Volatile.Read(ref slot.sequence);
+                long diff = sequence - position;
+
+                if (diff == 0)
+                {
+                    // the slot is free for this position, try to claim it
+                    long current = Interlocked.CompareExchange(ref m_tail.value, position + 1, position);
+                    if (current == position)
+                    {
+                        slot.item = item;
+                        Volatile.Write(ref slot.sequence, position + 1);
+                        return true;
+                    }
+                    position = current;
+                }
+                else if (diff < 0)
+                {
+                    // the slot still holds an item from the previous lap
+                    return false;
+                }
+                else
+                {
+                    // another producer claimed the slot first
+                    position = Volatile.Read(ref m_tail.value);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Removes the item at the front of the queue.
+        /// </summary>
+        /// <param name="item">Returns the removed item.</param>
+        /// <returns>False if the queue is empty.</returns>
+        public bool TryDequeue(out T item)
+        {
+            long position = Volatile.Read(ref m_head.value);
+
+            while (true)
+            {
+                ref Slot slot = ref m_slots[position & m_mask];
+                long sequence = Volatile.Read(ref slot.sequence);
+                long diff = sequence - (position + 1);
+
+                if (diff == 0)
+                {
+                    long current = Interlocked.CompareExchange(ref m_head.value, position + 1, position);
+                    if (current == position)
+                    {
+                        item = slot.item;
+                        slot.item = default(T);
+
+                        // mark the slot as free for the producers on the next lap
+                        Volatile.Write(ref slot.sequence, position + m_mask + 1);
+                        return true;
+                    }
+                    position = current;
+                }
+                else if (diff < 0)
+                {
+                    // the slot has not been written yet
+                    item = default(T);
+                    return false;
+                }
+                else
+                {
+                    position = Volatile.Read(ref m_head.value);
+                }
+            }
+        }
+    }
+}
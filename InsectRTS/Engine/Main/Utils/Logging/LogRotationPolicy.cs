@@ -0,0 +1,46 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+namespace Engine.Logging
+{
+    /// <summary>
+    /// Determines when the log writer starts a new log file during a session. This keeps individual
+    /// files manageable on long running processes such as dedicated simulation servers.
+    /// </summary>
+    internal struct LogRotationPolicy
+    {
+        /// <summary>
+        /// A policy that never rotates the log.
+        /// </summary>
+        public static readonly LogRotationPolicy None = new LogRotationPolicy(0, 0, false);
+
+        /// <summary>
+        /// The approximate size in bytes at which a new log file is started, or zero to never rotate.
+        /// </summary>
+        public readonly long maxFileSize;
+
+        /// <summary>
+        /// The number of previous files from this session to keep, or zero to keep all of them.
+        /// </summary>
+        public readonly int maxFileCount;
+
+        /// <summary>
+        /// If true completed log files are compressed using gzip.
+        /// </summary>
+        public readonly bool compress;
+
+        /// <summary>
+        /// Creates a new rotation policy.
+        /// </summary>
+        /// <param name="maxFileSize">The approximate size in bytes at which a new log file is started, or zero to never rotate.</param>
+        /// <param name="maxFileCount">The number of previous files from this session to keep, or zero to keep all of them.</param>
+        /// <param name="compress">If true completed log files are compressed using gzip.</param>
+        public LogRotationPolicy(long maxFileSize, int maxFileCount, bool compress)
+        {
+            this.maxFileSize = maxFileSize;
+            this.maxFileCount = maxFileCount;
+            this.compress = compress;
+        }
+    }
+}
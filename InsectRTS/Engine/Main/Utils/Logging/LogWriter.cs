@@ -2,9 +2,10 @@
 * Copyright © 2018-2019 Scott Sewell
 * See "Licence.txt" for full licence.
 */
-using System.Collections.Generic;
+using System;
 using System.Text;
 using System.IO;
+using System.IO.Compression;
 using System.Threading;
 using System.Diagnostics;
 using System.Threading.Tasks;
@@ -12,27 +13,90 @@ using System.Threading.Tasks;
 namespace Engine.Logging
 {
     /// <summary>
-    /// Handles logging buffered output to file and debug console. Uses double buffering to reduce
-    /// the time other threads might have to wait in case the message formatting on the writer
-    /// thread is significant.
+    /// Handles logging buffered output to file and debug console. Messages are passed to the writer
+    /// thread through a lock-free queue, so logging threads never wait on each other or on the
+    /// writer unless the queue is full and the overflow policy is to block. The log file is kept
+    /// open and written through a buffer that is flushed according to a <see cref="LogFlushPolicy"/>,
+    /// and is replaced by a new file according to a <see cref="LogRotationPolicy"/>.
     /// </summary>
     internal class LogWriter
     {
-        private readonly List<LogMessage> m_buffer = new List<LogMessage>();
-        private readonly object m_bufferLock = new object();
+        private struct LogRoute
+        {
+            public ILogSink sink;
+            public LogLevel minimumLevel;
+            public int categoryMask;
+
+            public bool Accepts(LogLevel level, LogCategory category)
+            {
+                return level >= minimumLevel && (categoryMask & (1 << (int)category)) != 0;
+            }
+        }
+
+        private readonly LogQueue<LogMessage> m_queue;
+        private readonly LogOverflowPolicy m_overflowPolicy;
+        private readonly AutoResetEvent m_wakeEvent = new AutoResetEvent(false);
+        private int m_writerSleeping;
+        private int m_droppedCount;
+
+        /// <summary>
+        /// The size in bytes of the file stream's write buffer.
+        /// </summary>
+        private const int FILE_BUFFER_SIZE = 64 * 1024;
+
+        /// <summary>
+        /// The extention added to compressed log files.
+        /// </summary>
+        public const string COMPRESSED_EXTENTION = ".gz";
+
+        /// <summary>
+        /// The sinks messages are routed to in addition to the log file. The array is replaced rather
+        /// than modified so the writer can read it without locking.
+        /// </summary>
+        private volatile LogRoute[] m_routes = new LogRoute[0];
+        private readonly object m_routesLock = new object();
 
         private readonly StringBuilder m_sb = new StringBuilder();
         private readonly object m_writeLock = new object();
+        private char[] m_chars = new char[1024];
 
         private readonly string m_filePath;
+        private readonly UTF8Encoding m_encoding = new UTF8Encoding(false);
+        private FileStream m_fileStream;
+        private StreamWriter m_fileWriter;
+        private readonly LogFlushPolicy m_flushPolicy;
+        private readonly Stopwatch m_flushTimer = new Stopwatch();
+        private int m_unflushedChars;
+
+        private readonly LogRotationPolicy m_rotationPolicy;
+        private int m_fileIndex;
+        private long m_fileBytes;
+
+        /// <summary>
+        /// The number of messages discarded because the queue was full since the writer last reported it.
+        /// </summary>
+        public int DroppedCount => Volatile.Read(ref m_droppedCount);
 
         /// <summary>
         /// Creates a new log writer and spawns a new thread to write from.
         /// </summary>
         /// <param name="outputFile">The log file to output to.</param>
-        public LogWriter(FileInfo outputFile)
+        /// <param name="capacity">The maximum number of messages waiting to be written.</param>
+        /// <param name="overflowPolicy">What to do with new messages when the queue is full.</param>
+        /// <param name="flushPolicy">When to flush written messages to the log file.</param>
+        /// <param name="rotationPolicy">When to start new log files.</param>
+        public LogWriter(FileInfo outputFile, int capacity, LogOverflowPolicy overflowPolicy, LogFlushPolicy flushPolicy, LogRotationPolicy rotationPolicy)
         {
+            m_queue = new LogQueue<LogMessage>(capacity);
+            m_overflowPolicy = overflowPolicy;
+            m_flushPolicy = flushPolicy;
+            m_rotationPolicy = rotationPolicy;
+
             m_filePath = outputFile.FullName;
+            OpenFile(m_filePath);
+
+            // make sure queued and buffered messages are not lost when the application closes normally
+            AppDomain.CurrentDomain.ProcessExit += (s, e) => WriteQueued();
 
             // start a thread for the log write loop
             Task task = new Task(LogLoop, TaskCreationOptions.LongRunning);
@@ -40,55 +104,56 @@ namespace Engine.Logging
         }
 
         /// <summary>
-        /// Loop that repeatedly checks the buffer for any new messages, and
+        /// Loop that repeatedly checks the queue for any new messages, and
         /// if any are found logs them.
         /// </summary>
         public void LogLoop()
         {
-            List<LogMessage> toWrite = new List<LogMessage>();
-
             while (true)
             {
-                // Aquire any buffered log messages
-                lock (m_bufferLock)
-                {
-                    // release lock and sleep until there is content to consume
-                    while (m_buffer.Count == 0)
-                    {
-                        Monitor.Wait(m_bufferLock);
-                    }
+                // announce that the writer is going to sleep before checking the queue a final time, so a
+                // producer that enqueues after the check is guaranteed to see the flag and wake us
+                Interlocked.Exchange(ref m_writerSleeping, 1);
 
-                    toWrite.AddRange(m_buffer);
-                    m_buffer.Clear();
+                if (m_queue.Count == 0)
+                {
+                    // wake up in time to flush any buffered text
+                    m_wakeEvent.WaitOne(m_unflushedChars > 0 ? GetTimeUntilFlush() : Timeout.Infinite);
                 }
+                Volatile.Write(ref m_writerSleeping, 0);
 
-                // write the messages in the write buffer
+                // write all the messages in the queue as a single batch
                 lock (m_writeLock)
                 {
-                    // build up the messages to log
-                    foreach (LogMessage message in toWrite)
+                    if (DrainQueue())
                     {
-                        message.AppendTo(m_sb);
+                        WriteText(m_sb);
                     }
-                    WriteText(m_sb);
-                }
 
-                // clear away written messages
-                toWrite.Clear();
+                    if (m_unflushedChars >= m_flushPolicy.size || (m_unflushedChars > 0 && GetTimeUntilFlush() == 0))
+                    {
+                        Flush(false);
+                    }
+                }
             }
         }
 
         /// <summary>
-        /// Adds a message to the message buffer.
+        /// Adds a message to the message queue.
         /// </summary>
         /// <param name="message">The message to log.</param>
         public void BufferMessage(LogMessage message)
         {
-            lock (m_bufferLock)
+            if (!m_queue.TryEnqueue(message))
+            {
+                HandleOverflow(message);
+            }
+
+            // only wake the writer if it is waiting, which avoids a kernel call for most messages
+            Interlocked.MemoryBarrier();
+            if (Volatile.Read(ref m_writerSleeping) == 1 && Interlocked.Exchange(ref m_writerSleeping, 0) == 1)
             {
-                m_buffer.Add(message);
-                // wake up writer thread since there is new content to consume
-                Monitor.Pulse(m_bufferLock);
+                m_wakeEvent.Set();
             }
         }
 
@@ -98,22 +163,203 @@ namespace Engine.Logging
         /// <param name="message">The message to log.</param>
         public void WriteSynchronous(LogMessage message)
         {
-            lock (m_bufferLock)
+            lock (m_writeLock)
             {
-                lock (m_writeLock)
+                // flush any queued messages first to preserve message ordering
+                DrainQueue();
+
+                // add the new message to the end
+                AppendMessage(message);
+
+                // write all messages and make sure they reach the file in case of a crash
+                WriteText(m_sb);
+                Flush(m_flushPolicy.syncOnError);
+            }
+        }
+
+        /// <summary>
+        /// Writes all queued messages and flushes the log file, without waiting for the writer thread.
+        /// </summary>
+        public void WriteQueued()
+        {
+            lock (m_writeLock)
+            {
+                if (DrainQueue())
+                {
+                    WriteText(m_sb);
+                }
+                Flush(false);
+            }
+        }
+
+        /// <summary>
+        /// Routes messages to a sink in addition to the log file.
+        /// </summary>
+        /// <param name="sink">The sink to add.</param>
+        /// <param name="minimumLevel">The least severe level of message sent to the sink.</param>
+        /// <param name="categories">The categories sent to the sink, or all categories if empty.</param>
+        public void AddSink(ILogSink sink, LogLevel minimumLevel, LogCategory[] categories)
+        {
+            int categoryMask = ~0;
+            if (categories != null && categories.Length > 0)
+            {
+                categoryMask = 0;
+                foreach (LogCategory category in categories)
+                {
+                    categoryMask |= 1 << (int)category;
+                }
+            }
+
+            LogRoute route = new LogRoute
+            {
+                sink = sink,
+                minimumLevel = minimumLevel,
+                categoryMask = categoryMask,
+            };
+
+            lock (m_routesLock)
+            {
+                LogRoute[] routes = new LogRoute[m_routes.Length + 1];
+                m_routes.CopyTo(routes, 0);
+                routes[routes.Length - 1] = route;
+                m_routes = routes;
+            }
+        }
+
+        /// <summary>
+        /// Stops routing messages to a sink.
+        /// </summary>
+        /// <param name="sink">The sink to remove.</param>
+        /// <returns>True if the sink was found.</returns>
+        public bool RemoveSink(ILogSink sink)
+        {
+            lock (m_routesLock)
+            {
+                int index = Array.FindIndex(m_routes, r => r.sink == sink);
+                if (index < 0)
+                {
+                    return false;
+                }
+
+                LogRoute[] routes = new LogRoute[m_routes.Length - 1];
+                Array.Copy(m_routes, 0, routes, 0, index);
+                Array.Copy(m_routes, index + 1, routes, index, routes.Length - index);
+                m_routes = routes;
+                return true;
+            }
+        }
+
+        /// <summary>
+        /// Writes any buffered text to the log file.
+        /// </summary>
+        /// <param name="toDisk">If true waits for the operating system to commit the file to disk.</param>
+        public void Flush(bool toDisk)
+        {
+            lock (m_writeLock)
+            {
+                m_fileWriter.Flush();
+                if (toDisk)
+                {
+                    m_fileStream.Flush(true);
+                }
+
+                m_unflushedChars = 0;
+                m_flushTimer.Reset();
+            }
+        }
+
+        /// <summary>
+        /// Adds a message to the queue when it was found to be full.
+        /// </summary>
+        /// <param name="message">The message to log.</param>
+        private void HandleOverflow(LogMessage message)
+        {
+            switch (m_overflowPolicy)
+            {
+                case LogOverflowPolicy.Block:
+                {
+                    SpinWait spin = new SpinWait();
+                    while (!m_queue.TryEnqueue(message))
+                    {
+                        // make sure the writer is running so that space is freed
+                        if (Interlocked.Exchange(ref m_writerSleeping, 0) == 1)
+                        {
+                            m_wakeEvent.Set();
+                        }
+                        spin.SpinOnce();
+                    }
+                    break;
+                }
+                case LogOverflowPolicy.DropOldest:
                 {
-                    // flush any buffered messages first to preserve message ordering
-                    foreach (LogMessage m in m_buffer)
+                    while (!m_queue.TryEnqueue(message))
                     {
-                        m.AppendTo(m_sb);
+                        if (m_queue.TryDequeue(out LogMessage oldest))
+                        {
+                            oldest.Discard();
+                            Interlocked.Increment(ref m_droppedCount);
+                        }
                     }
-                    m_buffer.Clear();
+                    break;
+                }
+                case LogOverflowPolicy.DropNewest:
+                {
+                    message.Discard();
+                    Interlocked.Increment(ref m_droppedCount);
+                    break;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Appends all queued messages to the write buffer. Must be called while holding the write lock.
+        /// </summary>
+        /// <returns>True if there is any text to write.</returns>
+        private bool DrainQueue()
+        {
+            // report any lost messages where they were lost
+            int dropped = Interlocked.Exchange(ref m_droppedCount, 0);
+            if (dropped > 0)
+            {
+                AppendMessage(new LogMessage(LogLevel.Warning, $"{dropped} log messages were dropped because the log queue was full!"));
+            }
 
-                    // add the new message to the end
-                    message.AppendTo(m_sb);
+            while (m_queue.TryDequeue(out LogMessage message))
+            {
+                AppendMessage(message);
+            }
+            return m_sb.Length > 0;
+        }
 
-                    // write all messages
-                    WriteText(m_sb);
+        /// <summary>
+        /// Appends a message to the write buffer and sends it to any sinks that accept it. Must be called
+        /// while holding the write lock.
+        /// </summary>
+        /// <param name="message">The message to write.</param>
+        private void AppendMessage(LogMessage message)
+        {
+            int start = m_sb.Length;
+            message.AppendTo(m_sb);
+
+            LogRoute[] routes = m_routes;
+            string text = null;
+
+            foreach (LogRoute route in routes)
+            {
+                if (route.Accepts(message.Level, message.Category))
+                {
+                    text = text ?? m_sb.ToString(start, m_sb.Length - start);
+
+                    try
+                    {
+                        route.sink.Write(message.Level, message.Category, text);
+                    }
+                    catch (Exception e)
+                    {
+                        // a broken sink must not stop the log file from being written
+                        RemoveSink(route.sink);
+                        new LogMessage(LogLevel.Error, $"Removed log sink {route.sink.GetType().Name} as it threw an exception: {e}").AppendTo(m_sb);
+                    }
                 }
             }
         }
@@ -124,16 +370,127 @@ namespace Engine.Logging
         /// <param name="sb">The text to write.</param>
         private void WriteText(StringBuilder sb)
         {
-            string text = sb.ToString();
-            sb.Clear();
-
 #if DEBUG
-            Debug.Print(text);
+            Debug.Print(sb.ToString());
 #endif
-            using (StreamWriter stream = File.AppendText(m_filePath))
+            // copy into a reused buffer rather than creating a string
+            int length = sb.Length;
+            if (m_chars.Length < length)
+            {
+                m_chars = new char[Math.Max(length, m_chars.Length * 2)];
+            }
+            sb.CopyTo(0, m_chars, 0, length);
+            sb.Clear();
+
+            m_fileWriter.Write(m_chars, 0, length);
+            m_fileBytes += m_encoding.GetByteCount(m_chars, 0, length);
+
+            // the flush interval is timed from the oldest unflushed message
+            if (m_unflushedChars == 0)
+            {
+                m_flushTimer.Restart();
+            }
+            m_unflushedChars += length;
+
+            if (m_rotationPolicy.maxFileSize > 0 && m_fileBytes >= m_rotationPolicy.maxFileSize)
+            {
+                Rotate();
+            }
+        }
+
+        /// <summary>
+        /// Opens a log file for writing.
+        /// </summary>
+        /// <param name="path">The path of the file.</param>
+        private void OpenFile(string path)
+        {
+            // allow other programs to read or remove the log while it is open
+            m_fileStream = new FileStream(path, FileMode.Append, FileAccess.Write, FileShare.Read | FileShare.Delete, FILE_BUFFER_SIZE);
+            m_fileWriter = new StreamWriter(m_fileStream, m_encoding, FILE_BUFFER_SIZE);
+            m_fileBytes = m_fileStream.Length;
+        }
+
+        /// <summary>
+        /// Closes the current log file and continues in a new one. Must be called while holding the write lock.
+        /// </summary>
+        private void Rotate()
+        {
+            string completedPath = GetFilePath(m_fileIndex);
+            m_fileWriter.Dispose();
+
+            m_fileIndex++;
+            OpenFile(GetFilePath(m_fileIndex));
+            m_unflushedChars = 0;
+            m_flushTimer.Reset();
+
+            // compressing on this thread delays writing a little, but keeps the work off the logging threads
+            if (m_rotationPolicy.compress)
+            {
+                try
+                {
+                    Compress(completedPath);
+                }
+                catch (Exception e) when (e is IOException || e is UnauthorizedAccessException)
+                {
+                    AppendMessage(new LogMessage(LogLevel.Warning, $"Failed to compress log file \"{completedPath}\": {e.Message}"));
+                }
+            }
+
+            // remove the oldest files from this session
+            if (m_rotationPolicy.maxFileCount > 0 && m_fileIndex - m_rotationPolicy.maxFileCount >= 0)
+            {
+                string oldPath = GetFilePath(m_fileIndex - m_rotationPolicy.maxFileCount);
+                try
+                {
+                    File.Delete(oldPath);
+                    File.Delete(oldPath + COMPRESSED_EXTENTION);
+                }
+                catch (Exception e) when (e is IOException || e is UnauthorizedAccessException)
+                {
+                    AppendMessage(new LogMessage(LogLevel.Warning, $"Failed to delete log file \"{oldPath}\": {e.Message}"));
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets the path of one of the files from this session.
+        /// </summary>
+        /// <param name="index">The number of times the log had been rotated when the file was started.</param>
+        private string GetFilePath(int index)
+        {
+            if (index == 0)
+            {
+                return m_filePath;
+            }
+
+            string directory = Path.GetDirectoryName(m_filePath);
+            string name = Path.GetFileNameWithoutExtension(m_filePath);
+            string extention = Path.GetExtension(m_filePath);
+
+            return Path.Combine(directory, $"{name}_{index}{extention}");
+        }
+
+        /// <summary>
+        /// Compresses a file using gzip and deletes the original.
+        /// </summary>
+        /// <param name="path">The file to compress.</param>
+        private static void Compress(string path)
+        {
+            using (FileStream source = new FileStream(path, FileMode.Open, FileAccess.Read, FileShare.Read))
+            using (FileStream destination = new FileStream(path + COMPRESSED_EXTENTION, FileMode.Create, FileAccess.Write))
+            using (GZipStream gzip = new GZipStream(destination, CompressionLevel.Optimal))
             {
-                stream.Write(text);
+                source.CopyTo(gzip);
             }
+            File.Delete(path);
+        }
+
+        /// <summary>
+        /// Gets the number of milliseconds until buffered text must be flushed.
+        /// </summary>
+        private int GetTimeUntilFlush()
+        {
+            return (int)Math.Max(m_flushPolicy.interval - m_flushTimer.ElapsedMilliseconds, 0);
         }
     }
 }
@@ -8,6 +8,8 @@ using System.IO;
 using System.Linq;
 using System.Text;
 using System.Diagnostics;
+using System.Runtime.CompilerServices;
+using System.Threading.Tasks;
 using Engine.Logging;
 
 namespace Engine
@@ -34,6 +36,11 @@ namespace Engine
         /// </summary>
         private static readonly string FILE_EXTENTION = ".log";
 
+        /// <summary>
+        /// The file extention used for binary event logs.
+        /// </summary>
+        private static readonly string EVENT_FILE_EXTENTION = ".blog";
+
         /// <summary>
         /// The maximum number of logs before the oldest will be automatically removed.
         /// </summary>
@@ -45,8 +52,54 @@ namespace Engine
         /// </summary>
         private const bool WRITE_ASNYCHRONOUSLY = true;
 
+        /// <summary>
+        /// The maximum number of messages waiting to be written by the log writer thread.
+        /// </summary>
+        internal const int QUEUE_CAPACITY = 8192;
+
+        /// <summary>
+        /// What to do when a message is logged while the queue is full.
+        /// </summary>
+        private const LogOverflowPolicy OVERFLOW_POLICY = LogOverflowPolicy.Block;
+
+        /// <summary>
+        /// Written messages are flushed to the log file at least every second, or once 32k characters
+        /// are buffered. Errors are flushed immediately and committed to disk.
+        /// </summary>
+        private static readonly LogFlushPolicy FLUSH_POLICY = new LogFlushPolicy(1000, 32 * 1024, true);
+
+        /// <summary>
+        /// A new log file is started every 64MB, which only happens during very long sessions such as on
+        /// dedicated servers. Completed files are compressed and the most recent 16 are kept.
+        /// </summary>
+        private static readonly LogRotationPolicy ROTATION_POLICY = new LogRotationPolicy(64 * 1024 * 1024, 16, true);
+
+        /// <summary>
+        /// The maximum time in milliseconds events stay buffered on a thread that keeps logging events.
+        /// </summary>
+        private const int EVENT_FLUSH_INTERVAL = 1000;
+
         private readonly LogWriter m_writer;
         private readonly FileInfo m_logInfo;
+        private readonly string m_logStartTime;
+
+        /// <summary>
+        /// The least severe level logged by default. Debug messages are also removed from release
+        /// builds at compile time.
+        /// </summary>
+#if DEBUG
+        private const LogLevel DEFAULT_LEVEL = LogLevel.Debug;
+#else
+        private const LogLevel DEFAULT_LEVEL = LogLevel.Info;
+#endif
+
+        /// <summary>
+        /// The least severe level logged for each category.
+        /// </summary>
+        private static readonly LogLevel[] m_minimumLevels = Enumerable.Repeat(DEFAULT_LEVEL, Enum.GetValues(typeof(LogCategory)).Length).ToArray();
+
+        private volatile BinaryLogWriter m_eventWriter;
+        private readonly object m_eventWriterLock = new object();
         
         /// <summary>
         /// Constructor.
@@ -59,24 +112,248 @@ namespace Engine
                 Directory.CreateDirectory(LOG_DIRECTORY);
             }
 
-            // Limit the number of previous logs stored by deleting the oldest
-            List<FileInfo> logs = new DirectoryInfo(LOG_DIRECTORY).GetFiles('*' + FILE_EXTENTION).ToList();
+            // Limit the number of previous logs stored by deleting the oldest. This is done in the background
+            // as it does not need to finish before logging starts.
+            Task.Run(() =>
+            {
+                DeleteOldLogs(FILE_EXTENTION, FILE_EXTENTION + LogWriter.COMPRESSED_EXTENTION);
+                DeleteOldLogs(EVENT_FILE_EXTENTION);
+            });
+
+            // Get the filepath for this session's log
+            m_logStartTime = DateTime.Now.ToString(LOG_DATE_FORMAT);
+            string logName = m_logStartTime + FILE_EXTENTION;
+
+            m_logInfo = new FileInfo(Path.Combine(AppDomain.CurrentDomain.BaseDirectory, LOG_DIRECTORY, logName));
+            
+            // create the log writer
+            m_writer = new LogWriter(m_logInfo, QUEUE_CAPACITY, OVERFLOW_POLICY, FLUSH_POLICY, ROTATION_POLICY);
+        }
+
+        /// <summary>
+        /// Deletes the oldest logs of a given type so there is space for a new log.
+        /// </summary>
+        /// <param name="extentions">The file extentions used by the type of log.</param>
+        private static void DeleteOldLogs(params string[] extentions)
+        {
+            DirectoryInfo directory = new DirectoryInfo(LOG_DIRECTORY);
+            List<FileInfo> logs = extentions.SelectMany(e => directory.GetFiles('*' + e)).ToList();
             logs.Sort((x, y) => (x.CreationTime.CompareTo(y.CreationTime)));
 
             while (logs.Count >= MAX_LOG_COUNT)
             {
-                logs[0].Delete();
+                try
+                {
+                    logs[0].Delete();
+                }
+                catch (Exception e) when (e is IOException || e is UnauthorizedAccessException)
+                {
+                    // another instance may still be using the log, so try again next time
+                }
                 logs.RemoveAt(0);
             }
+        }
 
-            // Get the filepath for this session's log
-            string logStartTime = DateTime.Now.ToString(LOG_DATE_FORMAT);
-            string logName = logStartTime + FILE_EXTENTION;
+        /// <summary>
+        /// The binary event log writer, created when the first event is registered so that sessions
+        /// without events do not create an event log.
+        /// </summary>
+        private BinaryLogWriter EventWriter
+        {
+            get
+            {
+                if (m_eventWriter == null)
+                {
+                    lock (m_eventWriterLock)
+                    {
+                        if (m_eventWriter == null)
+                        {
+                            string path = Path.Combine(AppDomain.CurrentDomain.BaseDirectory, LOG_DIRECTORY, m_logStartTime + EVENT_FILE_EXTENTION);
+                            m_eventWriter = new BinaryLogWriter(new FileInfo(path), EVENT_FLUSH_INTERVAL);
+                        }
+                    }
+                }
+                return m_eventWriter;
+            }
+        }
 
-            m_logInfo = new FileInfo(Path.Combine(AppDomain.CurrentDomain.BaseDirectory, LOG_DIRECTORY, logName));
-            
-            // create the log writer
-            m_writer = new LogWriter(m_logInfo);
+        /// <summary>
+        /// Registers an event template for the binary event log. Logging an event only records the
+        /// template, a timestamp, the thread and the arguments, which makes it cheap enough for very
+        /// frequent events such as simulation updates. Use the LogDecoder tool to convert the event log
+        /// to text.
+        /// </summary>
+        /// <param name="level">The level of the events.</param>
+        /// <param name="format">The event text. Arguments are inserted using the placeholders of
+        /// <see cref="string.Format(string, object[])"/>.</param>
+        /// <returns>The handle used to log events with this template.</returns>
+        public static LogEvent RegisterEvent(LogLevel level, string format)
+        {
+            return Instance.EventWriter.RegisterTemplate(level, format);
+        }
+
+        /// <summary>
+        /// Logs an event to the binary event log.
+        /// </summary>
+        /// <param name="logEvent">The event template.</param>
+        public static void Event(LogEvent logEvent)
+        {
+            if (IsEnabled(logEvent.level))
+            {
+                Instance.EventWriter.Write(logEvent);
+            }
+        }
+
+        /// <summary>
+        /// Logs an event to the binary event log.
+        /// </summary>
+        /// <param name="logEvent">The event template.</param>
+        /// <param name="arg0">The first argument.</param>
+        public static void Event(LogEvent logEvent, LogArg arg0)
+        {
+            if (IsEnabled(logEvent.level))
+            {
+                Instance.EventWriter.Write(logEvent, arg0);
+            }
+        }
+
+        /// <summary>
+        /// Logs an event to the binary event log.
+        /// </summary>
+        /// <param name="logEvent">The event template.</param>
+        /// <param name="arg0">The first argument.</param>
+        /// <param name="arg1">The second argument.</param>
+        public static void Event(LogEvent logEvent, LogArg arg0, LogArg arg1)
+        {
+            if (IsEnabled(logEvent.level))
+            {
+                Instance.EventWriter.Write(logEvent, arg0, arg1);
+            }
+        }
+
+        /// <summary>
+        /// Logs an event to the binary event log.
+        /// </summary>
+        /// <param name="logEvent">The event template.</param>
+        /// <param name="arg0">The first argument.</param>
+        /// <param name="arg1">The second argument.</param>
+        /// <param name="arg2">The third argument.</param>
+        public static void Event(LogEvent logEvent, LogArg arg0, LogArg arg1, LogArg arg2)
+        {
+            if (IsEnabled(logEvent.level))
+            {
+                Instance.EventWriter.Write(logEvent, arg0, arg1, arg2);
+            }
+        }
+
+        /// <summary>
+        /// Logs an event to the binary event log.
+        /// </summary>
+        /// <param name="logEvent">The event template.</param>
+        /// <param name="arg0">The first argument.</param>
+        /// <param name="arg1">The second argument.</param>
+        /// <param name="arg2">The third argument.</param>
+        /// <param name="arg3">The fourth argument.</param>
+        public static void Event(LogEvent logEvent, LogArg arg0, LogArg arg1, LogArg arg2, LogArg arg3)
+        {
+            if (IsEnabled(logEvent.level))
+            {
+                Instance.EventWriter.Write(logEvent, arg0, arg1, arg2, arg3);
+            }
+        }
+
+        /// <summary>
+        /// Writes out the events logged by the calling thread. Threads that log events should call this
+        /// before they finish, as each thread buffers its events. Events left in the buffers of other
+        /// threads are still written by the event writer once they are older than the flush interval.
+        /// </summary>
+        public static void FlushEvents()
+        {
+            // threads call this as they finish, which should not create the logger if nothing was logged
+            if (Exists)
+            {
+                Instance.m_eventWriter?.Flush();
+            }
+        }
+
+        /// <summary>
+        /// Checks if messages of a given level from general code will be logged. Use this to avoid
+        /// building expensive messages that would be discarded.
+        /// </summary>
+        /// <param name="level">The level of the message.</param>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static bool IsEnabled(LogLevel level)
+        {
+            return level >= m_minimumLevels[(int)LogCategory.General];
+        }
+
+        /// <summary>
+        /// Checks if messages of a given level from a system will be logged. Use this to avoid
+        /// building expensive messages that would be discarded.
+        /// </summary>
+        /// <param name="level">The level of the message.</param>
+        /// <param name="category">The system logging the message.</param>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static bool IsEnabled(LogLevel level, LogCategory category)
+        {
+            return level >= m_minimumLevels[(int)category];
+        }
+
+        /// <summary>
+        /// Sets the least severe level of message logged for all categories.
+        /// </summary>
+        /// <param name="minimumLevel">The least severe level to log.</param>
+        public static void SetLevel(LogLevel minimumLevel)
+        {
+            for (int i = 0; i < m_minimumLevels.Length; i++)
+            {
+                m_minimumLevels[i] = minimumLevel;
+            }
+        }
+
+        /// <summary>
+        /// Sets the least severe level of message logged for a category.
+        /// </summary>
+        /// <param name="category">The category to set the level of.</param>
+        /// <param name="minimumLevel">The least severe level to log.</param>
+        public static void SetLevel(LogCategory category, LogLevel minimumLevel)
+        {
+            m_minimumLevels[(int)category] = minimumLevel;
+        }
+
+        /// <summary>
+        /// Gets the least severe level of message logged for a category.
+        /// </summary>
+        /// <param name="category">The category to get the level of.</param>
+        public static LogLevel GetLevel(LogCategory category)
+        {
+            return m_minimumLevels[(int)category];
+        }
+
+        /// <summary>
+        /// Sends messages to a sink in addition to the log file. Messages must pass both the category
+        /// level and the sink's own minimum level to reach the sink.
+        /// </summary>
+        /// <param name="sink">The sink to add.</param>
+        /// <param name="minimumLevel">The least severe level of message sent to the sink.</param>
+        /// <param name="categories">The categories sent to the sink. All categories are sent if none are given.</param>
+        public static void AddSink(ILogSink sink, LogLevel minimumLevel, params LogCategory[] categories)
+        {
+            if (sink == null)
+            {
+                throw new ArgumentNullException("sink");
+            }
+            Instance.m_writer.AddSink(sink, minimumLevel, categories);
+        }
+
+        /// <summary>
+        /// Stops sending messages to a sink.
+        /// </summary>
+        /// <param name="sink">The sink to remove.</param>
+        /// <returns>True if the sink was found.</returns>
+        public static bool RemoveSink(ILogSink sink)
+        {
+            return Instance.m_writer.RemoveSink(sink);
         }
 
         /// <summary>
@@ -86,7 +363,10 @@ namespace Engine
         /// <param name="printStackTrace">Prints the stack trace.</param>
         public static void Info(object o)
         {
-            Info(o.ToString());
+            if (IsEnabled(LogLevel.Info))
+            {
+                Info(o.ToString());
+            }
         }
 
         /// <summary>
@@ -97,7 +377,10 @@ namespace Engine
 		[Conditional("DEBUG")]
         public static void Debug(object o)
         {
-            Debug(o.ToString());
+            if (IsEnabled(LogLevel.Debug))
+            {
+                Debug(o.ToString());
+            }
         }
 
         /// <summary>
@@ -107,7 +390,10 @@ namespace Engine
         /// <param name="printStackTrace">Prints the stack trace.</param>
         public static void Warning(object o, bool printStackTrace = false)
         {
-            Warning(o.ToString(), printStackTrace);
+            if (IsEnabled(LogLevel.Warning))
+            {
+                Warning(o.ToString(), printStackTrace);
+            }
         }
 
         /// <summary>
@@ -117,7 +403,10 @@ namespace Engine
         /// <param name="printStackTrace">Prints the stack trace.</param>
         public static void Error(object o, bool printStackTrace = true)
         {
-            Error(o.ToString(), printStackTrace);
+            if (IsEnabled(LogLevel.Error))
+            {
+                Error(o.ToString(), printStackTrace);
+            }
         }
 
         /// <summary>
@@ -127,7 +416,10 @@ namespace Engine
         /// <param name="printStackTrace">Prints the stack trace.</param>
         public static void Info(string message)
         {
-            Instance.LogMessage(message, LogLevel.Info, false);
+            if (IsEnabled(LogLevel.Info))
+            {
+                Instance.LogMessage(message, LogLevel.Info, LogCategory.General, false);
+            }
         }
 
         /// <summary>
@@ -138,7 +430,10 @@ namespace Engine
 		[Conditional("DEBUG")]
         public static void Debug(string message)
         {
-            Instance.LogMessage(message, LogLevel.Debug, false);
+            if (IsEnabled(LogLevel.Debug))
+            {
+                Instance.LogMessage(message, LogLevel.Debug, LogCategory.General, false);
+            }
         }
 
         /// <summary>
@@ -148,7 +443,10 @@ namespace Engine
         /// <param name="printStackTrace">Prints the stack trace.</param>
         public static void Warning(string message, bool printStackTrace = false)
         {
-            Instance.LogMessage(message, LogLevel.Warning, printStackTrace);
+            if (IsEnabled(LogLevel.Warning))
+            {
+                Instance.LogMessage(message, LogLevel.Warning, LogCategory.General, printStackTrace);
+            }
         }
 
         /// <summary>
@@ -157,7 +455,333 @@ namespace Engine
         /// <param name="message">The message to log.</param>
         public static void Error(string message, bool printStackTrace = true)
         {
-            Instance.LogMessage(message, LogLevel.Error, printStackTrace);
+            if (IsEnabled(LogLevel.Error))
+            {
+                Instance.LogMessage(message, LogLevel.Error, LogCategory.General, printStackTrace);
+            }
+        }
+
+        /// <summary>
+        /// Logs a message followed by a value, formatting the value into a pooled buffer to avoid
+        /// allocating strings in hot paths.
+        /// </summary>
+        /// <param name="message">The text that precedes the value.</param>
+        /// <param name="value">The value to print.</param>
+        public static void Info<T>(string message, T value) where T : ICharFormattable
+        {
+            if (IsEnabled(LogLevel.Info))
+            {
+                Instance.LogMessage(message, value, LogLevel.Info, false);
+            }
+        }
+
+        /// <summary>
+        /// Logs a debug message followed by a value, formatting the value into a pooled buffer to avoid
+        /// allocating strings in hot paths.
+        /// </summary>
+        /// <param name="message">The text that precedes the value.</param>
+        /// <param name="value">The value to print.</param>
+		[Conditional("DEBUG")]
+        public static void Debug<T>(string message, T value) where T : ICharFormattable
+        {
+            if (IsEnabled(LogLevel.Debug))
+            {
+                Instance.LogMessage(message, value, LogLevel.Debug, false);
+            }
+        }
+
+        /// <summary>
+        /// Logs a warning message followed by a value, formatting the value into a pooled buffer to avoid
+        /// allocating strings in hot paths.
+        /// </summary>
+        /// <param name="message">The text that precedes the value.</param>
+        /// <param name="value">The value to print.</param>
+        /// <param name="printStackTrace">Prints the stack trace.</param>
+        public static void Warning<T>(string message, T value, bool printStackTrace = false) where T : ICharFormattable
+        {
+            if (IsEnabled(LogLevel.Warning))
+            {
+                Instance.LogMessage(message, value, LogLevel.Warning, printStackTrace);
+            }
+        }
+
+        /// <summary>
+        /// Logs an error message followed by a value, formatting the value into a pooled buffer to avoid
+        /// allocating strings in hot paths.
+        /// </summary>
+        /// <param name="message">The text that precedes the value.</param>
+        /// <param name="value">The value to print.</param>
+        /// <param name="printStackTrace">Prints the stack trace.</param>
+        public static void Error<T>(string message, T value, bool printStackTrace = true) where T : ICharFormattable
+        {
+            if (IsEnabled(LogLevel.Error))
+            {
+                Instance.LogMessage(message, value, LogLevel.Error, printStackTrace);
+            }
+        }
+
+        /// <summary>
+        /// Logs an info message from a system.
+        /// </summary>
+        /// <param name="category">The system logging the message.</param>
+        /// <param name="message">The message to log.</param>
+        public static void Info(LogCategory category, string message)
+        {
+            if (IsEnabled(LogLevel.Info, category))
+            {
+                Instance.LogMessage(message, LogLevel.Info, category, false);
+            }
+        }
+
+        /// <summary>
+        /// Logs an info message from a system. The message is only formatted if the level is enabled
+        /// for the category, so arguments are not converted to strings when nobody wants the message.
+        /// </summary>
+        /// <param name="category">The system logging the message.</param>
+        /// <param name="format">The message text, with placeholders as used by <see cref="string.Format(string, object[])"/>.</param>
+        /// <param name="arg0">The first argument.</param>
+        public static void Info<T0>(LogCategory category, string format, T0 arg0)
+        {
+            if (IsEnabled(LogLevel.Info, category))
+            {
+                Instance.LogMessage(string.Format(format, arg0), LogLevel.Info, category, false);
+            }
+        }
+
+        /// <summary>
+        /// Logs an info message from a system. The message is only formatted if the level is enabled
+        /// for the category, so arguments are not converted to strings when nobody wants the message.
+        /// </summary>
+        /// <param name="category">The system logging the message.</param>
+        /// <param name="format">The message text, with placeholders as used by <see cref="string.Format(string, object[])"/>.</param>
+        /// <param name="arg0">The first argument.</param>
+        /// <param name="arg1">The second argument.</param>
+        public static void Info<T0, T1>(LogCategory category, string format, T0 arg0, T1 arg1)
+        {
+            if (IsEnabled(LogLevel.Info, category))
+            {
+                Instance.LogMessage(string.Format(format, arg0, arg1), LogLevel.Info, category, false);
+            }
+        }
+
+        /// <summary>
+        /// Logs an info message from a system. The message is only formatted if the level is enabled
+        /// for the category, so arguments are not converted to strings when nobody wants the message.
+        /// </summary>
+        /// <param name="category">The system logging the message.</param>
+        /// <param name="format">The message text, with placeholders as used by <see cref="string.Format(string, object[])"/>.</param>
+        /// <param name="arg0">The first argument.</param>
+        /// <param name="arg1">The second argument.</param>
+        /// <param name="arg2">The third argument.</param>
+        public static void Info<T0, T1, T2>(LogCategory category, string format, T0 arg0, T1 arg1, T2 arg2)
+        {
+            if (IsEnabled(LogLevel.Info, category))
+            {
+                Instance.LogMessage(string.Format(format, arg0, arg1, arg2), LogLevel.Info, category, false);
+            }
+        }
+
+        /// <summary>
+        /// Logs a debug message from a system.
+        /// </summary>
+        /// <param name="category">The system logging the message.</param>
+        /// <param name="message">The message to log.</param>
+		[Conditional("DEBUG")]
+        public static void Debug(LogCategory category, string message)
+        {
+            if (IsEnabled(LogLevel.Debug, category))
+            {
+                Instance.LogMessage(message, LogLevel.Debug, category, false);
+            }
+        }
+
+        /// <summary>
+        /// Logs a debug message from a system. The message is only formatted if the level is enabled
+        /// for the category, so arguments are not converted to strings when nobody wants the message.
+        /// </summary>
+        /// <param name="category">The system logging the message.</param>
+        /// <param name="format">The message text, with placeholders as used by <see cref="string.Format(string, object[])"/>.</param>
+        /// <param name="arg0">The first argument.</param>
+		[Conditional("DEBUG")]
+        public static void Debug<T0>(LogCategory category, string format, T0 arg0)
+        {
+            if (IsEnabled(LogLevel.Debug, category))
+            {
+                Instance.LogMessage(string.Format(format, arg0), LogLevel.Debug, category, false);
+            }
+        }
+
+        /// <summary>
+        /// Logs a debug message from a system. The message is only formatted if the level is enabled
+        /// for the category, so arguments are not converted to strings when nobody wants the message.
+        /// </summary>
+        /// <param name="category">The system logging the message.</param>
+        /// <param name="format">The message text, with placeholders as used by <see cref="string.Format(string, object[])"/>.</param>
+        /// <param name="arg0">The first argument.</param>
+        /// <param name="arg1">The second argument.</param>
+		[Conditional("DEBUG")]
+        public static void Debug<T0, T1>(LogCategory category, string format, T0 arg0, T1 arg1)
+        {
+            if (IsEnabled(LogLevel.Debug, category))
+            {
+                Instance.LogMessage(string.Format(format, arg0, arg1), LogLevel.Debug, category, false);
+            }
+        }
+
+        /// <summary>
+        /// Logs a debug message from a system. The message is only formatted if the level is enabled
+        /// for the category, so arguments are not converted to strings when nobody wants the message.
+        /// </summary>
+        /// <param name="category">The system logging the message.</param>
+        /// <param name="format">The message text, with placeholders as used by <see cref="string.Format(string, object[])"/>.</param>
+        /// <param name="arg0">The first argument.</param>
+        /// <param name="arg1">The second argument.</param>
+        /// <param name="arg2">The third argument.</param>
+		[Conditional("DEBUG")]
+        public static void Debug<T0, T1, T2>(LogCategory category, string format, T0 arg0, T1 arg1, T2 arg2)
+        {
+            if (IsEnabled(LogLevel.Debug, category))
+            {
+                Instance.LogMessage(string.Format(format, arg0, arg1, arg2), LogLevel.Debug, category, false);
+            }
+        }
+
+        /// <summary>
+        /// Logs a warning message from a system.
+        /// </summary>
+        /// <param name="category">The system logging the message.</param>
+        /// <param name="message">The message to log.</param>
+        public static void Warning(LogCategory category, string message)
+        {
+            if (IsEnabled(LogLevel.Warning, category))
+            {
+                Instance.LogMessage(message, LogLevel.Warning, category, false);
+            }
+        }
+
+        /// <summary>
+        /// Logs a warning message from a system. The message is only formatted if the level is enabled
+        /// for the category, so arguments are not converted to strings when nobody wants the message.
+        /// </summary>
+        /// <param name="category">The system logging the message.</param>
+        /// <param name="format">The message text, with placeholders as used by <see cref="string.Format(string, object[])"/>.</param>
+        /// <param name="arg0">The first argument.</param>
+        public static void Warning<T0>(LogCategory category, string format, T0 arg0)
+        {
+            if (IsEnabled(LogLevel.Warning, category))
+            {
+                Instance.LogMessage(string.Format(format, arg0), LogLevel.Warning, category, false);
+            }
+        }
+
+        /// <summary>
+        /// Logs a warning message from a system. The message is only formatted if the level is enabled
+        /// for the category, so arguments are not converted to strings when nobody wants the message.
+        /// </summary>
+        /// <param name="category">The system logging the message.</param>
+        /// <param name="format">The message text, with placeholders as used by <see cref="string.Format(string, object[])"/>.</param>
+        /// <param name="arg0">The first argument.</param>
+        /// <param name="arg1">The second argument.</param>
+        public static void Warning<T0, T1>(LogCategory category, string format, T0 arg0, T1 arg1)
+        {
+            if (IsEnabled(LogLevel.Warning, category))
+            {
+                Instance.LogMessage(string.Format(format, arg0, arg1), LogLevel.Warning, category, false);
+            }
+        }
+
+        /// <summary>
+        /// Logs a warning message from a system. The message is only formatted if the level is enabled
+        /// for the category, so arguments are not converted to strings when nobody wants the message.
+        /// </summary>
+        /// <param name="category">The system logging the message.</param>
+        /// <param name="format">The message text, with placeholders as used by <see cref="string.Format(string, object[])"/>.</param>
+        /// <param name="arg0">The first argument.</param>
+        /// <param name="arg1">The second argument.</param>
+        /// <param name="arg2">The third argument.</param>
+        public static void Warning<T0, T1, T2>(LogCategory category, string format, T0 arg0, T1 arg1, T2 arg2)
+        {
+            if (IsEnabled(LogLevel.Warning, category))
+            {
+                Instance.LogMessage(string.Format(format, arg0, arg1, arg2), LogLevel.Warning, category, false);
+            }
+        }
+
+        /// <summary>
+        /// Logs an error message from a system.
+        /// </summary>
+        /// <param name="category">The system logging the message.</param>
+        /// <param name="message">The message to log.</param>
+        public static void Error(LogCategory category, string message)
+        {
+            if (IsEnabled(LogLevel.Error, category))
+            {
+                Instance.LogMessage(message, LogLevel.Error, category, true);
+            }
+        }
+
+        /// <summary>
+        /// Logs an error message from a system. The message is only formatted if the level is enabled
+        /// for the category, so arguments are not converted to strings when nobody wants the message.
+        /// </summary>
+        /// <param name="category">The system logging the message.</param>
+        /// <param name="format">The message text, with placeholders as used by <see cref="string.Format(string, object[])"/>.</param>
+        /// <param name="arg0">The first argument.</param>
+        public static void Error<T0>(LogCategory category, string format, T0 arg0)
+        {
+            if (IsEnabled(LogLevel.Error, category))
+            {
+                Instance.LogMessage(string.Format(format, arg0), LogLevel.Error, category, true);
+            }
+        }
+
+        /// <summary>
+        /// Logs an error message from a system. The message is only formatted if the level is enabled
+        /// for the category, so arguments are not converted to strings when nobody wants the message.
+        /// </summary>
+        /// <param name="category">The system logging the message.</param>
+        /// <param name="format">The message text, with placeholders as used by <see cref="string.Format(string, object[])"/>.</param>
+        /// <param name="arg0">The first argument.</param>
+        /// <param name="arg1">The second argument.</param>
+        public static void Error<T0, T1>(LogCategory category, string format, T0 arg0, T1 arg1)
+        {
+            if (IsEnabled(LogLevel.Error, category))
+            {
+                Instance.LogMessage(string.Format(format, arg0, arg1), LogLevel.Error, category, true);
+            }
+        }
+
+        /// <summary>
+        /// Logs an error message from a system. The message is only formatted if the level is enabled
+        /// for the category, so arguments are not converted to strings when nobody wants the message.
+        /// </summary>
+        /// <param name="category">The system logging the message.</param>
+        /// <param name="format">The message text, with placeholders as used by <see cref="string.Format(string, object[])"/>.</param>
+        /// <param name="arg0">The first argument.</param>
+        /// <param name="arg1">The second argument.</param>
+        /// <param name="arg2">The third argument.</param>
+        public static void Error<T0, T1, T2>(LogCategory category, string format, T0 arg0, T1 arg1, T2 arg2)
+        {
+            if (IsEnabled(LogLevel.Error, category))
+            {
+                Instance.LogMessage(string.Format(format, arg0, arg1, arg2), LogLevel.Error, category, true);
+            }
+        }
+
+        /// <summary>
+        /// Logs a message with a level chosen at runtime. Debug messages logged this way are not removed
+        /// from release builds at compile time, but are still subject to the category level.
+        /// </summary>
+        /// <param name="level">The level of the message.</param>
+        /// <param name="category">The system logging the message.</param>
+        /// <param name="message">The message to log.</param>
+        /// <param name="printStackTrace">Prints the stack trace.</param>
+        public static void Log(LogLevel level, LogCategory category, string message, bool printStackTrace = false)
+        {
+            if (IsEnabled(level, category))
+            {
+                Instance.LogMessage(message, level, category, printStackTrace);
+            }
         }
 
         /// <summary>
@@ -167,7 +791,7 @@ namespace Engine
         public static void Exception(object exception)
         {
             // ToString on exeption objects typically includes the stack trace, so we don't need to include it
-            Instance.LogMessage(exception.ToString(), LogLevel.Error, false);
+            Instance.LogMessage(exception.ToString(), LogLevel.Error, LogCategory.General, false);
         }
 
         private static readonly string[] NEW_LINES = new string[] { Environment.NewLine };
@@ -177,32 +801,76 @@ namespace Engine
         /// </summary>
         /// <param name="message">The message content.</param>
         /// <param name="logLevel">The mesasge type.</param>
+        /// <param name="category">The system logging the message.</param>
+        /// <param name="showStackTrace">If true includes a stack trace.</param>
+        private void LogMessage(string content, LogLevel level, LogCategory category, bool showStackTrace)
+        {
+            string stackTrace = showStackTrace ? GetStackTrace() : null;
+            Write(new LogMessage(level, category, content, stackTrace));
+        }
+
+        /// <summary>
+        /// Formats a message followed by a value into a pooled buffer and sends it to the writer.
+        /// </summary>
+        /// <param name="content">The text that precedes the value.</param>
+        /// <param name="value">The value to format.</param>
+        /// <param name="level">The mesasge type.</param>
         /// <param name="showStackTrace">If true includes a stack trace.</param>
-        private void LogMessage(string content, LogLevel level, bool showStackTrace)
+        private void LogMessage<T>(string content, T value, LogLevel level, bool showStackTrace) where T : ICharFormattable
         {
-            // Include a stack trace if desired
-            string stackTrace = null;
-            if (showStackTrace)
+            char[] buffer = CharBufferPool.Shared.Rent(CharBufferPool.DEFAULT_SIZE);
+            int count;
+
+            // grow the buffer until the message fits
+            while (!TryFormatMessage(buffer, content, value, out count))
             {
-                string[] lines = Environment.StackTrace.Split(NEW_LINES, StringSplitOptions.RemoveEmptyEntries);
+                int size = buffer.Length * 2;
+                CharBufferPool.Shared.Return(buffer);
+                buffer = CharBufferPool.Shared.Rent(size);
+            }
+
+            string stackTrace = showStackTrace ? GetStackTrace() : null;
+            Write(new LogMessage(level, LogCategory.General, buffer, count, stackTrace));
+        }
 
-                StringBuilder sb = new StringBuilder();
-                for (int i = 0; i < lines.Length; i++)
+        private static bool TryFormatMessage<T>(char[] buffer, string content, T value, out int count) where T : ICharFormattable
+        {
+            count = 0;
+            if (CharFormat.TryWrite(buffer, ref count, content) && value.TryFormat(buffer, count, out int valueCount))
+            {
+                count += valueCount;
+                return true;
+            }
+            return false;
+        }
+
+        /// <summary>
+        /// Gets the current stack trace, excluding the function calls in the logger.
+        /// </summary>
+        private static string GetStackTrace()
+        {
+            string[] lines = Environment.StackTrace.Split(NEW_LINES, StringSplitOptions.RemoveEmptyEntries);
+
+            StringBuilder sb = new StringBuilder();
+            for (int i = 0; i < lines.Length; i++)
+            {
+                // Don't include the function calls in the logger in the stack trace, as it is not useful
+                if (i > 2 && !lines[i].Contains(typeof(Logger).FullName))
                 {
-                    // Don't include the function calls in the logger in the stack trace, as it is not useful
-                    if (i > 2 && !lines[i].Contains(typeof(Logger).FullName))
-                    {
-                        sb.AppendLine(lines[i]);
-                    }
+                    sb.AppendLine(lines[i]);
                 }
-                stackTrace = sb.ToString();
             }
+            return sb.ToString();
+        }
 
-            LogMessage message = new LogMessage(level, content, stackTrace);
-
+        /// <summary>
+        /// Sends a message to the writer.
+        /// </summary>
+        private void Write(LogMessage message)
+        {
             // Don't write error messages asynchronously as that helps ensure the message is
             // still logged in case of a fatal error.
-            if (level != LogLevel.Error && WRITE_ASNYCHRONOUSLY)
+            if (message.Level != LogLevel.Error && WRITE_ASNYCHRONOUSLY)
             {
                 m_writer.BufferMessage(message);
             }
@@ -0,0 +1,97 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+
+namespace Engine.Logging
+{
+    /// <summary>
+    /// Keeps the most recent log messages in memory, for example to show in an in-game console or to
+    /// include in a crash report.
+    /// </summary>
+    public class MemoryLogSink : ILogSink
+    {
+        private readonly string[] m_messages;
+        private readonly object m_lock = new object();
+        private int m_next;
+        private int m_count;
+
+        /// <summary>
+        /// The maximum number of messages kept.
+        /// </summary>
+        public int Capacity => m_messages.Length;
+
+        /// <summary>
+        /// The number of messages currently kept.
+        /// </summary>
+        public int Count
+        {
+            get
+            {
+                lock (m_lock)
+                {
+                    return m_count;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Creates a new memory sink.
+        /// </summary>
+        /// <param name="capacity">The maximum number of messages kept, after which the oldest are overwritten.</param>
+        public MemoryLogSink(int capacity)
+        {
+            if (capacity < 1)
+            {
+                throw new ArgumentOutOfRangeException(nameof(capacity), capacity, "Must be at least 1!");
+            }
+            m_messages = new string[capacity];
+        }
+
+        /// <summary>
+        /// Stores a log message, replacing the oldest message if the sink is full.
+        /// </summary>
+        public void Write(LogLevel level, LogCategory category, string text)
+        {
+            lock (m_lock)
+            {
+                m_messages[m_next] = text;
+                m_next = (m_next + 1) % m_messages.Length;
+                m_count = Math.Min(m_count + 1, m_messages.Length);
+            }
+        }
+
+        /// <summary>
+        /// Gets the stored messages.
+        /// </summary>
+        /// <returns>A new array containing the messages from oldest to newest.</returns>
+        public string[] GetMessages()
+        {
+            lock (m_lock)
+            {
+                string[] messages = new string[m_count];
+                int start = (m_next - m_count + m_messages.Length) % m_messages.Length;
+
+                for (int i = 0; i < m_count; i++)
+                {
+                    messages[i] = m_messages[(start + i) % m_messages.Length];
+                }
+                return messages;
+            }
+        }
+
+        /// <summary>
+        /// Removes all stored messages.
+        /// </summary>
+        public void Clear()
+        {
+            lock (m_lock)
+            {
+                Array.Clear(m_messages, 0, m_messages.Length);
+                m_next = 0;
+                m_count = 0;
+            }
+        }
+    }
+}
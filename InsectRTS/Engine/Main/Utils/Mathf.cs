@@ -3,6 +3,7 @@
 * See "Licence.txt" for full licence.
 */
 using System;
+using System.Numerics;
 using OpenTK;
 
 namespace Engine
@@ -72,6 +73,9 @@ namespace Engine
         /// </summary>
         public const float Log2E = 1.442695041f;
 
+        // the index of each lane in a vector of 32-bit values
+        private static readonly Vector<int> LANE_INDICES = CreateLaneIndices();
+
 
         /// <summary>
         /// Returns the least of two numbers.
@@ -93,21 +97,64 @@ namespace Engine
         /// </summary>
         public static double Min(double a, double b) => a < b ? a : b;
 
+        /// <summary>
+        /// Returns the least of three numbers.
+        /// </summary>
+        public static int Min(int a, int b, int c) => Min(Min(a, b), c);
+
+        /// <summary>
+        /// Returns the least of three numbers.
+        /// </summary>
+        public static float Min(float a, float b, float c) => Min(Min(a, b), c);
+
+        /// <summary>
+        /// Returns the least of a set of numbers.
+        /// </summary>
+        public static float Min(params int[] values) => Min(values, 0, values.Length);
+
         /// <summary>
         /// Returns the least of a set of numbers.
         /// </summary>
-        public static float Min(params int[] values)
+        /// <remarks>
+        /// NaN values are skipped. If every value is NaN, NaN is returned.
+        /// </remarks>
+        public static float Min(params float[] values) => Min(values, 0, values.Length);
+
+        /// <summary>
+        /// Returns the least of a range of numbers in an array. This does not allocate and is vectorized when possible.
+        /// </summary>
+        /// <param name="values">The array to search.</param>
+        /// <param name="index">The index of the first value to consider.</param>
+        /// <param name="length">The number of values to consider.</param>
+        /// <returns>The least value, or zero if the range is empty.</returns>
+        public static int Min(int[] values, int index, int length)
         {
-            int count = values.Length;
-            if (count == 0)
+            ValidateRange(values, index, length);
+
+            if (length == 0)
             {
                 return 0;
             }
 
-            var min = values[0];
-            for (int i = 1; i < count; i++)
+            var min = values[index];
+            int i = 0;
+
+            if (Simd.IsAccelerated && length >= Vector<int>.Count)
             {
-                var value = values[i];
+                var vectorMin = new Vector<int>(values, index);
+                for (i = Vector<int>.Count; i + Vector<int>.Count <= length; i += Vector<int>.Count)
+                {
+                    vectorMin = Vector.Min(vectorMin, new Vector<int>(values, index + i));
+                }
+                for (int j = 0; j < Vector<int>.Count; j++)
+                {
+                    min = Min(min, vectorMin[j]);
+                }
+            }
+
+            for (; i < length; i++)
+            {
+                var value = values[index + i];
                 if (value < min)
                 {
                     min = value;
@@ -118,21 +165,52 @@ namespace Engine
         }
 
         /// <summary>
-        /// Returns the least of a set of numbers.
+        /// Returns the least of a range of numbers in an array. This does not allocate and is vectorized when possible.
         /// </summary>
-        public static float Min(params float[] values)
+        /// <remarks>
+        /// NaN values are skipped. If every value is NaN, NaN is returned.
+        /// </remarks>
+        /// <param name="values">The array to search.</param>
+        /// <param name="index">The index of the first value to consider.</param>
+        /// <param name="length">The number of values to consider.</param>
+        /// <returns>The least value, or zero if the range is empty.</returns>
+        public static float Min(float[] values, int index, int length)
         {
-            int count = values.Length;
-            if (count == 0)
+            ValidateRange(values, index, length);
+
+            if (length == 0)
             {
                 return 0;
             }
 
-            var min = values[0];
-            for (int i = 1; i < count; i++)
+            var min = values[index];
+            int i = 0;
+
+            if (Simd.IsAccelerated && length >= Vector<float>.Count)
             {
-                var value = values[i];
-                if (value < min)
+                var vectorMin = new Vector<float>(values, index);
+                for (i = Vector<float>.Count; i + Vector<float>.Count <= length; i += Vector<float>.Count)
+                {
+                    var vector = new Vector<float>(values, index + i);
+
+                    // a lane holding NaN takes any other value
+                    var less = Vector.LessThan(vector, vectorMin) | Vector.AndNot(Vector.Equals(vector, vector), Vector.Equals(vectorMin, vectorMin));
+                    vectorMin = Vector.ConditionalSelect(less, vector, vectorMin);
+                }
+                for (int j = 0; j < Vector<float>.Count; j++)
+                {
+                    var value = vectorMin[j];
+                    if (value < min || float.IsNaN(min))
+                    {
+                        min = value;
+                    }
+                }
+            }
+
+            for (; i < length; i++)
+            {
+                var value = values[index + i];
+                if (value < min || float.IsNaN(min))
                 {
                     min = value;
                 }
@@ -161,21 +239,64 @@ namespace Engine
         /// </summary>
         public static double Max(double a, double b) => a > b ? a : b;
 
+        /// <summary>
+        /// Returns the greatest of three numbers.
+        /// </summary>
+        public static int Max(int a, int b, int c) => Max(Max(a, b), c);
+
+        /// <summary>
+        /// Returns the greatest of three numbers.
+        /// </summary>
+        public static float Max(float a, float b, float c) => Max(Max(a, b), c);
+
         /// <summary>
         /// Returns the greatest of a set of numbers.
         /// </summary>
-        public static float Max(params int[] values)
+        public static float Max(params int[] values) => Max(values, 0, values.Length);
+
+        /// <summary>
+        /// Returns the greatest of a set of numbers.
+        /// </summary>
+        /// <remarks>
+        /// NaN values are skipped. If every value is NaN, NaN is returned.
+        /// </remarks>
+        public static float Max(params float[] values) => Max(values, 0, values.Length);
+
+        /// <summary>
+        /// Returns the greatest of a range of numbers in an array. This does not allocate and is vectorized when possible.
+        /// </summary>
+        /// <param name="values">The array to search.</param>
+        /// <param name="index">The index of the first value to consider.</param>
+        /// <param name="length">The number of values to consider.</param>
+        /// <returns>The greatest value, or zero if the range is empty.</returns>
+        public static int Max(int[] values, int index, int length)
         {
-            int count = values.Length;
-            if (count == 0)
+            ValidateRange(values, index, length);
+
+            if (length == 0)
             {
                 return 0;
             }
 
-            var max = values[0];
-            for (int i = 1; i < count; i++)
+            var max = values[index];
+            int i = 0;
+
+            if (Simd.IsAccelerated && length >= Vector<int>.Count)
             {
-                var value = values[i];
+                var vectorMax = new Vector<int>(values, index);
+                for (i = Vector<int>.Count; i + Vector<int>.Count <= length; i += Vector<int>.Count)
+                {
+                    vectorMax = Vector.Max(vectorMax, new Vector<int>(values, index + i));
+                }
+                for (int j = 0; j < Vector<int>.Count; j++)
+                {
+                    max = Max(max, vectorMax[j]);
+                }
+            }
+
+            for (; i < length; i++)
+            {
+                var value = values[index + i];
                 if (value > max)
                 {
                     max = value;
@@ -186,21 +307,52 @@ namespace Engine
         }
 
         /// <summary>
-        /// Returns the greatest of a set of numbers.
+        /// Returns the greatest of a range of numbers in an array. This does not allocate and is vectorized when possible.
         /// </summary>
-        public static float Max(params float[] values)
+        /// <remarks>
+        /// NaN values are skipped. If every value is NaN, NaN is returned.
+        /// </remarks>
+        /// <param name="values">The array to search.</param>
+        /// <param name="index">The index of the first value to consider.</param>
+        /// <param name="length">The number of values to consider.</param>
+        /// <returns>The greatest value, or zero if the range is empty.</returns>
+        public static float Max(float[] values, int index, int length)
         {
-            int count = values.Length;
-            if (count == 0)
+            ValidateRange(values, index, length);
+
+            if (length == 0)
             {
                 return 0;
             }
 
-            var max = values[0];
-            for (int i = 1; i < count; i++)
+            var max = values[index];
+            int i = 0;
+
+            if (Simd.IsAccelerated && length >= Vector<float>.Count)
             {
-                var value = values[i];
-                if (value > max)
+                var vectorMax = new Vector<float>(values, index);
+                for (i = Vector<float>.Count; i + Vector<float>.Count <= length; i += Vector<float>.Count)
+                {
+                    var vector = new Vector<float>(values, index + i);
+
+                    // a lane holding NaN takes any other value
+                    var greater = Vector.GreaterThan(vector, vectorMax) | Vector.AndNot(Vector.Equals(vector, vector), Vector.Equals(vectorMax, vectorMax));
+                    vectorMax = Vector.ConditionalSelect(greater, vector, vectorMax);
+                }
+                for (int j = 0; j < Vector<float>.Count; j++)
+                {
+                    var value = vectorMax[j];
+                    if (value > max || float.IsNaN(max))
+                    {
+                        max = value;
+                    }
+                }
+            }
+
+            for (; i < length; i++)
+            {
+                var value = values[index + i];
+                if (value > max || float.IsNaN(max))
                 {
                     max = value;
                 }
@@ -209,6 +361,574 @@ namespace Engine
             return max;
         }
 
+        /// <summary>
+        /// Finds the least and greatest of a set of numbers in a single pass.
+        /// </summary>
+        /// <param name="values">The array to search.</param>
+        /// <param name="min">Returns the least value, or zero if the array is empty.</param>
+        /// <param name="max">Returns the greatest value, or zero if the array is empty.</param>
+        public static void MinMax(int[] values, out int min, out int max)
+        {
+            ValidateRange(values, 0, 0);
+            MinMax(values, 0, values.Length, out min, out max);
+        }
+
+        /// <summary>
+        /// Finds the least and greatest of a range of numbers in an array in a single pass. This does not
+        /// allocate and is vectorized when possible.
+        /// </summary>
+        /// <param name="values">The array to search.</param>
+        /// <param name="index">The index of the first value to consider.</param>
+        /// <param name="length">The number of values to consider.</param>
+        /// <param name="min">Returns the least value, or zero if the range is empty.</param>
+        /// <param name="max">Returns the greatest value, or zero if the range is empty.</param>
+        public static void MinMax(int[] values, int index, int length, out int min, out int max)
+        {
+            ValidateRange(values, index, length);
+
+            if (length == 0)
+            {
+                min = 0;
+                max = 0;
+                return;
+            }
+
+            min = values[index];
+            max = min;
+            int i = 0;
+
+            if (Simd.IsAccelerated && length >= Vector<int>.Count)
+            {
+                var vectorMin = new Vector<int>(values, index);
+                var vectorMax = vectorMin;
+                for (i = Vector<int>.Count; i + Vector<int>.Count <= length; i += Vector<int>.Count)
+                {
+                    var vector = new Vector<int>(values, index + i);
+                    vectorMin = Vector.Min(vectorMin, vector);
+                    vectorMax = Vector.Max(vectorMax, vector);
+                }
+                for (int j = 0; j < Vector<int>.Count; j++)
+                {
+                    min = Min(min, vectorMin[j]);
+                    max = Max(max, vectorMax[j]);
+                }
+            }
+
+            for (; i < length; i++)
+            {
+                var value = values[index + i];
+                if (value < min)
+                {
+                    min = value;
+                }
+                if (value > max)
+                {
+                    max = value;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Finds the least and greatest of a set of numbers in a single pass.
+        /// </summary>
+        /// <remarks>
+        /// NaN values are skipped. If every value is NaN, NaN is returned.
+        /// </remarks>
+        /// <param name="values">The array to search.</param>
+        /// <param name="min">Returns the least value, or zero if the array is empty.</param>
+        /// <param name="max">Returns the greatest value, or zero if the array is empty.</param>
+        public static void MinMax(float[] values, out float min, out float max)
+        {
+            ValidateRange(values, 0, 0);
+            MinMax(values, 0, values.Length, out min, out max);
+        }
+
+        /// <summary>
+        /// Finds the least and greatest of a range of numbers in an array in a single pass. This does not
+        /// allocate and is vectorized when possible.
+        /// </summary>
+        /// <remarks>
+        /// NaN values are skipped. If every value is NaN, NaN is returned.
+        /// </remarks>
+        /// <param name="values">The array to search.</param>
+        /// <param name="index">The index of the first value to consider.</param>
+        /// <param name="length">The number of values to consider.</param>
+        /// <param name="min">Returns the least value, or zero if the range is empty.</param>
+        /// <param name="max">Returns the greatest value, or zero if the range is empty.</param>
+        public static void MinMax(float[] values, int index, int length, out float min, out float max)
+        {
+            ValidateRange(values, index, length);
+
+            if (length == 0)
+            {
+                min = 0;
+                max = 0;
+                return;
+            }
+
+            min = values[index];
+            max = min;
+            int i = 0;
+
+            if (Simd.IsAccelerated && length >= Vector<float>.Count)
+            {
+                var vectorMin = new Vector<float>(values, index);
+                var vectorMax = vectorMin;
+                for (i = Vector<float>.Count; i + Vector<float>.Count <= length; i += Vector<float>.Count)
+                {
+                    var vector = new Vector<float>(values, index + i);
+
+                    // a lane holding NaN takes any other value
+                    var isNumber = Vector.Equals(vector, vector);
+                    var less = Vector.LessThan(vector, vectorMin) | Vector.AndNot(isNumber, Vector.Equals(vectorMin, vectorMin));
+                    var greater = Vector.GreaterThan(vector, vectorMax) | Vector.AndNot(isNumber, Vector.Equals(vectorMax, vectorMax));
+                    vectorMin = Vector.ConditionalSelect(less, vector, vectorMin);
+                    vectorMax = Vector.ConditionalSelect(greater, vector, vectorMax);
+                }
+                for (int j = 0; j < Vector<float>.Count; j++)
+                {
+                    var laneMin = vectorMin[j];
+                    if (laneMin < min || float.IsNaN(min))
+                    {
+                        min = laneMin;
+                    }
+                    var laneMax = vectorMax[j];
+                    if (laneMax > max || float.IsNaN(max))
+                    {
+                        max = laneMax;
+                    }
+                }
+            }
+
+            for (; i < length; i++)
+            {
+                var value = values[index + i];
+                if (value < min || float.IsNaN(min))
+                {
+                    min = value;
+                }
+                if (value > max || float.IsNaN(max))
+                {
+                    max = value;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Returns the sum of a set of numbers.
+        /// </summary>
+        /// <param name="values">The numbers to sum.</param>
+        public static int Sum(int[] values)
+        {
+            ValidateRange(values, 0, 0);
+            return Sum(values, 0, values.Length);
+        }
+
+        /// <summary>
+        /// Returns the sum of a range of numbers in an array. This does not allocate and is vectorized when possible.
+        /// </summary>
+        /// <remarks>
+        /// Overflow wraps around silently, as in an unchecked context.
+        /// </remarks>
+        /// <param name="values">The array containing the numbers to sum.</param>
+        /// <param name="index">The index of the first value to sum.</param>
+        /// <param name="length">The number of values to sum.</param>
+        public static int Sum(int[] values, int index, int length)
+        {
+            ValidateRange(values, index, length);
+
+            int sum = 0;
+            int i = 0;
+
+            if (Simd.IsAccelerated)
+            {
+                var vectorSum = Vector<int>.Zero;
+                for (; i + Vector<int>.Count <= length; i += Vector<int>.Count)
+                {
+                    vectorSum += new Vector<int>(values, index + i);
+                }
+                sum = Vector.Dot(vectorSum, Vector<int>.One);
+            }
+
+            for (; i < length; i++)
+            {
+                sum = unchecked(sum + values[index + i]);
+            }
+
+            return sum;
+        }
+
+        /// <summary>
+        /// Returns the sum of a set of numbers.
+        /// </summary>
+        /// <param name="values">The numbers to sum.</param>
+        public static float Sum(float[] values)
+        {
+            ValidateRange(values, 0, 0);
+            return Sum(values, 0, values.Length);
+        }
+
+        /// <summary>
+        /// Returns the sum of a range of numbers in an array. This does not allocate and is vectorized when possible.
+        /// </summary>
+        /// <remarks>
+        /// The values are summed in a different order from a sequential loop when vectorized,
+        /// so the result may differ slightly due to rounding.
+        /// </remarks>
+        /// <param name="values">The array containing the numbers to sum.</param>
+        /// <param name="index">The index of the first value to sum.</param>
+        /// <param name="length">The number of values to sum.</param>
+        public static float Sum(float[] values, int index, int length)
+        {
+            ValidateRange(values, index, length);
+
+            float sum = 0f;
+            int i = 0;
+
+            if (Simd.IsAccelerated)
+            {
+                var vectorSum = Vector<float>.Zero;
+                for (; i + Vector<float>.Count <= length; i += Vector<float>.Count)
+                {
+                    vectorSum += new Vector<float>(values, index + i);
+                }
+                sum = Vector.Dot(vectorSum, Vector<float>.One);
+            }
+
+            for (; i < length; i++)
+            {
+                sum += values[index + i];
+            }
+
+            return sum;
+        }
+
+        /// <summary>
+        /// Returns the index of the least of a set of numbers.
+        /// </summary>
+        /// <param name="values">The array to search.</param>
+        /// <returns>The index of the first occurrence of the least value, or -1 if the array is empty.</returns>
+        public static int ArgMin(int[] values)
+        {
+            ValidateRange(values, 0, 0);
+            return ArgMin(values, 0, values.Length);
+        }
+
+        /// <summary>
+        /// Returns the index of the least of a range of numbers in an array in a single pass. This does not
+        /// allocate and is vectorized when possible.
+        /// </summary>
+        /// <param name="values">The array to search.</param>
+        /// <param name="index">The index of the first value to consider.</param>
+        /// <param name="length">The number of values to consider.</param>
+        /// <returns>The array index of the first occurrence of the least value, or -1 if the range is empty.</returns>
+        public static int ArgMin(int[] values, int index, int length)
+        {
+            ValidateRange(values, index, length);
+
+            if (length == 0)
+            {
+                return -1;
+            }
+
+            int best = index;
+            int i = 1;
+
+            if (Simd.IsAccelerated && length >= Vector<int>.Count)
+            {
+                // each lane tracks the first index of its least value
+                var vectorBest = new Vector<int>(values, index);
+                var vectorIndex = new Vector<int>(index) + LANE_INDICES;
+                var indices = vectorIndex;
+                for (i = Vector<int>.Count; i + Vector<int>.Count <= length; i += Vector<int>.Count)
+                {
+                    var vector = new Vector<int>(values, index + i);
+                    indices += new Vector<int>(Vector<int>.Count);
+
+                    var better = Vector.LessThan(vector, vectorBest);
+                    vectorBest = Vector.ConditionalSelect(better, vector, vectorBest);
+                    vectorIndex = Vector.ConditionalSelect(better, indices, vectorIndex);
+                }
+                best = vectorIndex[0];
+                for (int j = 1; j < Vector<int>.Count; j++)
+                {
+                    var value = vectorBest[j];
+                    var current = values[best];
+                    if (value < current || (value == current && vectorIndex[j] < best))
+                    {
+                        best = vectorIndex[j];
+                    }
+                }
+            }
+
+            for (; i < length; i++)
+            {
+                if (values[index + i] < values[best])
+                {
+                    best = index + i;
+                }
+            }
+
+            return best;
+        }
+
+        /// <summary>
+        /// Returns the index of the least of a set of numbers.
+        /// </summary>
+        /// <remarks>
+        /// NaN values are skipped. If every value is NaN, the index of the first value is returned.
+        /// </remarks>
+        /// <param name="values">The array to search.</param>
+        /// <returns>The index of the first occurrence of the least value, or -1 if the array is empty.</returns>
+        public static int ArgMin(float[] values)
+        {
+            ValidateRange(values, 0, 0);
+            return ArgMin(values, 0, values.Length);
+        }
+
+        /// <summary>
+        /// Returns the index of the least of a range of numbers in an array in a single pass. This does not
+        /// allocate and is vectorized when possible.
+        /// </summary>
+        /// <remarks>
+        /// NaN values are skipped. If every value is NaN, the index of the first value is returned.
+        /// </remarks>
+        /// <param name="values">The array to search.</param>
+        /// <param name="index">The index of the first value to consider.</param>
+        /// <param name="length">The number of values to consider.</param>
+        /// <returns>The array index of the first occurrence of the least value, or -1 if the range is empty.</returns>
+        public static int ArgMin(float[] values, int index, int length)
+        {
+            ValidateRange(values, index, length);
+
+            if (length == 0)
+            {
+                return -1;
+            }
+
+            int best = index;
+            int i = 1;
+
+            if (Simd.IsAccelerated && length >= Vector<float>.Count)
+            {
+                // each lane tracks the first index of its least value
+                var vectorBest = new Vector<float>(values, index);
+                var vectorIndex = new Vector<int>(index) + LANE_INDICES;
+                var indices = vectorIndex;
+                for (i = Vector<float>.Count; i + Vector<float>.Count <= length; i += Vector<float>.Count)
+                {
+                    var vector = new Vector<float>(values, index + i);
+                    indices += new Vector<int>(Vector<float>.Count);
+
+                    // a lane holding NaN takes any other value
+                    var better = Vector.LessThan(vector, vectorBest) | Vector.AndNot(Vector.Equals(vector, vector), Vector.Equals(vectorBest, vectorBest));
+                    vectorBest = Vector.ConditionalSelect(better, vector, vectorBest);
+                    vectorIndex = Vector.ConditionalSelect(better, indices, vectorIndex);
+                }
+                best = vectorIndex[0];
+                for (int j = 1; j < Vector<float>.Count; j++)
+                {
+                    var value = vectorBest[j];
+                    var current = values[best];
+                    if (value < current || (value == current && vectorIndex[j] < best) || (float.IsNaN(current) && !float.IsNaN(value)))
+                    {
+                        best = vectorIndex[j];
+                    }
+                }
+            }
+
+            for (; i < length; i++)
+            {
+                var value = values[index + i];
+                var current = values[best];
+                if (value < current || (float.IsNaN(current) && !float.IsNaN(value)))
+                {
+                    best = index + i;
+                }
+            }
+
+            return best;
+        }
+
+        /// <summary>
+        /// Returns the index of the greatest of a set of numbers.
+        /// </summary>
+        /// <param name="values">The array to search.</param>
+        /// <returns>The index of the first occurrence of the greatest value, or -1 if the array is empty.</returns>
+        public static int ArgMax(int[] values)
+        {
+            ValidateRange(values, 0, 0);
+            return ArgMax(values, 0, values.Length);
+        }
+
+        /// <summary>
+        /// Returns the index of the greatest of a range of numbers in an array in a single pass. This does not
+        /// allocate and is vectorized when possible.
+        /// </summary>
+        /// <param name="values">The array to search.</param>
+        /// <param name="index">The index of the first value to consider.</param>
+        /// <param name="length">The number of values to consider.</param>
+        /// <returns>The array index of the first occurrence of the greatest value, or -1 if the range is empty.</returns>
+        public static int ArgMax(int[] values, int index, int length)
+        {
+            ValidateRange(values, index, length);
+
+            if (length == 0)
+            {
+                return -1;
+            }
+
+            int best = index;
+            int i = 1;
+
+            if (Simd.IsAccelerated && length >= Vector<int>.Count)
+            {
+                // each lane tracks the first index of its greatest value
+                var vectorBest = new Vector<int>(values, index);
+                var vectorIndex = new Vector<int>(index) + LANE_INDICES;
+                var indices = vectorIndex;
+                for (i = Vector<int>.Count; i + Vector<int>.Count <= length; i += Vector<int>.Count)
+                {
+                    var vector = new Vector<int>(values, index + i);
+                    indices += new Vector<int>(Vector<int>.Count);
+
+                    var better = Vector.GreaterThan(vector, vectorBest);
+                    vectorBest = Vector.ConditionalSelect(better, vector, vectorBest);
+                    vectorIndex = Vector.ConditionalSelect(better, indices, vectorIndex);
+                }
+                best = vectorIndex[0];
+                for (int j = 1; j < Vector<int>.Count; j++)
+                {
+                    var value = vectorBest[j];
+                    var current = values[best];
+                    if (value > current || (value == current && vectorIndex[j] < best))
+                    {
+                        best = vectorIndex[j];
+                    }
+                }
+            }
+
+            for (; i < length; i++)
+            {
+                if (values[index + i] > values[best])
+                {
+                    best = index + i;
+                }
+            }
+
+            return best;
+        }
+
+        /// <summary>
+        /// Returns the index of the greatest of a set of numbers.
+        /// </summary>
+        /// <remarks>
+        /// NaN values are skipped. If every value is NaN, the index of the first value is returned.
+        /// </remarks>
+        /// <param name="values">The array to search.</param>
+        /// <returns>The index of the first occurrence of the greatest value, or -1 if the array is empty.</returns>
+        public static int ArgMax(float[] values)
+        {
+            ValidateRange(values, 0, 0);
+            return ArgMax(values, 0, values.Length);
+        }
+
+        /// <summary>
+        /// Returns the index of the greatest of a range of numbers in an array in a single pass. This does not
+        /// allocate and is vectorized when possible.
+        /// </summary>
+        /// <remarks>
+        /// NaN values are skipped. If every value is NaN, the index of the first value is returned.
+        /// </remarks>
+        /// <param name="values">The array to search.</param>
+        /// <param name="index">The index of the first value to consider.</param>
+        /// <param name="length">The number of values to consider.</param>
+        /// <returns>The array index of the first occurrence of the greatest value, or -1 if the range is empty.</returns>
+        public static int ArgMax(float[] values, int index, int length)
+        {
+            ValidateRange(values, index, length);
+
+            if (length == 0)
+            {
+                return -1;
+            }
+
+            int best = index;
+            int i = 1;
+
+            if (Simd.IsAccelerated && length >= Vector<float>.Count)
+            {
+                // each lane tracks the first index of its greatest value
+                var vectorBest = new Vector<float>(values, index);
+                var vectorIndex = new Vector<int>(index) + LANE_INDICES;
+                var indices = vectorIndex;
+                for (i = Vector<float>.Count; i + Vector<float>.Count <= length; i += Vector<float>.Count)
+                {
+                    var vector = new Vector<float>(values, index + i);
+                    indices += new Vector<int>(Vector<float>.Count);
+
+                    // a lane holding NaN takes any other value
+                    var better = Vector.GreaterThan(vector, vectorBest) | Vector.AndNot(Vector.Equals(vector, vector), Vector.Equals(vectorBest, vectorBest));
+                    vectorBest = Vector.ConditionalSelect(better, vector, vectorBest);
+                    vectorIndex = Vector.ConditionalSelect(better, indices, vectorIndex);
+                }
+                best = vectorIndex[0];
+                for (int j = 1; j < Vector<float>.Count; j++)
+                {
+                    var value = vectorBest[j];
+                    var current = values[best];
+                    if (value > current || (value == current && vectorIndex[j] < best) || (float.IsNaN(current) && !float.IsNaN(value)))
+                    {
+                        best = vectorIndex[j];
+                    }
+                }
+            }
+
+            for (; i < length; i++)
+            {
+                var value = values[index + i];
+                var current = values[best];
+                if (value > current || (float.IsNaN(current) && !float.IsNaN(value)))
+                {
+                    best = index + i;
+                }
+            }
+
+            return best;
+        }
+
+        /// <summary>
+        /// Gets the index of each lane of a <see cref="Vector{T}"/> of 32-bit elements.
+        /// </summary>
+        private static Vector<int> CreateLaneIndices()
+        {
+            var indices = new int[Vector<int>.Count];
+            for (int i = 0; i < indices.Length; i++)
+            {
+                indices[i] = i;
+            }
+            return new Vector<int>(indices);
+        }
+
+        /// <summary>
+        /// Throws an exception if a range is not valid for an array.
+        /// </summary>
+        private static void ValidateRange(Array values, int index, int length)
+        {
+            if (values == null)
+            {
+                throw new ArgumentNullException("values");
+            }
+            if (index < 0 || length < 0)
+            {
+                throw new ArgumentOutOfRangeException(index < 0 ? "index" : "length", "Must be non-negative!");
+            }
+            if (values.Length < index + length)
+            {
+                throw new ArgumentException("Array length is lesser than index + length");
+            }
+        }
+
 
         /// <summary>
         /// Clamps a number between a minimum and a maximum.
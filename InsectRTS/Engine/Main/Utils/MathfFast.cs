@@ -0,0 +1,721 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Numerics;
+using System.Runtime.CompilerServices;
+
+namespace Engine
+{
+    /// <summary>
+    /// Contains fast approximations of the transcendental functions in <see cref="Mathf"/>.
+    /// </summary>
+    /// <remarks>
+    /// The functions in <see cref="Mathf"/> widen to double and call into <see cref="Math"/>, which is
+    /// accurate but slow in tight loops. These approximations are evaluated entirely in single precision using
+    /// polynomials, so they inline well and can be vectorized. The maximum error of each function is given in
+    /// its documentation, measured against the double precision result. Prefer <see cref="Mathf"/> wherever
+    /// accuracy matters more than throughput, such as in gameplay code that must be deterministic.
+    /// </remarks>
+    public static unsafe class MathfFast
+    {
+        // range reduction for sin/cos, 2π split so that n * TWO_PI_HI is exact for |n| < 2^16
+        private const float INV_TWO_PI = 0.159154937f;
+        private const float TWO_PI_HI = 6.28125f;
+        private const float TWO_PI_LO = 0.00193530717f;
+
+        // sin(x) / x for x in [-π/2, π/2], as a polynomial in x²
+        private const float SIN_0 = 1f;
+        private const float SIN_1 = -0.166666478f;
+        private const float SIN_2 = 0.00833289977f;
+        private const float SIN_3 = -0.000198009002f;
+        private const float SIN_4 = 2.59049307e-06f;
+
+        // cos(x) for x in [-π/2, π/2], as a polynomial in x²
+        private const float COS_0 = 0.99999994f;
+        private const float COS_1 = -0.499999046f;
+        private const float COS_2 = 0.0416635908f;
+        private const float COS_3 = -0.00138537411f;
+        private const float COS_4 = 2.31546073e-05f;
+
+        // atan(x) / x for x in [-1, 1], as a polynomial in x²
+        private const float ATAN_0 = 0.999996126f;
+        private const float ATAN_1 = -0.333173692f;
+        private const float ATAN_2 = 0.1980782f;
+        private const float ATAN_3 = -0.132333413f;
+        private const float ATAN_4 = 0.0796234757f;
+        private const float ATAN_5 = -0.0336039513f;
+        private const float ATAN_6 = 0.00681168353f;
+
+        // 2^x for x in [-0.5, 0.5]
+        private const float EXP2_0 = 1.00000012f;
+        private const float EXP2_1 = 0.693146944f;
+        private const float EXP2_2 = 0.240221202f;
+        private const float EXP2_3 = 0.0555071346f;
+        private const float EXP2_4 = 0.00967554096f;
+        private const float EXP2_5 = 0.00132764108f;
+
+        // range reduction for exp, ln(2) split so that n * LN2_HI is exact
+        private const float LOG2_E = 1.44269502f;
+        private const float LN2_HI = 0.693359375f;
+        private const float LN2_LO = -0.000212194442f;
+        private const float LN2 = 0.693147182f;
+
+        // inputs outside this range underflow to zero or overflow to infinity
+        private const float EXP_MIN = -87.5f;
+        private const float EXP_MAX = 89f;
+
+        private const float SQRT2 = 1.41421354f;
+
+        // adding and subtracting 1.5 * 2^23 rounds a float to the nearest integer
+        private const float ROUND_MAGIC = 12582912f;
+        private const int ROUND_MAGIC_BITS = 0x4B400000;
+
+        /// <summary>
+        /// Gets the sine of an angle.
+        /// </summary>
+        /// <remarks>
+        /// The absolute error is less than 3e-7 for angles in [-1000, 1000]. The error slowly grows for larger
+        /// angles, and the result is undefined for angles larger in magnitude than 1e5.
+        /// </remarks>
+        /// <param name="n">The angle in radians.</param>
+        public static float Sin(float n)
+        {
+            float r = ReduceAngle(n, out _);
+            float r2 = r * r;
+            return r * (SIN_0 + r2 * (SIN_1 + r2 * (SIN_2 + r2 * (SIN_3 + r2 * SIN_4))));
+        }
+
+        /// <summary>
+        /// Gets the cosine of an angle.
+        /// </summary>
+        /// <remarks>
+        /// The absolute error is less than 3e-7 for angles in [-1000, 1000]. The error slowly grows for larger
+        /// angles, and the result is undefined for angles larger in magnitude than 1e5.
+        /// </remarks>
+        /// <param name="n">The angle in radians.</param>
+        public static float Cos(float n)
+        {
+            float r = ReduceAngle(n, out bool folded);
+            float r2 = r * r;
+            float cos = COS_0 + r2 * (COS_1 + r2 * (COS_2 + r2 * (COS_3 + r2 * COS_4)));
+            return folded ? -cos : cos;
+        }
+
+        /// <summary>
+        /// Gets the sine and cosine of an angle. This is faster than calling <see cref="Sin(float)"/>
+        /// and <see cref="Cos(float)"/> separately, and has the same accuracy.
+        /// </summary>
+        /// <param name="n">The angle in radians.</param>
+        /// <param name="sin">The sine of the angle.</param>
+        /// <param name="cos">The cosine of the angle.</param>
+        public static void SinCos(float n, out float sin, out float cos)
+        {
+            float r = ReduceAngle(n, out bool folded);
+            float r2 = r * r;
+            float c = COS_0 + r2 * (COS_1 + r2 * (COS_2 + r2 * (COS_3 + r2 * COS_4)));
+
+            sin = r * (SIN_0 + r2 * (SIN_1 + r2 * (SIN_2 + r2 * (SIN_3 + r2 * SIN_4))));
+            cos = folded ? -c : c;
+        }
+
+        /// <summary>
+        /// Reduces an angle to the range [-π/2, π/2], such that the sine is unchanged.
+        /// </summary>
+        /// <param name="n">The angle in radians.</param>
+        /// <param name="folded">Indicates if the cosine of the reduced angle has the opposite sign.</param>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static float ReduceAngle(float n, out bool folded)
+        {
+            float k = n * INV_TWO_PI;
+            int q = (int)(k < 0f ? k - 0.5f : k + 0.5f);
+            float r = (n - q * TWO_PI_HI) - q * TWO_PI_LO;
+
+            if (r > Mathf.PiOver2)
+            {
+                folded = true;
+                return Mathf.Pi - r;
+            }
+            if (r < -Mathf.PiOver2)
+            {
+                folded = true;
+                return -Mathf.Pi - r;
+            }
+            folded = false;
+            return r;
+        }
+
+        /// <summary>
+        /// Gets the angle whose tangent is the specified value.
+        /// </summary>
+        /// <remarks>
+        /// The absolute error is less than 6e-7 radians.
+        /// </remarks>
+        /// <param name="n">The tangent of the angle.</param>
+        /// <returns>The angle in radians in the range [-π/2, π/2].</returns>
+        public static float Atan(float n)
+        {
+            if (n > 1f)
+            {
+                return Mathf.PiOver2 - AtanUnit(1f / n);
+            }
+            if (n < -1f)
+            {
+                return -Mathf.PiOver2 - AtanUnit(1f / n);
+            }
+            return AtanUnit(n);
+        }
+
+        /// <summary>
+        /// Gets the angle whose tangent is the quotient of two numbers.
+        /// </summary>
+        /// <remarks>
+        /// The absolute error is less than 6e-7 radians. Returns zero when both arguments are zero.
+        /// </remarks>
+        /// <param name="y">The y coordinate of a point.</param>
+        /// <param name="x">The x coordinate of a point.</param>
+        /// <returns>The angle in radians in the range [-π, π].</returns>
+        public static float Atan2(float y, float x)
+        {
+            if (x == 0f && y == 0f)
+            {
+                return 0f;
+            }
+
+            if (Math.Abs(x) >= Math.Abs(y))
+            {
+                float a = AtanUnit(y / x);
+                if (x < 0f)
+                {
+                    return y >= 0f ? a + Mathf.Pi : a - Mathf.Pi;
+                }
+                return a;
+            }
+            else
+            {
+                float a = AtanUnit(x / y);
+                return y > 0f ? Mathf.PiOver2 - a : -Mathf.PiOver2 - a;
+            }
+        }
+
+        /// <summary>
+        /// Approximates atan for values in the range [-1, 1].
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static float AtanUnit(float n)
+        {
+            float n2 = n * n;
+            return n * (ATAN_0 + n2 * (ATAN_1 + n2 * (ATAN_2 + n2 * (ATAN_3 + n2 * (ATAN_4 + n2 * (ATAN_5 + n2 * ATAN_6))))));
+        }
+
+        /// <summary>
+        /// Gets e raised to the specified power.
+        /// </summary>
+        /// <remarks>
+        /// The relative error is less than 3e-7. Results too small to be represented as a normalized
+        /// float are flushed to zero. The power must not be NaN.
+        /// </remarks>
+        /// <param name="p">The power to raise e to.</param>
+        public static float Exp(float p)
+        {
+            if (p < EXP_MIN)
+            {
+                p = EXP_MIN;
+            }
+            else if (p > EXP_MAX)
+            {
+                p = EXP_MAX;
+            }
+
+            // split into e^p = 2^n * 2^f, where n is an integer and f is in [-0.5, 0.5]
+            float k = p * LOG2_E;
+            int n = (int)(k < 0f ? k - 0.5f : k + 0.5f);
+            float f = ((p - n * LN2_HI) - n * LN2_LO) * LOG2_E;
+
+            float poly = EXP2_0 + f * (EXP2_1 + f * (EXP2_2 + f * (EXP2_3 + f * (EXP2_4 + f * EXP2_5))));
+
+            // build 2^(n-1) directly from the exponent bits, so n = 128 does not overflow the exponent
+            int bits = (n + 126) << 23;
+            return (poly * *(float*)&bits) * 2f;
+        }
+
+        /// <summary>
+        /// Gets the natural logarithm of a number.
+        /// </summary>
+        /// <remarks>
+        /// The relative error is less than 3e-7 for normalized positive inputs. Returns negative infinity
+        /// for zero and NaN for negative numbers. Denormalized inputs are not supported.
+        /// </remarks>
+        /// <param name="n">The number to get the logarithm of.</param>
+        public static float Log(float n)
+        {
+            if (n <= 0f)
+            {
+                return n == 0f ? float.NegativeInfinity : float.NaN;
+            }
+
+            // split into n = m * 2^e with m in [√½, √2]
+            int bits = *(int*)&n;
+            int e = ((bits >> 23) & 0xFF) - 127;
+            bits = (bits & 0x007FFFFF) | 0x3F800000;
+            float m = *(float*)&bits;
+
+            if (m > SQRT2)
+            {
+                m *= 0.5f;
+                e++;
+            }
+
+            // ln(m) = 2 atanh(s), where s = (m - 1) / (m + 1) is in [-0.172, 0.172]
+            float s = (m - 1f) / (m + 1f);
+            float s2 = s * s;
+            float poly = 1f + s2 * (1f / 3f + s2 * (1f / 5f + s2 * (1f / 7f)));
+
+            return e * LN2 + (2f * s) * poly;
+        }
+
+        /// <summary>
+        /// Gets a number raised to a specified power.
+        /// </summary>
+        /// <remarks>
+        /// Computed as e^(p * ln(b)), so the relative error grows with the magnitude of the exponent:
+        /// it is less than 2e-6 while |p * ln(b)| is less than 20. The base must be positive.
+        /// </remarks>
+        /// <param name="b">The base. Must be positive.</param>
+        /// <param name="p">The power to raise to.</param>
+        public static float Pow(float b, float p) => Exp(p * Log(b));
+
+        /// <summary>
+        /// Gets the square root of a number.
+        /// </summary>
+        /// <remarks>
+        /// This is exact, since the hardware square root instruction is already faster than any
+        /// approximation. It is provided so that code using this class does not need to mix in
+        /// <see cref="Mathf"/>, and so that the array overload can be vectorized.
+        /// </remarks>
+        /// <param name="n">The number to get the square root of.</param>
+        public static float Sqrt(float n) => (float)Math.Sqrt(n);
+
+        /// <summary>
+        /// Gets the reciprocal of the square root of a number.
+        /// </summary>
+        /// <remarks>
+        /// The relative error is less than 5e-6 for normalized positive inputs. The result is undefined
+        /// for zero, negative and denormalized inputs.
+        /// </remarks>
+        /// <param name="n">The number to get the inverse square root of.</param>
+        public static float InverseSqrt(float n)
+        {
+            float half = 0.5f * n;
+            int bits = 0x5F375A86 - (*(int*)&n >> 1);
+            float y = *(float*)&bits;
+
+            // two newton iterations
+            y = y * (1.5f - half * (y * y));
+            y = y * (1.5f - half * (y * y));
+            return y;
+        }
+
+        /// <summary>
+        /// Computes the sine of each value in an array.
+        /// </summary>
+        /// <param name="srcArray">Source array.</param>
+        /// <param name="destArray">Destination array. May be the source array.</param>
+        public static void Sin(float[] srcArray, float[] destArray)
+        {
+            ValidateArrays(srcArray, destArray);
+            Sin(srcArray, 0, destArray, 0, srcArray.Length);
+        }
+
+        /// <summary>
+        /// Computes the sine of a range of values in an array.
+        /// </summary>
+        /// <remarks>
+        /// Each result is within the error documented by <see cref="Sin(float)"/>.
+        /// </remarks>
+        /// <param name="srcArray">Source array.</param>
+        /// <param name="srcIndex">The starting index of the source array.</param>
+        /// <param name="destArray">Destination array. May be the source array.</param>
+        /// <param name="destIndex">The starting index of the destination array.</param>
+        /// <param name="length">The number of values to process.</param>
+        public static void Sin(float[] srcArray, int srcIndex, float[] destArray, int destIndex, int length)
+        {
+            ValidateArrays(srcArray, srcIndex, destArray, destIndex, length);
+
+            int i = 0;
+
+            if (Simd.IsAccelerated)
+            {
+                for (; i + Vector<float>.Count <= length; i += Vector<float>.Count)
+                {
+                    SinCos(new Vector<float>(srcArray, srcIndex + i), out Vector<float> sin, out _);
+                    sin.CopyTo(destArray, destIndex + i);
+                }
+            }
+
+            for (; i < length; i++)
+            {
+                destArray[destIndex + i] = Sin(srcArray[srcIndex + i]);
+            }
+        }
+
+        /// <summary>
+        /// Computes the cosine of each value in an array.
+        /// </summary>
+        /// <param name="srcArray">Source array.</param>
+        /// <param name="destArray">Destination array. May be the source array.</param>
+        public static void Cos(float[] srcArray, float[] destArray)
+        {
+            ValidateArrays(srcArray, destArray);
+            Cos(srcArray, 0, destArray, 0, srcArray.Length);
+        }
+
+        /// <summary>
+        /// Computes the cosine of a range of values in an array.
+        /// </summary>
+        /// <remarks>
+        /// Each result is within the error documented by <see cref="Cos(float)"/>.
+        /// </remarks>
+        /// <param name="srcArray">Source array.</param>
+        /// <param name="srcIndex">The starting index of the source array.</param>
+        /// <param name="destArray">Destination array. May be the source array.</param>
+        /// <param name="destIndex">The starting index of the destination array.</param>
+        /// <param name="length">The number of values to process.</param>
+        public static void Cos(float[] srcArray, int srcIndex, float[] destArray, int destIndex, int length)
+        {
+            ValidateArrays(srcArray, srcIndex, destArray, destIndex, length);
+
+            int i = 0;
+
+            if (Simd.IsAccelerated)
+            {
+                for (; i + Vector<float>.Count <= length; i += Vector<float>.Count)
+                {
+                    SinCos(new Vector<float>(srcArray, srcIndex + i), out _, out Vector<float> cos);
+                    cos.CopyTo(destArray, destIndex + i);
+                }
+            }
+
+            for (; i < length; i++)
+            {
+                destArray[destIndex + i] = Cos(srcArray[srcIndex + i]);
+            }
+        }
+
+        /// <summary>
+        /// Computes the sine and cosine of each value in an array.
+        /// </summary>
+        /// <param name="srcArray">Source array.</param>
+        /// <param name="sinArray">The array to store the sines in.</param>
+        /// <param name="cosArray">The array to store the cosines in.</param>
+        public static void SinCos(float[] srcArray, float[] sinArray, float[] cosArray)
+        {
+            ValidateArrays(srcArray, sinArray);
+            ValidateArrays(srcArray, cosArray);
+            SinCos(srcArray, 0, sinArray, cosArray, 0, srcArray.Length);
+        }
+
+        /// <summary>
+        /// Computes the sine and cosine of a range of values in an array.
+        /// </summary>
+        /// <param name="srcArray">Source array.</param>
+        /// <param name="srcIndex">The starting index of the source array.</param>
+        /// <param name="sinArray">The array to store the sines in.</param>
+        /// <param name="cosArray">The array to store the cosines in.</param>
+        /// <param name="destIndex">The starting index of the destination arrays.</param>
+        /// <param name="length">The number of values to process.</param>
+        public static void SinCos(float[] srcArray, int srcIndex, float[] sinArray, float[] cosArray, int destIndex, int length)
+        {
+            ValidateArrays(srcArray, srcIndex, sinArray, destIndex, length);
+            ValidateArrays(srcArray, srcIndex, cosArray, destIndex, length);
+
+            int i = 0;
+
+            if (Simd.IsAccelerated)
+            {
+                for (; i + Vector<float>.Count <= length; i += Vector<float>.Count)
+                {
+                    SinCos(new Vector<float>(srcArray, srcIndex + i), out Vector<float> sin, out Vector<float> cos);
+                    sin.CopyTo(sinArray, destIndex + i);
+                    cos.CopyTo(cosArray, destIndex + i);
+                }
+            }
+
+            for (; i < length; i++)
+            {
+                SinCos(srcArray[srcIndex + i], out sinArray[destIndex + i], out cosArray[destIndex + i]);
+            }
+        }
+
+        /// <summary>
+        /// Computes e raised to each value in an array.
+        /// </summary>
+        /// <param name="srcArray">Source array.</param>
+        /// <param name="destArray">Destination array. May be the source array.</param>
+        public static void Exp(float[] srcArray, float[] destArray)
+        {
+            ValidateArrays(srcArray, destArray);
+            Exp(srcArray, 0, destArray, 0, srcArray.Length);
+        }
+
+        /// <summary>
+        /// Computes e raised to a range of values in an array.
+        /// </summary>
+        /// <remarks>
+        /// Each result is within the error documented by <see cref="Exp(float)"/>.
+        /// </remarks>
+        /// <param name="srcArray">Source array.</param>
+        /// <param name="srcIndex">The starting index of the source array.</param>
+        /// <param name="destArray">Destination array. May be the source array.</param>
+        /// <param name="destIndex">The starting index of the destination array.</param>
+        /// <param name="length">The number of values to process.</param>
+        public static void Exp(float[] srcArray, int srcIndex, float[] destArray, int destIndex, int length)
+        {
+            ValidateArrays(srcArray, srcIndex, destArray, destIndex, length);
+
+            int i = 0;
+
+            if (Simd.IsAccelerated)
+            {
+                for (; i + Vector<float>.Count <= length; i += Vector<float>.Count)
+                {
+                    Exp(new Vector<float>(srcArray, srcIndex + i)).CopyTo(destArray, destIndex + i);
+                }
+            }
+
+            for (; i < length; i++)
+            {
+                destArray[destIndex + i] = Exp(srcArray[srcIndex + i]);
+            }
+        }
+
+        /// <summary>
+        /// Computes the square root of each value in an array.
+        /// </summary>
+        /// <param name="srcArray">Source array.</param>
+        /// <param name="destArray">Destination array. May be the source array.</param>
+        public static void Sqrt(float[] srcArray, float[] destArray)
+        {
+            ValidateArrays(srcArray, destArray);
+            Sqrt(srcArray, 0, destArray, 0, srcArray.Length);
+        }
+
+        /// <summary>
+        /// Computes the square root of a range of values in an array.
+        /// </summary>
+        /// <param name="srcArray">Source array.</param>
+        /// <param name="srcIndex">The starting index of the source array.</param>
+        /// <param name="destArray">Destination array. May be the source array.</param>
+        /// <param name="destIndex">The starting index of the destination array.</param>
+        /// <param name="length">The number of values to process.</param>
+        public static void Sqrt(float[] srcArray, int srcIndex, float[] destArray, int destIndex, int length)
+        {
+            ValidateArrays(srcArray, srcIndex, destArray, destIndex, length);
+
+            int i = 0;
+
+            if (Simd.IsAccelerated)
+            {
+                for (; i + Vector<float>.Count <= length; i += Vector<float>.Count)
+                {
+                    Vector.SquareRoot(new Vector<float>(srcArray, srcIndex + i)).CopyTo(destArray, destIndex + i);
+                }
+            }
+
+            for (; i < length; i++)
+            {
+                destArray[destIndex + i] = Sqrt(srcArray[srcIndex + i]);
+            }
+        }
+
+        /// <summary>
+        /// Computes the inverse square root of each value in an array.
+        /// </summary>
+        /// <param name="srcArray">Source array.</param>
+        /// <param name="destArray">Destination array. May be the source array.</param>
+        public static void InverseSqrt(float[] srcArray, float[] destArray)
+        {
+            ValidateArrays(srcArray, destArray);
+            InverseSqrt(srcArray, 0, destArray, 0, srcArray.Length);
+        }
+
+        /// <summary>
+        /// Computes the inverse square root of a range of values in an array.
+        /// </summary>
+        /// <remarks>
+        /// Unlike <see cref="InverseSqrt(float)"/>, this is exact to within one ulp. When vectorized the hardware
+        /// square root and division are faster than the integer approximation, so values left over by the
+        /// vectorized loop use the same computation, and results do not depend on their position in the array.
+        /// </remarks>
+        /// <param name="srcArray">Source array.</param>
+        /// <param name="srcIndex">The starting index of the source array.</param>
+        /// <param name="destArray">Destination array. May be the source array.</param>
+        /// <param name="destIndex">The starting index of the destination array.</param>
+        /// <param name="length">The number of values to process.</param>
+        public static void InverseSqrt(float[] srcArray, int srcIndex, float[] destArray, int destIndex, int length)
+        {
+            ValidateArrays(srcArray, srcIndex, destArray, destIndex, length);
+
+            int i = 0;
+
+            if (Simd.IsAccelerated)
+            {
+                for (; i + Vector<float>.Count <= length; i += Vector<float>.Count)
+                {
+                    Vector<float> n = new Vector<float>(srcArray, srcIndex + i);
+                    (Vector<float>.One / Vector.SquareRoot(n)).CopyTo(destArray, destIndex + i);
+                }
+            }
+
+            for (; i < length; i++)
+            {
+                destArray[destIndex + i] = 1f / (float)Math.Sqrt(srcArray[srcIndex + i]);
+            }
+        }
+
+        /// <summary>
+        /// Rounds each component of a vector to the nearest integer. Only valid for magnitudes below 2^22.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static Vector<float> Round(Vector<float> n)
+        {
+            Vector<float> magic = new Vector<float>(ROUND_MAGIC);
+            return (n + magic) - magic;
+        }
+
+        /// <summary>
+        /// Computes the sine and cosine of each component of a vector.
+        /// </summary>
+        internal static void SinCos(Vector<float> n, out Vector<float> sin, out Vector<float> cos)
+        {
+            Vector<float> q = Round(n * new Vector<float>(INV_TWO_PI));
+            Vector<float> r = (n - q * new Vector<float>(TWO_PI_HI)) - q * new Vector<float>(TWO_PI_LO);
+
+            Vector<float> pi = new Vector<float>(Mathf.Pi);
+            Vector<float> piOver2 = new Vector<float>(Mathf.PiOver2);
+
+            Vector<int> high = Vector.GreaterThan(r, piOver2);
+            Vector<int> low = Vector.LessThan(r, -piOver2);
+            Vector<int> folded = high | low;
+
+            r = Vector.ConditionalSelect(high, pi - r, Vector.ConditionalSelect(low, -pi - r, r));
+
+            Vector<float> r2 = r * r;
+
+            Vector<float> s = new Vector<float>(SIN_4);
+            s = s * r2 + new Vector<float>(SIN_3);
+            s = s * r2 + new Vector<float>(SIN_2);
+            s = s * r2 + new Vector<float>(SIN_1);
+            s = s * r2 + new Vector<float>(SIN_0);
+
+            Vector<float> c = new Vector<float>(COS_4);
+            c = c * r2 + new Vector<float>(COS_3);
+            c = c * r2 + new Vector<float>(COS_2);
+            c = c * r2 + new Vector<float>(COS_1);
+            c = c * r2 + new Vector<float>(COS_0);
+
+            sin = r * s;
+            cos = Vector.ConditionalSelect(folded, -c, c);
+        }
+
+        /// <summary>
+        /// Computes the arccosine of each component of a vector. The components must be in [0, 1].
+        /// </summary>
+        /// <remarks>
+        /// The absolute error is less than 6e-7 radians, the same as <see cref="Atan(float)"/>.
+        /// </remarks>
+        internal static Vector<float> Acos(Vector<float> n)
+        {
+            // acos(n) = atan2(sqrt(1 - n²), n), where both arguments are positive
+            Vector<float> s = Vector.SquareRoot(Vector.Max(Vector<float>.One - n * n, Vector<float>.Zero));
+            Vector<float> a = AtanUnit(Vector.Min(n, s) / Vector.Max(n, s));
+            return Vector.ConditionalSelect(Vector.LessThan(n, s), new Vector<float>(Mathf.PiOver2) - a, a);
+        }
+
+        /// <summary>
+        /// Approximates atan for each component of a vector in the range [-1, 1].
+        /// </summary>
+        private static Vector<float> AtanUnit(Vector<float> n)
+        {
+            Vector<float> n2 = n * n;
+
+            Vector<float> poly = new Vector<float>(ATAN_6);
+            poly = poly * n2 + new Vector<float>(ATAN_5);
+            poly = poly * n2 + new Vector<float>(ATAN_4);
+            poly = poly * n2 + new Vector<float>(ATAN_3);
+            poly = poly * n2 + new Vector<float>(ATAN_2);
+            poly = poly * n2 + new Vector<float>(ATAN_1);
+            poly = poly * n2 + new Vector<float>(ATAN_0);
+
+            return n * poly;
+        }
+
+        /// <summary>
+        /// Computes e raised to each component of a vector.
+        /// </summary>
+        private static Vector<float> Exp(Vector<float> p)
+        {
+            p = Vector.Min(Vector.Max(p, new Vector<float>(EXP_MIN)), new Vector<float>(EXP_MAX));
+
+            // the low bits of k + ROUND_MAGIC hold the rounded integer
+            Vector<float> k = p * new Vector<float>(LOG2_E) + new Vector<float>(ROUND_MAGIC);
+            Vector<float> n = k - new Vector<float>(ROUND_MAGIC);
+            Vector<float> f = ((p - n * new Vector<float>(LN2_HI)) - n * new Vector<float>(LN2_LO)) * new Vector<float>(LOG2_E);
+
+            Vector<float> poly = new Vector<float>(EXP2_5);
+            poly = poly * f + new Vector<float>(EXP2_4);
+            poly = poly * f + new Vector<float>(EXP2_3);
+            poly = poly * f + new Vector<float>(EXP2_2);
+            poly = poly * f + new Vector<float>(EXP2_1);
+            poly = poly * f + new Vector<float>(EXP2_0);
+
+            Vector<int> exponent = Vector.AsVectorInt32(k) - new Vector<int>(ROUND_MAGIC_BITS - 126);
+            Vector<float> scale = Vector.AsVectorSingle(exponent * new Vector<int>(1 << 23));
+
+            return (poly * scale) * new Vector<float>(2f);
+        }
+
+        /// <summary>
+        /// Throws an exception if the arrays are not valid for a whole array operation.
+        /// </summary>
+        private static void ValidateArrays(float[] srcArray, float[] destArray)
+        {
+            if (srcArray == null)
+            {
+                throw new ArgumentNullException("srcArray");
+            }
+            if (destArray == null)
+            {
+                throw new ArgumentNullException("destArray");
+            }
+            if (destArray.Length < srcArray.Length)
+            {
+                throw new ArgumentException("Destination array is smaller than source array.");
+            }
+        }
+
+        /// <summary>
+        /// Throws an exception if the arrays are not valid for an operation over a range.
+        /// </summary>
+        private static void ValidateArrays(float[] srcArray, int srcIndex, float[] destArray, int destIndex, int length)
+        {
+            if (srcArray == null)
+            {
+                throw new ArgumentNullException("srcArray");
+            }
+            if (destArray == null)
+            {
+                throw new ArgumentNullException("destArray");
+            }
+            if (srcArray.Length < srcIndex + length)
+            {
+                throw new ArgumentException("Source array length is lesser than srcIndex + length");
+            }
+            if (destArray.Length < destIndex + length)
+            {
+                throw new ArgumentException("Destination array length is lesser than destIndex + length");
+            }
+        }
+    }
+}
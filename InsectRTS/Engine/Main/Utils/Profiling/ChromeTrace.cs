@@ -0,0 +1,113 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Globalization;
+using System.IO;
+using System.Text;
+
+namespace Engine.Profiling
+{
+    /// <summary>
+    /// A completed sample recorded while capturing.
+    /// </summary>
+    internal struct TraceEvent
+    {
+        public string name;
+        public int threadId;
+        public long start;
+        public long duration;
+    }
+
+    /// <summary>
+    /// Writes samples in the Chrome trace event JSON format, which can be opened in chrome://tracing
+    /// or other trace viewers.
+    /// </summary>
+    internal static class ChromeTrace
+    {
+        /// <summary>
+        /// Writes a trace.
+        /// </summary>
+        /// <param name="writer">The writer to write the JSON to.</param>
+        /// <param name="events">The samples to write.</param>
+        /// <param name="threadNames">The names of the threads, by thread ID.</param>
+        /// <param name="captureStart">The timestamp that trace times are measured from.</param>
+        public static void Write(TextWriter writer, List<TraceEvent> events, Dictionary<int, string> threadNames, long captureStart)
+        {
+            StringBuilder sb = new StringBuilder();
+            bool first = true;
+
+            writer.Write("{\"traceEvents\":[");
+
+            foreach (KeyValuePair<int, string> thread in threadNames)
+            {
+                sb.Clear();
+                sb.Append(first ? "\n" : ",\n");
+                sb.Append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":");
+                sb.Append(thread.Key.ToString(CultureInfo.InvariantCulture));
+                sb.Append(",\"args\":{\"name\":");
+                AppendString(sb, thread.Value);
+                sb.Append("}}");
+
+                writer.Write(sb.ToString());
+                first = false;
+            }
+
+            foreach (TraceEvent e in events)
+            {
+                sb.Clear();
+                sb.Append(first ? "\n" : ",\n");
+                sb.Append("{\"name\":");
+                AppendString(sb, e.name);
+                sb.Append(",\"ph\":\"X\",\"pid\":1,\"tid\":");
+                sb.Append(e.threadId.ToString(CultureInfo.InvariantCulture));
+                sb.Append(",\"ts\":");
+                sb.Append(TicksToMicroseconds(e.start - captureStart));
+                sb.Append(",\"dur\":");
+                sb.Append(TicksToMicroseconds(e.duration));
+                sb.Append('}');
+
+                writer.Write(sb.ToString());
+                first = false;
+            }
+
+            writer.Write("\n]}\n");
+        }
+
+        private static string TicksToMicroseconds(long ticks)
+        {
+            double microseconds = (1000000.0 * ticks) / Stopwatch.Frequency;
+            return microseconds.ToString("0.###", CultureInfo.InvariantCulture);
+        }
+
+        private static void AppendString(StringBuilder sb, string value)
+        {
+            sb.Append('"');
+            foreach (char c in value)
+            {
+                switch (c)
+                {
+                    case '"':  sb.Append("\\\""); break;
+                    case '\\': sb.Append("\\\\"); break;
+                    case '\n': sb.Append("\\n"); break;
+                    case '\r': sb.Append("\\r"); break;
+                    case '\t': sb.Append("\\t"); break;
+                    default:
+                        if (c < ' ')
+                        {
+                            sb.Append("\\u");
+                            sb.Append(((int)c).ToString("x4", CultureInfo.InvariantCulture));
+                        }
+                        else
+                        {
+                            sb.Append(c);
+                        }
+                        break;
+                }
+            }
+            sb.Append('"');
+        }
+    }
+}
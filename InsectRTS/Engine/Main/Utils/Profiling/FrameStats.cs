@@ -0,0 +1,490 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Reflection;
+using Engine.Profiling;
+
+namespace Engine
+{
+    /// <summary>
+    /// Keeps statistics about the most recent frames, such as frame time percentiles, the worst frame and
+    /// memory allocated per frame. Must only be used from the main thread.
+    /// </summary>
+    /// <remarks>
+    /// The .NET Framework does not report how long garbage collections pause for, so frames in which a
+    /// collection happened are tracked instead. Comparing their frame times and the time they spent outside
+    /// of updating and rendering to those of the other frames shows the cost.
+    /// To help keep the frame loop from allocating, an <see cref="AllocationBudget"/> can be set, which
+    /// logs a warning naming the phase that allocated the most whenever a frame goes over it.
+    /// </remarks>
+    public sealed class FrameStats
+    {
+        /// <summary>
+        /// The number of frames the statistics are calculated from.
+        /// </summary>
+        public const int HISTORY_LENGTH = 1024;
+
+        /// <summary>
+        /// The range of frame times in milliseconds covered by each histogram bucket.
+        /// </summary>
+        public const double BUCKET_WIDTH = 0.5;
+
+        /// <summary>
+        /// The number of histogram buckets. The last bucket counts all frames too long for the others.
+        /// </summary>
+        public const int BUCKET_COUNT = 128;
+
+        private static readonly double TICKS_TO_MILLISECONDS = 1000.0 / Stopwatch.Frequency;
+
+        /// <summary>
+        /// The minimum number of seconds between warnings about frames over the allocation budget.
+        /// </summary>
+        private const double BUDGET_WARNING_INTERVAL = 1.0;
+
+        private static readonly Func<long> m_getAllocatedBytes;
+        private static readonly bool m_allocationsPerThread;
+
+        static FrameStats()
+        {
+            // only available from .NET Framework 4.8, which replaces 4.7.2 when installed
+            MethodInfo method = typeof(GC).GetMethod("GetAllocatedBytesForCurrentThread", BindingFlags.Public | BindingFlags.Static, null, Type.EmptyTypes, null);
+
+            if (method != null)
+            {
+                m_getAllocatedBytes = (Func<long>)Delegate.CreateDelegate(typeof(Func<long>), method);
+                m_allocationsPerThread = true;
+            }
+            else
+            {
+                AppDomain.MonitoringIsEnabled = true;
+                m_getAllocatedBytes = () => AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize;
+                m_allocationsPerThread = false;
+            }
+        }
+
+        private readonly FrameTiming[] m_history = new FrameTiming[HISTORY_LENGTH];
+        private readonly double[] m_sortedFrameTimes = new double[HISTORY_LENGTH];
+        private readonly int[] m_histogram = new int[BUCKET_COUNT];
+        private bool m_sortedDirty = false;
+        private long m_frameCount = 0;
+
+        private long m_frameStart = 0;
+        private long m_updateTicks = 0;
+        private long m_renderTicks = 0;
+        private long m_updateAllocated = 0;
+        private long m_renderAllocated = 0;
+        private long m_frameStartAllocated = 0;
+        private int m_collectionCount = 0;
+        private int m_gen1CollectionCount = 0;
+        private int m_gen2CollectionCount = 0;
+
+        private long m_allocationBudget = -1;
+        private long m_lastBudgetWarning = 0;
+        private int m_framesOverBudget = 0;
+
+        private FrameTiming m_lastFrame;
+        private FrameTiming m_worstFrame;
+        private readonly ProfilerFrame m_worstFrameProfile = new ProfilerFrame();
+        private bool m_hasWorstFrameProfile = false;
+        private long m_lastReport = 0;
+        private double m_reportInterval = 10.0;
+
+        /// <summary>
+        /// The number of frames completed.
+        /// </summary>
+        public long FrameCount => m_frameCount;
+
+        /// <summary>
+        /// The number of frames in the history used for the statistics.
+        /// </summary>
+        public int SampleCount => (int)Math.Min(m_frameCount, HISTORY_LENGTH);
+
+        /// <summary>
+        /// The timings of the last completed frame.
+        /// </summary>
+        public FrameTiming LastFrame => m_lastFrame;
+
+        /// <summary>
+        /// The slowest frame since the statistics were last reported or <see cref="ResetWorstFrame"/> was called.
+        /// </summary>
+        public FrameTiming WorstFrame => m_worstFrame;
+
+        /// <summary>
+        /// The profiler samples recorded during <see cref="WorstFrame"/>, or null if the profiler is not enabled.
+        /// </summary>
+        public ProfilerFrame WorstFrameProfile => m_hasWorstFrameProfile ? m_worstFrameProfile : null;
+
+        /// <summary>
+        /// The number of frames in the history in each frame time range of <see cref="BUCKET_WIDTH"/>.
+        /// </summary>
+        public IReadOnlyList<int> Histogram => m_histogram;
+
+        /// <summary>
+        /// The average frame time in milliseconds.
+        /// </summary>
+        public double AverageFrameTime => Average(f => f.frameTime);
+
+        /// <summary>
+        /// The average time in milliseconds spent updating each frame.
+        /// </summary>
+        public double AverageUpdateTime => Average(f => f.updateTime);
+
+        /// <summary>
+        /// The average time in milliseconds spent rendering each frame.
+        /// </summary>
+        public double AverageRenderTime => Average(f => f.renderTime);
+
+        /// <summary>
+        /// The average number of frames per second.
+        /// </summary>
+        public double FramesPerSecond
+        {
+            get
+            {
+                double frameTime = AverageFrameTime;
+                return frameTime > 0 ? 1000.0 / frameTime : 0.0;
+            }
+        }
+
+        /// <summary>
+        /// The median frame time in milliseconds.
+        /// </summary>
+        public double P50 => GetPercentile(50);
+
+        /// <summary>
+        /// The frame time in milliseconds that 95% of frames are at most.
+        /// </summary>
+        public double P95 => GetPercentile(95);
+
+        /// <summary>
+        /// The frame time in milliseconds that 99% of frames are at most.
+        /// </summary>
+        public double P99 => GetPercentile(99);
+
+        /// <summary>
+        /// The average number of bytes allocated each frame.
+        /// </summary>
+        public double AverageAllocatedBytes => Average(f => f.allocatedBytes);
+
+        /// <summary>
+        /// Indicates if allocations are only counted on the main thread. If false, allocations on all threads are
+        /// counted, as the runtime can't count allocations per thread.
+        /// </summary>
+        public static bool AllocationsPerThread => m_allocationsPerThread;
+
+        /// <summary>
+        /// The number of frames in the history in which a garbage collection happened.
+        /// </summary>
+        public int CollectionFrameCount
+        {
+            get
+            {
+                int count = 0;
+                for (int i = 0; i < SampleCount; i++)
+                {
+                    if (m_history[i].collections > 0)
+                    {
+                        count++;
+                    }
+                }
+                return count;
+            }
+        }
+
+        /// <summary>
+        /// The average frame time in milliseconds of frames in which a garbage collection happened. This
+        /// is the whole frame time, including the update and render time.
+        /// </summary>
+        public double AverageCollectionFrameTime => Average(f => f.frameTime, true);
+
+        /// <summary>
+        /// The average time in milliseconds that frames in which a garbage collection happened spent outside
+        /// of updating and rendering. Compare to <see cref="AverageUnaccountedTime"/> to see the cost of
+        /// collections that happened outside of update and render.
+        /// </summary>
+        public double AverageCollectionUnaccountedTime => Average(f => f.UnaccountedTime, true);
+
+        /// <summary>
+        /// The average time in milliseconds that frames without a garbage collection spent outside of
+        /// updating and rendering.
+        /// </summary>
+        public double AverageUnaccountedTime => Average(f => f.UnaccountedTime, false);
+
+        /// <summary>
+        /// The number of seconds between logging the statistics. Zero disables logging.
+        /// </summary>
+        public double ReportInterval
+        {
+            get { return m_reportInterval; }
+            set
+            {
+                if (value < 0)
+                {
+                    throw new ArgumentOutOfRangeException(nameof(value), value, "Must be non-negative!");
+                }
+                m_reportInterval = value;
+            }
+        }
+
+        /// <summary>
+        /// The maximum number of bytes a frame should allocate, or a negative value if there is no limit. When a frame
+        /// allocates more, a warning is logged saying how much was allocated while updating and rendering.
+        /// </summary>
+        public long AllocationBudget
+        {
+            get { return m_allocationBudget; }
+            set { m_allocationBudget = value; }
+        }
+
+        /// <summary>
+        /// Gets the number of bytes allocated so far. See <see cref="AllocationsPerThread"/> for which threads
+        /// are counted. Only differences between values are meaningful.
+        /// </summary>
+        public static long GetAllocatedBytes()
+        {
+            return m_getAllocatedBytes();
+        }
+
+        /// <summary>
+        /// Gets a frame time percentile over the history.
+        /// </summary>
+        /// <param name="percentile">The percentile from 0 to 100.</param>
+        /// <returns>The frame time in milliseconds that the given percentage of frames are at most.</returns>
+        public double GetPercentile(double percentile)
+        {
+            if (percentile < 0 || percentile > 100)
+            {
+                throw new ArgumentOutOfRangeException(nameof(percentile), percentile, "Must be in range [0, 100]!");
+            }
+
+            int count = SampleCount;
+            if (count == 0)
+            {
+                return 0.0;
+            }
+
+            if (m_sortedDirty)
+            {
+                for (int i = 0; i < count; i++)
+                {
+                    m_sortedFrameTimes[i] = m_history[i].frameTime;
+                }
+                Array.Sort(m_sortedFrameTimes, 0, count);
+                m_sortedDirty = false;
+            }
+
+            // nearest rank
+            int index = (int)Math.Ceiling(percentile / 100.0 * count) - 1;
+            return m_sortedFrameTimes[Math.Max(index, 0)];
+        }
+
+        /// <summary>
+        /// Forgets the worst frame so a new one is found.
+        /// </summary>
+        public void ResetWorstFrame()
+        {
+            m_worstFrame = default(FrameTiming);
+            m_hasWorstFrameProfile = false;
+        }
+
+        /// <summary>
+        /// Ends the current frame and starts the next one. The first call only starts a frame.
+        /// </summary>
+        internal void NextFrame()
+        {
+            long now = Stopwatch.GetTimestamp();
+            long allocated = GetAllocatedBytes();
+            int collectionCount = GC.CollectionCount(0);
+            int gen1CollectionCount = GC.CollectionCount(1);
+            int gen2CollectionCount = GC.CollectionCount(2);
+
+            if (m_frameStart != 0)
+            {
+                FrameTiming frame = new FrameTiming
+                {
+                    index = m_frameCount,
+                    frameTime = (now - m_frameStart) * TICKS_TO_MILLISECONDS,
+                    updateTime = m_updateTicks * TICKS_TO_MILLISECONDS,
+                    renderTime = m_renderTicks * TICKS_TO_MILLISECONDS,
+                    collections = collectionCount - m_collectionCount,
+                    gen1Collections = gen1CollectionCount - m_gen1CollectionCount,
+                    gen2Collections = gen2CollectionCount - m_gen2CollectionCount,
+                    allocatedBytes = allocated - m_frameStartAllocated,
+                    updateAllocatedBytes = m_updateAllocated,
+                    renderAllocatedBytes = m_renderAllocated,
+                };
+
+                AddFrame(frame);
+
+                if (m_allocationBudget >= 0 && frame.allocatedBytes > m_allocationBudget)
+                {
+                    OverAllocationBudget(frame, now);
+                }
+
+                if (m_reportInterval > 0 && (now - m_lastReport) >= m_reportInterval * Stopwatch.Frequency)
+                {
+                    Logger.Info(ToString());
+                    ResetWorstFrame();
+                    m_lastReport = now;
+                }
+            }
+            else
+            {
+                m_lastReport = now;
+            }
+
+            m_frameStart = now;
+            m_updateTicks = 0;
+            m_renderTicks = 0;
+            m_updateAllocated = 0;
+            m_renderAllocated = 0;
+            m_collectionCount = collectionCount;
+            m_gen1CollectionCount = gen1CollectionCount;
+            m_gen2CollectionCount = gen2CollectionCount;
+
+            // measured last so that the logging above is not counted against the next frame
+            m_frameStartAllocated = GetAllocatedBytes();
+        }
+
+        /// <summary>
+        /// Adds time spent updating to the current frame.
+        /// </summary>
+        /// <param name="ticks">The duration in <see cref="Stopwatch"/> ticks.</param>
+        /// <param name="allocatedBytes">The number of bytes allocated, see <see cref="GetAllocatedBytes"/>.</param>
+        internal void AddUpdate(long ticks, long allocatedBytes)
+        {
+            m_updateTicks += ticks;
+            m_updateAllocated += allocatedBytes;
+        }
+
+        /// <summary>
+        /// Adds time spent rendering to the current frame.
+        /// </summary>
+        /// <param name="ticks">The duration in <see cref="Stopwatch"/> ticks.</param>
+        /// <param name="allocatedBytes">The number of bytes allocated, see <see cref="GetAllocatedBytes"/>.</param>
+        internal void AddRender(long ticks, long allocatedBytes)
+        {
+            m_renderTicks += ticks;
+            m_renderAllocated += allocatedBytes;
+        }
+
+        private void OverAllocationBudget(FrameTiming frame, long now)
+        {
+            m_framesOverBudget++;
+
+            // avoid flooding the log, as logging allocates too
+            if ((now - m_lastBudgetWarning) < BUDGET_WARNING_INTERVAL * Stopwatch.Frequency)
+            {
+                return;
+            }
+
+            long otherAllocated = frame.allocatedBytes - frame.updateAllocatedBytes - frame.renderAllocatedBytes;
+
+            string phase = "outside of update and render";
+            if (frame.updateAllocatedBytes >= frame.renderAllocatedBytes && frame.updateAllocatedBytes >= otherAllocated)
+            {
+                phase = "update";
+            }
+            else if (frame.renderAllocatedBytes >= otherAllocated)
+            {
+                phase = "render";
+            }
+
+            Logger.Warning($"Frame {frame.index} allocated {frame.allocatedBytes} bytes, over the budget of {m_allocationBudget} bytes, mostly during {phase} " +
+                $"(update {frame.updateAllocatedBytes}, render {frame.renderAllocatedBytes}, other {otherAllocated}). " +
+                $"{m_framesOverBudget} frames were over budget since the last warning.");
+
+            m_lastBudgetWarning = now;
+            m_framesOverBudget = 0;
+        }
+
+        private void AddFrame(FrameTiming frame)
+        {
+            int slot = (int)(frame.index % HISTORY_LENGTH);
+
+            // replace the oldest frame in the history
+            if (m_frameCount >= HISTORY_LENGTH)
+            {
+                m_histogram[GetBucket(m_history[slot].frameTime)]--;
+            }
+            m_history[slot] = frame;
+            m_histogram[GetBucket(frame.frameTime)]++;
+
+            m_frameCount++;
+            m_sortedDirty = true;
+            m_lastFrame = frame;
+
+            if (frame.frameTime > m_worstFrame.frameTime)
+            {
+                m_worstFrame = frame;
+
+                // the profiler ends its frames at the same time, so its last frame is this one, copied
+                // since the profiler reuses its frames
+                ProfilerFrame profile = Profiler.LastFrame;
+                if (profile != null)
+                {
+                    m_worstFrameProfile.CopyFrom(profile);
+                }
+                m_hasWorstFrameProfile = profile != null;
+            }
+        }
+
+        private static int GetBucket(double frameTime)
+        {
+            return Math.Min((int)(frameTime / BUCKET_WIDTH), BUCKET_COUNT - 1);
+        }
+
+        private double Average(Func<FrameTiming, double> selector)
+        {
+            int count = SampleCount;
+            if (count == 0)
+            {
+                return 0.0;
+            }
+
+            double total = 0;
+            for (int i = 0; i < count; i++)
+            {
+                total += selector(m_history[i]);
+            }
+            return total / count;
+        }
+
+        /// <summary>
+        /// Averages a value over the frames in the history that either had or did not have a garbage collection.
+        /// </summary>
+        /// <param name="selector">Gets the value from a frame.</param>
+        /// <param name="collected">If true, averages the frames in which a collection happened, otherwise the others.</param>
+        /// <returns>The average, or zero if no frames match.</returns>
+        private double Average(Func<FrameTiming, double> selector, bool collected)
+        {
+            double total = 0;
+            int count = 0;
+            for (int i = 0; i < SampleCount; i++)
+            {
+                if ((m_history[i].collections > 0) == collected)
+                {
+                    total += selector(m_history[i]);
+                    count++;
+                }
+            }
+            return count > 0 ? total / count : 0.0;
+        }
+
+        /// <summary>
+        /// Gets a summary of the statistics.
+        /// </summary>
+        public override string ToString()
+        {
+            return $"{FramesPerSecond:0.0} FPS, frame {AverageFrameTime:0.00}ms (update {AverageUpdateTime:0.00}ms, render {AverageRenderTime:0.00}ms), " +
+                $"p50 {P50:0.00}ms, p95 {P95:0.00}ms, p99 {P99:0.00}ms, worst {m_worstFrame.frameTime:0.00}ms (frame {m_worstFrame.index}), " +
+                $"{AverageAllocatedBytes:0} bytes allocated per frame, " +
+                $"{CollectionFrameCount} of {SampleCount} frames had GCs, taking {AverageCollectionFrameTime:0.00}ms with " +
+                $"{AverageCollectionUnaccountedTime:0.00}ms outside update and render (other frames {AverageUnaccountedTime:0.00}ms)";
+        }
+    }
+}
@@ -0,0 +1,76 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+namespace Engine
+{
+    /// <summary>
+    /// The timings recorded for a single frame by <see cref="FrameStats"/>.
+    /// </summary>
+    public struct FrameTiming
+    {
+        /// <summary>
+        /// The number of frames completed before this one.
+        /// </summary>
+        public long index;
+
+        /// <summary>
+        /// The time in milliseconds from the start of this frame to the start of the next.
+        /// </summary>
+        public double frameTime;
+
+        /// <summary>
+        /// The time in milliseconds spent updating.
+        /// </summary>
+        public double updateTime;
+
+        /// <summary>
+        /// The time in milliseconds spent rendering.
+        /// </summary>
+        public double renderTime;
+
+        /// <summary>
+        /// The number of garbage collections that happened during the frame.
+        /// </summary>
+        public int collections;
+
+        /// <summary>
+        /// The number of generation 1 collections during the frame. Each also counts as one of <see cref="collections"/>.
+        /// </summary>
+        public int gen1Collections;
+
+        /// <summary>
+        /// The number of generation 2 collections during the frame. Each also counts as one of <see cref="collections"/>
+        /// and <see cref="gen1Collections"/>.
+        /// </summary>
+        public int gen2Collections;
+
+        /// <summary>
+        /// The number of bytes allocated during the frame, see <see cref="FrameStats.GetAllocatedBytes"/>.
+        /// </summary>
+        public long allocatedBytes;
+
+        /// <summary>
+        /// The number of bytes allocated while updating.
+        /// </summary>
+        public long updateAllocatedBytes;
+
+        /// <summary>
+        /// The number of bytes allocated while rendering.
+        /// </summary>
+        public long renderAllocatedBytes;
+
+        /// <summary>
+        /// The time in milliseconds spent outside of updating and rendering, such as waiting for the next
+        /// frame, or in garbage collections that the frame loop itself triggered.
+        /// </summary>
+        public double UnaccountedTime => frameTime - updateTime - renderTime;
+
+        public override string ToString()
+        {
+            return $"frame {index}: {frameTime:0.00}ms (update {updateTime:0.00}ms, render {renderTime:0.00}ms), " +
+                $"{allocatedBytes} bytes allocated (update {updateAllocatedBytes}, render {renderAllocatedBytes}), " +
+                $"{collections} GCs ({gen1Collections} gen 1, {gen2Collections} gen 2)";
+        }
+    }
+}
@@ -0,0 +1,356 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Threading;
+using Engine.Profiling;
+
+namespace Engine
+{
+    /// <summary>
+    /// A low overhead CPU profiler. Code is measured using samples, which can be nested:
+    /// <code>using (Profiler.Sample("Pathfinding")) { ... }</code>
+    /// </summary>
+    /// <remarks>
+    /// Each thread writes sample begin and end markers to its own ring buffer without locking. Once per
+    /// frame the markers from every thread are combined into a tree of timings for each thread, which is
+    /// available from <see cref="LastFrame"/>. While capturing, every sample is also kept so the capture
+    /// can be saved as a Chrome trace.
+    /// The profiler is only compiled in when the PROFILE symbol is defined. Otherwise <see cref="Sample"/>
+    /// does nothing, and calls to <see cref="BeginSample"/> and <see cref="EndSample"/> are removed.
+    /// </remarks>
+    public static class Profiler
+    {
+#if PROFILE
+        private const bool COMPILED = true;
+#else
+        private const bool COMPILED = false;
+#endif
+
+        /// <summary>
+        /// The maximum number of samples kept while capturing, limiting memory use if a capture is left running.
+        /// </summary>
+        private const int MAX_CAPTURE_SAMPLES = 4 * 1024 * 1024;
+
+        /// <summary>
+        /// The number of markers copied from a thread's buffer at a time when ending a frame.
+        /// </summary>
+        private const int READ_BATCH_SIZE = 1024;
+
+        private static readonly object m_lock = new object();
+        private static readonly List<ProfilerThreadBuffer> m_threads = new List<ProfilerThreadBuffer>();
+
+        [ThreadStatic]
+        private static ProfilerThreadBuffer m_threadBuffer;
+
+        private static volatile bool m_enabled = true;
+        private static readonly ProfilerEvent[] m_readBatch = new ProfilerEvent[READ_BATCH_SIZE];
+        private static volatile ProfilerFrame m_lastFrame = null;
+#if PROFILE
+        private static readonly ProfilerFrame[] m_frames = new ProfilerFrame[] { new ProfilerFrame(), new ProfilerFrame() };
+        private static long m_frameIndex = 0;
+        private static long m_frameStart = Stopwatch.GetTimestamp();
+#endif
+
+        private static List<TraceEvent> m_capture = null;
+        private static Dictionary<int, string> m_captureThreads = null;
+        private static long m_captureStart = 0;
+
+        /// <summary>
+        /// Indicates if the profiler is compiled into this build.
+        /// </summary>
+        public static bool IsCompiled => COMPILED;
+
+        /// <summary>
+        /// Enables or disables recording samples. Should not be changed while samples begun with
+        /// <see cref="BeginSample"/> are still open.
+        /// </summary>
+        public static bool Enabled
+        {
+            get { return COMPILED && m_enabled; }
+            set { m_enabled = value; }
+        }
+
+        /// <summary>
+        /// The timings of the last completed frame, or null if no frame has completed. The frame is reused
+        /// once the next frame completes, so should not be kept.
+        /// </summary>
+        public static ProfilerFrame LastFrame => m_lastFrame;
+
+        /// <summary>
+        /// Indicates if samples are being kept for a trace.
+        /// </summary>
+        public static bool IsCapturing => m_capture != null;
+
+        /// <summary>
+        /// Begins a sample that ends when the returned value is disposed.
+        /// </summary>
+        /// <param name="name">The name of the sample. Should be a constant string to avoid allocating.</param>
+        public static ProfilerSample Sample(string name)
+        {
+#if PROFILE
+            if (m_enabled)
+            {
+                BeginSampleInternal(name);
+                return new ProfilerSample(true);
+            }
+#endif
+            return default(ProfilerSample);
+        }
+
+        /// <summary>
+        /// Begins a sample. Each call must be matched by a call to <see cref="EndSample"/> on the same thread.
+        /// </summary>
+        /// <param name="name">The name of the sample. Should be a constant string to avoid allocating.</param>
+        [Conditional("PROFILE")]
+        public static void BeginSample(string name)
+        {
+            if (m_enabled)
+            {
+                BeginSampleInternal(name);
+            }
+        }
+
+        /// <summary>
+        /// Ends the last sample begun on this thread.
+        /// </summary>
+        [Conditional("PROFILE")]
+        public static void EndSample()
+        {
+            if (m_enabled)
+            {
+                EndSampleInternal();
+            }
+        }
+
+        private static void BeginSampleInternal(string name)
+        {
+            if (name == null)
+            {
+                throw new ArgumentNullException("name");
+            }
+            GetThreadBuffer().Write(name, Stopwatch.GetTimestamp());
+        }
+
+        internal static void EndSampleInternal()
+        {
+            GetThreadBuffer().Write(null, Stopwatch.GetTimestamp());
+        }
+
+        private static ProfilerThreadBuffer GetThreadBuffer()
+        {
+            if (m_threadBuffer == null)
+            {
+                m_threadBuffer = new ProfilerThreadBuffer(Thread.CurrentThread);
+
+                lock (m_lock)
+                {
+                    m_threads.Add(m_threadBuffer);
+                }
+            }
+            return m_threadBuffer;
+        }
+
+        /// <summary>
+        /// Ends the current frame, combining the samples recorded by all threads since the last frame.
+        /// Should be called once per frame from the thread running the frame loop.
+        /// </summary>
+        public static void NextFrame()
+        {
+#if PROFILE
+            long now = Stopwatch.GetTimestamp();
+
+            // alternate between two frames so the last frame stays valid while the next is filled
+            ProfilerFrame frame = m_frames[m_frameIndex & 1];
+
+            lock (m_lock)
+            {
+                frame.Reset(m_frameIndex, now - m_frameStart);
+
+                foreach (ProfilerThreadBuffer thread in m_threads)
+                {
+                    ReadThread(thread, frame);
+                }
+
+                // forget threads that have exited once everything they wrote has been read
+                for (int i = m_threads.Count - 1; i >= 0; i--)
+                {
+                    ProfilerThreadBuffer thread = m_threads[i];
+                    if (!thread.thread.IsAlive && thread.readIndex >= thread.WriteIndex)
+                    {
+                        m_threads.RemoveAt(i);
+                    }
+                }
+
+                if (m_capture != null)
+                {
+                    Thread thread = Thread.CurrentThread;
+                    AddCaptureSample("Frame", thread.ManagedThreadId, thread.Name ?? $"Thread {thread.ManagedThreadId}", m_frameStart, now - m_frameStart);
+                }
+            }
+
+            m_lastFrame = frame;
+            m_frameIndex++;
+            m_frameStart = now;
+#endif
+        }
+
+        /// <summary>
+        /// Combines the markers written by a thread since the last frame into a tree, which is added to
+        /// the frame if the thread had any samples.
+        /// </summary>
+        private static void ReadThread(ProfilerThreadBuffer thread, ProfilerFrame frame)
+        {
+            ProfilerNode root = frame.RentRoot(thread.threadName);
+            List<OpenSample> open = thread.openSamples;
+
+            // samples still open from earlier frames continue in this frame's tree
+            for (int i = 0; i < open.Count; i++)
+            {
+                OpenSample sample = open[i];
+                sample.node = frame.GetChild(i == 0 ? root : open[i - 1].node, sample.name);
+                open[i] = sample;
+            }
+
+            long writeIndex = thread.WriteIndex;
+            if (writeIndex - thread.readIndex > ProfilerThreadBuffer.CAPACITY)
+            {
+                DropMarkers(thread, writeIndex - ProfilerThreadBuffer.CAPACITY);
+            }
+
+            while (thread.readIndex < writeIndex)
+            {
+                int count = (int)Math.Min(writeIndex - thread.readIndex, READ_BATCH_SIZE);
+                long firstValid = thread.Read(thread.readIndex, count, m_readBatch);
+
+                if (firstValid > thread.readIndex)
+                {
+                    // the thread lapped the buffer while the markers were copied, so some copies may be overwritten
+                    DropMarkers(thread, firstValid);
+                    continue;
+                }
+
+                for (int i = 0; i < count; i++)
+                {
+                    ProfilerEvent e = m_readBatch[i];
+
+                    if (e.name != null)
+                    {
+                        ProfilerNode parent = open.Count > 0 ? open[open.Count - 1].node : root;
+                        open.Add(new OpenSample { name = e.name, start = e.timestamp, node = frame.GetChild(parent, e.name) });
+                    }
+                    else if (open.Count > 0)
+                    {
+                        OpenSample sample = open[open.Count - 1];
+                        open.RemoveAt(open.Count - 1);
+
+                        long duration = e.timestamp - sample.start;
+                        sample.node.AddSample(duration);
+
+                        if (m_capture != null)
+                        {
+                            AddCaptureSample(sample.name, thread.threadId, thread.threadName, sample.start, duration);
+                        }
+                    }
+                }
+                thread.readIndex += count;
+            }
+
+            if (root.Children.Count == 0)
+            {
+                frame.ReturnRoot(root);
+                return;
+            }
+
+            root.SumChildren();
+            frame.AddThread(root);
+        }
+
+        /// <summary>
+        /// Skips the markers of a thread that were overwritten before they were read.
+        /// </summary>
+        /// <param name="thread">The thread that wrote more markers than its buffer holds.</param>
+        /// <param name="readIndex">The index of the oldest marker that was not overwritten.</param>
+        private static void DropMarkers(ProfilerThreadBuffer thread, long readIndex)
+        {
+            thread.droppedCount += readIndex - thread.readIndex;
+            thread.readIndex = readIndex;
+
+            // the begin markers of the open samples may have been lost, so their ends can't be matched
+            thread.openSamples.Clear();
+
+            Logger.Warning($"Profiler dropped samples on thread \"{thread.threadName}\", {thread.droppedCount} markers lost so far");
+        }
+
+        private static void AddCaptureSample(string name, int threadId, string threadName, long start, long duration)
+        {
+            if (m_capture.Count < MAX_CAPTURE_SAMPLES)
+            {
+                m_capture.Add(new TraceEvent { name = name, threadId = threadId, start = start, duration = duration });
+
+                if (!m_captureThreads.ContainsKey(threadId))
+                {
+                    m_captureThreads.Add(threadId, threadName);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Starts keeping every sample so they can be saved using <see cref="EndCapture"/>.
+        /// Samples are collected when each frame ends.
+        /// </summary>
+        public static void BeginCapture()
+        {
+            lock (m_lock)
+            {
+                m_capture = new List<TraceEvent>();
+                m_captureThreads = new Dictionary<int, string>();
+                m_captureStart = Stopwatch.GetTimestamp();
+            }
+        }
+
+        /// <summary>
+        /// Stops capturing and saves the samples as a Chrome trace event JSON file, which can be opened
+        /// in chrome://tracing or other trace viewers.
+        /// </summary>
+        /// <param name="path">The path of the file to write.</param>
+        /// <exception cref="InvalidOperationException">Thrown if no capture was started.</exception>
+        public static void EndCapture(string path)
+        {
+            if (path == null)
+            {
+                throw new ArgumentNullException("path");
+            }
+
+            List<TraceEvent> samples;
+            Dictionary<int, string> threads;
+            long start;
+
+            lock (m_lock)
+            {
+                if (m_capture == null)
+                {
+                    throw new InvalidOperationException("No profiler capture has been started!");
+                }
+
+                samples = m_capture;
+                threads = m_captureThreads;
+                start = m_captureStart;
+
+                m_capture = null;
+                m_captureThreads = null;
+            }
+
+            using (StreamWriter writer = new StreamWriter(path))
+            {
+                ChromeTrace.Write(writer, samples, threads, start);
+            }
+
+            Logger.Info($"Wrote {samples.Count} profiler samples to \"{path}\"");
+        }
+    }
+}
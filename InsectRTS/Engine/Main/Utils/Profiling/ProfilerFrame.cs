@@ -0,0 +1,140 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System.Collections.Generic;
+using System.Text;
+
+namespace Engine.Profiling
+{
+    /// <summary>
+    /// The samples recorded during a frame, combined into a tree for each thread.
+    /// </summary>
+    /// <remarks>
+    /// A sample is counted in the frame it ends in, so a sample running across a frame boundary
+    /// has its full duration counted in the later frame.
+    /// Frames and their nodes are reused by the profiler to avoid allocating each frame, so a frame
+    /// only holds its timings until the profiler ends the frame after next.
+    /// </remarks>
+    public sealed class ProfilerFrame
+    {
+        private readonly List<ProfilerNode> m_threads = new List<ProfilerNode>();
+        private readonly Stack<ProfilerNode> m_nodePool = new Stack<ProfilerNode>();
+        private long m_index = 0;
+        private long m_ticks = 0;
+
+        /// <summary>
+        /// The number of frames before this one.
+        /// </summary>
+        public long Index => m_index;
+
+        /// <summary>
+        /// The duration of the frame in milliseconds.
+        /// </summary>
+        public double Duration => ProfilerNode.TicksToMilliseconds(m_ticks);
+
+        /// <summary>
+        /// The root node of each thread that recorded samples during the frame. The root nodes are
+        /// named after the threads.
+        /// </summary>
+        public IReadOnlyList<ProfilerNode> Threads => m_threads;
+
+        internal ProfilerFrame()
+        {
+        }
+
+        /// <summary>
+        /// Clears the frame so it can be filled with the samples of another frame.
+        /// </summary>
+        internal void Reset(long index, long ticks)
+        {
+            foreach (ProfilerNode thread in m_threads)
+            {
+                thread.Reset(null, m_nodePool);
+                m_nodePool.Push(thread);
+            }
+            m_threads.Clear();
+
+            m_index = index;
+            m_ticks = ticks;
+        }
+
+        /// <summary>
+        /// Makes this frame a copy of another frame, so the timings are kept after the profiler reuses the other frame.
+        /// </summary>
+        internal void CopyFrom(ProfilerFrame other)
+        {
+            Reset(other.m_index, other.m_ticks);
+
+            foreach (ProfilerNode otherThread in other.m_threads)
+            {
+                ProfilerNode thread = ProfilerNode.Rent(otherThread.Name, m_nodePool);
+                thread.CopyFrom(otherThread, m_nodePool);
+                m_threads.Add(thread);
+            }
+        }
+
+        /// <summary>
+        /// Gets a node from the frame's pool to be used as the root of a thread.
+        /// </summary>
+        internal ProfilerNode RentRoot(string threadName)
+        {
+            return ProfilerNode.Rent(threadName, m_nodePool);
+        }
+
+        /// <summary>
+        /// Returns a root node that was not added to the frame.
+        /// </summary>
+        internal void ReturnRoot(ProfilerNode root)
+        {
+            root.Reset(null, m_nodePool);
+            m_nodePool.Push(root);
+        }
+
+        /// <summary>
+        /// Gets a child node for a sample name, taking new nodes from the frame's pool.
+        /// </summary>
+        internal ProfilerNode GetChild(ProfilerNode parent, string name)
+        {
+            return parent.GetChild(name, m_nodePool);
+        }
+
+        internal void AddThread(ProfilerNode root)
+        {
+            m_threads.Add(root);
+        }
+
+        /// <summary>
+        /// Finds the first node with a sample name on any thread.
+        /// </summary>
+        /// <param name="name">The sample name.</param>
+        /// <returns>The node, or null if no sample with the name ended this frame.</returns>
+        public ProfilerNode Find(string name)
+        {
+            foreach (ProfilerNode thread in m_threads)
+            {
+                ProfilerNode node = thread.Find(name);
+                if (node != null)
+                {
+                    return node;
+                }
+            }
+            return null;
+        }
+
+        /// <summary>
+        /// Returns the sample tree of each thread as indented text.
+        /// </summary>
+        public override string ToString()
+        {
+            StringBuilder sb = new StringBuilder();
+            sb.AppendLine($"Frame {m_index} ({Duration:F3}ms)");
+
+            foreach (ProfilerNode thread in m_threads)
+            {
+                thread.AppendTo(sb, 1);
+            }
+            return sb.ToString();
+        }
+    }
+}
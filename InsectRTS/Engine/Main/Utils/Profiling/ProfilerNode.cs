@@ -0,0 +1,193 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Text;
+
+namespace Engine.Profiling
+{
+    /// <summary>
+    /// The combined timings of all samples with the same name and parent in a frame.
+    /// </summary>
+    public sealed class ProfilerNode
+    {
+        private string m_name;
+        private readonly List<ProfilerNode> m_children = new List<ProfilerNode>();
+        private int m_callCount = 0;
+        private long m_ticks = 0;
+
+        /// <summary>
+        /// The name of the sample, or of the thread for root nodes.
+        /// </summary>
+        public string Name => m_name;
+
+        /// <summary>
+        /// The number of samples that ended in the frame.
+        /// </summary>
+        public int CallCount => m_callCount;
+
+        /// <summary>
+        /// The total time spent in the samples in milliseconds.
+        /// </summary>
+        public double TotalTime => TicksToMilliseconds(m_ticks);
+
+        /// <summary>
+        /// The time spent in the samples excluding child samples in milliseconds.
+        /// </summary>
+        public double SelfTime
+        {
+            get
+            {
+                long ticks = m_ticks;
+                foreach (ProfilerNode child in m_children)
+                {
+                    ticks -= child.m_ticks;
+                }
+                return TicksToMilliseconds(ticks);
+            }
+        }
+
+        /// <summary>
+        /// The samples made inside these samples.
+        /// </summary>
+        public IReadOnlyList<ProfilerNode> Children => m_children;
+
+        internal ProfilerNode(string name)
+        {
+            m_name = name;
+        }
+
+        /// <summary>
+        /// Clears the timings and gives the node a new name, returning the nodes below it to a pool.
+        /// </summary>
+        internal void Reset(string name, Stack<ProfilerNode> pool)
+        {
+            foreach (ProfilerNode child in m_children)
+            {
+                child.Reset(null, pool);
+                pool.Push(child);
+            }
+            m_children.Clear();
+
+            m_name = name;
+            m_callCount = 0;
+            m_ticks = 0;
+        }
+
+        /// <summary>
+        /// Makes this node a copy of another node and the nodes below it.
+        /// </summary>
+        internal void CopyFrom(ProfilerNode other, Stack<ProfilerNode> pool)
+        {
+            Reset(other.m_name, pool);
+            m_callCount = other.m_callCount;
+            m_ticks = other.m_ticks;
+
+            foreach (ProfilerNode otherChild in other.m_children)
+            {
+                ProfilerNode child = Rent(otherChild.m_name, pool);
+                child.CopyFrom(otherChild, pool);
+                m_children.Add(child);
+            }
+        }
+
+        /// <summary>
+        /// Finds the first node with a name in this node's subtree.
+        /// </summary>
+        /// <param name="name">The sample name.</param>
+        /// <returns>The node, or null if there is no such node.</returns>
+        public ProfilerNode Find(string name)
+        {
+            if (m_name == name)
+            {
+                return this;
+            }
+            foreach (ProfilerNode child in m_children)
+            {
+                ProfilerNode node = child.Find(name);
+                if (node != null)
+                {
+                    return node;
+                }
+            }
+            return null;
+        }
+
+        /// <summary>
+        /// Gets the child node for a sample name, creating it if needed.
+        /// </summary>
+        internal ProfilerNode GetChild(string name, Stack<ProfilerNode> pool)
+        {
+            foreach (ProfilerNode child in m_children)
+            {
+                if (child.m_name == name)
+                {
+                    return child;
+                }
+            }
+
+            ProfilerNode node = Rent(name, pool);
+            m_children.Add(node);
+            return node;
+        }
+
+        /// <summary>
+        /// Takes a node from a pool, or creates one if the pool is empty.
+        /// </summary>
+        internal static ProfilerNode Rent(string name, Stack<ProfilerNode> pool)
+        {
+            if (pool.Count > 0)
+            {
+                ProfilerNode node = pool.Pop();
+                node.m_name = name;
+                return node;
+            }
+            return new ProfilerNode(name);
+        }
+
+        /// <summary>
+        /// Records a completed sample.
+        /// </summary>
+        internal void AddSample(long ticks)
+        {
+            m_callCount++;
+            m_ticks += ticks;
+        }
+
+        /// <summary>
+        /// Sets the time of a root node to the time of its children.
+        /// </summary>
+        internal void SumChildren()
+        {
+            m_ticks = 0;
+            foreach (ProfilerNode child in m_children)
+            {
+                m_ticks += child.m_ticks;
+            }
+        }
+
+        /// <summary>
+        /// Appends an indented line for this node and each node below it.
+        /// </summary>
+        internal void AppendTo(StringBuilder sb, int depth)
+        {
+            sb.Append(' ', depth * 2);
+            sb.Append(m_name);
+            sb.Append(' ', Math.Max(1, 48 - (depth * 2) - m_name.Length));
+            sb.AppendLine($"{TotalTime,9:F3}ms total {SelfTime,9:F3}ms self {m_callCount,6} calls");
+
+            foreach (ProfilerNode child in m_children)
+            {
+                child.AppendTo(sb, depth + 1);
+            }
+        }
+
+        internal static double TicksToMilliseconds(long ticks)
+        {
+            return (1000.0 * ticks) / Stopwatch.Frequency;
+        }
+    }
+}
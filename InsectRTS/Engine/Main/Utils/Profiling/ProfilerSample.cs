@@ -0,0 +1,35 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+
+namespace Engine
+{
+    /// <summary>
+    /// Ends a profiler sample when disposed. Returned by <see cref="Profiler.Sample"/> to be used with
+    /// a using statement. Being a struct, it does not allocate.
+    /// </summary>
+    public struct ProfilerSample : IDisposable
+    {
+        private readonly bool m_active;
+
+        internal ProfilerSample(bool active)
+        {
+            m_active = active;
+        }
+
+        /// <summary>
+        /// Ends the sample.
+        /// </summary>
+        public void Dispose()
+        {
+#if PROFILE
+            if (m_active)
+            {
+                Profiler.EndSampleInternal();
+            }
+#endif
+        }
+    }
+}
@@ -0,0 +1,130 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System.Collections.Generic;
+using System.Threading;
+
+namespace Engine.Profiling
+{
+    /// <summary>
+    /// A begin or end marker written by <see cref="Profiler"/>.
+    /// </summary>
+    internal struct ProfilerEvent
+    {
+        /// <summary>
+        /// The sample name for begin markers, or null for end markers.
+        /// </summary>
+        public string name;
+
+        /// <summary>
+        /// The <see cref="System.Diagnostics.Stopwatch"/> timestamp of the marker.
+        /// </summary>
+        public long timestamp;
+    }
+
+    /// <summary>
+    /// A sample that has begun but not yet ended.
+    /// </summary>
+    internal struct OpenSample
+    {
+        public string name;
+        public long start;
+        public ProfilerNode node;
+    }
+
+    /// <summary>
+    /// A ring buffer of the markers written by one thread. Only the owning thread writes to the buffer,
+    /// and only the thread ending frames reads from it, so neither needs a lock.
+    /// </summary>
+    internal sealed class ProfilerThreadBuffer
+    {
+        /// <summary>
+        /// The number of markers the buffer can hold. Must be a power of two.
+        /// </summary>
+        public const int CAPACITY = 64 * 1024;
+
+        private readonly ProfilerEvent[] m_events = new ProfilerEvent[CAPACITY];
+        private long m_writeIndex = 0;
+
+        /// <summary>
+        /// The thread that writes to this buffer.
+        /// </summary>
+        public readonly Thread thread;
+
+        /// <summary>
+        /// The name of the thread.
+        /// </summary>
+        public readonly string threadName;
+
+        /// <summary>
+        /// The ID of the thread.
+        /// </summary>
+        public readonly int threadId;
+
+        /// <summary>
+        /// The index of the next marker to read.
+        /// </summary>
+        public long readIndex = 0;
+
+        /// <summary>
+        /// The samples that have begun but not ended as of the last read marker.
+        /// </summary>
+        public readonly List<OpenSample> openSamples = new List<OpenSample>();
+
+        /// <summary>
+        /// The number of markers overwritten before they were read.
+        /// </summary>
+        public long droppedCount = 0;
+
+        /// <summary>
+        /// The index the next marker will be written at.
+        /// </summary>
+        public long WriteIndex => Volatile.Read(ref m_writeIndex);
+
+        public ProfilerThreadBuffer(Thread thread)
+        {
+            this.thread = thread;
+            threadId = thread.ManagedThreadId;
+            threadName = thread.Name ?? $"Thread {threadId}";
+        }
+
+        /// <summary>
+        /// Adds a marker. Must only be called by the owning thread.
+        /// </summary>
+        /// <param name="name">The sample name for begin markers, or null for end markers.</param>
+        /// <param name="timestamp">The time of the marker.</param>
+        public void Write(string name, long timestamp)
+        {
+            long index = m_writeIndex;
+
+            ref ProfilerEvent e = ref m_events[index & (CAPACITY - 1)];
+            e.name = name;
+            e.timestamp = timestamp;
+
+            Volatile.Write(ref m_writeIndex, index + 1);
+        }
+
+        /// <summary>
+        /// Copies markers that have been written. The owning thread may overwrite markers while they are
+        /// copied, so the copies before the returned index must be discarded.
+        /// </summary>
+        /// <param name="index">The index of the first marker to copy.</param>
+        /// <param name="count">The number of markers to copy.</param>
+        /// <param name="destination">The array to copy the markers into, starting at the first element.</param>
+        /// <returns>The index of the first marker known not to have been overwritten while copying.</returns>
+        public long Read(long index, int count, ProfilerEvent[] destination)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                destination[i] = m_events[(index + i) & (CAPACITY - 1)];
+            }
+
+            // the copies must complete before the write index is checked
+            Interlocked.MemoryBarrier();
+
+            // the marker being written may already be partly copied over the oldest marker
+            return Volatile.Read(ref m_writeIndex) - CAPACITY + 1;
+        }
+    }
+}
@@ -2,25 +2,80 @@
 * Copyright © 2018-2019 Scott Sewell
 * See "Licence.txt" for full licence.
 */
+using System;
+using System.Threading;
 
 namespace Engine
 {
     /// <summary>
     /// Class for generating random values.
     /// </summary>
+    /// <remarks>
+    /// This class is thread safe. Each thread lazily creates its own <see cref="RandomGenerator"/>, using the
+    /// shared seed and the next free stream, so threads never share state or produce overlapping sequences.
+    /// For reproducible results across threads, give each worker an explicit generator created using
+    /// <see cref="RandomGenerator(ulong, int)"/> instead, since the order in which threads first ask for
+    /// a value is not deterministic.
+    /// </remarks>
     public static class Random
     {
-        private static System.Random m_random = new System.Random();
+        private static readonly object m_lock = new object();
+        private static ulong m_seed = (ulong)DateTime.UtcNow.Ticks;
+        private static int m_nextStream = 0;
+        private static int m_version = 1;
+
+        [ThreadStatic]
+        private static RandomGenerator m_generator;
+        [ThreadStatic]
+        private static int m_generatorVersion;
 
         /// <summary>
-        /// Gets a random value [0, 1).
+        /// The seed used to create the generator for each thread.
         /// </summary>
-        public static float Value => (float)m_random.NextDouble();
+        /// <remarks>
+        /// Setting the seed replaces the generator of every thread the next time it is used on that thread.
+        /// The first thread to use the new seed gets the same sequence as <c>new RandomGenerator(seed)</c>.
+        /// </remarks>
+        public static ulong Seed
+        {
+            get
+            {
+                lock (m_lock)
+                {
+                    return m_seed;
+                }
+            }
+            set
+            {
+                lock (m_lock)
+                {
+                    m_seed = value;
+                    m_nextStream = 0;
+                    Interlocked.Increment(ref m_version);
+                }
+            }
+        }
 
-        //public static int Seed
-        //{
-        //    get => m_random.
-        //}
+        /// <summary>
+        /// Gets the generator owned by the calling thread.
+        /// </summary>
+        public static RandomGenerator Current
+        {
+            get
+            {
+                RandomGenerator generator = m_generator;
+                if (generator == null || m_generatorVersion != Volatile.Read(ref m_version))
+                {
+                    generator = CreateGenerator();
+                }
+                return generator;
+            }
+        }
+
+        /// <summary>
+        /// Gets a random value [0, 1).
+        /// </summary>
+        public static float Value => Current.NextFloat();
 
         /// <summary>
         /// Gets a random value in some range.
@@ -29,7 +84,7 @@ namespace Engine
         /// <param name="max">The upper bound.</param>
         public static float GetRange(float min, float max)
         {
-            return Mathf.Lerp(min, max, Value);
+            return Current.GetRange(min, max);
         }
 
         /// <summary>
@@ -38,7 +93,7 @@ namespace Engine
         /// <param name="maxMagnitude">The maximum length of the vector.</param>
         public static Vector3 GetVector3(float maxMagnitude)
         {
-            return GetVector3() * maxMagnitude;
+            return Current.GetVector3(maxMagnitude);
         }
 
         /// <summary>
@@ -46,15 +101,51 @@ namespace Engine
         /// </summary>
         public static Vector3 GetVector3()
         {
-            Vector3 random;
-            do
+            return Current.GetVector3();
+        }
+
+        /// <summary>
+        /// Fills a range of an array with random values [0, 1).
+        /// </summary>
+        /// <param name="array">The array to fill.</param>
+        /// <param name="index">The index of the first value to fill.</param>
+        /// <param name="length">The number of values to fill.</param>
+        public static void Fill(float[] array, int index, int length)
+        {
+            Current.Fill(array, index, length);
+        }
+
+        /// <summary>
+        /// Fills a range of an array with random vectors within a sphere.
+        /// </summary>
+        /// <param name="array">The array to fill.</param>
+        /// <param name="index">The index of the first vector to fill.</param>
+        /// <param name="length">The number of vectors to fill.</param>
+        /// <param name="maxMagnitude">The maximum length of the vectors.</param>
+        public static void GetVector3(Vector3[] array, int index, int length, float maxMagnitude)
+        {
+            Current.GetVector3(array, index, length, maxMagnitude);
+        }
+
+        /// <summary>
+        /// Creates the generator for the calling thread from the current seed.
+        /// </summary>
+        private static RandomGenerator CreateGenerator()
+        {
+            ulong seed;
+            int stream;
+            int version;
+
+            lock (m_lock)
             {
-                random.x = GetRange(-1, 1);
-                random.y = GetRange(-1, 1);
-                random.z = GetRange(-1, 1);
+                seed = m_seed;
+                stream = m_nextStream++;
+                version = m_version;
             }
-            while (random.LengthSquared > 1);
-            return random;
+
+            m_generator = new RandomGenerator(seed, stream);
+            m_generatorVersion = version;
+            return m_generator;
         }
 
         /// <summary>
@@ -0,0 +1,280 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Runtime.CompilerServices;
+
+namespace Engine
+{
+    /// <summary>
+    /// A fast, seedable pseudo-random number generator using the xoshiro128** algorithm.
+    /// </summary>
+    /// <remarks>
+    /// Instances are not thread safe. Each thread or parallel task should own a generator, and
+    /// <see cref="RandomGenerator(ulong, int)"/> or <see cref="Jump"/> can be used to give each of them a
+    /// non-overlapping stream derived from the same seed. A generator produces 2^64 values per stream
+    /// before it would overlap with the next one. Use <see cref="Random"/> for a per-thread instance.
+    /// </remarks>
+    public sealed class RandomGenerator
+    {
+        private static readonly uint[] JUMP = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+
+        // 1 - 2^-21, which leaves room for directions that are up to a few ulps longer than one
+        private const float MAX_RADIUS = 0.99999952f;
+
+        private uint m_s0;
+        private uint m_s1;
+        private uint m_s2;
+        private uint m_s3;
+
+        /// <summary>
+        /// Creates a new generator.
+        /// </summary>
+        /// <param name="seed">The seed. Generators with the same seed produce the same sequence.</param>
+        public RandomGenerator(ulong seed)
+        {
+            // expand the seed with splitmix64 so similar seeds give unrelated states
+            ulong a = SplitMix64(ref seed);
+            ulong b = SplitMix64(ref seed);
+
+            m_s0 = (uint)a;
+            m_s1 = (uint)(a >> 32);
+            m_s2 = (uint)b;
+            m_s3 = (uint)(b >> 32);
+
+            // the all zero state is the only one that never changes
+            if ((m_s0 | m_s1 | m_s2 | m_s3) == 0)
+            {
+                m_s0 = 1;
+            }
+        }
+
+        /// <summary>
+        /// Creates a new generator for one of several independent streams that share a seed.
+        /// </summary>
+        /// <param name="seed">The seed. Generators with the same seed and stream produce the same sequence.</param>
+        /// <param name="stream">The index of the stream, used to give parallel workers non-overlapping sequences.</param>
+        public RandomGenerator(ulong seed, int stream) : this(seed)
+        {
+            if (stream < 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(stream), stream, "Must be non-negative!");
+            }
+
+            for (int i = 0; i < stream; i++)
+            {
+                Jump();
+            }
+        }
+
+        /// <summary>
+        /// Gets a random unsigned integer, with all bits equally likely.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public uint NextUInt()
+        {
+            uint result = RotateLeft(m_s1 * 5, 7) * 9;
+            uint t = m_s1 << 9;
+
+            m_s2 ^= m_s0;
+            m_s3 ^= m_s1;
+            m_s1 ^= m_s2;
+            m_s0 ^= m_s3;
+            m_s2 ^= t;
+            m_s3 = RotateLeft(m_s3, 11);
+
+            return result;
+        }
+
+        /// <summary>
+        /// Gets a random integer in some range.
+        /// </summary>
+        /// <remarks>
+        /// The range is mapped with a multiply and shift rather than a modulus. The bias this introduces is
+        /// less than range / 2^32, which is negligible for game use.
+        /// </remarks>
+        /// <param name="min">The inclusive lower bound.</param>
+        /// <param name="max">The exclusive upper bound.</param>
+        public int Next(int min, int max)
+        {
+            if (max <= min)
+            {
+                return min;
+            }
+
+            ulong range = (ulong)((long)max - min);
+            return (int)(min + (long)((NextUInt() * range) >> 32));
+        }
+
+        /// <summary>
+        /// Gets a random value [0, 1).
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public float NextFloat()
+        {
+            // use the top 24 bits, which is all the precision a float has in [0, 1)
+            return (NextUInt() >> 8) * (1f / 16777216f);
+        }
+
+        /// <summary>
+        /// Gets a random value in some range.
+        /// </summary>
+        /// <param name="min">The lower bound.</param>
+        /// <param name="max">The upper bound.</param>
+        public float GetRange(float min, float max)
+        {
+            return Mathf.Lerp(min, max, NextFloat());
+        }
+
+        /// <summary>
+        /// Gets a random vector with length 1.
+        /// </summary>
+        public Vector3 GetDirection()
+        {
+            // uniform on the sphere: pick the height uniformly, then an angle around the vertical axis
+            float z = (2f * NextFloat()) - 1f;
+            float r = Mathf.Sqrt(Mathf.Max(1f - (z * z), 0f));
+            MathfFast.SinCos(Mathf.TwoPi * NextFloat(), out float sin, out float cos);
+
+            return new Vector3(r * cos, r * sin, z);
+        }
+
+        /// <summary>
+        /// Gets a random vector with length [0, 1), uniformly distributed within the unit sphere.
+        /// </summary>
+        /// <remarks>
+        /// This always consumes three values from the generator, unlike rejection sampling.
+        /// </remarks>
+        public Vector3 GetVector3()
+        {
+            Vector3 direction = GetDirection();
+
+            // the cube root makes the points uniform by volume rather than clustered at the center, but rounds
+            // the largest inputs up to one, so clamp it to keep the length below one
+            float radius = Mathf.Min((float)Math.Pow(NextFloat(), 1.0 / 3.0), MAX_RADIUS);
+            return direction * radius;
+        }
+
+        /// <summary>
+        /// Gets a random vector.
+        /// </summary>
+        /// <param name="maxMagnitude">The maximum length of the vector.</param>
+        public Vector3 GetVector3(float maxMagnitude)
+        {
+            return GetVector3() * maxMagnitude;
+        }
+
+        /// <summary>
+        /// Fills a range of an array with random values [0, 1).
+        /// </summary>
+        /// <param name="array">The array to fill.</param>
+        /// <param name="index">The index of the first value to fill.</param>
+        /// <param name="length">The number of values to fill.</param>
+        public void Fill(float[] array, int index, int length)
+        {
+            ValidateRange(array, index, length);
+
+            for (int i = index; i < index + length; i++)
+            {
+                array[i] = (NextUInt() >> 8) * (1f / 16777216f);
+            }
+        }
+
+        /// <summary>
+        /// Fills a range of an array with random values in some range.
+        /// </summary>
+        /// <param name="array">The array to fill.</param>
+        /// <param name="index">The index of the first value to fill.</param>
+        /// <param name="length">The number of values to fill.</param>
+        /// <param name="min">The lower bound.</param>
+        /// <param name="max">The upper bound.</param>
+        public void Fill(float[] array, int index, int length, float min, float max)
+        {
+            ValidateRange(array, index, length);
+
+            for (int i = index; i < index + length; i++)
+            {
+                array[i] = Mathf.Lerp(min, max, (NextUInt() >> 8) * (1f / 16777216f));
+            }
+        }
+
+        /// <summary>
+        /// Fills a range of an array with random vectors within a sphere.
+        /// </summary>
+        /// <param name="array">The array to fill.</param>
+        /// <param name="index">The index of the first vector to fill.</param>
+        /// <param name="length">The number of vectors to fill.</param>
+        /// <param name="maxMagnitude">The maximum length of the vectors.</param>
+        public void GetVector3(Vector3[] array, int index, int length, float maxMagnitude)
+        {
+            ValidateRange(array, index, length);
+
+            for (int i = index; i < index + length; i++)
+            {
+                array[i] = GetVector3() * maxMagnitude;
+            }
+        }
+
+        /// <summary>
+        /// Advances the generator by 2^64 values. This is equivalent to moving to the next stream.
+        /// </summary>
+        public void Jump()
+        {
+            uint s0 = 0;
+            uint s1 = 0;
+            uint s2 = 0;
+            uint s3 = 0;
+
+            for (int i = 0; i < JUMP.Length; i++)
+            {
+                for (int b = 0; b < 32; b++)
+                {
+                    if ((JUMP[i] & (1u << b)) != 0)
+                    {
+                        s0 ^= m_s0;
+                        s1 ^= m_s1;
+                        s2 ^= m_s2;
+                        s3 ^= m_s3;
+                    }
+                    NextUInt();
+                }
+            }
+
+            m_s0 = s0;
+            m_s1 = s1;
+            m_s2 = s2;
+            m_s3 = s3;
+        }
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static uint RotateLeft(uint x, int k)
+        {
+            return (x << k) | (x >> (32 - k));
+        }
+
+        private static ulong SplitMix64(ref ulong state)
+        {
+            ulong z = (state += 0x9E3779B97F4A7C15UL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9UL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBUL;
+            return z ^ (z >> 31);
+        }
+
+        private static void ValidateRange(Array array, int index, int length)
+        {
+            if (array == null)
+            {
+                throw new ArgumentNullException("array");
+            }
+            if (index < 0 || length < 0)
+            {
+                throw new ArgumentOutOfRangeException(index < 0 ? "index" : "length", "Must be non-negative!");
+            }
+            if (array.Length < index + length)
+            {
+                throw new ArgumentException("Array length is lesser than index + length");
+            }
+        }
+    }
+}
@@ -0,0 +1,700 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Numerics;
+using System.Runtime.CompilerServices;
+
+using SimdVector4 = System.Numerics.Vector4;
+
+namespace Engine
+{
+    /// <summary>
+    /// Contains vectorized kernels used to accelerate batch operations on the math types.
+    /// </summary>
+    /// <remarks>
+    /// The kernels are built on the SIMD enabled types from System.Numerics, which the JIT maps to SSE/AVX
+    /// instructions when <see cref="IsAccelerated"/> is true. Unless noted otherwise, each kernel evaluates its
+    /// products and sums in the same order as the matching scalar method and no fused multiply-add is emitted,
+    /// so in a 64-bit process the results are bit identical to the scalar path. Where the scalar path is evaluated
+    /// using extended precision intermediates (the legacy 32-bit x87 JIT), results may differ by up to
+    /// <see cref="MaxUlpError"/> units in the last place per component.
+    /// </remarks>
+    internal static unsafe class Simd
+    {
+        /// <summary>
+        /// Indicates if the vectorized kernels are hardware accelerated on this machine.
+        /// </summary>
+        public static readonly bool IsAccelerated = System.Numerics.Vector.IsHardwareAccelerated;
+
+        /// <summary>
+        /// The maximum difference in units in the last place between a kernel and the equivalent scalar code.
+        /// </summary>
+        public const int MaxUlpError = 2;
+
+        /// <summary>
+        /// The maximum difference per component between <see cref="Slerp"/> and the scalar slerp.
+        /// </summary>
+        public const float SlerpMaxError = 2e-6f;
+
+        /// <summary>
+        /// The number of elements processed at once by the kernels that work across <see cref="Vector{T}"/> lanes.
+        /// </summary>
+        /// <remarks>
+        /// These kernels transpose the elements into one lane per component, so that each instruction processes
+        /// the same component of many elements, like <see cref="Vector3SoA"/>. The last group of elements is
+        /// padded rather than handled by a scalar loop, so every element of a batch gets the same result.
+        /// </remarks>
+        public static readonly int LaneWidth = Vector<float>.Count;
+
+        // the most lanes used at once by a kernel
+        private const int LANE_COUNT = 9;
+
+        [ThreadStatic]
+        private static float[] m_lanes;
+
+        /// <summary>
+        /// Loads a row of a matrix.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static SimdVector4 Load(float* row)
+        {
+            return *(SimdVector4*)row;
+        }
+
+        /// <summary>
+        /// Stores a row of a matrix.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static void Store(float* row, SimdVector4 value)
+        {
+            *(SimdVector4*)row = value;
+        }
+
+        /// <summary>
+        /// Transforms a set of positions by a matrix.
+        /// </summary>
+        public static void TransformPosition(Vector3[] srcArray, int srcIndex, ref Matrix matrix, Vector3[] destArray, int destIndex, int length)
+        {
+            if (length <= 0)
+            {
+                return;
+            }
+
+            fixed (Matrix* m = &matrix)
+            fixed (Vector3* src = &srcArray[srcIndex])
+            fixed (Vector3* dest = &destArray[destIndex])
+            {
+                SimdVector4 row0 = Load(&m->m00);
+                SimdVector4 row1 = Load(&m->m10);
+                SimdVector4 row2 = Load(&m->m20);
+                SimdVector4 row3 = Load(&m->m30);
+
+                for (int i = 0; i < length; i++)
+                {
+                    Vector3 v = src[i];
+                    SimdVector4 r = (v.x * row0) + (v.y * row1) + (v.z * row2) + row3;
+
+                    // only store three components so we never write past the element
+                    dest[i].x = r.X;
+                    dest[i].y = r.Y;
+                    dest[i].z = r.Z;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Transforms a set of directions by a matrix.
+        /// </summary>
+        public static void TransformDirection(Vector3[] srcArray, int srcIndex, ref Matrix matrix, Vector3[] destArray, int destIndex, int length)
+        {
+            if (length <= 0)
+            {
+                return;
+            }
+
+            fixed (Matrix* m = &matrix)
+            fixed (Vector3* src = &srcArray[srcIndex])
+            fixed (Vector3* dest = &destArray[destIndex])
+            {
+                SimdVector4 row0 = Load(&m->m00);
+                SimdVector4 row1 = Load(&m->m10);
+                SimdVector4 row2 = Load(&m->m20);
+
+                for (int i = 0; i < length; i++)
+                {
+                    Vector3 v = src[i];
+                    SimdVector4 r = (v.x * row0) + (v.y * row1) + (v.z * row2);
+
+                    dest[i].x = r.X;
+                    dest[i].y = r.Y;
+                    dest[i].z = r.Z;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Transforms a set of 4d vectors by a matrix.
+        /// </summary>
+        public static void Transform(Vector4[] srcArray, int srcIndex, ref Matrix matrix, Vector4[] destArray, int destIndex, int length)
+        {
+            if (length <= 0)
+            {
+                return;
+            }
+
+            fixed (Matrix* m = &matrix)
+            fixed (Vector4* src = &srcArray[srcIndex])
+            fixed (Vector4* dest = &destArray[destIndex])
+            {
+                SimdVector4 row0 = Load(&m->m00);
+                SimdVector4 row1 = Load(&m->m10);
+                SimdVector4 row2 = Load(&m->m20);
+                SimdVector4 row3 = Load(&m->m30);
+
+                for (int i = 0; i < length; i++)
+                {
+                    Vector4 v = src[i];
+                    Store(&dest[i].x, (v.x * row0) + (v.y * row1) + (v.z * row2) + (v.w * row3));
+                }
+            }
+        }
+
+        /// <summary>
+        /// Multiplies two matrices.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static void Multiply(Matrix* left, Matrix* right, Matrix* result)
+        {
+            SimdVector4 r0 = Load(&right->m00);
+            SimdVector4 r1 = Load(&right->m10);
+            SimdVector4 r2 = Load(&right->m20);
+            SimdVector4 r3 = Load(&right->m30);
+
+            // compute every row before storing any, as the result may alias either operand
+            SimdVector4 row0 = (left->m00 * r0) + (left->m01 * r1) + (left->m02 * r2) + (left->m03 * r3);
+            SimdVector4 row1 = (left->m10 * r0) + (left->m11 * r1) + (left->m12 * r2) + (left->m13 * r3);
+            SimdVector4 row2 = (left->m20 * r0) + (left->m21 * r1) + (left->m22 * r2) + (left->m23 * r3);
+            SimdVector4 row3 = (left->m30 * r0) + (left->m31 * r1) + (left->m32 * r2) + (left->m33 * r3);
+
+            Store(&result->m00, row0);
+            Store(&result->m10, row1);
+            Store(&result->m20, row2);
+            Store(&result->m30, row3);
+        }
+
+        /// <summary>
+        /// Multiplies two matrices.
+        /// </summary>
+        public static void Multiply(ref Matrix left, ref Matrix right, out Matrix result)
+        {
+            Matrix product;
+
+            fixed (Matrix* l = &left)
+            fixed (Matrix* r = &right)
+            {
+                Multiply(l, r, &product);
+            }
+
+            result = product;
+        }
+
+        /// <summary>
+        /// Inverts a matrix.
+        /// </summary>
+        /// <remarks>
+        /// This factors the inverse using the 2x2 sub-determinants of the upper and lower halves of the
+        /// matrix so that each row of the result is three vector multiply-adds. The factoring differs from
+        /// the scalar cofactor expansion, so results are not bit identical to <see cref="Matrix.Invert(ref Matrix, out Matrix)"/>,
+        /// but have the same accuracy.
+        /// </remarks>
+        public static void Invert(ref Matrix matrix, out Matrix result)
+        {
+            float a00 = matrix.m00, a01 = matrix.m01, a02 = matrix.m02, a03 = matrix.m03;
+            float a10 = matrix.m10, a11 = matrix.m11, a12 = matrix.m12, a13 = matrix.m13;
+            float a20 = matrix.m20, a21 = matrix.m21, a22 = matrix.m22, a23 = matrix.m23;
+            float a30 = matrix.m30, a31 = matrix.m31, a32 = matrix.m32, a33 = matrix.m33;
+
+            // sub-determinants of the upper two rows
+            float s0 = a00 * a11 - a10 * a01;
+            float s1 = a00 * a12 - a10 * a02;
+            float s2 = a00 * a13 - a10 * a03;
+            float s3 = a01 * a12 - a11 * a02;
+            float s4 = a01 * a13 - a11 * a03;
+            float s5 = a02 * a13 - a12 * a03;
+
+            // sub-determinants of the lower two rows
+            float c0 = a20 * a31 - a30 * a21;
+            float c1 = a20 * a32 - a30 * a22;
+            float c2 = a20 * a33 - a30 * a23;
+            float c3 = a21 * a32 - a31 * a22;
+            float c4 = a21 * a33 - a31 * a23;
+            float c5 = a22 * a33 - a32 * a23;
+
+            float invDet = 1f / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+
+            SimdVector4 v0 = new SimdVector4(a10, a00, a30, a20);
+            SimdVector4 v1 = new SimdVector4(a11, a01, a31, a21);
+            SimdVector4 v2 = new SimdVector4(a12, a02, a32, a22);
+            SimdVector4 v3 = new SimdVector4(a13, a03, a33, a23);
+
+            SimdVector4 d0 = new SimdVector4(c0, c0, s0, s0);
+            SimdVector4 d1 = new SimdVector4(c1, c1, s1, s1);
+            SimdVector4 d2 = new SimdVector4(c2, c2, s2, s2);
+            SimdVector4 d3 = new SimdVector4(c3, c3, s3, s3);
+            SimdVector4 d4 = new SimdVector4(c4, c4, s4, s4);
+            SimdVector4 d5 = new SimdVector4(c5, c5, s5, s5);
+
+            // the cofactors alternate in sign along each row
+            SimdVector4 scale = new SimdVector4(invDet, -invDet, invDet, -invDet);
+
+            Matrix inverse;
+            Matrix* dst = &inverse;
+            Store(&dst->m00, ((v1 * d5) - (v2 * d4) + (v3 * d3)) * scale);
+            Store(&dst->m10, ((v2 * d2) - (v0 * d5) - (v3 * d1)) * scale);
+            Store(&dst->m20, ((v0 * d4) - (v1 * d2) + (v3 * d0)) * scale);
+            Store(&dst->m30, ((v1 * d1) - (v0 * d3) - (v2 * d0)) * scale);
+            result = inverse;
+        }
+
+        /// <summary>
+        /// Inverts an affine matrix, where the last column is (0, 0, 0, 1).
+        /// </summary>
+        public static void InvertAffine(ref Matrix matrix, out Matrix result)
+        {
+            float a00 = matrix.m00, a01 = matrix.m01, a02 = matrix.m02;
+            float a10 = matrix.m10, a11 = matrix.m11, a12 = matrix.m12;
+            float a20 = matrix.m20, a21 = matrix.m21, a22 = matrix.m22;
+
+            // the columns of the inverse are the cross products of the rows
+            float b00 = a11 * a22 - a12 * a21;
+            float b10 = a12 * a20 - a10 * a22;
+            float b20 = a10 * a21 - a11 * a20;
+
+            float invDet = 1f / (a00 * b00 + a01 * b10 + a02 * b20);
+
+            SimdVector4 row0 = new SimdVector4(b00, a21 * a02 - a22 * a01, a01 * a12 - a02 * a11, 0f) * invDet;
+            SimdVector4 row1 = new SimdVector4(b10, a22 * a00 - a20 * a02, a02 * a10 - a00 * a12, 0f) * invDet;
+            SimdVector4 row2 = new SimdVector4(b20, a20 * a01 - a21 * a00, a00 * a11 - a01 * a10, 0f) * invDet;
+            SimdVector4 row3 = SimdVector4.UnitW - ((matrix.m30 * row0) + (matrix.m31 * row1) + (matrix.m32 * row2));
+
+            Matrix inverse;
+            Matrix* dst = &inverse;
+            Store(&dst->m00, row0);
+            Store(&dst->m10, row1);
+            Store(&dst->m20, row2);
+            Store(&dst->m30, row3);
+            result = inverse;
+        }
+
+        /// <summary>
+        /// Performs a normalized linear blend between pairs of quaternions from two sets.
+        /// </summary>
+        /// <param name="tArray">The blend amount for each pair, or null to use <paramref name="t"/> for all pairs.</param>
+        /// <param name="approximateSlerp">Corrects the blend amounts so that the blend approximates a spherical blend.</param>
+        public static void Blend(Quaternion[] aArray, Quaternion[] bArray, float[] tArray, float t, Quaternion[] destArray, int length, bool approximateSlerp)
+        {
+            if (length <= 0)
+            {
+                return;
+            }
+
+            float[] lanes = GetLanes();
+
+            fixed (Quaternion* a = &aArray[0])
+            fixed (Quaternion* b = &bArray[0])
+            fixed (Quaternion* dest = &destArray[0])
+            fixed (float* l = &lanes[0])
+            {
+                for (int i = 0; i < length; i += LaneWidth)
+                {
+                    int count = Math.Min(LaneWidth, length - i);
+
+                    LoadLanes(a + i, count, l, 0);
+                    LoadLanes(b + i, count, l, 4);
+                    Vector<float> blend = LoadBlend(tArray, t, i, count, lanes, l, 8);
+
+                    Vector<float> ax = LoadLane(lanes, 0), ay = LoadLane(lanes, 1), az = LoadLane(lanes, 2), aw = LoadLane(lanes, 3);
+                    Vector<float> bx = LoadLane(lanes, 4), by = LoadLane(lanes, 5), bz = LoadLane(lanes, 6), bw = LoadLane(lanes, 7);
+
+                    Vector<float> cosHalfAngle = (ax * bx) + (ay * by) + (az * bz) + (aw * bw);
+
+                    if (approximateSlerp)
+                    {
+                        blend = Quaternion.SlerpFastBlend(Vector.Abs(cosHalfAngle), blend);
+                    }
+
+                    Vector<float> blendA = Vector<float>.One - blend;
+                    Vector<float> blendB = Vector.ConditionalSelect(Vector.LessThan(cosHalfAngle, Vector<float>.Zero), -blend, blend);
+
+                    Vector<float> x = (blendA * ax) + (blendB * bx);
+                    Vector<float> y = (blendA * ay) + (blendB * by);
+                    Vector<float> z = (blendA * az) + (blendB * bz);
+                    Vector<float> w = (blendA * aw) + (blendB * bw);
+
+                    NormalizeOrIdentity(ref x, ref y, ref z, ref w);
+                    StoreLanes(x, y, z, w, lanes, l, dest + i, count);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Performs a spherical linear blend between pairs of quaternions from two sets.
+        /// </summary>
+        /// <remarks>
+        /// The trigonometric functions use the approximations from <see cref="MathfFast"/>, so each component
+        /// of the results is within <see cref="SlerpMaxError"/> of <see cref="Quaternion.Slerp(ref Quaternion, ref Quaternion, float, out Quaternion)"/>.
+        /// </remarks>
+        /// <param name="tArray">The blend amount for each pair, or null to use <paramref name="t"/> for all pairs.</param>
+        public static void Slerp(Quaternion[] aArray, Quaternion[] bArray, float[] tArray, float t, Quaternion[] destArray, int length)
+        {
+            if (length <= 0)
+            {
+                return;
+            }
+
+            float[] lanes = GetLanes();
+
+            fixed (Quaternion* a = &aArray[0])
+            fixed (Quaternion* b = &bArray[0])
+            fixed (Quaternion* dest = &destArray[0])
+            fixed (float* l = &lanes[0])
+            {
+                for (int i = 0; i < length; i += LaneWidth)
+                {
+                    int count = Math.Min(LaneWidth, length - i);
+
+                    LoadLanes(a + i, count, l, 0);
+                    LoadLanes(b + i, count, l, 4);
+                    Vector<float> blend = LoadBlend(tArray, t, i, count, lanes, l, 8);
+
+                    Vector<float> ax = LoadLane(lanes, 0), ay = LoadLane(lanes, 1), az = LoadLane(lanes, 2), aw = LoadLane(lanes, 3);
+                    Vector<float> bx = LoadLane(lanes, 4), by = LoadLane(lanes, 5), bz = LoadLane(lanes, 6), bw = LoadLane(lanes, 7);
+
+                    Vector<float> cosHalfAngle = (ax * bx) + (ay * by) + (az * bz) + (aw * bw);
+                    Vector<int> conjugate = Vector.LessThan(cosHalfAngle, Vector<float>.Zero);
+                    Vector<float> d = Vector.Abs(cosHalfAngle);
+
+                    // both blends are computed for every lane, then the one the scalar code would use is selected
+                    Vector<float> halfAngle = MathfFast.Acos(Vector.Min(d, Vector<float>.One));
+                    Vector<float> invSinHalfAngle = Vector<float>.One / Vector.SquareRoot(Vector<float>.One - (d * d));
+                    MathfFast.SinCos(halfAngle * (Vector<float>.One - blend), out Vector<float> sinA, out _);
+                    MathfFast.SinCos(halfAngle * blend, out Vector<float> sinB, out _);
+
+                    Vector<int> small = Vector.GreaterThanOrEqual(d, new Vector<float>(0.99f));
+                    Vector<float> blendA = Vector.ConditionalSelect(small, Vector<float>.One - blend, sinA * invSinHalfAngle);
+                    Vector<float> blendB = Vector.ConditionalSelect(small, blend, sinB * invSinHalfAngle);
+                    blendB = Vector.ConditionalSelect(conjugate, -blendB, blendB);
+
+                    Vector<float> x = (blendA * ax) + (blendB * bx);
+                    Vector<float> y = (blendA * ay) + (blendB * by);
+                    Vector<float> z = (blendA * az) + (blendB * bz);
+                    Vector<float> w = (blendA * aw) + (blendB * bw);
+
+                    NormalizeOrIdentity(ref x, ref y, ref z, ref w);
+
+                    // when the angle is zero either input is returned
+                    Vector<int> same = Vector.GreaterThanOrEqual(d, Vector<float>.One);
+                    x = Vector.ConditionalSelect(same, ax, x);
+                    y = Vector.ConditionalSelect(same, ay, y);
+                    z = Vector.ConditionalSelect(same, az, z);
+                    w = Vector.ConditionalSelect(same, aw, w);
+
+                    StoreLanes(x, y, z, w, lanes, l, dest + i, count);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Rotates each vector in a set by the rotation at the same index in another set.
+        /// </summary>
+        public static void Rotate(Vector3[] srcArray, Quaternion[] rotations, Vector3[] destArray, int length)
+        {
+            if (length <= 0)
+            {
+                return;
+            }
+
+            float[] lanes = GetLanes();
+
+            fixed (Vector3* src = &srcArray[0])
+            fixed (Quaternion* rotation = &rotations[0])
+            fixed (Vector3* dest = &destArray[0])
+            fixed (float* l = &lanes[0])
+            {
+                for (int i = 0; i < length; i += LaneWidth)
+                {
+                    int count = Math.Min(LaneWidth, length - i);
+
+                    LoadLanes(src + i, count, l, 0);
+                    LoadLanes(rotation + i, count, l, 3);
+
+                    Vector<float> vx = LoadLane(lanes, 0), vy = LoadLane(lanes, 1), vz = LoadLane(lanes, 2);
+                    Vector<float> rx = LoadLane(lanes, 3), ry = LoadLane(lanes, 4), rz = LoadLane(lanes, 5), rw = LoadLane(lanes, 6);
+
+                    Vector<float> two = new Vector<float>(2f);
+                    Vector<float> x = two * ((ry * vz) - (rz * vy));
+                    Vector<float> y = two * ((rz * vx) - (rx * vz));
+                    Vector<float> z = two * ((rx * vy) - (ry * vx));
+
+                    StoreLane(vx + (x * rw) + ((ry * z) - (rz * y)), lanes, 0);
+                    StoreLane(vy + (y * rw) + ((rz * x) - (rx * z)), lanes, 1);
+                    StoreLane(vz + (z * rw) + ((rx * y) - (ry * x)), lanes, 2);
+
+                    float* lx = l;
+                    float* ly = lx + LaneWidth;
+                    float* lz = ly + LaneWidth;
+
+                    for (int k = 0; k < count; k++)
+                    {
+                        dest[i + k] = new Vector3(lx[k], ly[k], lz[k]);
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Creates rotation matrices from a set of quaternions.
+        /// </summary>
+        public static void CreateFromQuaternion(Quaternion[] srcArray, Matrix[] destArray, int length)
+        {
+            if (length <= 0)
+            {
+                return;
+            }
+
+            float[] lanes = GetLanes();
+
+            fixed (Quaternion* src = &srcArray[0])
+            fixed (Matrix* dest = &destArray[0])
+            fixed (float* l = &lanes[0])
+            {
+                for (int i = 0; i < length; i += LaneWidth)
+                {
+                    int count = Math.Min(LaneWidth, length - i);
+
+                    LoadLanes(src + i, count, l, 0);
+
+                    Vector<float> qx = LoadLane(lanes, 0), qy = LoadLane(lanes, 1), qz = LoadLane(lanes, 2), qw = LoadLane(lanes, 3);
+
+                    Vector<float> xx = qx * qx;
+                    Vector<float> xy = qx * qy;
+                    Vector<float> xz = qz * qx;
+                    Vector<float> xw = qx * qw;
+
+                    Vector<float> yy = qy * qy;
+                    Vector<float> yz = qy * qz;
+                    Vector<float> yw = qy * qw;
+
+                    Vector<float> zz = qz * qz;
+                    Vector<float> zw = qz * qw;
+
+                    Vector<float> one = Vector<float>.One;
+                    Vector<float> two = new Vector<float>(2f);
+
+                    StoreLane(one - (two * (yy + zz)), lanes, 0);
+                    StoreLane(two * (xy + zw), lanes, 1);
+                    StoreLane(two * (xz - yw), lanes, 2);
+                    StoreLane(two * (xy - zw), lanes, 3);
+                    StoreLane(one - (two * (xx + zz)), lanes, 4);
+                    StoreLane(two * (yz + xw), lanes, 5);
+                    StoreLane(two * (xz + yw), lanes, 6);
+                    StoreLane(two * (yz - xw), lanes, 7);
+                    StoreLane(one - (two * (xx + yy)), lanes, 8);
+
+                    for (int k = 0; k < count; k++)
+                    {
+                        Matrix* m = dest + i + k;
+                        float* lane = l + k;
+
+                        m->m00 = lane[0];
+                        m->m01 = lane[LaneWidth];
+                        m->m02 = lane[2 * LaneWidth];
+                        m->m03 = 0f;
+
+                        m->m10 = lane[3 * LaneWidth];
+                        m->m11 = lane[4 * LaneWidth];
+                        m->m12 = lane[5 * LaneWidth];
+                        m->m13 = 0f;
+
+                        m->m20 = lane[6 * LaneWidth];
+                        m->m21 = lane[7 * LaneWidth];
+                        m->m22 = lane[8 * LaneWidth];
+                        m->m23 = 0f;
+
+                        m->m30 = 0f;
+                        m->m31 = 0f;
+                        m->m32 = 0f;
+                        m->m33 = 1f;
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets the calling thread's scratch space used to transpose values into lanes.
+        /// </summary>
+        private static float[] GetLanes()
+        {
+            return m_lanes ?? (m_lanes = new float[LANE_COUNT * LaneWidth]);
+        }
+
+        /// <summary>
+        /// Transposes up to <see cref="LaneWidth"/> quaternions into four consecutive lanes, one per component.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static void LoadLanes(Quaternion* src, int count, float* lanes, int lane)
+        {
+            float* x = lanes + (lane * LaneWidth);
+            float* y = x + LaneWidth;
+            float* z = y + LaneWidth;
+            float* w = z + LaneWidth;
+
+            for (int k = 0; k < count; k++)
+            {
+                x[k] = src[k].x;
+                y[k] = src[k].y;
+                z[k] = src[k].z;
+                w[k] = src[k].w;
+            }
+        }
+
+        /// <summary>
+        /// Transposes up to <see cref="LaneWidth"/> vectors into three consecutive lanes, one per component.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static void LoadLanes(Vector3* src, int count, float* lanes, int lane)
+        {
+            float* x = lanes + (lane * LaneWidth);
+            float* y = x + LaneWidth;
+            float* z = y + LaneWidth;
+
+            for (int k = 0; k < count; k++)
+            {
+                x[k] = src[k].x;
+                y[k] = src[k].y;
+                z[k] = src[k].z;
+            }
+        }
+
+        /// <summary>
+        /// Gets the blend amounts for a group of pairs.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static Vector<float> LoadBlend(float[] tArray, float t, int index, int count, float[] lanes, float* l, int lane)
+        {
+            if (tArray == null)
+            {
+                return new Vector<float>(t);
+            }
+
+            float* dest = l + (lane * LaneWidth);
+            for (int k = 0; k < count; k++)
+            {
+                dest[k] = tArray[index + k];
+            }
+            return LoadLane(lanes, lane);
+        }
+
+        /// <summary>
+        /// Reads a lane from the scratch space.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static Vector<float> LoadLane(float[] lanes, int lane)
+        {
+            return new Vector<float>(lanes, lane * LaneWidth);
+        }
+
+        /// <summary>
+        /// Writes a lane to the scratch space.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static void StoreLane(Vector<float> value, float[] lanes, int lane)
+        {
+            value.CopyTo(lanes, lane * LaneWidth);
+        }
+
+        /// <summary>
+        /// Transposes quaternion components back out of the first four lanes.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static void StoreLanes(Vector<float> x, Vector<float> y, Vector<float> z, Vector<float> w, float[] lanes, float* l, Quaternion* dest, int count)
+        {
+            StoreLane(x, lanes, 0);
+            StoreLane(y, lanes, 1);
+            StoreLane(z, lanes, 2);
+            StoreLane(w, lanes, 3);
+
+            float* lx = l;
+            float* ly = lx + LaneWidth;
+            float* lz = ly + LaneWidth;
+            float* lw = lz + LaneWidth;
+
+            for (int k = 0; k < count; k++)
+            {
+                dest[k] = new Quaternion(lx[k], ly[k], lz[k], lw[k]);
+            }
+        }
+
+        /// <summary>
+        /// Normalizes the quaternions in a group of lanes, replacing any too small to normalize with the identity.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static void NormalizeOrIdentity(ref Vector<float> x, ref Vector<float> y, ref Vector<float> z, ref Vector<float> w)
+        {
+            Vector<float> lengthSquared = (x * x) + (y * y) + (z * z) + (w * w);
+            Vector<int> valid = Vector.GreaterThan(lengthSquared, new Vector<float>(float.Epsilon));
+            Vector<float> scale = Vector<float>.One / Vector.SquareRoot(lengthSquared);
+
+            x = Vector.ConditionalSelect(valid, x * scale, Vector<float>.Zero);
+            y = Vector.ConditionalSelect(valid, y * scale, Vector<float>.Zero);
+            z = Vector.ConditionalSelect(valid, z * scale, Vector<float>.Zero);
+            w = Vector.ConditionalSelect(valid, w * scale, Vector<float>.One);
+        }
+
+        /// <summary>
+        /// Multiplies pairs of matrices from two sets.
+        /// </summary>
+        public static void Multiply(Matrix[] leftArray, int leftIndex, Matrix[] rightArray, int rightIndex, Matrix[] destArray, int destIndex, int length)
+        {
+            if (length <= 0)
+            {
+                return;
+            }
+
+            fixed (Matrix* left = &leftArray[leftIndex])
+            fixed (Matrix* right = &rightArray[rightIndex])
+            fixed (Matrix* dest = &destArray[destIndex])
+            {
+                for (int i = 0; i < length; i++)
+                {
+                    Multiply(left + i, right + i, dest + i);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Multiplies each matrix in a set by a single matrix.
+        /// </summary>
+        public static void Multiply(Matrix[] srcArray, int srcIndex, ref Matrix matrix, Matrix[] destArray, int destIndex, int length)
+        {
+            if (length <= 0)
+            {
+                return;
+            }
+
+            // copy the shared operand so results written into the destination can't change it
+            Matrix right = matrix;
+
+            fixed (Matrix* src = &srcArray[srcIndex])
+            fixed (Matrix* dest = &destArray[destIndex])
+            {
+                for (int i = 0; i < length; i++)
+                {
+                    Multiply(src + i, &right, dest + i);
+                }
+            }
+        }
+    }
+}
@@ -34,6 +34,11 @@ namespace Engine
             }
         }
 
+        /// <summary>
+        /// Indicates if the instance has been created.
+        /// </summary>
+        public static bool Exists => m_instance != null;
+
         protected Singleton()
         {
             if (m_instance != null)
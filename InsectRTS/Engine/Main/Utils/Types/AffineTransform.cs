@@ -0,0 +1,323 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Runtime.InteropServices;
+
+namespace Engine
+{
+    /// <summary>
+    /// Describes a rigid transformation with uniform scale, stored as a position, rotation and scale.
+    /// </summary>
+    /// <remarks>
+    /// Unlike a general <see cref="Matrix"/>, this type can be composed and inverted cheaply and remains
+    /// closed under both operations. A transform is applied by scaling, then rotating, then translating.
+    /// Transform hierarchies should stay in this representation and only convert to a <see cref="Matrix"/>
+    /// when uploading to the GPU.
+    /// </remarks>
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct AffineTransform : IEquatable<AffineTransform>, ICharFormattable
+    {
+        /// <summary>
+        /// Returns the identity transform.
+        /// </summary>
+        public static readonly AffineTransform Identity = new AffineTransform(Vector3.Zero, Quaternion.Identity, 1f);
+
+        /// <summary>
+        /// The translation.
+        /// </summary>
+        public Vector3 position;
+
+        /// <summary>
+        /// The rotation. Must be normalized.
+        /// </summary>
+        public Quaternion rotation;
+
+        /// <summary>
+        /// The uniform scale factor.
+        /// </summary>
+        public float scale;
+
+        /// <summary>
+        /// Constructs a new transform.
+        /// </summary>
+        /// <param name="position">The translation.</param>
+        /// <param name="rotation">The rotation. Must be normalized.</param>
+        /// <param name="scale">The uniform scale factor.</param>
+        public AffineTransform(Vector3 position, Quaternion rotation, float scale)
+        {
+            this.position = position;
+            this.rotation = rotation;
+            this.scale = scale;
+        }
+
+        /// <summary>
+        /// Constructs a new transform without any scaling.
+        /// </summary>
+        /// <param name="position">The translation.</param>
+        /// <param name="rotation">The rotation. Must be normalized.</param>
+        public AffineTransform(Vector3 position, Quaternion rotation) : this(position, rotation, 1f)
+        {
+        }
+
+        /// <summary>
+        /// Returns the inverse of this transform.
+        /// </summary>
+        public AffineTransform Inverse => Invert(this);
+
+        /// <summary>
+        /// Combines two transforms.
+        /// </summary>
+        /// <param name="left">The transform applied first.</param>
+        /// <param name="right">The transform applied second.</param>
+        /// <returns>A transform equivalent to applying left and then right.</returns>
+        public static AffineTransform Multiply(AffineTransform left, AffineTransform right)
+        {
+            Multiply(ref left, ref right, out AffineTransform result);
+            return result;
+        }
+
+        /// <summary>
+        /// Combines two transforms.
+        /// </summary>
+        /// <remarks>
+        /// This follows the same order as <see cref="Matrix.Multiply(ref Matrix, ref Matrix, out Matrix)"/>, so
+        /// a child transform multiplied by its parent's transform gives the child's world transform.
+        /// </remarks>
+        /// <param name="left">The transform applied first.</param>
+        /// <param name="right">The transform applied second.</param>
+        /// <param name="result">The combined transform as an output parameter.</param>
+        public static void Multiply(ref AffineTransform left, ref AffineTransform right, out AffineTransform result)
+        {
+            Vector3 position = left.position * right.scale;
+            Vector3.Rotate(ref position, ref right.rotation, out position);
+
+            Quaternion rotation;
+            Quaternion.Multiply(ref right.rotation, ref left.rotation, out rotation);
+
+            result.position = position + right.position;
+            result.rotation = rotation;
+            result.scale = left.scale * right.scale;
+        }
+
+        /// <summary>
+        /// Computes the inverse of a transform.
+        /// </summary>
+        /// <param name="transform">The transform to invert.</param>
+        public static AffineTransform Invert(AffineTransform transform)
+        {
+            Invert(ref transform, out AffineTransform result);
+            return result;
+        }
+
+        /// <summary>
+        /// Computes the inverse of a transform.
+        /// </summary>
+        /// <param name="transform">The transform to invert.</param>
+        /// <param name="result">The inverted transform as an output parameter.</param>
+        public static void Invert(ref AffineTransform transform, out AffineTransform result)
+        {
+            float invScale = 1f / transform.scale;
+
+            // a unit quaternion's conjugate is its inverse
+            Quaternion.Conjugate(ref transform.rotation, out Quaternion invRotation);
+
+            Vector3 position = transform.position * -invScale;
+            Vector3.Rotate(ref position, ref invRotation, out position);
+
+            result.position = position;
+            result.rotation = invRotation;
+            result.scale = invScale;
+        }
+
+        /// <summary>
+        /// Transforms a position.
+        /// </summary>
+        /// <param name="position">The position to transform.</param>
+        /// <param name="transform">The transformation to apply.</param>
+        public static Vector3 TransformPosition(Vector3 position, AffineTransform transform)
+        {
+            TransformPosition(ref position, ref transform, out Vector3 result);
+            return result;
+        }
+
+        /// <summary>
+        /// Transforms a position.
+        /// </summary>
+        /// <param name="position">The position to transform.</param>
+        /// <param name="transform">The transformation to apply.</param>
+        /// <param name="result">The transformed position as an output parameter.</param>
+        public static void TransformPosition(ref Vector3 position, ref AffineTransform transform, out Vector3 result)
+        {
+            Vector3 scaled = position * transform.scale;
+            Vector3.Rotate(ref scaled, ref transform.rotation, out result);
+            result.x += transform.position.x;
+            result.y += transform.position.y;
+            result.z += transform.position.z;
+        }
+
+        /// <summary>
+        /// Transforms a direction vector. The translation is ignored.
+        /// </summary>
+        /// <param name="direction">The direction to transform.</param>
+        /// <param name="transform">The transformation to apply.</param>
+        public static Vector3 TransformDirection(Vector3 direction, AffineTransform transform)
+        {
+            TransformDirection(ref direction, ref transform, out Vector3 result);
+            return result;
+        }
+
+        /// <summary>
+        /// Transforms a direction vector. The translation is ignored.
+        /// </summary>
+        /// <param name="direction">The direction to transform.</param>
+        /// <param name="transform">The transformation to apply.</param>
+        /// <param name="result">The transformed direction as an output parameter.</param>
+        public static void TransformDirection(ref Vector3 direction, ref AffineTransform transform, out Vector3 result)
+        {
+            Vector3 scaled = direction * transform.scale;
+            Vector3.Rotate(ref scaled, ref transform.rotation, out result);
+        }
+
+        /// <summary>
+        /// Creates a matrix equivalent to this transform.
+        /// </summary>
+        public Matrix ToMatrix()
+        {
+            ToMatrix(ref this, out Matrix result);
+            return result;
+        }
+
+        /// <summary>
+        /// Creates a matrix equivalent to a transform.
+        /// </summary>
+        /// <param name="transform">The transform to convert.</param>
+        /// <param name="result">The matrix as an output parameter.</param>
+        public static void ToMatrix(ref AffineTransform transform, out Matrix result)
+        {
+            Quaternion q = transform.rotation;
+            float s = transform.scale;
+
+            float xx = q.x * q.x;
+            float xy = q.x * q.y;
+            float xz = q.z * q.x;
+            float xw = q.x * q.w;
+
+            float yy = q.y * q.y;
+            float yz = q.y * q.z;
+            float yw = q.y * q.w;
+
+            float zz = q.z * q.z;
+            float zw = q.z * q.w;
+
+            result.m00 = s * (1f - (2f * (yy + zz)));
+            result.m01 = s * (2f * (xy + zw));
+            result.m02 = s * (2f * (xz - yw));
+            result.m03 = 0f;
+
+            result.m10 = s * (2f * (xy - zw));
+            result.m11 = s * (1f - (2f * (xx + zz)));
+            result.m12 = s * (2f * (yz + xw));
+            result.m13 = 0f;
+
+            result.m20 = s * (2f * (xz + yw));
+            result.m21 = s * (2f * (yz - xw));
+            result.m22 = s * (1f - (2f * (xx + yy)));
+            result.m23 = 0f;
+
+            result.m30 = transform.position.x;
+            result.m31 = transform.position.y;
+            result.m32 = transform.position.z;
+            result.m33 = 1f;
+        }
+
+        /// <summary>
+        /// Compares whether this instance is equal to another.
+        /// </summary>
+        /// <param name="other">The instance to compare with.</param>
+        /// <returns><c>true</c> if the instances are equal, <c>false</c> otherwise.</returns>
+        public bool Equals(AffineTransform other)
+        {
+            return
+                position == other.position &&
+                rotation == other.rotation &&
+                scale == other.scale;
+        }
+
+        /// <summary>
+        /// Compares whether this instance is equal to specified <see cref="Object"/>.
+        /// </summary>
+        /// <param name="obj">The <see cref="Object"/> to compare.</param>
+        /// <returns><c>true</c> if the instances are equal, <c>false</c> otherwise.</returns>
+        public override bool Equals(object obj)
+        {
+            return (obj is AffineTransform) && Equals((AffineTransform)obj);
+        }
+
+        /// <summary>
+        /// Gets the hash code of this instance.
+        /// </summary>
+        public override int GetHashCode()
+        {
+            unchecked
+            {
+                int hashCode = position.GetHashCode();
+                hashCode = (hashCode * 397) ^ rotation.GetHashCode();
+                hashCode = (hashCode * 397) ^ scale.GetHashCode();
+                return hashCode;
+            }
+        }
+
+        /// <summary>
+        /// Writes the text of <see cref="ToString"/>, formatted with the invariant culture, into a buffer without allocating.
+        /// </summary>
+        /// <param name="destination">The buffer to write to.</param>
+        /// <param name="index">The index in the buffer to start writing at.</param>
+        /// <param name="charsWritten">Returns the number of characters written, or zero on failure.</param>
+        /// <returns>False if the buffer was too small.</returns>
+        public bool TryFormat(char[] destination, int index, out int charsWritten)
+        {
+            int i = index;
+            bool success =
+                CharFormat.TryWrite(destination, ref i, "(Position: ") &&
+                CharFormat.TryWrite(destination, ref i, position) &&
+                CharFormat.TryWrite(destination, ref i, ", Rotation: ") &&
+                CharFormat.TryWrite(destination, ref i, rotation) &&
+                CharFormat.TryWrite(destination, ref i, ", Scale: ") &&
+                CharFormat.TryWrite(destination, ref i, scale, 2) &&
+                CharFormat.TryWrite(destination, ref i, ')');
+
+            charsWritten = success ? i - index : 0;
+            return success;
+        }
+
+        /// <summary>
+        /// Returns a <see cref="String"/> representation of this instance.
+        /// </summary>
+        public override string ToString()
+        {
+            return $"(Position: {position}, Rotation: {rotation}, Scale: {scale.ToString("F2")})";
+        }
+
+        /// <summary>
+        /// Combines two transforms.
+        /// </summary>
+        /// <param name="left">The transform applied first.</param>
+        /// <param name="right">The transform applied second.</param>
+        public static AffineTransform operator *(AffineTransform left, AffineTransform right) => Multiply(left, right);
+
+        public static bool operator ==(AffineTransform left, AffineTransform right) => left.Equals(right);
+        public static bool operator !=(AffineTransform left, AffineTransform right) => !left.Equals(right);
+
+        /// <summary>
+        /// Converts the transform to a <see cref="Matrix"/>.
+        /// </summary>
+        /// <param name="transform">The transform to convert.</param>
+        public static implicit operator Matrix(AffineTransform transform)
+        {
+            ToMatrix(ref transform, out Matrix result);
+            return result;
+        }
+    }
+}
@@ -13,7 +13,7 @@ namespace Engine
     /// </summary>
     [Serializable]
     [StructLayout(LayoutKind.Sequential, Pack = 1)]
-    public struct Color : IEquatable<Color>
+    public struct Color : IEquatable<Color>, ICharFormattable
     {
         /// <summary>
         /// Gets the color with RGBA of (0, 0, 0, 0).
@@ -447,6 +447,31 @@ namespace Engine
             return ToArgb();
         }
 
+        /// <summary>
+        /// Writes the text of <see cref="ToString"/>, formatted with the invariant culture, into a buffer without allocating.
+        /// </summary>
+        /// <param name="destination">The buffer to write to.</param>
+        /// <param name="index">The index in the buffer to start writing at.</param>
+        /// <param name="charsWritten">Returns the number of characters written, or zero on failure.</param>
+        /// <returns>False if the buffer was too small.</returns>
+        public bool TryFormat(char[] destination, int index, out int charsWritten)
+        {
+            int i = index;
+            bool success =
+                CharFormat.TryWrite(destination, ref i, '(') &&
+                CharFormat.TryWrite(destination, ref i, r, 2) &&
+                CharFormat.TryWrite(destination, ref i, ", ") &&
+                CharFormat.TryWrite(destination, ref i, g, 2) &&
+                CharFormat.TryWrite(destination, ref i, ", ") &&
+                CharFormat.TryWrite(destination, ref i, b, 2) &&
+                CharFormat.TryWrite(destination, ref i, ", ") &&
+                CharFormat.TryWrite(destination, ref i, a, 2) &&
+                CharFormat.TryWrite(destination, ref i, ')');
+
+            charsWritten = success ? i - index : 0;
+            return success;
+        }
+
         /// <summary>
         /// Returns a <see cref="String"/> representation of this instance.
         /// </summary>
@@ -0,0 +1,262 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Runtime.InteropServices;
+
+namespace Engine
+{
+    /// <summary>
+    /// Describes a signed Q16.16 fixed-point number.
+    /// </summary>
+    /// <remarks>
+    /// All arithmetic is done using integer instructions, so results are bit identical on every machine and
+    /// runtime, which floats can't guarantee. This makes it suitable for lockstep simulation and replays.
+    /// The range is [-32768, 32768) with a precision of 1/65536. Overflow wraps around silently, as in an
+    /// unchecked context. Conversions from floats are deterministic only if the float values are.
+    /// </remarks>
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct Fixed : IEquatable<Fixed>, IComparable<Fixed>, ICharFormattable
+    {
+        /// <summary>
+        /// The number of bits after the binary point.
+        /// </summary>
+        public const int FRACTIONAL_BITS = 16;
+
+        private const int ONE_RAW = 1 << FRACTIONAL_BITS;
+
+        /// <summary>
+        /// Returns the value 0.
+        /// </summary>
+        public static readonly Fixed Zero = FromRaw(0);
+
+        /// <summary>
+        /// Returns the value 1.
+        /// </summary>
+        public static readonly Fixed One = FromRaw(ONE_RAW);
+
+        /// <summary>
+        /// Returns the value 0.5.
+        /// </summary>
+        public static readonly Fixed Half = FromRaw(ONE_RAW / 2);
+
+        /// <summary>
+        /// Returns the smallest positive value.
+        /// </summary>
+        public static readonly Fixed Epsilon = FromRaw(1);
+
+        /// <summary>
+        /// Returns the largest value.
+        /// </summary>
+        public static readonly Fixed MaxValue = FromRaw(int.MaxValue);
+
+        /// <summary>
+        /// Returns the smallest value.
+        /// </summary>
+        public static readonly Fixed MinValue = FromRaw(int.MinValue);
+
+        /// <summary>
+        /// Returns the value of π.
+        /// </summary>
+        public static readonly Fixed Pi = FromRaw(205887);
+
+        /// <summary>
+        /// Returns the value of π/2.
+        /// </summary>
+        public static readonly Fixed PiOver2 = FromRaw(102944);
+
+        /// <summary>
+        /// Returns the value of 2π.
+        /// </summary>
+        public static readonly Fixed TwoPi = FromRaw(411775);
+
+        /// <summary>
+        /// The underlying value, scaled by 2^16.
+        /// </summary>
+        public int raw;
+
+        /// <summary>
+        /// Constructs a fixed-point number from an integer.
+        /// </summary>
+        /// <param name="value">The integer value.</param>
+        public Fixed(int value)
+        {
+            raw = value << FRACTIONAL_BITS;
+        }
+
+        /// <summary>
+        /// Constructs a fixed-point number from its underlying value.
+        /// </summary>
+        /// <param name="raw">The underlying value, scaled by 2^16.</param>
+        public static Fixed FromRaw(int raw)
+        {
+            Fixed result;
+            result.raw = raw;
+            return result;
+        }
+
+        /// <summary>
+        /// Gets the value as a <see cref="float"/>.
+        /// </summary>
+        public float ToFloat()
+        {
+            return raw * (1f / ONE_RAW);
+        }
+
+        /// <summary>
+        /// Compares whether this instance is equal to another.
+        /// </summary>
+        /// <param name="other">The instance to compare with.</param>
+        /// <returns><c>true</c> if the instances are equal, <c>false</c> otherwise.</returns>
+        public bool Equals(Fixed other)
+        {
+            return raw == other.raw;
+        }
+
+        /// <summary>
+        /// Compares this instance to another.
+        /// </summary>
+        /// <param name="other">The instance to compare with.</param>
+        public int CompareTo(Fixed other)
+        {
+            return raw.CompareTo(other.raw);
+        }
+
+        /// <summary>
+        /// Compares whether this instance is equal to specified <see cref="Object"/>.
+        /// </summary>
+        /// <param name="obj">The <see cref="Object"/> to compare.</param>
+        /// <returns><c>true</c> if the instances are equal, <c>false</c> otherwise.</returns>
+        public override bool Equals(object obj)
+        {
+            return (obj is Fixed) && Equals((Fixed)obj);
+        }
+
+        /// <summary>
+        /// Gets the hash code of this instance.
+        /// </summary>
+        public override int GetHashCode()
+        {
+            return raw;
+        }
+
+        /// <summary>
+        /// Writes the text of <see cref="ToString"/>, formatted with the invariant culture, into a buffer without allocating.
+        /// </summary>
+        /// <param name="destination">The buffer to write to.</param>
+        /// <param name="index">The index in the buffer to start writing at.</param>
+        /// <param name="charsWritten">Returns the number of characters written, or zero on failure.</param>
+        /// <returns>False if the buffer was too small.</returns>
+        public bool TryFormat(char[] destination, int index, out int charsWritten)
+        {
+            // the value is exact in decimal, so round the raw value to four places directly
+            long magnitude = Math.Abs((long)raw);
+            ulong digits = (ulong)(((magnitude * 10000) + (ONE_RAW / 2)) >> FRACTIONAL_BITS);
+
+            int i = index;
+            bool success = CharFormat.TryWriteDigits(destination, ref i, digits, 4, raw < 0 && digits != 0);
+
+            charsWritten = success ? i - index : 0;
+            return success;
+        }
+
+        /// <summary>
+        /// Returns a <see cref="String"/> representation of this instance.
+        /// </summary>
+        public override string ToString()
+        {
+            return ((double)raw / ONE_RAW).ToString("F4");
+        }
+
+        public static Fixed operator +(Fixed left, Fixed right)
+        {
+            left.raw += right.raw;
+            return left;
+        }
+
+        public static Fixed operator -(Fixed left, Fixed right)
+        {
+            left.raw -= right.raw;
+            return left;
+        }
+
+        public static Fixed operator -(Fixed value)
+        {
+            value.raw = -value.raw;
+            return value;
+        }
+
+        /// <summary>
+        /// Multiplies two numbers. The result is rounded towards negative infinity.
+        /// </summary>
+        /// <param name="left">Left operand.</param>
+        /// <param name="right">Right operand.</param>
+        public static Fixed operator *(Fixed left, Fixed right)
+        {
+            left.raw = (int)(((long)left.raw * right.raw) >> FRACTIONAL_BITS);
+            return left;
+        }
+
+        /// <summary>
+        /// Divides two numbers. The result is rounded towards zero.
+        /// </summary>
+        /// <param name="left">Left operand.</param>
+        /// <param name="right">Right operand.</param>
+        /// <exception cref="DivideByZeroException">Thrown if the divisor is zero.</exception>
+        public static Fixed operator /(Fixed left, Fixed right)
+        {
+            left.raw = (int)(((long)left.raw << FRACTIONAL_BITS) / right.raw);
+            return left;
+        }
+
+        public static Fixed operator %(Fixed left, Fixed right)
+        {
+            left.raw %= right.raw;
+            return left;
+        }
+
+        public static bool operator ==(Fixed left, Fixed right) => left.raw == right.raw;
+        public static bool operator !=(Fixed left, Fixed right) => left.raw != right.raw;
+        public static bool operator <(Fixed left, Fixed right) => left.raw < right.raw;
+        public static bool operator >(Fixed left, Fixed right) => left.raw > right.raw;
+        public static bool operator <=(Fixed left, Fixed right) => left.raw <= right.raw;
+        public static bool operator >=(Fixed left, Fixed right) => left.raw >= right.raw;
+
+        /// <summary>
+        /// Converts an integer to a fixed-point number.
+        /// </summary>
+        /// <param name="value">The value to convert.</param>
+        public static implicit operator Fixed(int value)
+        {
+            return new Fixed(value);
+        }
+
+        /// <summary>
+        /// Converts a float to the nearest fixed-point number.
+        /// </summary>
+        /// <param name="value">The value to convert.</param>
+        public static explicit operator Fixed(float value)
+        {
+            return FromRaw((int)Math.Round(value * (double)ONE_RAW));
+        }
+
+        /// <summary>
+        /// Converts a fixed-point number to a float.
+        /// </summary>
+        /// <param name="value">The value to convert.</param>
+        public static explicit operator float(Fixed value)
+        {
+            return value.raw * (1f / ONE_RAW);
+        }
+
+        /// <summary>
+        /// Converts a fixed-point number to an integer, rounding towards negative infinity.
+        /// </summary>
+        /// <param name="value">The value to convert.</param>
+        public static explicit operator int(Fixed value)
+        {
+            return value.raw >> FRACTIONAL_BITS;
+        }
+    }
+}
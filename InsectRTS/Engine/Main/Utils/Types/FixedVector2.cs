@@ -0,0 +1,326 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Runtime.InteropServices;
+
+namespace Engine
+{
+    /// <summary>
+    /// Describes a 2d vector with <see cref="Fixed"/> components, for use in deterministic simulation.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct FixedVector2 : IEquatable<FixedVector2>, ICharFormattable
+    {
+        /// <summary>
+        /// Returns a vector with components (0, 0).
+        /// </summary>
+        public static readonly FixedVector2 Zero = new FixedVector2(0, 0);
+
+        /// <summary>
+        /// Returns a vector with components (1, 1).
+        /// </summary>
+        public static readonly FixedVector2 One = new FixedVector2(1, 1);
+
+        /// <summary>
+        /// Returns a vector with components (1, 0).
+        /// </summary>
+        public static readonly FixedVector2 UnitX = new FixedVector2(1, 0);
+
+        /// <summary>
+        /// Returns a vector with components (0, 1).
+        /// </summary>
+        public static readonly FixedVector2 UnitY = new FixedVector2(0, 1);
+
+        /// <summary>
+        /// The x coordinate.
+        /// </summary>
+        public Fixed x;
+
+        /// <summary>
+        /// The y coordinate.
+        /// </summary>
+        public Fixed y;
+
+        /// <summary>
+        /// Constructs a 2d vector from two values.
+        /// </summary>
+        /// <param name="x">The x coordinate.</param>
+        /// <param name="y">The y coordinate.</param>
+        public FixedVector2(Fixed x, Fixed y)
+        {
+            this.x = x;
+            this.y = y;
+        }
+
+        /// <summary>
+        /// Gets the length of the vector.
+        /// </summary>
+        /// <remarks>
+        /// The squares are summed at double width, so this does not overflow for any vector whose length
+        /// is representable.
+        /// </remarks>
+        public Fixed Length => Fixed.FromRaw((int)FixedMath.SqrtRaw(RawLengthSquared(ref this)));
+
+        /// <summary>
+        /// Gets the squared length of the vector. This overflows for lengths larger than about 181.
+        /// </summary>
+        public Fixed LengthSquared => Dot(this, this);
+
+        /// <summary>
+        /// Gets a vector with the same direction and a length of one, or zero if this vector is zero.
+        /// </summary>
+        public FixedVector2 Normalized
+        {
+            get
+            {
+                Fixed length = Length;
+                if (length.raw == 0)
+                {
+                    return Zero;
+                }
+                return new FixedVector2(x / length, y / length);
+            }
+        }
+
+        /// <summary>
+        /// Calculates the dot product of two vectors.
+        /// </summary>
+        /// <param name="a">First operand.</param>
+        /// <param name="b">Second operand.</param>
+        public static Fixed Dot(FixedVector2 a, FixedVector2 b)
+        {
+            long sum = ((long)a.x.raw * b.x.raw) + ((long)a.y.raw * b.y.raw);
+            return Fixed.FromRaw((int)(sum >> Fixed.FRACTIONAL_BITS));
+        }
+
+        /// <summary>
+        /// Calculates the z component of the cross product of two vectors, treating them as 3d vectors on the xy plane.
+        /// </summary>
+        /// <param name="a">First operand.</param>
+        /// <param name="b">Second operand.</param>
+        public static Fixed Cross(FixedVector2 a, FixedVector2 b)
+        {
+            long cross = ((long)a.x.raw * b.y.raw) - ((long)a.y.raw * b.x.raw);
+            return Fixed.FromRaw((int)(cross >> Fixed.FRACTIONAL_BITS));
+        }
+
+        /// <summary>
+        /// Gets the distance between two points.
+        /// </summary>
+        /// <param name="a">The first point.</param>
+        /// <param name="b">The second point.</param>
+        public static Fixed Distance(FixedVector2 a, FixedVector2 b)
+        {
+            return (b - a).Length;
+        }
+
+        /// <summary>
+        /// Linearly interpolates between two vectors.
+        /// </summary>
+        /// <param name="a">The starting vector.</param>
+        /// <param name="b">The end vector.</param>
+        /// <param name="t">The blend factor.</param>
+        public static FixedVector2 Lerp(FixedVector2 a, FixedVector2 b, Fixed t)
+        {
+            return a + ((b - a) * t);
+        }
+
+        /// <summary>
+        /// Gets the squared length of a vector at double width.
+        /// </summary>
+        private static ulong RawLengthSquared(ref FixedVector2 v)
+        {
+            return
+                (ulong)((long)v.x.raw * v.x.raw) +
+                (ulong)((long)v.y.raw * v.y.raw);
+        }
+
+        /// <summary>
+        /// Converts the vector to a <see cref="Vector2"/> for rendering.
+        /// </summary>
+        public Vector2 ToVector2()
+        {
+            const float scale = 1f / (1 << Fixed.FRACTIONAL_BITS);
+            return new Vector2(x.raw * scale, y.raw * scale);
+        }
+
+        /// <summary>
+        /// Compares whether current instance is equal to specified <see cref="FixedVector2"/>.
+        /// </summary>
+        /// <param name="other">The <see cref="FixedVector2"/> to compare.</param>
+        /// <returns><c>true</c> if the instances are equal, <c>false</c> otherwise.</returns>
+        public bool Equals(FixedVector2 other)
+        {
+            return x == other.x && y == other.y;
+        }
+
+        /// <summary>
+        /// Compares whether current instance is equal to specified <see cref="Object"/>.
+        /// </summary>
+        /// <param name="obj">The <see cref="Object"/> to compare.</param>
+        /// <returns><c>true</c> if the instances are equal, <c>false</c> otherwise.</returns>
+        public override bool Equals(object obj)
+        {
+            return (obj is FixedVector2) && Equals((FixedVector2)obj);
+        }
+
+        /// <summary>
+        /// Gets the hash code of this instance.
+        /// </summary>
+        public override int GetHashCode()
+        {
+            unchecked
+            {
+                return (x.raw * 397) ^ y.raw;
+            }
+        }
+
+        /// <summary>
+        /// Writes the text of <see cref="ToString"/>, formatted with the invariant culture, into a buffer without allocating.
+        /// </summary>
+        /// <param name="destination">The buffer to write to.</param>
+        /// <param name="index">The index in the buffer to start writing at.</param>
+        /// <param name="charsWritten">Returns the number of characters written, or zero on failure.</param>
+        /// <returns>False if the buffer was too small.</returns>
+        public bool TryFormat(char[] destination, int index, out int charsWritten)
+        {
+            int i = index;
+            bool success =
+                CharFormat.TryWrite(destination, ref i, '(') &&
+                CharFormat.TryWrite(destination, ref i, x) &&
+                CharFormat.TryWrite(destination, ref i, ", ") &&
+                CharFormat.TryWrite(destination, ref i, y) &&
+                CharFormat.TryWrite(destination, ref i, ')');
+
+            charsWritten = success ? i - index : 0;
+            return success;
+        }
+
+        /// <summary>
+        /// Returns a <see cref="String"/> representation of this instance.
+        /// </summary>
+        public override string ToString()
+        {
+            return $"({x}, {y})";
+        }
+
+        /// <summary>
+        /// Adds the specified vectors.
+        /// </summary>
+        /// <param name="left">Left operand.</param>
+        /// <param name="right">Right operand.</param>
+        /// <returns>Sum of the vectors.</returns>
+        public static FixedVector2 operator +(FixedVector2 left, FixedVector2 right)
+        {
+            left.x += right.x;
+            left.y += right.y;
+            return left;
+        }
+
+        /// <summary>
+        /// Subtracts the specified vectors.
+        /// </summary>
+        /// <param name="left">Left operand.</param>
+        /// <param name="right">Right operand.</param>
+        /// <returns>Result of the vector subtraction.</returns>
+        public static FixedVector2 operator -(FixedVector2 left, FixedVector2 right)
+        {
+            left.x -= right.x;
+            left.y -= right.y;
+            return left;
+        }
+
+        /// <summary>
+        /// Negates the specified vector.
+        /// </summary>
+        /// <param name="vector">Operand.</param>
+        /// <returns>Result of the negation.</returns>
+        public static FixedVector2 operator -(FixedVector2 vector)
+        {
+            vector.x = -vector.x;
+            vector.y = -vector.y;
+            return vector;
+        }
+
+        /// <summary>
+        /// Multiplies the components of vector by a scalar.
+        /// </summary>
+        /// <param name="vector">Left operand.</param>
+        /// <param name="scale">Right operand.</param>
+        /// <returns>Result of the vector multiplication with a scalar.</returns>
+        public static FixedVector2 operator *(FixedVector2 vector, Fixed scale)
+        {
+            vector.x *= scale;
+            vector.y *= scale;
+            return vector;
+        }
+
+        /// <summary>
+        /// Multiplies the components of vector by a scalar.
+        /// </summary>
+        /// <param name="scale">Left operand.</param>
+        /// <param name="vector">Right operand.</param>
+        /// <returns>Result of the vector multiplication with a scalar.</returns>
+        public static FixedVector2 operator *(Fixed scale, FixedVector2 vector)
+        {
+            vector.x *= scale;
+            vector.y *= scale;
+            return vector;
+        }
+
+        /// <summary>
+        /// Divides the components of a vector by a scalar.
+        /// </summary>
+        /// <param name="vector">Left operand.</param>
+        /// <param name="divider">Right operand.</param>
+        /// <returns>The result of dividing a vector by a scalar.</returns>
+        public static FixedVector2 operator /(FixedVector2 vector, Fixed divider)
+        {
+            vector.x /= divider;
+            vector.y /= divider;
+            return vector;
+        }
+
+        /// <summary>
+        /// Compares whether two vectors are equal.
+        /// </summary>
+        /// <param name="left">Left operand.</param>
+        /// <param name="right">Right operand.</param>
+        /// <returns><c>true</c> if the instances are equal, <c>false</c> otherwise.</returns>
+        public static bool operator ==(FixedVector2 left, FixedVector2 right)
+        {
+            return left.Equals(right);
+        }
+
+        /// <summary>
+        /// Compares whether two vectors are not equal.
+        /// </summary>
+        /// <param name="left">Left operand.</param>
+        /// <param name="right">Right operand.</param>
+        /// <returns><c>true</c> if the instances are not equal, <c>false</c> otherwise.</returns>
+        public static bool operator !=(FixedVector2 left, FixedVector2 right)
+        {
+            return !left.Equals(right);
+        }
+
+        /// <summary>
+        /// Converts the vector to a <see cref="Vector2"/>.
+        /// </summary>
+        /// <param name="vector">The vector to convert.</param>
+        public static explicit operator Vector2(FixedVector2 vector)
+        {
+            return vector.ToVector2();
+        }
+
+        /// <summary>
+        /// Converts a <see cref="Vector2"/> to the nearest fixed-point vector.
+        /// </summary>
+        /// <param name="vector">The vector to convert.</param>
+        public static explicit operator FixedVector2(Vector2 vector)
+        {
+            return new FixedVector2((Fixed)vector.x, (Fixed)vector.y);
+        }
+    }
+}
@@ -0,0 +1,353 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Runtime.InteropServices;
+
+namespace Engine
+{
+    /// <summary>
+    /// Describes a 3d vector with <see cref="Fixed"/> components, for use in deterministic simulation.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct FixedVector3 : IEquatable<FixedVector3>, ICharFormattable
+    {
+        /// <summary>
+        /// Returns a vector with components (0, 0, 0).
+        /// </summary>
+        public static readonly FixedVector3 Zero = new FixedVector3(0, 0, 0);
+
+        /// <summary>
+        /// Returns a vector with components (1, 1, 1).
+        /// </summary>
+        public static readonly FixedVector3 One = new FixedVector3(1, 1, 1);
+
+        /// <summary>
+        /// Returns a vector with components (1, 0, 0).
+        /// </summary>
+        public static readonly FixedVector3 UnitX = new FixedVector3(1, 0, 0);
+
+        /// <summary>
+        /// Returns a vector with components (0, 1, 0).
+        /// </summary>
+        public static readonly FixedVector3 UnitY = new FixedVector3(0, 1, 0);
+
+        /// <summary>
+        /// Returns a vector with components (0, 0, 1).
+        /// </summary>
+        public static readonly FixedVector3 UnitZ = new FixedVector3(0, 0, 1);
+
+        /// <summary>
+        /// The x coordinate.
+        /// </summary>
+        public Fixed x;
+
+        /// <summary>
+        /// The y coordinate.
+        /// </summary>
+        public Fixed y;
+
+        /// <summary>
+        /// The z coordinate.
+        /// </summary>
+        public Fixed z;
+
+        /// <summary>
+        /// Constructs a 3d vector from three values.
+        /// </summary>
+        /// <param name="x">The x coordinate.</param>
+        /// <param name="y">The y coordinate.</param>
+        /// <param name="z">The z coordinate.</param>
+        public FixedVector3(Fixed x, Fixed y, Fixed z)
+        {
+            this.x = x;
+            this.y = y;
+            this.z = z;
+        }
+
+        /// <summary>
+        /// Gets the length of the vector.
+        /// </summary>
+        /// <remarks>
+        /// The squares are summed at double width, so this does not overflow for any vector whose length
+        /// is representable.
+        /// </remarks>
+        public Fixed Length => Fixed.FromRaw((int)FixedMath.SqrtRaw(RawLengthSquared(ref this)));
+
+        /// <summary>
+        /// Gets the squared length of the vector. This overflows for lengths larger than about 181.
+        /// </summary>
+        public Fixed LengthSquared => Dot(this, this);
+
+        /// <summary>
+        /// Gets a vector with the same direction and a length of one, or zero if this vector is zero.
+        /// </summary>
+        public FixedVector3 Normalized
+        {
+            get
+            {
+                Fixed length = Length;
+                if (length.raw == 0)
+                {
+                    return Zero;
+                }
+                return new FixedVector3(x / length, y / length, z / length);
+            }
+        }
+
+        /// <summary>
+        /// Calculates the dot product of two vectors.
+        /// </summary>
+        /// <param name="a">First operand.</param>
+        /// <param name="b">Second operand.</param>
+        public static Fixed Dot(FixedVector3 a, FixedVector3 b)
+        {
+            long sum = ((long)a.x.raw * b.x.raw) + ((long)a.y.raw * b.y.raw) + ((long)a.z.raw * b.z.raw);
+            return Fixed.FromRaw((int)(sum >> Fixed.FRACTIONAL_BITS));
+        }
+
+        /// <summary>
+        /// Calculates the cross product of two vectors.
+        /// </summary>
+        /// <param name="a">First operand.</param>
+        /// <param name="b">Second operand.</param>
+        public static FixedVector3 Cross(FixedVector3 a, FixedVector3 b)
+        {
+            return new FixedVector3(
+                (a.y * b.z) - (a.z * b.y),
+                (a.z * b.x) - (a.x * b.z),
+                (a.x * b.y) - (a.y * b.x)
+            );
+        }
+
+        /// <summary>
+        /// Gets the distance between two points.
+        /// </summary>
+        /// <param name="a">The first point.</param>
+        /// <param name="b">The second point.</param>
+        public static Fixed Distance(FixedVector3 a, FixedVector3 b)
+        {
+            return (b - a).Length;
+        }
+
+        /// <summary>
+        /// Linearly interpolates between two vectors.
+        /// </summary>
+        /// <param name="a">The starting vector.</param>
+        /// <param name="b">The end vector.</param>
+        /// <param name="t">The blend factor.</param>
+        public static FixedVector3 Lerp(FixedVector3 a, FixedVector3 b, Fixed t)
+        {
+            return a + ((b - a) * t);
+        }
+
+        /// <summary>
+        /// Gets the squared length of a vector at double width.
+        /// </summary>
+        private static ulong RawLengthSquared(ref FixedVector3 v)
+        {
+            return
+                (ulong)((long)v.x.raw * v.x.raw) +
+                (ulong)((long)v.y.raw * v.y.raw) +
+                (ulong)((long)v.z.raw * v.z.raw);
+        }
+
+        /// <summary>
+        /// Converts the vector to a <see cref="Vector3"/> for rendering.
+        /// </summary>
+        public Vector3 ToVector3()
+        {
+            const float scale = 1f / (1 << Fixed.FRACTIONAL_BITS);
+            return new Vector3(x.raw * scale, y.raw * scale, z.raw * scale);
+        }
+
+        /// <summary>
+        /// Compares whether current instance is equal to specified <see cref="FixedVector3"/>.
+        /// </summary>
+        /// <param name="other">The <see cref="FixedVector3"/> to compare.</param>
+        /// <returns><c>true</c> if the instances are equal, <c>false</c> otherwise.</returns>
+        public bool Equals(FixedVector3 other)
+        {
+            return x == other.x && y == other.y && z == other.z;
+        }
+
+        /// <summary>
+        /// Compares whether current instance is equal to specified <see cref="Object"/>.
+        /// </summary>
+        /// <param name="obj">The <see cref="Object"/> to compare.</param>
+        /// <returns><c>true</c> if the instances are equal, <c>false</c> otherwise.</returns>
+        public override bool Equals(object obj)
+        {
+            return (obj is FixedVector3) && Equals((FixedVector3)obj);
+        }
+
+        /// <summary>
+        /// Gets the hash code of this instance.
+        /// </summary>
+        public override int GetHashCode()
+        {
+            unchecked
+            {
+                int hashCode = x.raw;
+                hashCode = (hashCode * 397) ^ y.raw;
+                hashCode = (hashCode * 397) ^ z.raw;
+                return hashCode;
+            }
+        }
+
+        /// <summary>
+        /// Writes the text of <see cref="ToString"/>, formatted with the invariant culture, into a buffer without allocating.
+        /// </summary>
+        /// <param name="destination">The buffer to write to.</param>
+        /// <param name="index">The index in the buffer to start writing at.</param>
+        /// <param name="charsWritten">Returns the number of characters written, or zero on failure.</param>
+        /// <returns>False if the buffer was too small.</returns>
+        public bool TryFormat(char[] destination, int index, out int charsWritten)
+        {
+            int i = index;
+            bool success =
+                CharFormat.TryWrite(destination, ref i, '(') &&
+                CharFormat.TryWrite(destination, ref i, x) &&
+                CharFormat.TryWrite(destination, ref i, ", ") &&
+                CharFormat.TryWrite(destination, ref i, y) &&
+                CharFormat.TryWrite(destination, ref i, ", ") &&
+                CharFormat.TryWrite(destination, ref i, z) &&
+                CharFormat.TryWrite(destination, ref i, ')');
+
+            charsWritten = success ? i - index : 0;
+            return success;
+        }
+
+        /// <summary>
+        /// Returns a <see cref="String"/> representation of this instance.
+        /// </summary>
+        public override string ToString()
+        {
+            return $"({x}, {y}, {z})";
+        }
+
+        /// <summary>
+        /// Adds the specified vectors.
+        /// </summary>
+        /// <param name="left">Left operand.</param>
+        /// <param name="right">Right operand.</param>
+        /// <returns>Sum of the vectors.</returns>
+        public static FixedVector3 operator +(FixedVector3 left, FixedVector3 right)
+        {
+            left.x += right.x;
+            left.y += right.y;
+            left.z += right.z;
+            return left;
+        }
+
+        /// <summary>
+        /// Subtracts the specified vectors.
+        /// </summary>
+        /// <param name="left">Left operand.</param>
+        /// <param name="right">Right operand.</param>
+        /// <returns>Result of the vector subtraction.</returns>
+        public static FixedVector3 operator -(FixedVector3 left, FixedVector3 right)
+        {
+            left.x -= right.x;
+            left.y -= right.y;
+            left.z -= right.z;
+            return left;
+        }
+
+        /// <summary>
+        /// Negates the specified vector.
+        /// </summary>
+        /// <param name="vector">Operand.</param>
+        /// <returns>Result of the negation.</returns>
+        public static FixedVector3 operator -(FixedVector3 vector)
+        {
+            vector.x = -vector.x;
+            vector.y = -vector.y;
+            vector.z = -vector.z;
+            return vector;
+        }
+
+        /// <summary>
+        /// Multiplies the components of vector by a scalar.
+        /// </summary>
+        /// <param name="vector">Left operand.</param>
+        /// <param name="scale">Right operand.</param>
+        /// <returns>Result of the vector multiplication with a scalar.</returns>
+        public static FixedVector3 operator *(FixedVector3 vector, Fixed scale)
+        {
+            vector.x *= scale;
+            vector.y *= scale;
+            vector.z *= scale;
+            return vector;
+        }
+
+        /// <summary>
+        /// Multiplies the components of vector by a scalar.
+        /// </summary>
+        /// <param name="scale">Left operand.</param>
+        /// <param name="vector">Right operand.</param>
+        /// <returns>Result of the vector multiplication with a scalar.</returns>
+        public static FixedVector3 operator *(Fixed scale, FixedVector3 vector)
+        {
+            vector.x *= scale;
+            vector.y *= scale;
+            vector.z *= scale;
+            return vector;
+        }
+
+        /// <summary>
+        /// Divides the components of a vector by a scalar.
+        /// </summary>
+        /// <param name="vector">Left operand.</param>
+        /// <param name="divider">Right operand.</param>
+        /// <returns>The result of dividing a vector by a scalar.</returns>
+        public static FixedVector3 operator /(FixedVector3 vector, Fixed divider)
+        {
+            vector.x /= divider;
+            vector.y /= divider;
+            vector.z /= divider;
+            return vector;
+        }
+
+        /// <summary>
+        /// Compares whether two vectors are equal.
+        /// </summary>
+        /// <param name="left">Left operand.</param>
+        /// <param name="right">Right operand.</param>
+        /// <returns><c>true</c> if the instances are equal, <c>false</c> otherwise.</returns>
+        public static bool operator ==(FixedVector3 left, FixedVector3 right)
+        {
+            return left.Equals(right);
+        }
+
+        /// <summary>
+        /// Compares whether two vectors are not equal.
+        /// </summary>
+        /// <param name="left">Left operand.</param>
+        /// <param name="right">Right operand.</param>
+        /// <returns><c>true</c> if the instances are not equal, <c>false</c> otherwise.</returns>
+        public static bool operator !=(FixedVector3 left, FixedVector3 right)
+        {
+            return !left.Equals(right);
+        }
+
+        /// <summary>
+        /// Converts the vector to a <see cref="Vector3"/>.
+        /// </summary>
+        /// <param name="vector">The vector to convert.</param>
+        public static explicit operator Vector3(FixedVector3 vector)
+        {
+            return vector.ToVector3();
+        }
+
+        /// <summary>
+        /// Converts a <see cref="Vector3"/> to the nearest fixed-point vector.
+        /// </summary>
+        /// <param name="vector">The vector to convert.</param>
+        public static explicit operator FixedVector3(Vector3 vector)
+        {
+            return new FixedVector3((Fixed)vector.x, (Fixed)vector.y, (Fixed)vector.z);
+        }
+    }
+}
@@ -12,7 +12,7 @@ namespace Engine
     /// Represents the right-handed 4x4 floating point matrix, which can store translation, scale and rotation information.
     /// </summary>
     [StructLayout(LayoutKind.Sequential, Pack = 1)]
-    public struct Matrix : IEquatable<Matrix>
+    public struct Matrix : IEquatable<Matrix>, ICharFormattable
     {
         /// <summary>
         /// Returns the zero matrix.
@@ -704,22 +704,185 @@ namespace Engine
         /// <param name="result">Result of the matrix multiplication as an output parameter.</param>
         public static void Multiply(ref Matrix left, ref Matrix right, out Matrix result)
         {
-            result.m00 = (left.m00 * right.m00) + (left.m01 * right.m10) + (left.m02 * right.m20) + (left.m03 * right.m30);
-            result.m01 = (left.m00 * right.m01) + (left.m01 * right.m11) + (left.m02 * right.m21) + (left.m03 * right.m31);
-            result.m02 = (left.m00 * right.m02) + (left.m01 * right.m12) + (left.m02 * right.m22) + (left.m03 * right.m32);
-            result.m03 = (left.m00 * right.m03) + (left.m01 * right.m13) + (left.m02 * right.m23) + (left.m03 * right.m33);
-            result.m10 = (left.m10 * right.m00) + (left.m11 * right.m10) + (left.m12 * right.m20) + (left.m13 * right.m30);
-            result.m11 = (left.m10 * right.m01) + (left.m11 * right.m11) + (left.m12 * right.m21) + (left.m13 * right.m31);
-            result.m12 = (left.m10 * right.m02) + (left.m11 * right.m12) + (left.m12 * right.m22) + (left.m13 * right.m32);
-            result.m13 = (left.m10 * right.m03) + (left.m11 * right.m13) + (left.m12 * right.m23) + (left.m13 * right.m33);
-            result.m20 = (left.m20 * right.m00) + (left.m21 * right.m10) + (left.m22 * right.m20) + (left.m23 * right.m30);
-            result.m21 = (left.m20 * right.m01) + (left.m21 * right.m11) + (left.m22 * right.m21) + (left.m23 * right.m31);
-            result.m22 = (left.m20 * right.m02) + (left.m21 * right.m12) + (left.m22 * right.m22) + (left.m23 * right.m32);
-            result.m23 = (left.m20 * right.m03) + (left.m21 * right.m13) + (left.m22 * right.m23) + (left.m23 * right.m33);
-            result.m30 = (left.m30 * right.m00) + (left.m31 * right.m10) + (left.m32 * right.m20) + (left.m33 * right.m30);
-            result.m31 = (left.m30 * right.m01) + (left.m31 * right.m11) + (left.m32 * right.m21) + (left.m33 * right.m31);
-            result.m32 = (left.m30 * right.m02) + (left.m31 * right.m12) + (left.m32 * right.m22) + (left.m33 * right.m32);
-            result.m33 = (left.m30 * right.m03) + (left.m31 * right.m13) + (left.m32 * right.m23) + (left.m33 * right.m33);
+            if (Simd.IsAccelerated)
+            {
+                Simd.Multiply(ref left, ref right, out result);
+                return;
+            }
+
+            // compute into a copy, as the result may be one of the operands
+            Matrix product;
+            product.m00 = (left.m00 * right.m00) + (left.m01 * right.m10) + (left.m02 * right.m20) + (left.m03 * right.m30);
+            product.m01 = (left.m00 * right.m01) + (left.m01 * right.m11) + (left.m02 * right.m21) + (left.m03 * right.m31);
+            product.m02 = (left.m00 * right.m02) + (left.m01 * right.m12) + (left.m02 * right.m22) + (left.m03 * right.m32);
+            product.m03 = (left.m00 * right.m03) + (left.m01 * right.m13) + (left.m02 * right.m23) + (left.m03 * right.m33);
+            product.m10 = (left.m10 * right.m00) + (left.m11 * right.m10) + (left.m12 * right.m20) + (left.m13 * right.m30);
+            product.m11 = (left.m10 * right.m01) + (left.m11 * right.m11) + (left.m12 * right.m21) + (left.m13 * right.m31);
+            product.m12 = (left.m10 * right.m02) + (left.m11 * right.m12) + (left.m12 * right.m22) + (left.m13 * right.m32);
+            product.m13 = (left.m10 * right.m03) + (left.m11 * right.m13) + (left.m12 * right.m23) + (left.m13 * right.m33);
+            product.m20 = (left.m20 * right.m00) + (left.m21 * right.m10) + (left.m22 * right.m20) + (left.m23 * right.m30);
+            product.m21 = (left.m20 * right.m01) + (left.m21 * right.m11) + (left.m22 * right.m21) + (left.m23 * right.m31);
+            product.m22 = (left.m20 * right.m02) + (left.m21 * right.m12) + (left.m22 * right.m22) + (left.m23 * right.m32);
+            product.m23 = (left.m20 * right.m03) + (left.m21 * right.m13) + (left.m22 * right.m23) + (left.m23 * right.m33);
+            product.m30 = (left.m30 * right.m00) + (left.m31 * right.m10) + (left.m32 * right.m20) + (left.m33 * right.m30);
+            product.m31 = (left.m30 * right.m01) + (left.m31 * right.m11) + (left.m32 * right.m21) + (left.m33 * right.m31);
+            product.m32 = (left.m30 * right.m02) + (left.m31 * right.m12) + (left.m32 * right.m22) + (left.m33 * right.m32);
+            product.m33 = (left.m30 * right.m03) + (left.m31 * right.m13) + (left.m32 * right.m23) + (left.m33 * right.m33);
+            result = product;
+        }
+
+        /// <summary>
+        /// Multiplies the matrices at each index in two arrays and places the results in an another array.
+        /// </summary>
+        /// <remarks>
+        /// The destination range may be the same as the source range to update the matrices in place. When hardware
+        /// acceleration is available a vectorized kernel is used, which gives bit identical results to the scalar
+        /// path in a 64-bit process, and is otherwise within 2 units in the last place per component.
+        /// </remarks>
+        /// <param name="leftArray">The left operands.</param>
+        /// <param name="rightArray">The right operands.</param>
+        /// <param name="destArray">The array the products are output to.</param>
+        public static void Multiply(Matrix[] leftArray, Matrix[] rightArray, Matrix[] destArray)
+        {
+            if (leftArray == null)
+            {
+                throw new ArgumentNullException("leftArray");
+            }
+            if (rightArray == null)
+            {
+                throw new ArgumentNullException("rightArray");
+            }
+            if (rightArray.Length < leftArray.Length)
+            {
+                throw new ArgumentException("Right array is smaller than left array.");
+            }
+
+            Multiply(leftArray, 0, rightArray, 0, destArray, 0, leftArray.Length);
+        }
+
+        /// <summary>
+        /// Multiplies the matrices at each index in two arrays and places the results in an another array.
+        /// </summary>
+        /// <remarks>
+        /// The destination range may be the same as the source range to update the matrices in place. When hardware
+        /// acceleration is available a vectorized kernel is used, which gives bit identical results to the scalar
+        /// path in a 64-bit process, and is otherwise within 2 units in the last place per component.
+        /// </remarks>
+        /// <param name="leftArray">The left operands.</param>
+        /// <param name="leftIndex">The starting index in the left array.</param>
+        /// <param name="rightArray">The right operands.</param>
+        /// <param name="rightIndex">The starting index in the right array.</param>
+        /// <param name="destArray">The array the products are output to.</param>
+        /// <param name="destIndex">The starting index in the destination array.</param>
+        /// <param name="length">The number of matrices to multiply.</param>
+        public static void Multiply(Matrix[] leftArray, int leftIndex, Matrix[] rightArray, int rightIndex, Matrix[] destArray, int destIndex, int length)
+        {
+            if (leftArray == null)
+            {
+                throw new ArgumentNullException("leftArray");
+            }
+            if (rightArray == null)
+            {
+                throw new ArgumentNullException("rightArray");
+            }
+            if (destArray == null)
+            {
+                throw new ArgumentNullException("destArray");
+            }
+            if (leftArray.Length < leftIndex + length)
+            {
+                throw new ArgumentException("Left array length is lesser than leftIndex + length");
+            }
+            if (rightArray.Length < rightIndex + length)
+            {
+                throw new ArgumentException("Right array length is lesser than rightIndex + length");
+            }
+            if (destArray.Length < destIndex + length)
+            {
+                throw new ArgumentException("Destination array length is lesser than destIndex + length");
+            }
+
+            if (Simd.IsAccelerated)
+            {
+                Simd.Multiply(leftArray, leftIndex, rightArray, rightIndex, destArray, destIndex, length);
+            }
+            else
+            {
+                for (int i = 0; i < length; i++)
+                {
+                    Multiply(ref leftArray[leftIndex + i], ref rightArray[rightIndex + i], out Matrix result);
+                    destArray[destIndex + i] = result;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Multiplies all matrices within an array by a matrix and places the results in an another array.
+        /// </summary>
+        /// <remarks>
+        /// The destination range may be the same as the source range to update the matrices in place. When hardware
+        /// acceleration is available a vectorized kernel is used, which gives bit identical results to the scalar
+        /// path in a 64-bit process, and is otherwise within 2 units in the last place per component.
+        /// </remarks>
+        /// <param name="srcArray">The left operands.</param>
+        /// <param name="matrix">The right operand.</param>
+        /// <param name="destArray">The array the products are output to.</param>
+        public static void Multiply(Matrix[] srcArray, ref Matrix matrix, Matrix[] destArray)
+        {
+            if (srcArray == null)
+            {
+                throw new ArgumentNullException("srcArray");
+            }
+
+            Multiply(srcArray, 0, ref matrix, destArray, 0, srcArray.Length);
+        }
+
+        /// <summary>
+        /// Multiplies all matrices within an array by a matrix and places the results in an another array.
+        /// </summary>
+        /// <remarks>
+        /// The destination range may be the same as the source range to update the matrices in place. When hardware
+        /// acceleration is available a vectorized kernel is used, which gives bit identical results to the scalar
+        /// path in a 64-bit process, and is otherwise within 2 units in the last place per component.
+        /// </remarks>
+        /// <param name="srcArray">The left operands.</param>
+        /// <param name="srcIndex">The starting index in the source array.</param>
+        /// <param name="matrix">The right operand.</param>
+        /// <param name="destArray">The array the products are output to.</param>
+        /// <param name="destIndex">The starting index in the destination array.</param>
+        /// <param name="length">The number of matrices to multiply.</param>
+        public static void Multiply(Matrix[] srcArray, int srcIndex, ref Matrix matrix, Matrix[] destArray, int destIndex, int length)
+        {
+            if (srcArray == null)
+            {
+                throw new ArgumentNullException("srcArray");
+            }
+            if (destArray == null)
+            {
+                throw new ArgumentNullException("destArray");
+            }
+            if (srcArray.Length < srcIndex + length)
+            {
+                throw new ArgumentException("Source array length is lesser than srcIndex + length");
+            }
+            if (destArray.Length < destIndex + length)
+            {
+                throw new ArgumentException("Destination array length is lesser than destIndex + length");
+            }
+
+            if (Simd.IsAccelerated)
+            {
+                Simd.Multiply(srcArray, srcIndex, ref matrix, destArray, destIndex, length);
+            }
+            else
+            {
+                Matrix right = matrix;
+                for (int i = 0; i < length; i++)
+                {
+                    Multiply(ref srcArray[srcIndex + i], ref right, out Matrix result);
+                    destArray[destIndex + i] = result;
+                }
+            }
         }
 
         /// <summary>
@@ -930,6 +1093,12 @@ namespace Engine
         /// <param name="result">The inverted matrix as output parameter.</param>
         public static void Invert(ref Matrix matrix, out Matrix result)
         {
+            if (Simd.IsAccelerated)
+            {
+                Simd.Invert(ref matrix, out result);
+                return;
+            }
+
             float num1 = matrix.m00;
             float num2 = matrix.m01;
             float num3 = matrix.m02;
@@ -989,6 +1158,69 @@ namespace Engine
             result.m33 = (num1 * num36 - num2 * num38 + num3 * num39) * num27;
         }
 
+        /// <summary>
+        /// Creates a new matrix which contains inversion of the specified affine matrix. 
+        /// </summary>
+        /// <remarks>
+        /// This is cheaper than <see cref="Invert(Matrix)"/>, but is only valid if the last column of the matrix
+        /// is (0, 0, 0, 1), as it is for any combination of translation, rotation and scale.
+        /// </remarks>
+        /// <param name="matrix">The matrix to invert.</param>
+        public static Matrix InvertAffine(Matrix matrix)
+        {
+            InvertAffine(ref matrix, out Matrix result);
+            return result;
+        }
+
+        /// <summary>
+        /// Creates a new matrix which contains inversion of the specified affine matrix. 
+        /// </summary>
+        /// <remarks>
+        /// This is cheaper than <see cref="Invert(ref Matrix, out Matrix)"/>, but is only valid if the last column
+        /// of the matrix is (0, 0, 0, 1), as it is for any combination of translation, rotation and scale.
+        /// </remarks>
+        /// <param name="matrix">The matrix to invert.</param>
+        /// <param name="result">The inverted matrix as output parameter.</param>
+        public static void InvertAffine(ref Matrix matrix, out Matrix result)
+        {
+            if (Simd.IsAccelerated)
+            {
+                Simd.InvertAffine(ref matrix, out result);
+                return;
+            }
+
+            float a00 = matrix.m00, a01 = matrix.m01, a02 = matrix.m02;
+            float a10 = matrix.m10, a11 = matrix.m11, a12 = matrix.m12;
+            float a20 = matrix.m20, a21 = matrix.m21, a22 = matrix.m22;
+            float t0 = matrix.m30, t1 = matrix.m31, t2 = matrix.m32;
+
+            float b00 = a11 * a22 - a12 * a21;
+            float b10 = a12 * a20 - a10 * a22;
+            float b20 = a10 * a21 - a11 * a20;
+
+            float invDet = 1f / (a00 * b00 + a01 * b10 + a02 * b20);
+
+            result.m00 = b00 * invDet;
+            result.m01 = (a21 * a02 - a22 * a01) * invDet;
+            result.m02 = (a01 * a12 - a02 * a11) * invDet;
+            result.m03 = 0f;
+
+            result.m10 = b10 * invDet;
+            result.m11 = (a22 * a00 - a20 * a02) * invDet;
+            result.m12 = (a02 * a10 - a00 * a12) * invDet;
+            result.m13 = 0f;
+
+            result.m20 = b20 * invDet;
+            result.m21 = (a20 * a01 - a21 * a00) * invDet;
+            result.m22 = (a00 * a11 - a01 * a10) * invDet;
+            result.m23 = 0f;
+
+            result.m30 = -((t0 * result.m00) + (t1 * result.m10) + (t2 * result.m20));
+            result.m31 = -((t0 * result.m01) + (t1 * result.m11) + (t2 * result.m21));
+            result.m32 = -((t0 * result.m02) + (t1 * result.m12) + (t2 * result.m22));
+            result.m33 = 1f;
+        }
+
         /// <summary>
         /// Creates a new matrix which contains inversion of the specified matrix with greater precision.
         /// </summary>
@@ -1261,6 +1493,39 @@ namespace Engine
             result.m33 = 1f;
         }
 
+        /// <summary>
+        /// Creates rotation matrices from all quaternions within an array and places them in an another array.
+        /// </summary>
+        /// <param name="srcArray">The rotations to convert.</param>
+        /// <param name="destArray">The array the rotation matrices are output to.</param>
+        public static void CreateFromQuaternion(Quaternion[] srcArray, Matrix[] destArray)
+        {
+            if (srcArray == null)
+            {
+                throw new ArgumentNullException("srcArray");
+            }
+            if (destArray == null)
+            {
+                throw new ArgumentNullException("destArray");
+            }
+            if (destArray.Length < srcArray.Length)
+            {
+                throw new ArgumentException("Destination array is smaller than source array.");
+            }
+
+            if (Simd.IsAccelerated)
+            {
+                Simd.CreateFromQuaternion(srcArray, destArray, srcArray.Length);
+            }
+            else
+            {
+                for (int i = 0; i < srcArray.Length; i++)
+                {
+                    CreateFromQuaternion(ref srcArray[i], out destArray[i]);
+                }
+            }
+        }
+
         /// <summary>
         /// Creates a new projection matrix for an orthographic view.
         /// </summary>
@@ -1807,6 +2072,30 @@ namespace Engine
             }
         }
 
+        /// <summary>
+        /// Writes the text of <see cref="ToString"/>, formatted with the invariant culture, into a buffer without allocating.
+        /// </summary>
+        /// <param name="destination">The buffer to write to.</param>
+        /// <param name="index">The index in the buffer to start writing at.</param>
+        /// <param name="charsWritten">Returns the number of characters written, or zero on failure.</param>
+        /// <returns>False if the buffer was too small.</returns>
+        public bool TryFormat(char[] destination, int index, out int charsWritten)
+        {
+            int i = index;
+            bool success =
+                CharFormat.TryWrite(destination, ref i, '\n') &&
+                CharFormat.TryWrite(destination, ref i, Row0) &&
+                CharFormat.TryWrite(destination, ref i, '\n') &&
+                CharFormat.TryWrite(destination, ref i, Row1) &&
+                CharFormat.TryWrite(destination, ref i, '\n') &&
+                CharFormat.TryWrite(destination, ref i, Row2) &&
+                CharFormat.TryWrite(destination, ref i, '\n') &&
+                CharFormat.TryWrite(destination, ref i, Row3);
+
+            charsWritten = success ? i - index : 0;
+            return success;
+        }
+
         /// <summary>
         /// Returns a <see cref="String"/> representation of this instance.
         /// </summary>
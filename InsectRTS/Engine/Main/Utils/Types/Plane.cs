@@ -8,7 +8,7 @@ using System.Runtime.InteropServices;
 namespace Engine
 {
     [StructLayout(LayoutKind.Sequential, Pack = 1)]
-    public struct Plane : IEquatable<Plane>
+    public struct Plane : IEquatable<Plane>, ICharFormattable
     {
         /// <summary>
         /// The distance of the plane from the origin.
@@ -233,6 +233,27 @@ namespace Engine
             }
         }
 
+        /// <summary>
+        /// Writes the text of <see cref="ToString"/>, formatted with the invariant culture, into a buffer without allocating.
+        /// </summary>
+        /// <param name="destination">The buffer to write to.</param>
+        /// <param name="index">The index in the buffer to start writing at.</param>
+        /// <param name="charsWritten">Returns the number of characters written, or zero on failure.</param>
+        /// <returns>False if the buffer was too small.</returns>
+        public bool TryFormat(char[] destination, int index, out int charsWritten)
+        {
+            int i = index;
+            bool success =
+                CharFormat.TryWrite(destination, ref i, "{normal:") &&
+                CharFormat.TryWrite(destination, ref i, normal) &&
+                CharFormat.TryWrite(destination, ref i, " distance:") &&
+                CharFormat.TryWrite(destination, ref i, distance) &&
+                CharFormat.TryWrite(destination, ref i, '}');
+
+            charsWritten = success ? i - index : 0;
+            return success;
+        }
+
         /// <summary>
         /// Returns a <see cref="String"/> representation of this instance.
         /// </summary>
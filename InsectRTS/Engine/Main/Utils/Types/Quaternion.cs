@@ -3,6 +3,7 @@
 * See "Licence.txt" for full licence.
 */
 using System;
+using System.Numerics;
 using System.Runtime.InteropServices;
 
 namespace Engine
@@ -11,10 +12,22 @@ namespace Engine
     /// An efficient mathematical representation for three dimensional rotations.
     /// </summary>
     [StructLayout(LayoutKind.Sequential, Pack = 1)]
-    public struct Quaternion : IEquatable<Quaternion>
+    public struct Quaternion : IEquatable<Quaternion>, ICharFormattable
     {
         public static readonly Quaternion Identity = new Quaternion(0f, 0f, 0f, 1f);
 
+        /// <summary>
+        /// The largest angle in radians (about 0.045 degrees) of the rotation between the result of
+        /// <see cref="SlerpFast(Quaternion, Quaternion, float)"/> and the exact slerp.
+        /// </summary>
+        /// <remarks>
+        /// Measured against a double precision slerp over 200k random pairs and a sweep of the angle between
+        /// the pairs and the blend amount; the worst case is near opposite rotations. The angle is 2 atan2(|v|, |w|)
+        /// of the difference quaternion, computed in double. Measuring it as 2 acos(|dot|) instead adds up to
+        /// 6e-4 radians of float rounding noise, as acos is poorly conditioned near 1.
+        /// </remarks>
+        public const float SlerpFastMaxError = 8e-4f;
+
         /// <summary>
         /// The x coordinate.
         /// </summary>
@@ -589,6 +602,240 @@ namespace Engine
             }
         }
 
+        /// <summary>
+        /// Performs an approximate spherical linear blend between two quaternions.
+        /// </summary>
+        /// <remarks>
+        /// This corrects the blend factor of a normalized linear blend using a polynomial fit to the slerp curve,
+        /// avoiding all trigonometric functions. The result differs from the exact slerp by up to <see cref="SlerpFastMaxError"/>
+        /// radians, which is suitable for distant or low detail animation.
+        /// </remarks>
+        /// <param name="a">The quaternion to interpolate from.</param>
+        /// <param name="b">The quaternion to interpolate to.</param>
+        /// <param name="t">The blend amount where 0 returns <paramref name="a"/> and 1 <paramref name="b"/>.</param>
+        public static Quaternion SlerpFast(Quaternion a, Quaternion b, float t)
+        {
+            SlerpFast(ref a, ref b, t, out a);
+            return a;
+        }
+
+        /// <summary>
+        /// Performs an approximate spherical linear blend between two quaternions.
+        /// </summary>
+        /// <remarks>
+        /// This corrects the blend factor of a normalized linear blend using a polynomial fit to the slerp curve,
+        /// avoiding all trigonometric functions. The result differs from the exact slerp by up to <see cref="SlerpFastMaxError"/>
+        /// radians, which is suitable for distant or low detail animation.
+        /// </remarks>
+        /// <param name="a">The quaternion to interpolate from.</param>
+        /// <param name="b">The quaternion to interpolate to.</param>
+        /// <param name="t">The blend amount where 0 returns <paramref name="a"/> and 1 <paramref name="b"/>.</param>
+        /// <param name="result">The result of the blend as an output parameter.</param>
+        public static void SlerpFast(ref Quaternion a, ref Quaternion b, float t, out Quaternion result)
+        {
+            Dot(ref a, ref b, out float cosHalfAngle);
+            Lerp(ref a, ref b, SlerpFastBlend(Math.Abs(cosHalfAngle), t), out result);
+        }
+
+        /// <summary>
+        /// Computes the blend factor to use for a normalized linear blend such that it approximates a spherical blend.
+        /// </summary>
+        /// <remarks>
+        /// See https://zeux.io/2015/07/23/approximating-slerp/ for the derivation of the coefficients.
+        /// </remarks>
+        /// <param name="cosHalfAngle">The absolute value of the dot product of the quaternions being blended.</param>
+        /// <param name="t">The desired spherical blend amount.</param>
+        internal static float SlerpFastBlend(float cosHalfAngle, float t)
+        {
+            float d = cosHalfAngle;
+            float a = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+            float b = 0.848013f + d * (-1.06021f + d * 0.215638f);
+            float k = a * (t - 0.5f) * (t - 0.5f) + b;
+            return t + t * (t - 0.5f) * (t - 1f) * k;
+        }
+
+        /// <summary>
+        /// Computes <see cref="SlerpFastBlend(float, float)"/> for each component of a vector, evaluated in the
+        /// same order so that the results are identical.
+        /// </summary>
+        internal static Vector<float> SlerpFastBlend(Vector<float> cosHalfAngle, Vector<float> t)
+        {
+            Vector<float> d = cosHalfAngle;
+            Vector<float> half = new Vector<float>(0.5f);
+            Vector<float> a = new Vector<float>(1.0904f) + d * (new Vector<float>(-3.2452f) + d * (new Vector<float>(3.55645f) - d * new Vector<float>(1.43519f)));
+            Vector<float> b = new Vector<float>(0.848013f) + d * (new Vector<float>(-1.06021f) + d * new Vector<float>(0.215638f));
+            Vector<float> k = a * (t - half) * (t - half) + b;
+            return t + t * (t - half) * (t - Vector<float>.One) * k;
+        }
+
+        /// <summary>
+        /// Performs a linear blend between the quaternions at each index in two arrays.
+        /// </summary>
+        /// <param name="aArray">The quaternions to interpolate from.</param>
+        /// <param name="bArray">The quaternions to interpolate to.</param>
+        /// <param name="tArray">The blend amount for each pair of quaternions.</param>
+        /// <param name="destArray">The array the blended quaternions are output to.</param>
+        public static void Lerp(Quaternion[] aArray, Quaternion[] bArray, float[] tArray, Quaternion[] destArray)
+        {
+            ValidateBlendArrays(aArray, bArray, tArray, destArray);
+            Blend(aArray, bArray, tArray, 0f, destArray, false);
+        }
+
+        /// <summary>
+        /// Performs a linear blend between the quaternions at each index in two arrays.
+        /// </summary>
+        /// <param name="aArray">The quaternions to interpolate from.</param>
+        /// <param name="bArray">The quaternions to interpolate to.</param>
+        /// <param name="t">The blend amount used for all quaternions.</param>
+        /// <param name="destArray">The array the blended quaternions are output to.</param>
+        public static void Lerp(Quaternion[] aArray, Quaternion[] bArray, float t, Quaternion[] destArray)
+        {
+            ValidateBlendArrays(aArray, bArray, null, destArray);
+            Blend(aArray, bArray, null, t, destArray, false);
+        }
+
+        /// <summary>
+        /// Performs a spherical linear blend between the quaternions at each index in two arrays.
+        /// </summary>
+        /// <remarks>
+        /// When hardware acceleration is available a vectorized kernel is used, which computes the trigonometric
+        /// functions using <see cref="MathfFast"/> and is within <see cref="Simd.SlerpMaxError"/> per component.
+        /// </remarks>
+        /// <param name="aArray">The quaternions to interpolate from.</param>
+        /// <param name="bArray">The quaternions to interpolate to.</param>
+        /// <param name="tArray">The blend amount for each pair of quaternions.</param>
+        /// <param name="destArray">The array the blended quaternions are output to.</param>
+        public static void Slerp(Quaternion[] aArray, Quaternion[] bArray, float[] tArray, Quaternion[] destArray)
+        {
+            ValidateBlendArrays(aArray, bArray, tArray, destArray);
+
+            if (Simd.IsAccelerated)
+            {
+                Simd.Slerp(aArray, bArray, tArray, 0f, destArray, aArray.Length);
+            }
+            else
+            {
+                for (int i = 0; i < aArray.Length; i++)
+                {
+                    Slerp(ref aArray[i], ref bArray[i], tArray[i], out destArray[i]);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Performs a spherical linear blend between the quaternions at each index in two arrays.
+        /// </summary>
+        /// <remarks>
+        /// When hardware acceleration is available a vectorized kernel is used, which computes the trigonometric
+        /// functions using <see cref="MathfFast"/> and is within <see cref="Simd.SlerpMaxError"/> per component.
+        /// </remarks>
+        /// <param name="aArray">The quaternions to interpolate from.</param>
+        /// <param name="bArray">The quaternions to interpolate to.</param>
+        /// <param name="t">The blend amount used for all quaternions.</param>
+        /// <param name="destArray">The array the blended quaternions are output to.</param>
+        public static void Slerp(Quaternion[] aArray, Quaternion[] bArray, float t, Quaternion[] destArray)
+        {
+            ValidateBlendArrays(aArray, bArray, null, destArray);
+
+            if (Simd.IsAccelerated)
+            {
+                Simd.Slerp(aArray, bArray, null, t, destArray, aArray.Length);
+            }
+            else
+            {
+                for (int i = 0; i < aArray.Length; i++)
+                {
+                    Slerp(ref aArray[i], ref bArray[i], t, out destArray[i]);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Performs an approximate spherical linear blend between the quaternions at each index in two arrays.
+        /// See <see cref="SlerpFast(Quaternion, Quaternion, float)"/> for the error bounds.
+        /// </summary>
+        /// <param name="aArray">The quaternions to interpolate from.</param>
+        /// <param name="bArray">The quaternions to interpolate to.</param>
+        /// <param name="tArray">The blend amount for each pair of quaternions.</param>
+        /// <param name="destArray">The array the blended quaternions are output to.</param>
+        public static void SlerpFast(Quaternion[] aArray, Quaternion[] bArray, float[] tArray, Quaternion[] destArray)
+        {
+            ValidateBlendArrays(aArray, bArray, tArray, destArray);
+            Blend(aArray, bArray, tArray, 0f, destArray, true);
+        }
+
+        /// <summary>
+        /// Performs an approximate spherical linear blend between the quaternions at each index in two arrays.
+        /// See <see cref="SlerpFast(Quaternion, Quaternion, float)"/> for the error bounds.
+        /// </summary>
+        /// <param name="aArray">The quaternions to interpolate from.</param>
+        /// <param name="bArray">The quaternions to interpolate to.</param>
+        /// <param name="t">The blend amount used for all quaternions.</param>
+        /// <param name="destArray">The array the blended quaternions are output to.</param>
+        public static void SlerpFast(Quaternion[] aArray, Quaternion[] bArray, float t, Quaternion[] destArray)
+        {
+            ValidateBlendArrays(aArray, bArray, null, destArray);
+            Blend(aArray, bArray, null, t, destArray, true);
+        }
+
+        /// <summary>
+        /// Blends arrays of quaternions using the vectorized kernel if possible.
+        /// </summary>
+        private static void Blend(Quaternion[] aArray, Quaternion[] bArray, float[] tArray, float t, Quaternion[] destArray, bool approximateSlerp)
+        {
+            if (Simd.IsAccelerated)
+            {
+                Simd.Blend(aArray, bArray, tArray, t, destArray, aArray.Length, approximateSlerp);
+            }
+            else
+            {
+                for (int i = 0; i < aArray.Length; i++)
+                {
+                    float blend = tArray != null ? tArray[i] : t;
+
+                    if (approximateSlerp)
+                    {
+                        SlerpFast(ref aArray[i], ref bArray[i], blend, out destArray[i]);
+                    }
+                    else
+                    {
+                        Lerp(ref aArray[i], ref bArray[i], blend, out destArray[i]);
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Throws an exception if the arrays used for a batch blend are invalid.
+        /// </summary>
+        private static void ValidateBlendArrays(Quaternion[] aArray, Quaternion[] bArray, float[] tArray, Quaternion[] destArray)
+        {
+            if (aArray == null)
+            {
+                throw new ArgumentNullException("aArray");
+            }
+            if (bArray == null)
+            {
+                throw new ArgumentNullException("bArray");
+            }
+            if (destArray == null)
+            {
+                throw new ArgumentNullException("destArray");
+            }
+            if (bArray.Length < aArray.Length)
+            {
+                throw new ArgumentException("B array is smaller than a array.");
+            }
+            if (tArray != null && tArray.Length < aArray.Length)
+            {
+                throw new ArgumentException("T array is smaller than a array.");
+            }
+            if (destArray.Length < aArray.Length)
+            {
+                throw new ArgumentException("Destination array is smaller than a array.");
+            }
+        }
+
         /// <summary>
         /// Rotates a towards b up to some amount.
         /// </summary>
@@ -659,6 +906,31 @@ namespace Engine
             }
         }
 
+        /// <summary>
+        /// Writes the text of <see cref="ToString"/>, formatted with the invariant culture, into a buffer without allocating.
+        /// </summary>
+        /// <param name="destination">The buffer to write to.</param>
+        /// <param name="index">The index in the buffer to start writing at.</param>
+        /// <param name="charsWritten">Returns the number of characters written, or zero on failure.</param>
+        /// <returns>False if the buffer was too small.</returns>
+        public bool TryFormat(char[] destination, int index, out int charsWritten)
+        {
+            int i = index;
+            bool success =
+                CharFormat.TryWrite(destination, ref i, '(') &&
+                CharFormat.TryWrite(destination, ref i, x, 4) &&
+                CharFormat.TryWrite(destination, ref i, ", ") &&
+                CharFormat.TryWrite(destination, ref i, y, 4) &&
+                CharFormat.TryWrite(destination, ref i, ", ") &&
+                CharFormat.TryWrite(destination, ref i, z, 4) &&
+                CharFormat.TryWrite(destination, ref i, ", ") &&
+                CharFormat.TryWrite(destination, ref i, w, 4) &&
+                CharFormat.TryWrite(destination, ref i, ')');
+
+            charsWritten = success ? i - index : 0;
+            return success;
+        }
+
         /// <summary>
         /// Returns a <see cref="String"/> representation of this instance.
         /// </summary>
@@ -11,7 +11,7 @@ namespace Engine
     /// Describes a ray in 3d space.
     /// </summary>
     [StructLayout(LayoutKind.Sequential, Pack = 1)]
-    public struct Ray : IEquatable<Ray>
+    public struct Ray : IEquatable<Ray>, ICharFormattable
     {
         /// <summary>
         /// The origin of the ray.
@@ -249,6 +249,27 @@ namespace Engine
             }
         }
 
+        /// <summary>
+        /// Writes the text of <see cref="ToString"/>, formatted with the invariant culture, into a buffer without allocating.
+        /// </summary>
+        /// <param name="destination">The buffer to write to.</param>
+        /// <param name="index">The index in the buffer to start writing at.</param>
+        /// <param name="charsWritten">Returns the number of characters written, or zero on failure.</param>
+        /// <returns>False if the buffer was too small.</returns>
+        public bool TryFormat(char[] destination, int index, out int charsWritten)
+        {
+            int i = index;
+            bool success =
+                CharFormat.TryWrite(destination, ref i, "{origin:") &&
+                CharFormat.TryWrite(destination, ref i, origin) &&
+                CharFormat.TryWrite(destination, ref i, " direction:") &&
+                CharFormat.TryWrite(destination, ref i, direction) &&
+                CharFormat.TryWrite(destination, ref i, '}');
+
+            charsWritten = success ? i - index : 0;
+            return success;
+        }
+
         /// <summary>
         /// Returns a <see cref="String"/> representation of this instance.
         /// </summary>
@@ -13,7 +13,7 @@ namespace Engine
     /// Describes a 2d rectangle.
     /// </summary>
     [StructLayout(LayoutKind.Sequential, Pack = 1)]
-    public struct Rect : IEquatable<Rect>
+    public struct Rect : IEquatable<Rect>, ICharFormattable
     {
         /// <summary>
         /// The rect at (0, 0) with size (0, 0).
@@ -456,6 +456,31 @@ namespace Engine
             }
         }
 
+        /// <summary>
+        /// Writes the text of <see cref="ToString"/>, formatted with the invariant culture, into a buffer without allocating.
+        /// </summary>
+        /// <param name="destination">The buffer to write to.</param>
+        /// <param name="index">The index in the buffer to start writing at.</param>
+        /// <param name="charsWritten">Returns the number of characters written, or zero on failure.</param>
+        /// <returns>False if the buffer was too small.</returns>
+        public bool TryFormat(char[] destination, int index, out int charsWritten)
+        {
+            int i = index;
+            bool success =
+                CharFormat.TryWrite(destination, ref i, '(') &&
+                CharFormat.TryWrite(destination, ref i, x) &&
+                CharFormat.TryWrite(destination, ref i, ", ") &&
+                CharFormat.TryWrite(destination, ref i, y) &&
+                CharFormat.TryWrite(destination, ref i, ", ") &&
+                CharFormat.TryWrite(destination, ref i, width) &&
+                CharFormat.TryWrite(destination, ref i, ", ") &&
+                CharFormat.TryWrite(destination, ref i, height) &&
+                CharFormat.TryWrite(destination, ref i, ')');
+
+            charsWritten = success ? i - index : 0;
+            return success;
+        }
+
         /// <summary>
         /// Returns a <see cref="String"/> representation of this instance.
         /// </summary>
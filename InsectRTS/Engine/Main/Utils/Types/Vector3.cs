@@ -12,7 +12,7 @@ namespace Engine
     /// Describes a 3d vector.
     /// </summary>
     [StructLayout(LayoutKind.Sequential, Pack = 1)]
-    public struct Vector3 : IEquatable<Vector3>
+    public struct Vector3 : IEquatable<Vector3>, ICharFormattable
     {
         /// <summary>
         /// Returns a vector with components (0, 0, 0).
@@ -1092,6 +1092,49 @@ namespace Engine
             }
         }
 
+        /// <summary>
+        /// Rotates each vector within an array by the rotation at the same index in another array
+        /// and places the results in an another array.
+        /// </summary>
+        /// <param name="srcArray">The vectors to transform.</param>
+        /// <param name="rotations">The rotations to apply.</param>
+        /// <param name="destArray">The array transformed vectors are output to.</param>
+        public static void Rotate(Vector3[] srcArray, Quaternion[] rotations, Vector3[] destArray)
+        {
+            if (srcArray == null)
+            {
+                throw new ArgumentNullException("srcArray");
+            }
+            if (rotations == null)
+            {
+                throw new ArgumentNullException("rotations");
+            }
+            if (destArray == null)
+            {
+                throw new ArgumentNullException("destArray");
+            }
+            if (rotations.Length < srcArray.Length)
+            {
+                throw new ArgumentException("Rotation array is smaller than source array.");
+            }
+            if (destArray.Length < srcArray.Length)
+            {
+                throw new ArgumentException("Destination array is smaller than source array.");
+            }
+
+            if (Simd.IsAccelerated)
+            {
+                Simd.Rotate(srcArray, rotations, destArray, srcArray.Length);
+            }
+            else
+            {
+                for (int i = 0; i < srcArray.Length; i++)
+                {
+                    Rotate(ref srcArray[i], ref rotations[i], out destArray[i]);
+                }
+            }
+        }
+
         /// <summary>
         /// Transform a position.
         /// </summary>
@@ -1110,14 +1153,24 @@ namespace Engine
         /// <param name="matrix">The transformation to apply.</param>
         public static void TransformPosition(ref Vector3 position, ref Matrix matrix, out Vector3 result)
         {
-            result.x = (position.x * matrix.m00) + (position.y * matrix.m10) + (position.z * matrix.m20) + matrix.m30;
-            result.y = (position.x * matrix.m01) + (position.y * matrix.m11) + (position.z * matrix.m21) + matrix.m31;
-            result.z = (position.x * matrix.m02) + (position.y * matrix.m12) + (position.z * matrix.m22) + matrix.m32;
+            // read the position first, as the result may be the same vector
+            float x = position.x;
+            float y = position.y;
+            float z = position.z;
+
+            result.x = (x * matrix.m00) + (y * matrix.m10) + (z * matrix.m20) + matrix.m30;
+            result.y = (x * matrix.m01) + (y * matrix.m11) + (z * matrix.m21) + matrix.m31;
+            result.z = (x * matrix.m02) + (y * matrix.m12) + (z * matrix.m22) + matrix.m32;
         }
 
         /// <summary>
         /// Applies a transformation to all vectors within array and places the resuls in an another array.
         /// </summary>
+        /// <remarks>
+        /// The destination range may be the same as the source range to update the vectors in place. When hardware
+        /// acceleration is available a vectorized kernel is used, which gives bit identical results to the scalar
+        /// path in a 64-bit process, and is otherwise within 2 units in the last place per component.
+        /// </remarks>
         /// <param name="srcArray">The vectors to transform.</param>
         /// <param name="matrix">The transformation to apply.</param>
         /// <param name="destArray">The array transformed vectors are output to.</param>
@@ -1136,15 +1189,27 @@ namespace Engine
                 throw new ArgumentException("Destination array is smaller than source array.");
             }
 
-            for (int i = 0; i < srcArray.Length; i++)
+            if (Simd.IsAccelerated)
             {
-                TransformPosition(ref srcArray[i], ref matrix, out destArray[i]);
+                Simd.TransformPosition(srcArray, 0, ref matrix, destArray, 0, srcArray.Length);
+            }
+            else
+            {
+                for (int i = 0; i < srcArray.Length; i++)
+                {
+                    TransformPosition(ref srcArray[i], ref matrix, out destArray[i]);
+                }
             }
         }
 
         /// <summary>
         /// Applies a transformation to all vectors within array and places the results in an another array.
         /// </summary>
+        /// <remarks>
+        /// The destination range may be the same as the source range to update the vectors in place. When hardware
+        /// acceleration is available a vectorized kernel is used, which gives bit identical results to the scalar
+        /// path in a 64-bit process, and is otherwise within 2 units in the last place per component.
+        /// </remarks>
         /// <param name="srcArray">The vectors to transform.</param>
         /// <param name="srcIndex">The starting index in the source array.</param>
         /// <param name="matrix">The transformation to apply.</param>
@@ -1170,9 +1235,16 @@ namespace Engine
                 throw new ArgumentException("Destination array length is lesser than destinationIndex + length");
             }
 
-            for (int i = 0; i < length; i++)
+            if (Simd.IsAccelerated)
+            {
+                Simd.TransformPosition(srcArray, srcIndex, ref matrix, destArray, destIndex, length);
+            }
+            else
             {
-                TransformPosition(ref srcArray[srcIndex + i], ref matrix, out destArray[destIndex + i]);
+                for (int i = 0; i < length; i++)
+                {
+                    TransformPosition(ref srcArray[srcIndex + i], ref matrix, out destArray[destIndex + i]);
+                }
             }
         }
 
@@ -1195,14 +1267,24 @@ namespace Engine
         /// <param name="result">The transformed vector as an output parameter.</param>
         public static void TransformDirection(ref Vector3 direction, ref Matrix matrix, out Vector3 result)
         {
-            result.x = (direction.x * matrix.m00) + (direction.y * matrix.m10) + (direction.z * matrix.m20);
-            result.y = (direction.x * matrix.m01) + (direction.y * matrix.m11) + (direction.z * matrix.m21);
-            result.z = (direction.x * matrix.m02) + (direction.y * matrix.m12) + (direction.z * matrix.m22);
+            // read the direction first, as the result may be the same vector
+            float x = direction.x;
+            float y = direction.y;
+            float z = direction.z;
+
+            result.x = (x * matrix.m00) + (y * matrix.m10) + (z * matrix.m20);
+            result.y = (x * matrix.m01) + (y * matrix.m11) + (z * matrix.m21);
+            result.z = (x * matrix.m02) + (y * matrix.m12) + (z * matrix.m22);
         }
 
         /// <summary>
         /// Applies a transformation to all vectors within array and places the results in an another array.
         /// </summary>
+        /// <remarks>
+        /// The destination range may be the same as the source range to update the vectors in place. When hardware
+        /// acceleration is available a vectorized kernel is used, which gives bit identical results to the scalar
+        /// path in a 64-bit process, and is otherwise within 2 units in the last place per component.
+        /// </remarks>
         /// <param name="srcArray">The vectors to transform.</param>
         /// <param name="matrix">The transformation to apply.</param>
         /// <param name="destArray">The array transformed vectors are output to.</param>
@@ -1221,15 +1303,27 @@ namespace Engine
                 throw new ArgumentException("Destination array is smaller than source array.");
             }
 
-            for (int i = 0; i < srcArray.Length; i++)
+            if (Simd.IsAccelerated)
             {
-                TransformDirection(ref srcArray[i], ref matrix, out destArray[i]);
+                Simd.TransformDirection(srcArray, 0, ref matrix, destArray, 0, srcArray.Length);
+            }
+            else
+            {
+                for (int i = 0; i < srcArray.Length; i++)
+                {
+                    TransformDirection(ref srcArray[i], ref matrix, out destArray[i]);
+                }
             }
         }
 
         /// <summary>
         /// Applies a transformation to all vectors within array and places the results in an another array.
         /// </summary>
+        /// <remarks>
+        /// The destination range may be the same as the source range to update the vectors in place. When hardware
+        /// acceleration is available a vectorized kernel is used, which gives bit identical results to the scalar
+        /// path in a 64-bit process, and is otherwise within 2 units in the last place per component.
+        /// </remarks>
         /// <param name="srcArray">The vectors to transform.</param>
         /// <param name="srcIndex">The starting index in the source array.</param>
         /// <param name="matrix">The transformation to apply.</param>
@@ -1255,9 +1349,16 @@ namespace Engine
                 throw new ArgumentException("Destination array length is lesser than destinationIndex + length");
             }
 
-            for (int i = 0; i < length; i++)
+            if (Simd.IsAccelerated)
             {
-                TransformDirection(ref srcArray[srcIndex + i], ref matrix, out destArray[destIndex + i]);
+                Simd.TransformDirection(srcArray, srcIndex, ref matrix, destArray, destIndex, length);
+            }
+            else
+            {
+                for (int i = 0; i < length; i++)
+                {
+                    TransformDirection(ref srcArray[srcIndex + i], ref matrix, out destArray[destIndex + i]);
+                }
             }
         }
 
@@ -1608,6 +1709,29 @@ namespace Engine
             }
         }
 
+        /// <summary>
+        /// Writes the text of <see cref="ToString"/>, formatted with the invariant culture, into a buffer without allocating.
+        /// </summary>
+        /// <param name="destination">The buffer to write to.</param>
+        /// <param name="index">The index in the buffer to start writing at.</param>
+        /// <param name="charsWritten">Returns the number of characters written, or zero on failure.</param>
+        /// <returns>False if the buffer was too small.</returns>
+        public bool TryFormat(char[] destination, int index, out int charsWritten)
+        {
+            int i = index;
+            bool success =
+                CharFormat.TryWrite(destination, ref i, '(') &&
+                CharFormat.TryWrite(destination, ref i, x, 2) &&
+                CharFormat.TryWrite(destination, ref i, ", ") &&
+                CharFormat.TryWrite(destination, ref i, y, 2) &&
+                CharFormat.TryWrite(destination, ref i, ", ") &&
+                CharFormat.TryWrite(destination, ref i, z, 2) &&
+                CharFormat.TryWrite(destination, ref i, ')');
+
+            charsWritten = success ? i - index : 0;
+            return success;
+        }
+
         /// <summary>
         /// Returns a <see cref="String"/> representation of this instance.
         /// </summary>
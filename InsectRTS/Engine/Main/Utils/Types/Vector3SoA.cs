@@ -0,0 +1,581 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Numerics;
+
+namespace Engine
+{
+    /// <summary>
+    /// Stores a set of 3d vectors as separate arrays of x, y and z coordinates, allowing operations
+    /// over large numbers of vectors to be vectorized.
+    /// </summary>
+    /// <remarks>
+    /// The coordinate arrays are padded to a multiple of the SIMD register width, so the kernels
+    /// never need a scalar remainder loop when writing to another <see cref="Vector3SoA"/>. Values
+    /// stored in the padding are undefined.
+    /// </remarks>
+    public class Vector3SoA
+    {
+        /// <summary>
+        /// The number of floats processed by each vector instruction.
+        /// </summary>
+        public static readonly int LANE_WIDTH = Vector<float>.Count;
+
+        private readonly float[] m_x;
+        private readonly float[] m_y;
+        private readonly float[] m_z;
+        private readonly int m_count;
+
+        /// <summary>
+        /// The number of vectors in the set.
+        /// </summary>
+        public int Count => m_count;
+
+        /// <summary>
+        /// The length of the coordinate arrays, including padding.
+        /// </summary>
+        public int Capacity => m_x.Length;
+
+        /// <summary>
+        /// The x coordinates.
+        /// </summary>
+        public float[] X => m_x;
+
+        /// <summary>
+        /// The y coordinates.
+        /// </summary>
+        public float[] Y => m_y;
+
+        /// <summary>
+        /// The z coordinates.
+        /// </summary>
+        public float[] Z => m_z;
+
+        /// <summary>
+        /// Creates a new set of vectors with all coordinates set to zero.
+        /// </summary>
+        /// <param name="count">The number of vectors in the set.</param>
+        public Vector3SoA(int count)
+        {
+            if (count < 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(count), count, "Must be non-negative!");
+            }
+
+            int capacity = ((count + LANE_WIDTH - 1) / LANE_WIDTH) * LANE_WIDTH;
+
+            m_x = new float[capacity];
+            m_y = new float[capacity];
+            m_z = new float[capacity];
+            m_count = count;
+        }
+
+        /// <summary>
+        /// Creates a new set of vectors copied from an array.
+        /// </summary>
+        /// <param name="values">The vectors to copy.</param>
+        public Vector3SoA(Vector3[] values) : this(values.Length)
+        {
+            CopyFrom(values, 0, 0, values.Length);
+        }
+
+        /// <summary>
+        /// Gets or sets a vector in the set.
+        /// </summary>
+        /// <param name="index">The index of the vector.</param>
+        public Vector3 this[int index]
+        {
+            get
+            {
+                ValidateIndex(index);
+                return new Vector3(m_x[index], m_y[index], m_z[index]);
+            }
+            set
+            {
+                ValidateIndex(index);
+                m_x[index] = value.x;
+                m_y[index] = value.y;
+                m_z[index] = value.z;
+            }
+        }
+
+        /// <summary>
+        /// Copies vectors from an array into this set.
+        /// </summary>
+        /// <param name="srcArray">The array to copy from.</param>
+        /// <param name="srcIndex">The starting index in the source array.</param>
+        /// <param name="destIndex">The starting index in this set.</param>
+        /// <param name="length">The number of vectors to copy.</param>
+        public void CopyFrom(Vector3[] srcArray, int srcIndex, int destIndex, int length)
+        {
+            if (srcArray == null)
+            {
+                throw new ArgumentNullException("srcArray");
+            }
+            if (srcArray.Length < srcIndex + length)
+            {
+                throw new ArgumentException("Source array length is lesser than srcIndex + length");
+            }
+            if (m_count < destIndex + length)
+            {
+                throw new ArgumentException("Count is lesser than destIndex + length");
+            }
+
+            for (int i = 0; i < length; i++)
+            {
+                Vector3 v = srcArray[srcIndex + i];
+                m_x[destIndex + i] = v.x;
+                m_y[destIndex + i] = v.y;
+                m_z[destIndex + i] = v.z;
+            }
+        }
+
+        /// <summary>
+        /// Copies vectors from this set into an array, such as a vertex array used by the renderer.
+        /// </summary>
+        /// <remarks>
+        /// The layouts differ so a copy is unavoidable, but no memory is allocated.
+        /// </remarks>
+        /// <param name="srcIndex">The starting index in this set.</param>
+        /// <param name="destArray">The array to copy into.</param>
+        /// <param name="destIndex">The starting index in the destination array.</param>
+        /// <param name="length">The number of vectors to copy.</param>
+        public void CopyTo(int srcIndex, Vector3[] destArray, int destIndex, int length)
+        {
+            if (destArray == null)
+            {
+                throw new ArgumentNullException("destArray");
+            }
+            if (m_count < srcIndex + length)
+            {
+                throw new ArgumentException("Count is lesser than srcIndex + length");
+            }
+            if (destArray.Length < destIndex + length)
+            {
+                throw new ArgumentException("Destination array length is lesser than destIndex + length");
+            }
+
+            for (int i = 0; i < length; i++)
+            {
+                destArray[destIndex + i] = new Vector3(m_x[srcIndex + i], m_y[srcIndex + i], m_z[srcIndex + i]);
+            }
+        }
+
+        /// <summary>
+        /// Copies all vectors from this set into an array.
+        /// </summary>
+        /// <param name="destArray">The array to copy into.</param>
+        public void CopyTo(Vector3[] destArray)
+        {
+            CopyTo(0, destArray, 0, m_count);
+        }
+
+        /// <summary>
+        /// Adds the vectors in two sets.
+        /// </summary>
+        /// <param name="a">The first set.</param>
+        /// <param name="b">The second set.</param>
+        /// <param name="result">The set to store the sums in. May be one of the operands.</param>
+        public static void Add(Vector3SoA a, Vector3SoA b, Vector3SoA result)
+        {
+            ValidateCount(a, b);
+            ValidateCount(a, result);
+
+            int length = a.Capacity;
+
+            if (Simd.IsAccelerated)
+            {
+                for (int i = 0; i < length; i += LANE_WIDTH)
+                {
+                    (new Vector<float>(a.m_x, i) + new Vector<float>(b.m_x, i)).CopyTo(result.m_x, i);
+                    (new Vector<float>(a.m_y, i) + new Vector<float>(b.m_y, i)).CopyTo(result.m_y, i);
+                    (new Vector<float>(a.m_z, i) + new Vector<float>(b.m_z, i)).CopyTo(result.m_z, i);
+                }
+            }
+            else
+            {
+                for (int i = 0; i < length; i++)
+                {
+                    result.m_x[i] = a.m_x[i] + b.m_x[i];
+                    result.m_y[i] = a.m_y[i] + b.m_y[i];
+                    result.m_z[i] = a.m_z[i] + b.m_z[i];
+                }
+            }
+        }
+
+        /// <summary>
+        /// Subtracts the vectors in one set from the vectors in another.
+        /// </summary>
+        /// <param name="a">The set to subtract from.</param>
+        /// <param name="b">The set to subtract.</param>
+        /// <param name="result">The set to store the differences in. May be one of the operands.</param>
+        public static void Subtract(Vector3SoA a, Vector3SoA b, Vector3SoA result)
+        {
+            ValidateCount(a, b);
+            ValidateCount(a, result);
+
+            int length = a.Capacity;
+
+            if (Simd.IsAccelerated)
+            {
+                for (int i = 0; i < length; i += LANE_WIDTH)
+                {
+                    (new Vector<float>(a.m_x, i) - new Vector<float>(b.m_x, i)).CopyTo(result.m_x, i);
+                    (new Vector<float>(a.m_y, i) - new Vector<float>(b.m_y, i)).CopyTo(result.m_y, i);
+                    (new Vector<float>(a.m_z, i) - new Vector<float>(b.m_z, i)).CopyTo(result.m_z, i);
+                }
+            }
+            else
+            {
+                for (int i = 0; i < length; i++)
+                {
+                    result.m_x[i] = a.m_x[i] - b.m_x[i];
+                    result.m_y[i] = a.m_y[i] - b.m_y[i];
+                    result.m_z[i] = a.m_z[i] - b.m_z[i];
+                }
+            }
+        }
+
+        /// <summary>
+        /// Scales the vectors in a set.
+        /// </summary>
+        /// <param name="vectors">The set to scale.</param>
+        /// <param name="scale">The scale to apply.</param>
+        /// <param name="result">The set to store the scaled vectors in. May be the operand.</param>
+        public static void Multiply(Vector3SoA vectors, float scale, Vector3SoA result)
+        {
+            ValidateCount(vectors, result);
+
+            int length = vectors.Capacity;
+
+            if (Simd.IsAccelerated)
+            {
+                Vector<float> s = new Vector<float>(scale);
+
+                for (int i = 0; i < length; i += LANE_WIDTH)
+                {
+                    (new Vector<float>(vectors.m_x, i) * s).CopyTo(result.m_x, i);
+                    (new Vector<float>(vectors.m_y, i) * s).CopyTo(result.m_y, i);
+                    (new Vector<float>(vectors.m_z, i) * s).CopyTo(result.m_z, i);
+                }
+            }
+            else
+            {
+                for (int i = 0; i < length; i++)
+                {
+                    result.m_x[i] = vectors.m_x[i] * scale;
+                    result.m_y[i] = vectors.m_y[i] * scale;
+                    result.m_z[i] = vectors.m_z[i] * scale;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Multiplies the components of the vectors in two sets.
+        /// </summary>
+        /// <param name="vectors">The set to scale.</param>
+        /// <param name="scales">The scales to apply.</param>
+        /// <param name="result">The set to store the scaled vectors in. May be one of the operands.</param>
+        public static void Multiply(Vector3SoA vectors, Vector3SoA scales, Vector3SoA result)
+        {
+            ValidateCount(vectors, scales);
+            ValidateCount(vectors, result);
+
+            int length = vectors.Capacity;
+
+            if (Simd.IsAccelerated)
+            {
+                for (int i = 0; i < length; i += LANE_WIDTH)
+                {
+                    (new Vector<float>(vectors.m_x, i) * new Vector<float>(scales.m_x, i)).CopyTo(result.m_x, i);
+                    (new Vector<float>(vectors.m_y, i) * new Vector<float>(scales.m_y, i)).CopyTo(result.m_y, i);
+                    (new Vector<float>(vectors.m_z, i) * new Vector<float>(scales.m_z, i)).CopyTo(result.m_z, i);
+                }
+            }
+            else
+            {
+                for (int i = 0; i < length; i++)
+                {
+                    result.m_x[i] = vectors.m_x[i] * scales.m_x[i];
+                    result.m_y[i] = vectors.m_y[i] * scales.m_y[i];
+                    result.m_z[i] = vectors.m_z[i] * scales.m_z[i];
+                }
+            }
+        }
+
+        /// <summary>
+        /// Adds scaled vectors in one set to the vectors in another, such as when integrating velocities.
+        /// </summary>
+        /// <param name="a">The set to add to.</param>
+        /// <param name="b">The set to scale and add.</param>
+        /// <param name="scale">The scale to apply to the vectors in b.</param>
+        /// <param name="result">The set to store the sums in. May be one of the operands.</param>
+        public static void MultiplyAdd(Vector3SoA a, Vector3SoA b, float scale, Vector3SoA result)
+        {
+            ValidateCount(a, b);
+            ValidateCount(a, result);
+
+            int length = a.Capacity;
+
+            if (Simd.IsAccelerated)
+            {
+                Vector<float> s = new Vector<float>(scale);
+
+                for (int i = 0; i < length; i += LANE_WIDTH)
+                {
+                    (new Vector<float>(a.m_x, i) + new Vector<float>(b.m_x, i) * s).CopyTo(result.m_x, i);
+                    (new Vector<float>(a.m_y, i) + new Vector<float>(b.m_y, i) * s).CopyTo(result.m_y, i);
+                    (new Vector<float>(a.m_z, i) + new Vector<float>(b.m_z, i) * s).CopyTo(result.m_z, i);
+                }
+            }
+            else
+            {
+                for (int i = 0; i < length; i++)
+                {
+                    result.m_x[i] = a.m_x[i] + b.m_x[i] * scale;
+                    result.m_y[i] = a.m_y[i] + b.m_y[i] * scale;
+                    result.m_z[i] = a.m_z[i] + b.m_z[i] * scale;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Computes the dot products of the vectors in two sets.
+        /// </summary>
+        /// <param name="a">The first set.</param>
+        /// <param name="b">The second set.</param>
+        /// <param name="result">The array to store the dot products in. Must be at least <see cref="Count"/> long.</param>
+        public static void Dot(Vector3SoA a, Vector3SoA b, float[] result)
+        {
+            ValidateCount(a, b);
+            ValidateResult(a, result);
+
+            int i = 0;
+
+            if (Simd.IsAccelerated)
+            {
+                for (; i + LANE_WIDTH <= a.m_count; i += LANE_WIDTH)
+                {
+                    Vector<float> dot =
+                        (new Vector<float>(a.m_x, i) * new Vector<float>(b.m_x, i)) +
+                        (new Vector<float>(a.m_y, i) * new Vector<float>(b.m_y, i)) +
+                        (new Vector<float>(a.m_z, i) * new Vector<float>(b.m_z, i));
+
+                    dot.CopyTo(result, i);
+                }
+            }
+
+            for (; i < a.m_count; i++)
+            {
+                result[i] = (a.m_x[i] * b.m_x[i]) + (a.m_y[i] * b.m_y[i]) + (a.m_z[i] * b.m_z[i]);
+            }
+        }
+
+        /// <summary>
+        /// Computes the cross products of the vectors in two sets.
+        /// </summary>
+        /// <param name="left">The left operands.</param>
+        /// <param name="right">The right operands.</param>
+        /// <param name="result">The set to store the cross products in. May be one of the operands.</param>
+        public static void Cross(Vector3SoA left, Vector3SoA right, Vector3SoA result)
+        {
+            ValidateCount(left, right);
+            ValidateCount(left, result);
+
+            int length = left.Capacity;
+
+            if (Simd.IsAccelerated)
+            {
+                for (int i = 0; i < length; i += LANE_WIDTH)
+                {
+                    Vector<float> lx = new Vector<float>(left.m_x, i);
+                    Vector<float> ly = new Vector<float>(left.m_y, i);
+                    Vector<float> lz = new Vector<float>(left.m_z, i);
+                    Vector<float> rx = new Vector<float>(right.m_x, i);
+                    Vector<float> ry = new Vector<float>(right.m_y, i);
+                    Vector<float> rz = new Vector<float>(right.m_z, i);
+
+                    ((ly * rz) - (lz * ry)).CopyTo(result.m_x, i);
+                    ((lz * rx) - (lx * rz)).CopyTo(result.m_y, i);
+                    ((lx * ry) - (ly * rx)).CopyTo(result.m_z, i);
+                }
+            }
+            else
+            {
+                for (int i = 0; i < length; i++)
+                {
+                    float lx = left.m_x[i];
+                    float ly = left.m_y[i];
+                    float lz = left.m_z[i];
+                    float rx = right.m_x[i];
+                    float ry = right.m_y[i];
+                    float rz = right.m_z[i];
+
+                    result.m_x[i] = (ly * rz) - (lz * ry);
+                    result.m_y[i] = (lz * rx) - (lx * rz);
+                    result.m_z[i] = (lx * ry) - (ly * rx);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Scales the vectors in a set to unit length.
+        /// </summary>
+        /// <param name="vectors">The set to normalize.</param>
+        /// <param name="result">The set to store the normalized vectors in. May be the operand.</param>
+        public static void Normalize(Vector3SoA vectors, Vector3SoA result)
+        {
+            ValidateCount(vectors, result);
+
+            int length = vectors.Capacity;
+
+            if (Simd.IsAccelerated)
+            {
+                for (int i = 0; i < length; i += LANE_WIDTH)
+                {
+                    Vector<float> x = new Vector<float>(vectors.m_x, i);
+                    Vector<float> y = new Vector<float>(vectors.m_y, i);
+                    Vector<float> z = new Vector<float>(vectors.m_z, i);
+
+                    Vector<float> scale = Vector<float>.One / Vector.SquareRoot((x * x) + (y * y) + (z * z));
+
+                    (x * scale).CopyTo(result.m_x, i);
+                    (y * scale).CopyTo(result.m_y, i);
+                    (z * scale).CopyTo(result.m_z, i);
+                }
+            }
+            else
+            {
+                for (int i = 0; i < length; i++)
+                {
+                    float x = vectors.m_x[i];
+                    float y = vectors.m_y[i];
+                    float z = vectors.m_z[i];
+
+                    float scale = 1f / Mathf.Sqrt((x * x) + (y * y) + (z * z));
+
+                    result.m_x[i] = x * scale;
+                    result.m_y[i] = y * scale;
+                    result.m_z[i] = z * scale;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Linearly interpolates between the vectors in two sets by factor t.
+        /// </summary>
+        /// <param name="a">The set to interpolate from.</param>
+        /// <param name="b">The set to interpolate to.</param>
+        /// <param name="t">Weighting value.</param>
+        /// <param name="result">The set to store the interpolated vectors in. May be one of the operands.</param>
+        public static void Lerp(Vector3SoA a, Vector3SoA b, float t, Vector3SoA result)
+        {
+            ValidateCount(a, b);
+            ValidateCount(a, result);
+
+            int length = a.Capacity;
+
+            if (Simd.IsAccelerated)
+            {
+                Vector<float> w = new Vector<float>(t);
+
+                for (int i = 0; i < length; i += LANE_WIDTH)
+                {
+                    Vector<float> ax = new Vector<float>(a.m_x, i);
+                    Vector<float> ay = new Vector<float>(a.m_y, i);
+                    Vector<float> az = new Vector<float>(a.m_z, i);
+
+                    ((w * (new Vector<float>(b.m_x, i) - ax)) + ax).CopyTo(result.m_x, i);
+                    ((w * (new Vector<float>(b.m_y, i) - ay)) + ay).CopyTo(result.m_y, i);
+                    ((w * (new Vector<float>(b.m_z, i) - az)) + az).CopyTo(result.m_z, i);
+                }
+            }
+            else
+            {
+                for (int i = 0; i < length; i++)
+                {
+                    result.m_x[i] = (t * (b.m_x[i] - a.m_x[i])) + a.m_x[i];
+                    result.m_y[i] = (t * (b.m_y[i] - a.m_y[i])) + a.m_y[i];
+                    result.m_z[i] = (t * (b.m_z[i] - a.m_z[i])) + a.m_z[i];
+                }
+            }
+        }
+
+        /// <summary>
+        /// Computes the squared distances between the vectors in two sets.
+        /// </summary>
+        /// <param name="a">The first set.</param>
+        /// <param name="b">The second set.</param>
+        /// <param name="result">The array to store the squared distances in. Must be at least <see cref="Count"/> long.</param>
+        public static void DistanceSquared(Vector3SoA a, Vector3SoA b, float[] result)
+        {
+            ValidateCount(a, b);
+            ValidateResult(a, result);
+
+            int i = 0;
+
+            if (Simd.IsAccelerated)
+            {
+                for (; i + LANE_WIDTH <= a.m_count; i += LANE_WIDTH)
+                {
+                    Vector<float> dx = new Vector<float>(a.m_x, i) - new Vector<float>(b.m_x, i);
+                    Vector<float> dy = new Vector<float>(a.m_y, i) - new Vector<float>(b.m_y, i);
+                    Vector<float> dz = new Vector<float>(a.m_z, i) - new Vector<float>(b.m_z, i);
+
+                    ((dx * dx) + (dy * dy) + (dz * dz)).CopyTo(result, i);
+                }
+            }
+
+            for (; i < a.m_count; i++)
+            {
+                float dx = a.m_x[i] - b.m_x[i];
+                float dy = a.m_y[i] - b.m_y[i];
+                float dz = a.m_z[i] - b.m_z[i];
+                result[i] = (dx * dx) + (dy * dy) + (dz * dz);
+            }
+        }
+
+        /// <summary>
+        /// Throws an exception if an index is not within the set.
+        /// </summary>
+        private void ValidateIndex(int index)
+        {
+            if (index < 0 || index >= m_count)
+            {
+                throw new IndexOutOfRangeException();
+            }
+        }
+
+        /// <summary>
+        /// Throws an exception if two sets do not contain the same number of vectors.
+        /// </summary>
+        private static void ValidateCount(Vector3SoA a, Vector3SoA b)
+        {
+            if (a == null || b == null)
+            {
+                throw new ArgumentNullException(a == null ? "a" : "b");
+            }
+            if (a.m_count != b.m_count)
+            {
+                throw new ArgumentException($"Vector sets have different counts ({a.m_count} and {b.m_count})!");
+            }
+        }
+
+        /// <summary>
+        /// Throws an exception if an array can't hold a value for each vector in a set.
+        /// </summary>
+        private static void ValidateResult(Vector3SoA vectors, float[] result)
+        {
+            if (result == null)
+            {
+                throw new ArgumentNullException("result");
+            }
+            if (result.Length < vectors.m_count)
+            {
+                throw new ArgumentException("Result array length is lesser than the vector count");
+            }
+        }
+    }
+}
@@ -12,7 +12,7 @@ namespace Engine
     /// Describes a 4d vector.
     /// </summary>
     [StructLayout(LayoutKind.Sequential, Pack = 1)]
-    public struct Vector4 : IEquatable<Vector4>
+    public struct Vector4 : IEquatable<Vector4>, ICharFormattable
     {
         /// <summary>
         /// Returns a vector with components (0, 0, 0, 0).
@@ -880,15 +880,26 @@ namespace Engine
         /// <param name="result">The transformed vector as an output parameter.</param>
         public static void Transform(ref Vector4 vector, ref Matrix matrix, out Vector4 result)
         {
-            result.x = (vector.x * matrix.m00) + (vector.y * matrix.m10) + (vector.z * matrix.m20) + (vector.w * matrix.m30);
-            result.y = (vector.x * matrix.m01) + (vector.y * matrix.m11) + (vector.z * matrix.m21) + (vector.w * matrix.m31);
-            result.z = (vector.x * matrix.m02) + (vector.y * matrix.m12) + (vector.z * matrix.m22) + (vector.w * matrix.m32);
-            result.w = (vector.x * matrix.m03) + (vector.y * matrix.m13) + (vector.z * matrix.m23) + (vector.w * matrix.m33);
+            // read the vector first, as the result may be the same vector
+            float x = vector.x;
+            float y = vector.y;
+            float z = vector.z;
+            float w = vector.w;
+
+            result.x = (x * matrix.m00) + (y * matrix.m10) + (z * matrix.m20) + (w * matrix.m30);
+            result.y = (x * matrix.m01) + (y * matrix.m11) + (z * matrix.m21) + (w * matrix.m31);
+            result.z = (x * matrix.m02) + (y * matrix.m12) + (z * matrix.m22) + (w * matrix.m32);
+            result.w = (x * matrix.m03) + (y * matrix.m13) + (z * matrix.m23) + (w * matrix.m33);
         }
 
         /// <summary>
         /// Applies a transformation to all vectors within array and places the resuls in an another array.
         /// </summary>
+        /// <remarks>
+        /// The destination range may be the same as the source range to update the vectors in place. When hardware
+        /// acceleration is available a vectorized kernel is used, which gives bit identical results to the scalar
+        /// path in a 64-bit process, and is otherwise within 2 units in the last place per component.
+        /// </remarks>
         /// <param name="srcArray">The vectors to transform.</param>
         /// <param name="srcIndex">The starting index in the source array.</param>
         /// <param name="matrix">The transformation to apply.</param>
@@ -910,15 +921,27 @@ namespace Engine
                 throw new ArgumentException("Destination array is smaller than source array.");
             }
 
-            for (int i = 0; i < srcArray.Length; i++)
+            if (Simd.IsAccelerated)
+            {
+                Simd.Transform(srcArray, 0, ref matrix, destArray, 0, srcArray.Length);
+            }
+            else
             {
-                Transform(ref srcArray[i], ref matrix, out destArray[i]);
+                for (int i = 0; i < srcArray.Length; i++)
+                {
+                    Transform(ref srcArray[i], ref matrix, out destArray[i]);
+                }
             }
         }
         
         /// <summary>
         /// Applies a transformation to all vectors within array and places the resuls in an another array.
         /// </summary>
+        /// <remarks>
+        /// The destination range may be the same as the source range to update the vectors in place. When hardware
+        /// acceleration is available a vectorized kernel is used, which gives bit identical results to the scalar
+        /// path in a 64-bit process, and is otherwise within 2 units in the last place per component.
+        /// </remarks>
         /// <param name="srcArray">The vectors to transform.</param>
         /// <param name="srcIndex">The starting index in the source array.</param>
         /// <param name="matrix">The transformation to apply.</param>
@@ -944,9 +967,16 @@ namespace Engine
                 throw new ArgumentException("Destination array length is lesser than destinationIndex + length");
             }
 
-            for (int i = 0; i < length; i++)
+            if (Simd.IsAccelerated)
             {
-                Transform(ref srcArray[srcIndex + i], ref matrix, out destArray[destIndex + i]);
+                Simd.Transform(srcArray, srcIndex, ref matrix, destArray, destIndex, length);
+            }
+            else
+            {
+                for (int i = 0; i < length; i++)
+                {
+                    Transform(ref srcArray[srcIndex + i], ref matrix, out destArray[destIndex + i]);
+                }
             }
         }
         
@@ -989,6 +1019,31 @@ namespace Engine
             }
         }
 
+        /// <summary>
+        /// Writes the text of <see cref="ToString"/>, formatted with the invariant culture, into a buffer without allocating.
+        /// </summary>
+        /// <param name="destination">The buffer to write to.</param>
+        /// <param name="index">The index in the buffer to start writing at.</param>
+        /// <param name="charsWritten">Returns the number of characters written, or zero on failure.</param>
+        /// <returns>False if the buffer was too small.</returns>
+        public bool TryFormat(char[] destination, int index, out int charsWritten)
+        {
+            int i = index;
+            bool success =
+                CharFormat.TryWrite(destination, ref i, '(') &&
+                CharFormat.TryWrite(destination, ref i, x, 2) &&
+                CharFormat.TryWrite(destination, ref i, ", ") &&
+                CharFormat.TryWrite(destination, ref i, y, 2) &&
+                CharFormat.TryWrite(destination, ref i, ", ") &&
+                CharFormat.TryWrite(destination, ref i, z, 2) &&
+                CharFormat.TryWrite(destination, ref i, ", ") &&
+                CharFormat.TryWrite(destination, ref i, w, 2) &&
+                CharFormat.TryWrite(destination, ref i, ')');
+
+            charsWritten = success ? i - index : 0;
+            return success;
+        }
+
         /// <summary>
         /// Returns a <see cref="String"/> representation of this instance.
         /// </summary>
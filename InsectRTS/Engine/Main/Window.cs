@@ -3,6 +3,7 @@
 * See "Licence.txt" for full licence.
 */
 using System;
+using System.Diagnostics;
 using OpenTK;
 using OpenTK.Graphics;
 using Engine.Rendering;
@@ -14,10 +15,22 @@ namespace Engine
     /// </summary>
     internal class Window : GameWindow
     {
+        /// <summary>
+        /// The maximum time in milliseconds spent each frame running actions deferred to the main thread.
+        /// </summary>
+        internal const double DEFERRED_ACTION_BUDGET = 2.0;
+
+        /// <summary>
+        /// The minimum number of seconds between updates to the frame rate shown in the title.
+        /// </summary>
+        private const double TITLE_UPDATE_INTERVAL = 0.25;
+
         private readonly IContext m_context;
+        private readonly FrameStats m_frameStats;
         private bool m_viewportDirty = true;
+        private long m_lastTitleUpdate = 0;
 
-        public Window(IContext context, int width, int height, string title) : base(
+        public Window(IContext context, FrameStats frameStats, int width, int height, string title, double renderFrequency) : base(
             width, height,
             RendererConfig.GRAPHICS_MODE,
             title,
@@ -32,6 +45,7 @@ namespace Engine
         )
         {
             m_context = context;
+            m_frameStats = frameStats;
             
 #if DEBUG
             m_context.EnableDebugOutput();
@@ -41,7 +55,7 @@ namespace Engine
             m_context.CheckSupport();
             
             VSync = VSyncMode.Adaptive;
-            TargetRenderFrequency = 60.0;
+            TargetRenderFrequency = renderFrequency;
         }
 
         protected override void OnResize(EventArgs e)
@@ -50,17 +64,43 @@ namespace Engine
             base.OnResize(e);
         }
 
+        protected override void OnUnload(EventArgs e)
+        {
+            // free any remaining resources while the context is still current
+            Threading.RunDeferredActions(double.PositiveInfinity);
+            base.OnUnload(e);
+        }
+
         protected override void OnRenderFrame(FrameEventArgs e)
         {
-            Title = $"(Vsync: {VSync}) FPS: {1f / e.Time:0}";
+            long start = Stopwatch.GetTimestamp();
+            long startAllocated = FrameStats.GetAllocatedBytes();
 
-            if (m_viewportDirty)
+            using (Profiler.Sample("Window.OnRenderFrame"))
             {
-                m_context.Resize(Width, Height);
-                m_viewportDirty = false;
+                // setting the title is slow, so only do it a few times a second
+                if (start - m_lastTitleUpdate >= TITLE_UPDATE_INTERVAL * Stopwatch.Frequency)
+                {
+                    Title = $"(Vsync: {VSync}) FPS: {m_frameStats.FramesPerSecond:0} p99: {m_frameStats.P99:0.0}ms";
+                    m_lastTitleUpdate = start;
+                }
+
+                // run GL work handed over by other threads, such as freeing finalized resources
+                using (Profiler.Sample("Deferred Actions"))
+                {
+                    Threading.RunDeferredActions(DEFERRED_ACTION_BUDGET);
+                }
+
+                if (m_viewportDirty)
+                {
+                    m_context.Resize(Width, Height);
+                    m_viewportDirty = false;
+                }
+
+                base.OnRenderFrame(e);
             }
 
-            base.OnRenderFrame(e);
+            m_frameStats.AddRender(Stopwatch.GetTimestamp() - start, FrameStats.GetAllocatedBytes() - startAllocated);
         }
     }
 }
@@ -38,3 +38,6 @@ using System.Runtime.InteropServices;
 // [assembly: AssemblyVersion("1.0.*")]
 [assembly: AssemblyVersion("1.0.0.0")]
 [assembly: AssemblyFileVersion("1.0.0.0")]
+
+// Allow the benchmarks to measure internal systems such as the log writer
+[assembly: InternalsVisibleTo("Benchmarks")]
@@ -0,0 +1,71 @@
+﻿/*
+* Copyright © 2018-2019 Scott Sewell
+* See "Licence.txt" for full licence.
+*/
+using System;
+using System.Collections.Generic;
+using System.IO;
+using Engine.Logging;
+
+namespace LogDecoder
+{
+    /// <summary>
+    /// Converts binary event logs into text logs.
+    /// </summary>
+    internal class Program
+    {
+        private const string THREADS_OPTION = "--threads";
+
+        public static int Main(string[] args)
+        {
+            List<string> paths = new List<string>();
+            bool includeThreadIds = false;
+
+            foreach (string arg in args)
+            {
+                if (arg == THREADS_OPTION)
+                {
+                    includeThreadIds = true;
+                }
+                else
+                {
+                    paths.Add(arg);
+                }
+            }
+
+            if (paths.Count < 1 || paths.Count > 2)
+            {
+                Console.Error.WriteLine($"Usage: LogDecoder <input.blog> [output.log] [{THREADS_OPTION}]");
+                Console.Error.WriteLine("Writes the decoded log to the output file, or to the console if no output file is given.");
+                Console.Error.WriteLine($"{THREADS_OPTION} prefixes each message with the ID of the thread that logged it.");
+                return 1;
+            }
+
+            try
+            {
+                // the game may still have the log open
+                using (FileStream input = new FileStream(paths[0], FileMode.Open, FileAccess.Read, FileShare.ReadWrite | FileShare.Delete))
+                {
+                    if (paths.Count == 2)
+                    {
+                        using (StreamWriter output = new StreamWriter(paths[1]))
+                        {
+                            int count = BinaryLogReader.Decode(input, output, includeThreadIds);
+                            Console.WriteLine($"Decoded {count} events to \"{paths[1]}\"");
+                        }
+                    }
+                    else
+                    {
+                        BinaryLogReader.Decode(input, Console.Out, includeThreadIds);
+                    }
+                }
+                return 0;
+            }
+            catch (Exception e) when (e is IOException || e is InvalidDataException || e is UnauthorizedAccessException)
+            {
+                Console.Error.WriteLine(e.Message);
+                return 1;
+            }
+        }
+    }
+}